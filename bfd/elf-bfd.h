@@ -1166,6 +1166,15 @@ struct elf_backend_data
   bfd_boolean (*gc_sweep_hook)
     (bfd *, struct bfd_link_info *, asection *, const Elf_Internal_Rela *);
 
+  /* This function, if defined, is called by --icf=safe to find out
+     whether a reloc of the given type may take the address of the code
+     it refers to, rather than just call or branch to it.  Sections whose
+     address is taken are not folded.  --icf is only supported by
+     targets that define it, and that move the symbols of the sections
+     in icf_folded with those of the section they were folded into.  */
+  bfd_boolean (*icf_address_reloc_p)
+    (unsigned int);
+
   /* This function, if defined, is called after the ELF headers have
      been created.  This allows for things like the OS and ABI versions
      to be changed.  */
@@ -1635,6 +1644,10 @@ struct bfd_elf_section_data
 
   /* A pointer used for various section optimizations.  */
   void *sec_info;
+
+  /* The sections that identical code folding has folded into this one,
+     chained through this field of each.  */
+  asection *icf_folded;
 };
 
 #define elf_section_data(sec) ((struct bfd_elf_section_data*)(sec)->used_by_bfd)
@@ -2233,6 +2246,8 @@ extern bfd_boolean _bfd_elf_link_create_dynamic_sections
   (bfd *, struct bfd_link_info *);
 extern bfd_boolean _bfd_elf_link_omit_section_dynsym
   (bfd *, struct bfd_link_info *, asection *);
+extern bfd_boolean _bfd_elf_link_add_glibc_version_dependency
+  (bfd *, struct bfd_link_info *, const char *);
 extern bfd_boolean _bfd_elf_create_dynamic_sections
   (bfd *, struct bfd_link_info *);
 extern bfd_boolean _bfd_elf_create_got_section
@@ -2425,6 +2440,9 @@ extern bfd_boolean bfd_elf_gc_mark_dynamic_ref_symbol
 extern bfd_boolean bfd_elf_gc_sections
   (bfd *, struct bfd_link_info *);
 
+extern bfd_boolean bfd_elf_icf_sections
+  (bfd *, struct bfd_link_info *);
+
 extern bfd_boolean bfd_elf_gc_record_vtinherit
   (bfd *, asection *, struct elf_link_hash_entry *, bfd_vma);
 
@@ -2025,6 +2025,7 @@ bfd_section_from_shdr (bfd *abfd, unsigned int shindex)
     case SHT_PREINIT_ARRAY:	/* .preinit_array section.  */
     case SHT_GNU_LIBLIST:	/* .gnu.liblist section.  */
     case SHT_GNU_HASH:		/* .gnu.hash section.  */
+    case SHT_RELR:		/* .relr.dyn section.  */
       ret = _bfd_elf_make_section_from_shdr (abfd, hdr, name, shindex);
       goto success;
 
@@ -2649,6 +2650,7 @@ static const struct bfd_elf_special_section special_sections_r[] =
 {
   { STRING_COMMA_LEN (".rodata"), -2, SHT_PROGBITS, SHF_ALLOC },
   { STRING_COMMA_LEN (".rodata1"), 0, SHT_PROGBITS, SHF_ALLOC },
+  { STRING_COMMA_LEN (".relr.dyn"), 0, SHT_RELR,   SHF_ALLOC },
   { STRING_COMMA_LEN (".rela"),   -1, SHT_RELA,     0 },
   { STRING_COMMA_LEN (".rel"),    -1, SHT_REL,      0 },
   { NULL,                   0,     0, 0,            0 }
@@ -3251,6 +3253,7 @@ elf_fake_sections (bfd *abfd, asection *asect, void *fsarg)
     case SHT_INIT_ARRAY:
     case SHT_FINI_ARRAY:
     case SHT_PREINIT_ARRAY:
+    case SHT_RELR:
       this_hdr->sh_entsize = bed->s->arch_size / 8;
       break;
 
@@ -5968,6 +5968,170 @@ elf_gc_sweep_symbol (struct elf_link_hash_entry *h, void *data)
   return TRUE;
 }
 
+/* Build the .gnu.version_r section S of OUTPUT_BFD from the version
+   references found so far, or exclude it if there are none.  */
+
+static bfd_boolean
+elf_link_size_version_r (bfd *output_bfd, struct bfd_link_info *info,
+			 asection *s)
+{
+  Elf_Internal_Verneed *vn;
+  unsigned int size;
+  unsigned int crefs;
+  bfd_byte *p;
+
+  if (elf_tdata (output_bfd)->verref == NULL)
+    {
+      s->flags |= SEC_EXCLUDE;
+      return TRUE;
+    }
+
+  /* Build the version dependency section.  */
+  size = 0;
+  crefs = 0;
+  for (vn = elf_tdata (output_bfd)->verref;
+       vn != NULL;
+       vn = vn->vn_nextref)
+    {
+      Elf_Internal_Vernaux *a;
+
+      size += sizeof (Elf_External_Verneed);
+      ++crefs;
+      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	size += sizeof (Elf_External_Vernaux);
+    }
+
+  s->size = size;
+  s->contents = (unsigned char *) bfd_alloc (output_bfd, s->size);
+  if (s->contents == NULL)
+    return FALSE;
+
+  p = s->contents;
+  for (vn = elf_tdata (output_bfd)->verref;
+       vn != NULL;
+       vn = vn->vn_nextref)
+    {
+      unsigned int caux;
+      Elf_Internal_Vernaux *a;
+      size_t indx;
+
+      caux = 0;
+      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	++caux;
+
+      vn->vn_version = VER_NEED_CURRENT;
+      vn->vn_cnt = caux;
+      indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
+				  elf_dt_name (vn->vn_bfd) != NULL
+				  ? elf_dt_name (vn->vn_bfd)
+				  : lbasename (vn->vn_bfd->filename),
+				  FALSE);
+      if (indx == (size_t) -1)
+	return FALSE;
+      vn->vn_file = indx;
+      vn->vn_aux = sizeof (Elf_External_Verneed);
+      if (vn->vn_nextref == NULL)
+	vn->vn_next = 0;
+      else
+	vn->vn_next = (sizeof (Elf_External_Verneed)
+		      + caux * sizeof (Elf_External_Vernaux));
+
+      _bfd_elf_swap_verneed_out (output_bfd, vn,
+				 (Elf_External_Verneed *) p);
+      p += sizeof (Elf_External_Verneed);
+
+      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	{
+	  a->vna_hash = bfd_elf_hash (a->vna_nodename);
+	  indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
+				      a->vna_nodename, FALSE);
+	  if (indx == (size_t) -1)
+	    return FALSE;
+	  a->vna_name = indx;
+	  if (a->vna_nextptr == NULL)
+	    a->vna_next = 0;
+	  else
+	    a->vna_next = sizeof (Elf_External_Vernaux);
+
+	  _bfd_elf_swap_vernaux_out (output_bfd, a,
+				     (Elf_External_Vernaux *) p);
+	  p += sizeof (Elf_External_Vernaux);
+	}
+    }
+
+  elf_tdata (output_bfd)->cverrefs = crefs;
+  return TRUE;
+}
+
+/* Add a need for version VERSION of the C library to the version
+   references of OUTPUT_BFD, and rebuild .gnu.version_r to match.  Do
+   nothing unless the output already needs a GLIBC_2 version from a
+   libc.so, so that only links against glibc get the new need.  This is
+   for backends to call from their size_dynamic_sections hook, before
+   the dynamic string table is finalized.  */
+
+bfd_boolean
+_bfd_elf_link_add_glibc_version_dependency (bfd *output_bfd,
+					    struct bfd_link_info *info,
+					    const char *version)
+{
+  Elf_Internal_Verneed *t, *vn;
+  Elf_Internal_Vernaux *a;
+  bfd_boolean glibc = FALSE;
+  unsigned int vers;
+  asection *s;
+
+  for (t = elf_tdata (output_bfd)->verref; t != NULL; t = t->vn_nextref)
+    {
+      const char *soname = bfd_elf_get_dt_soname (t->vn_bfd);
+
+      if (soname != NULL && CONST_STRNEQ (soname, "libc.so."))
+	break;
+    }
+  if (t == NULL)
+    return TRUE;
+
+  for (a = t->vn_auxptr; a != NULL; a = a->vna_nextptr)
+    {
+      if (strcmp (a->vna_nodename, version) == 0)
+	return TRUE;
+      if (CONST_STRNEQ (a->vna_nodename, "GLIBC_2."))
+	glibc = TRUE;
+    }
+  if (!glibc)
+    return TRUE;
+
+  /* Version indices after those of the version definitions are handed
+     out in order, so the new one follows the highest in use.  Drop the
+     dynamic string references of the section built so far; rebuilding it
+     takes them again.  */
+  vers = 0;
+  for (vn = elf_tdata (output_bfd)->verref; vn != NULL; vn = vn->vn_nextref)
+    {
+      _bfd_elf_strtab_delref (elf_hash_table (info)->dynstr, vn->vn_file);
+      for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
+	{
+	  _bfd_elf_strtab_delref (elf_hash_table (info)->dynstr,
+				  a->vna_name);
+	  if (a->vna_other > vers)
+	    vers = a->vna_other;
+	}
+    }
+
+  a = (Elf_Internal_Vernaux *) bfd_zalloc (output_bfd, sizeof *a);
+  if (a == NULL)
+    return FALSE;
+  a->vna_nodename = version;
+  a->vna_other = vers + 1;
+  a->vna_nextptr = t->vn_auxptr;
+  t->vn_auxptr = a;
+
+  s = bfd_get_linker_section (elf_hash_table (info)->dynobj,
+			      ".gnu.version_r");
+  BFD_ASSERT (s != NULL);
+  return elf_link_size_version_r (output_bfd, info, s);
+}
+
 /* Set up the sizes and contents of the ELF dynamic sections.  This is
    called by the ELF linker emulation before_allocation routine.  We
    must set the sizes of the sections before the linker sets the
@@ -6369,90 +6533,8 @@ bfd_elf_size_dynamic_sections (bfd *output_bfd,
 	if (sinfo.failed)
 	  return FALSE;
 
-	if (elf_tdata (output_bfd)->verref == NULL)
-	  s->flags |= SEC_EXCLUDE;
-	else
-	  {
-	    Elf_Internal_Verneed *vn;
-	    unsigned int size;
-	    unsigned int crefs;
-	    bfd_byte *p;
-
-	    /* Build the version dependency section.  */
-	    size = 0;
-	    crefs = 0;
-	    for (vn = elf_tdata (output_bfd)->verref;
-		 vn != NULL;
-		 vn = vn->vn_nextref)
-	      {
-		Elf_Internal_Vernaux *a;
-
-		size += sizeof (Elf_External_Verneed);
-		++crefs;
-		for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
-		  size += sizeof (Elf_External_Vernaux);
-	      }
-
-	    s->size = size;
-	    s->contents = (unsigned char *) bfd_alloc (output_bfd, s->size);
-	    if (s->contents == NULL)
-	      return FALSE;
-
-	    p = s->contents;
-	    for (vn = elf_tdata (output_bfd)->verref;
-		 vn != NULL;
-		 vn = vn->vn_nextref)
-	      {
-		unsigned int caux;
-		Elf_Internal_Vernaux *a;
-		size_t indx;
-
-		caux = 0;
-		for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
-		  ++caux;
-
-		vn->vn_version = VER_NEED_CURRENT;
-		vn->vn_cnt = caux;
-		indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
-					    elf_dt_name (vn->vn_bfd) != NULL
-					    ? elf_dt_name (vn->vn_bfd)
-					    : lbasename (vn->vn_bfd->filename),
-					    FALSE);
-		if (indx == (size_t) -1)
-		  return FALSE;
-		vn->vn_file = indx;
-		vn->vn_aux = sizeof (Elf_External_Verneed);
-		if (vn->vn_nextref == NULL)
-		  vn->vn_next = 0;
-		else
-		  vn->vn_next = (sizeof (Elf_External_Verneed)
-				+ caux * sizeof (Elf_External_Vernaux));
-
-		_bfd_elf_swap_verneed_out (output_bfd, vn,
-					   (Elf_External_Verneed *) p);
-		p += sizeof (Elf_External_Verneed);
-
-		for (a = vn->vn_auxptr; a != NULL; a = a->vna_nextptr)
-		  {
-		    a->vna_hash = bfd_elf_hash (a->vna_nodename);
-		    indx = _bfd_elf_strtab_add (elf_hash_table (info)->dynstr,
-						a->vna_nodename, FALSE);
-		    if (indx == (size_t) -1)
-		      return FALSE;
-		    a->vna_name = indx;
-		    if (a->vna_nextptr == NULL)
-		      a->vna_next = 0;
-		    else
-		      a->vna_next = sizeof (Elf_External_Vernaux);
-
-		    _bfd_elf_swap_vernaux_out (output_bfd, a,
-					       (Elf_External_Vernaux *) p);
-		    p += sizeof (Elf_External_Vernaux);
-		  }
-	      }
-
-	    elf_tdata (output_bfd)->cverrefs = crefs;
-	  }
+	if (!elf_link_size_version_r (output_bfd, info, s))
+	  return FALSE;
       }
     }
 
@@ -13382,6 +13464,670 @@ bfd_elf_gc_sections (bfd *abfd, struct bfd_link_info *info)
   return elf_gc_sweep (abfd, info);
 }
 
+/* Identical code folding.  Each code section whose contents and relocs
+   match those of another is folded into that other section: its
+   kept_section is set to the section that is kept, the linker neither
+   lays it out nor writes it, and it is given the output_offset of the
+   kept section, so that its symbols, and relocs against them, resolve to
+   the one copy.  Relocs against two sections that are themselves being
+   folded match if those sections do, which is found by splitting the
+   candidates into classes of matching sections until no class splits.  */
+
+/* A reloc of a section that may be folded, reduced to what decides
+   whether two such sections match.  */
+
+struct elf_icf_reloc
+{
+  bfd_vma offset;
+  bfd_vma type;
+  bfd_vma addend;
+  bfd_vma value;
+
+  /* The symbol referred to, if it might be preempted, else NULL.  */
+  struct elf_link_hash_entry *h;
+
+  /* The section referred to, if it is not a candidate for folding.  */
+  asection *sec;
+
+  /* The index of the candidate referred to, or -1.  */
+  int cand;
+};
+
+/* A section that may be folded.  */
+
+struct elf_icf_section
+{
+  asection *sec;
+  bfd_byte *contents;
+  struct elf_icf_reloc *relocs;
+  unsigned int reloc_count;
+
+  /* A hash of everything that decides whether sections match, except
+     for which candidates the relocs refer to.  */
+  hashval_t hash;
+
+  /* The lowest index of the candidates in the same class.  */
+  unsigned int cls;
+
+  /* TRUE if something may compare the address of this section.  */
+  bfd_boolean address_taken;
+
+  /* TRUE if a reloc of this section cannot be compared.  */
+  bfd_boolean unique;
+};
+
+/* The state of identical code folding.  */
+
+struct elf_icf_info
+{
+  struct bfd_link_info *info;
+  struct elf_icf_section *cands;
+  unsigned int count;
+
+  /* One more than the index of the candidate, indexed by section id,
+     or zero for sections that are not candidates.  */
+  unsigned int *index;
+  unsigned int index_size;
+};
+
+/* The position of a candidate while its class is split.  */
+
+struct elf_icf_key
+{
+  unsigned int cls;
+  hashval_t hash;
+  unsigned int index;
+};
+
+/* Return the candidate index of SEC, or -1.  */
+
+static int
+elf_icf_index (const struct elf_icf_info *icf, const asection *sec)
+{
+  if (sec->id >= icf->index_size)
+    return -1;
+  return (int) icf->index[sec->id] - 1;
+}
+
+/* Return TRUE if SEC, an input section of a regular ELF object, may be
+   folded.  */
+
+static bfd_boolean
+elf_icf_candidate_p (asection *sec)
+{
+  return ((sec->flags & (SEC_ALLOC | SEC_CODE | SEC_HAS_CONTENTS
+			 | SEC_EXCLUDE | SEC_KEEP | SEC_MERGE
+			 | SEC_THREAD_LOCAL | SEC_LINKER_CREATED))
+	  == (SEC_ALLOC | SEC_CODE | SEC_HAS_CONTENTS)
+	  && sec->size != 0
+	  && sec->output_section != NULL
+	  && !discarded_section (sec)
+	  && sec->kept_section == NULL
+	  && sec->sec_info_type == SEC_INFO_TYPE_NONE
+	  /* Dynamic relocs are counted per section.  */
+	  && elf_section_data (sec)->sreloc == NULL);
+}
+
+/* Return the symbol that COOKIE's current reloc refers to, or NULL if
+   it refers to a local symbol, in which case store that in *ISYM.  */
+
+static struct elf_link_hash_entry *
+elf_icf_reloc_sym (struct elf_reloc_cookie *cookie, Elf_Internal_Sym **isym)
+{
+  unsigned long r_symndx = cookie->rel->r_info >> cookie->r_sym_shift;
+  struct elf_link_hash_entry *h;
+
+  *isym = NULL;
+  if (r_symndx < cookie->locsymcount
+      && ELF_ST_BIND (cookie->locsyms[r_symndx].st_info) == STB_LOCAL)
+    {
+      *isym = &cookie->locsyms[r_symndx];
+      return NULL;
+    }
+
+  h = cookie->sym_hashes[r_symndx - cookie->extsymoff];
+  while (h->root.type == bfd_link_hash_indirect
+	 || h->root.type == bfd_link_hash_warning)
+    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+  return h;
+}
+
+/* Reduce COOKIE's current reloc to R.  Return FALSE if it refers to
+   something that cannot be compared.  */
+
+static bfd_boolean
+elf_icf_read_reloc (struct elf_icf_info *icf, struct elf_reloc_cookie *cookie,
+		    struct elf_icf_reloc *r)
+{
+  const Elf_Internal_Rela *rel = cookie->rel;
+  struct elf_link_hash_entry *h;
+  Elf_Internal_Sym *isym;
+  asection *sec;
+  bfd_boolean section_sym = FALSE;
+
+  r->offset = rel->r_offset;
+  r->type = rel->r_info & (((bfd_vma) 1 << cookie->r_sym_shift) - 1);
+  r->addend = rel->r_addend;
+  r->value = 0;
+  r->h = NULL;
+  r->sec = NULL;
+  r->cand = -1;
+
+  if ((rel->r_info >> cookie->r_sym_shift) == STN_UNDEF)
+    return TRUE;
+
+  h = elf_icf_reloc_sym (cookie, &isym);
+  if (h == NULL)
+    {
+      if (isym->st_shndx == SHN_ABS)
+	sec = bfd_abs_section_ptr;
+      else
+	{
+	  sec = bfd_section_from_elf_index (cookie->abfd, isym->st_shndx);
+	  if (sec == NULL)
+	    return FALSE;
+	}
+      r->value = isym->st_value;
+      section_sym = ELF_ST_TYPE (isym->st_info) == STT_SECTION;
+    }
+  else if ((h->root.type == bfd_link_hash_defined
+	    || h->root.type == bfd_link_hash_defweak)
+	   && _bfd_elf_symbol_refs_local_p (h, icf->info, FALSE))
+    {
+      sec = h->root.u.def.section;
+      r->value = h->root.u.def.value;
+    }
+  else
+    {
+      r->h = h;
+      return TRUE;
+    }
+
+  /* Refer to merged constants by where they end up, so that references
+     to the same string from different objects match.  */
+  if (sec->sec_info_type == SEC_INFO_TYPE_MERGE)
+    {
+      void *sec_info = elf_section_data (sec)->sec_info;
+
+      if (section_sym)
+	{
+	  r->value = _bfd_merged_section_offset (icf->info->output_bfd, &sec,
+						 sec_info,
+						 r->value + r->addend);
+	  r->addend = 0;
+	}
+      else
+	r->value = _bfd_merged_section_offset (icf->info->output_bfd, &sec,
+					       sec_info, r->value);
+    }
+
+  r->cand = elf_icf_index (icf, sec);
+  if (r->cand < 0)
+    r->sec = sec;
+  return TRUE;
+}
+
+/* Read the contents and relocs of candidate C, using COOKIE, and hash
+   them.  Return FALSE on error.  */
+
+static bfd_boolean
+elf_icf_read_section (struct elf_icf_info *icf, struct elf_icf_section *c,
+		      struct elf_reloc_cookie *cookie)
+{
+  asection *sec = c->sec;
+  hashval_t hash;
+  unsigned int i;
+
+  if (!bfd_malloc_and_get_section (sec->owner, sec, &c->contents))
+    return FALSE;
+
+  if (!init_reloc_cookie_rels (cookie, icf->info, sec->owner, sec))
+    return FALSE;
+
+  c->reloc_count = cookie->relend - cookie->rels;
+  if (c->reloc_count != 0)
+    {
+      c->relocs = (struct elf_icf_reloc *)
+	bfd_malloc (c->reloc_count * sizeof (*c->relocs));
+      if (c->relocs == NULL)
+	{
+	  fini_reloc_cookie_rels (cookie, sec);
+	  return FALSE;
+	}
+    }
+
+  hash = iterative_hash_object (sec->output_section, 0);
+  hash = iterative_hash_object (sec->flags, hash);
+  hash = iterative_hash_object (sec->alignment_power, hash);
+  hash = iterative_hash (c->contents, sec->size, hash);
+  for (i = 0; i < c->reloc_count; i++)
+    {
+      struct elf_icf_reloc *r = &c->relocs[i];
+
+      cookie->rel = cookie->rels + i;
+      if (!elf_icf_read_reloc (icf, cookie, r))
+	{
+	  c->reloc_count = i;
+	  c->unique = TRUE;
+	  break;
+	}
+      hash = iterative_hash_object (r->offset, hash);
+      hash = iterative_hash_object (r->type, hash);
+      hash = iterative_hash_object (r->addend, hash);
+      hash = iterative_hash_object (r->value, hash);
+      hash = iterative_hash_object (r->h, hash);
+      hash = iterative_hash_object (r->sec, hash);
+    }
+  c->hash = hash;
+
+  fini_reloc_cookie_rels (cookie, sec);
+  return TRUE;
+}
+
+/* Return TRUE if candidates A and B match, except perhaps for which
+   candidates their relocs refer to.  */
+
+static bfd_boolean
+elf_icf_sections_match (const struct elf_icf_section *a,
+			const struct elf_icf_section *b)
+{
+  unsigned int i;
+
+  if (a->unique
+      || b->unique
+      || a->hash != b->hash
+      || a->sec->output_section != b->sec->output_section
+      || a->sec->flags != b->sec->flags
+      || a->sec->alignment_power != b->sec->alignment_power
+      || a->sec->size != b->sec->size
+      || a->reloc_count != b->reloc_count
+      || memcmp (a->contents, b->contents, a->sec->size) != 0)
+    return FALSE;
+
+  for (i = 0; i < a->reloc_count; i++)
+    {
+      const struct elf_icf_reloc *ra = &a->relocs[i];
+      const struct elf_icf_reloc *rb = &b->relocs[i];
+
+      if (ra->offset != rb->offset
+	  || ra->type != rb->type
+	  || ra->addend != rb->addend
+	  || ra->value != rb->value
+	  || ra->h != rb->h
+	  || ra->sec != rb->sec
+	  || (ra->cand < 0) != (rb->cand < 0))
+	return FALSE;
+    }
+  return TRUE;
+}
+
+/* Return TRUE if the relocs of candidates A and B refer to candidates
+   in the same classes.  */
+
+static bfd_boolean
+elf_icf_targets_match (const struct elf_icf_info *icf,
+		       const struct elf_icf_section *a,
+		       const struct elf_icf_section *b)
+{
+  unsigned int i;
+
+  for (i = 0; i < a->reloc_count; i++)
+    if (a->relocs[i].cand >= 0
+	&& (icf->cands[a->relocs[i].cand].cls
+	    != icf->cands[b->relocs[i].cand].cls))
+      return FALSE;
+  return TRUE;
+}
+
+/* Order candidates by class, then hash, then index.  */
+
+static int
+elf_icf_key_compare (const void *a, const void *b)
+{
+  const struct elf_icf_key *ka = (const struct elf_icf_key *) a;
+  const struct elf_icf_key *kb = (const struct elf_icf_key *) b;
+
+  if (ka->cls != kb->cls)
+    return ka->cls < kb->cls ? -1 : 1;
+  if (ka->hash != kb->hash)
+    return ka->hash < kb->hash ? -1 : 1;
+  return ka->index < kb->index ? -1 : ka->index > kb->index;
+}
+
+/* Split each class of candidates into those that match, using their
+   contents and relocs if INITIAL, or else the classes of the candidates
+   their relocs refer to.  KEYS and CLS are scratch arrays with one
+   element per candidate.  Return the number of classes.  */
+
+static unsigned int
+elf_icf_split_classes (struct elf_icf_info *icf, struct elf_icf_key *keys,
+		       unsigned int *cls, bfd_boolean initial)
+{
+  unsigned int i, j, start, count = 0;
+
+  for (i = 0; i < icf->count; i++)
+    {
+      struct elf_icf_section *c = &icf->cands[i];
+
+      keys[i].index = i;
+      if (initial)
+	{
+	  keys[i].cls = 0;
+	  keys[i].hash = c->hash;
+	}
+      else
+	{
+	  hashval_t hash = 0;
+
+	  for (j = 0; j < c->reloc_count; j++)
+	    if (c->relocs[j].cand >= 0)
+	      hash = iterative_hash_object
+		(icf->cands[c->relocs[j].cand].cls, hash);
+	  keys[i].cls = c->cls;
+	  keys[i].hash = hash;
+	}
+    }
+
+  qsort (keys, icf->count, sizeof (*keys), elf_icf_key_compare);
+
+  /* Within each run of equal keys, each candidate joins the class of the
+     first earlier one it matches, or else starts a class of its own.  */
+  for (start = 0; start < icf->count; start = i)
+    {
+      for (i = start;
+	   (i < icf->count
+	    && keys[i].cls == keys[start].cls
+	    && keys[i].hash == keys[start].hash);
+	   i++)
+	{
+	  struct elf_icf_section *c = &icf->cands[keys[i].index];
+
+	  cls[keys[i].index] = keys[i].index;
+	  for (j = start; j < i; j++)
+	    {
+	      struct elf_icf_section *leader = &icf->cands[keys[j].index];
+
+	      if (cls[keys[j].index] == keys[j].index
+		  && (initial
+		      ? elf_icf_sections_match (leader, c)
+		      : elf_icf_targets_match (icf, leader, c)))
+		{
+		  cls[keys[i].index] = keys[j].index;
+		  break;
+		}
+	    }
+	  if (cls[keys[i].index] == keys[i].index)
+	    count++;
+	}
+    }
+
+  for (i = 0; i < icf->count; i++)
+    icf->cands[i].cls = cls[i];
+  return count;
+}
+
+/* Mark the candidate that defines H as having its address taken if code
+   outside this link may see H.  */
+
+static bfd_boolean
+elf_icf_mark_exported (struct elf_link_hash_entry *h, void *data)
+{
+  struct elf_icf_info *icf = (struct elf_icf_info *) data;
+  struct bfd_link_info *info = icf->info;
+  int cand;
+
+  if ((h->root.type != bfd_link_hash_defined
+       && h->root.type != bfd_link_hash_defweak)
+      || h->forced_local)
+    return TRUE;
+
+  cand = elf_icf_index (icf, h->root.u.def.section);
+  if (cand >= 0
+      && (h->ref_dynamic
+	  || h->dynamic
+	  || ((ELF_ST_VISIBILITY (h->other) == STV_DEFAULT
+	       || ELF_ST_VISIBILITY (h->other) == STV_PROTECTED)
+	      && (bfd_link_dll (info) || info->export_dynamic))))
+    icf->cands[cand].address_taken = TRUE;
+  return TRUE;
+}
+
+/* Mark the candidates whose address relocs in allocated section SEC,
+   read through COOKIE, may take.  */
+
+static bfd_boolean
+elf_icf_mark_address_taken (struct elf_icf_info *icf, asection *sec,
+			    struct elf_reloc_cookie *cookie)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (sec->owner);
+  bfd_vma r_type_mask = ((bfd_vma) 1 << cookie->r_sym_shift) - 1;
+
+  if (!init_reloc_cookie_rels (cookie, icf->info, sec->owner, sec))
+    return FALSE;
+
+  for (cookie->rel = cookie->rels;
+       cookie->rel < cookie->relend;
+       cookie->rel++)
+    {
+      struct elf_link_hash_entry *h;
+      Elf_Internal_Sym *isym;
+      asection *target = NULL;
+      int cand;
+
+      if ((cookie->rel->r_info >> cookie->r_sym_shift) == STN_UNDEF
+	  || !bed->icf_address_reloc_p (cookie->rel->r_info & r_type_mask))
+	continue;
+
+      h = elf_icf_reloc_sym (cookie, &isym);
+      if (h == NULL)
+	target = bfd_section_from_elf_index (cookie->abfd, isym->st_shndx);
+      else if (h->root.type == bfd_link_hash_defined
+	       || h->root.type == bfd_link_hash_defweak)
+	target = h->root.u.def.section;
+
+      if (target != NULL && (cand = elf_icf_index (icf, target)) >= 0)
+	icf->cands[cand].address_taken = TRUE;
+    }
+
+  fini_reloc_cookie_rels (cookie, sec);
+  return TRUE;
+}
+
+/* Free the candidates of ICF.  */
+
+static void
+elf_icf_free (struct elf_icf_info *icf)
+{
+  unsigned int i;
+
+  for (i = 0; i < icf->count; i++)
+    {
+      free (icf->cands[i].contents);
+      free (icf->cands[i].relocs);
+    }
+  free (icf->cands);
+  free (icf->index);
+}
+
+/* Fold identical code sections, as asked by --icf.  This is done once
+   the input sections have been placed in output sections, and before
+   dynamic sections are sized.  */
+
+bfd_boolean
+bfd_elf_icf_sections (bfd *abfd, struct bfd_link_info *info)
+{
+  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+  struct elf_icf_info icf;
+  struct elf_icf_key *keys = NULL;
+  unsigned int *cls = NULL;
+  unsigned int i, nclasses, prev;
+  bfd_boolean ok = FALSE;
+  bfd *sub;
+
+  if (info->icf == icf_none || bfd_link_relocatable (info))
+    return TRUE;
+
+  if (bed->icf_address_reloc_p == NULL
+      || !is_elf_hash_table (info->hash))
+    {
+      _bfd_error_handler (_("Warning: --icf option ignored"));
+      return TRUE;
+    }
+
+  memset (&icf, 0, sizeof (icf));
+  icf.info = info;
+
+  /* Pick the candidates, and number them in link order.  */
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    {
+      asection *o;
+
+      if (bfd_get_flavour (sub) != bfd_target_elf_flavour
+	  || !(*bed->relocs_compatible) (sub->xvec, abfd->xvec))
+	continue;
+
+      for (o = sub->sections; o != NULL; o = o->next)
+	{
+	  if (o->id >= icf.index_size)
+	    icf.index_size = o->id + 1;
+	  if ((sub->flags & DYNAMIC) == 0 && elf_icf_candidate_p (o))
+	    icf.count++;
+	}
+    }
+
+  if (icf.count < 2)
+    return TRUE;
+
+  icf.cands = (struct elf_icf_section *)
+    bfd_zmalloc (icf.count * sizeof (*icf.cands));
+  icf.index = (unsigned int *)
+    bfd_zmalloc (icf.index_size * sizeof (*icf.index));
+  keys = (struct elf_icf_key *) bfd_malloc (icf.count * sizeof (*keys));
+  cls = (unsigned int *) bfd_malloc (icf.count * sizeof (*cls));
+  if (icf.cands == NULL || icf.index == NULL || keys == NULL || cls == NULL)
+    goto out;
+
+  i = 0;
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    {
+      asection *o;
+
+      if (bfd_get_flavour (sub) != bfd_target_elf_flavour
+	  || !(*bed->relocs_compatible) (sub->xvec, abfd->xvec)
+	  || (sub->flags & DYNAMIC) != 0)
+	continue;
+
+      for (o = sub->sections; o != NULL; o = o->next)
+	if (elf_icf_candidate_p (o))
+	  {
+	    icf.cands[i].sec = o;
+	    icf.index[o->id] = ++i;
+	  }
+    }
+
+  /* Read the candidates, and for --icf=safe find those whose address is
+     taken.  */
+  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+    {
+      struct elf_reloc_cookie cookie;
+      asection *o;
+
+      if (bfd_get_flavour (sub) != bfd_target_elf_flavour
+	  || !(*bed->relocs_compatible) (sub->xvec, abfd->xvec)
+	  || (sub->flags & DYNAMIC) != 0
+	  || (sub->sections != NULL
+	      && sub->sections->sec_info_type == SEC_INFO_TYPE_JUST_SYMS))
+	continue;
+
+      if (!init_reloc_cookie (&cookie, info, sub))
+	goto out;
+
+      for (o = sub->sections; o != NULL; o = o->next)
+	{
+	  int cand = elf_icf_index (&icf, o);
+
+	  if (cand >= 0
+	      && !elf_icf_read_section (&icf, &icf.cands[cand], &cookie))
+	    break;
+
+	  if (info->icf == icf_safe
+	      && (o->flags & (SEC_ALLOC | SEC_RELOC | SEC_EXCLUDE))
+		  == (SEC_ALLOC | SEC_RELOC)
+	      && o->reloc_count != 0
+	      && o->output_section != NULL
+	      && !discarded_section (o)
+	      && o->sec_info_type != SEC_INFO_TYPE_EH_FRAME
+	      && strcmp (o->name, ".eh_frame") != 0
+	      && !elf_icf_mark_address_taken (&icf, o, &cookie))
+	    break;
+	}
+
+      fini_reloc_cookie (&cookie, sub);
+      if (o != NULL)
+	goto out;
+    }
+
+  if (info->icf == icf_safe)
+    elf_link_hash_traverse (elf_hash_table (info), elf_icf_mark_exported,
+			    &icf);
+
+  /* Split the candidates by contents and relocs, and then by what their
+     relocs refer to until no class splits any more.  */
+  nclasses = elf_icf_split_classes (&icf, keys, cls, TRUE);
+  do
+    {
+      prev = nclasses;
+      nclasses = elf_icf_split_classes (&icf, keys, cls, FALSE);
+    }
+  while (nclasses != prev);
+
+  /* Pick the section of each class that is kept, indexed by the first
+     of the class: the first of the class, except that for --icf=safe it
+     is the first whose address is taken, if any is.  That section must
+     be kept anyway, so the others can still be folded into it.  */
+  for (i = 0; i < icf.count; i++)
+    cls[i] = i;
+  if (info->icf == icf_safe)
+    for (i = 0; i < icf.count; i++)
+      {
+	struct elf_icf_section *c = &icf.cands[i];
+
+	if (c->address_taken && !icf.cands[cls[c->cls]].address_taken)
+	  cls[c->cls] = i;
+      }
+
+  /* Fold each other candidate into the one kept of its class.  */
+  for (i = 0; i < icf.count; i++)
+    {
+      struct elf_icf_section *c = &icf.cands[i];
+      asection *kept;
+
+      if (cls[c->cls] == i
+	  || (info->icf == icf_safe && c->address_taken))
+	continue;
+
+      kept = icf.cands[cls[c->cls]].sec;
+      c->sec->kept_section = kept;
+      c->sec->output_offset = kept->output_offset;
+      elf_section_data (c->sec)->icf_folded
+	= elf_section_data (kept)->icf_folded;
+      elf_section_data (kept)->icf_folded = c->sec;
+
+      if (info->print_icf_sections)
+	/* xgettext:c-format */
+	_bfd_error_handler (_("Folding section '%A' in file '%B' into"
+			      " '%A' in file '%B'"),
+			    c->sec, c->sec->owner, kept, kept->owner);
+    }
+  ok = TRUE;
+
+ out:
+  free (keys);
+  free (cls);
+  elf_icf_free (&icf);
+  return ok;
+}
+
 /* Called from check_relocs to record the existence of a VTINHERIT reloc.  */
 
 bfd_boolean
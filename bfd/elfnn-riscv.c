@@ -90,6 +90,18 @@ struct riscv_elf_link_hash_entry
 #define GOT_TLS_IE      4
 #define GOT_TLS_LE      8
   char tls_type;
+
+  /* The number of R_RISCV_TLS_GD_HI20 relocs against this symbol, so that
+     its GD GOT slots can be dropped once they have all been relaxed.  */
+  bfd_signed_vma tls_gd_refcount;
+
+  /* TRUE if the PLT entry of this symbol loads its address from the
+     symbol's GOT entry, rather than from a .got.plt entry.  */
+  bfd_boolean plt_got;
+
+  /* Set by riscv_elf_shrink_got if some reloc still loads the address
+     of this symbol from its GOT entry.  */
+  bfd_boolean got_used;
 };
 
 #define riscv_elf_hash_entry(ent) \
@@ -118,6 +130,58 @@ struct _bfd_riscv_elf_obj_tdata
    && elf_tdata (bfd) != NULL				\
    && elf_object_id (bfd) == RISCV_ELF_DATA)
 
+static bfd_boolean
+elfNN_riscv_mkobject (bfd *abfd)
+{
+  return bfd_elf_allocate_object (abfd,
+				  sizeof (struct _bfd_riscv_elf_obj_tdata),
+				  RISCV_ELF_DATA);
+}
+
+/* RISC-V ELF section data.  */
+
+struct _bfd_riscv_elf_section_data
+{
+  struct bfd_elf_section_data elf;
+
+  /* For each reloc of the section, the alignment requested by an
+     R_RISCV_ALIGN reloc that relaxation has handled, or zero.  Once an
+     R_RISCV_ALIGN reloc has been handled its addend is the padding that
+     is left, so that later deletions can be checked against it.  NULL
+     until the first one is handled.  */
+  bfd_vma *relax_alignments;
+
+  /* The indices of the R_RISCV_ALIGN relocs whose padding deleting bytes
+     before them might make too small, in order of offset: those that have
+     been handled, and those that reserve less than the alignment less two
+     bytes.  There is room for all of the section's R_RISCV_ALIGN relocs.
+     Only valid if RELAX_ALIGNS_COUNTED.  */
+  unsigned int *relax_align_checks;
+  unsigned int relax_align_check_count;
+  bfd_boolean relax_aligns_counted;
+};
+
+#define riscv_elf_section_data(sec) \
+  ((struct _bfd_riscv_elf_section_data *) elf_section_data (sec))
+
+/* Allocate target specific section data.  */
+
+static bfd_boolean
+riscv_elf_new_section_hook (bfd *abfd, asection *sec)
+{
+  if (!sec->used_by_bfd)
+    {
+      struct _bfd_riscv_elf_section_data *sdata;
+
+      sdata = bfd_zalloc (abfd, sizeof (*sdata));
+      if (sdata == NULL)
+	return FALSE;
+      sec->used_by_bfd = sdata;
+    }
+
+  return _bfd_elf_new_section_hook (abfd, sec);
+}
+
 #include "elf/common.h"
 #include "elf/internal.h"
 
@@ -133,6 +197,61 @@ struct riscv_elf_link_hash_table
 
   /* The max alignment of output sections.  */
   bfd_vma max_alignment;
+
+  /* The allocated output sections, recorded once when relaxation starts and
+     kept sorted by address, so that per-reloc alignment bounds need only
+     look at the sections in range.  RELAX_OSEC_PASS and RELAX_OSEC_TRIP
+     say for which relaxation trip they were last sorted.  */
+  asection **relax_osecs;
+  unsigned int relax_osec_count;
+  int relax_osec_pass;
+  int relax_osec_trip;
+
+  /* TRUE once riscv_relax_arena_init has read in what relaxation needs.
+     The pcgp records of each section are taken from PCGP_HI_POOL and
+     PCGP_LO_POOL, which have room for PCGP_POOL_SIZE records each.  */
+  bfd_boolean relax_arena_ready;
+  struct riscv_pcgp_hi_reloc *pcgp_hi_pool;
+  struct riscv_pcgp_lo_reloc *pcgp_lo_pool;
+  bfd_size_type pcgp_pool_size;
+
+  /* The PC-relative relocs of the section being relocated, kept from one
+     section to the next so that their storage is reused.  */
+  struct riscv_pcrel_relocs *pcrel_relocs;
+
+  /* The stubs of the call islands, hashed by their target, or NULL if
+     bfd_elfNN_riscv_size_call_islands has not made any.  */
+  htab_t call_island_targets;
+
+  /* The size of the PLT entries that load from the GOT, which -z now
+     links place after the others.  */
+  bfd_vma plt_got_size;
+
+  /* The section of packed relative relocs, if -z pack-relative-relocs
+     asked for one.  RELR_COUNT is the number of R_RISCV_RELATIVE relocs
+     it replaces, RELR_EMITTED the number riscv_elf_relocate_section has
+     left out of .rela.dyn so far, RELR_ADDRS the addresses they apply
+     to in ascending order, and RELR_SIZE the size of their encoding.  */
+  asection *srelr;
+  bfd_size_type relr_count;
+  bfd_size_type relr_emitted;
+  bfd_vma *relr_addrs;
+  bfd_size_type relr_size;
+
+  /* Relaxation statistics, one entry per trip of each pass, if they are
+     being collected.  RELAX_STATS_CUR is the entry for the section being
+     relaxed, or NULL.  */
+  bfd_boolean relax_stats_enabled;
+  struct riscv_relax_stats *relax_stats;
+  unsigned int relax_stats_count;
+  unsigned int relax_stats_size;
+  struct riscv_relax_stats *relax_stats_cur;
+
+  /* TRUE once pass 0 of relaxation has converted the GOT loads of the
+     whole link.  GOT_LOADS_CONVERTED counts the loads it turned into
+     address computations.  */
+  bfd_boolean got_loads_done;
+  bfd_size_type got_loads_converted;
 };
 
 
@@ -255,11 +374,27 @@ link_hash_newfunc (struct bfd_hash_entry *entry,
       eh = (struct riscv_elf_link_hash_entry *) entry;
       eh->dyn_relocs = NULL;
       eh->tls_type = GOT_UNKNOWN;
+      eh->tls_gd_refcount = 0;
+      eh->plt_got = FALSE;
+      eh->got_used = FALSE;
     }
 
   return entry;
 }
 
+/* Destroy a RISC-V ELF linker hash table.  */
+
+static void
+riscv_elf_link_hash_table_free (bfd *obfd)
+{
+  struct riscv_elf_link_hash_table *htab
+    = (struct riscv_elf_link_hash_table *) obfd->link.hash;
+
+  if (htab->call_island_targets != NULL)
+    htab_delete (htab->call_island_targets);
+  _bfd_elf_link_hash_table_free (obfd);
+}
+
 /* Create a RISC-V ELF linker hash table.  */
 
 static struct bfd_link_hash_table *
@@ -281,6 +416,7 @@ riscv_elf_link_hash_table_create (bfd *abfd)
     }
 
   ret->max_alignment = (bfd_vma) -1;
+  ret->elf.root.hash_table_free = riscv_elf_link_hash_table_free;
   return &ret->elf.root;
 }
 
@@ -431,6 +567,12 @@ riscv_elf_copy_indirect_symbol (struct bfd_link_info *info,
       edir->tls_type = eind->tls_type;
       eind->tls_type = GOT_UNKNOWN;
     }
+
+  if (ind->root.type == bfd_link_hash_indirect)
+    {
+      edir->tls_gd_refcount += eind->tls_gd_refcount;
+      eind->tls_gd_refcount = 0;
+    }
   _bfd_elf_link_hash_copy_indirect (info, dir, ind);
 }
 
@@ -555,6 +697,8 @@ riscv_elf_check_relocs (bfd *abfd, struct bfd_link_info *info,
 	  if (!riscv_elf_record_got_reference (abfd, info, h, r_symndx)
 	      || !riscv_elf_record_tls_type (abfd, h, r_symndx, GOT_TLS_GD))
 	    return FALSE;
+	  if (h != NULL)
+	    riscv_elf_hash_entry (h)->tls_gd_refcount += 1;
 	  break;
 
 	case R_RISCV_TLS_GOT_HI20:
@@ -761,6 +905,33 @@ riscv_elf_gc_mark_hook (asection *sec,
   return _bfd_elf_gc_mark_hook (sec, info, rel, h, sym);
 }
 
+/* Return TRUE if a reloc of type R_TYPE may take the address of its
+   target, so that --icf=safe must not fold it.  Calls and branches
+   only transfer control, and %pcrel_lo refers back to its %pcrel_hi.  */
+
+static bfd_boolean
+riscv_elf_icf_address_reloc_p (unsigned int r_type)
+{
+  switch (r_type)
+    {
+    case R_RISCV_NONE:
+    case R_RISCV_BRANCH:
+    case R_RISCV_JAL:
+    case R_RISCV_CALL:
+    case R_RISCV_CALL_PLT:
+    case R_RISCV_RVC_BRANCH:
+    case R_RISCV_RVC_JUMP:
+    case R_RISCV_PCREL_LO12_I:
+    case R_RISCV_PCREL_LO12_S:
+    case R_RISCV_RELAX:
+    case R_RISCV_ALIGN:
+      return FALSE;
+
+    default:
+      return TRUE;
+    }
+}
+
 /* Update the got entry reference counts for the section being removed.  */
 
 static bfd_boolean
@@ -814,6 +985,9 @@ riscv_elf_gc_sweep_hook (bfd *abfd,
 	    {
 	      if (h->got.refcount > 0)
 		h->got.refcount--;
+	      if (ELFNN_R_TYPE (rel->r_info) == R_RISCV_TLS_GD_HI20
+		  && riscv_elf_hash_entry (h)->tls_gd_refcount > 0)
+		riscv_elf_hash_entry (h)->tls_gd_refcount--;
 	    }
 	  else
 	    {
@@ -996,6 +1170,25 @@ riscv_elf_adjust_dynamic_symbol (struct bfd_link_info *info,
   return _bfd_elf_adjust_dynamic_copy (info, h, s);
 }
 
+/* Return TRUE if the PLT entry of H should load the address of H from
+   H's GOT entry, so that it needs neither a .got.plt entry nor an
+   R_RISCV_JUMP_SLOT reloc.  That is only done in -z now links, which ask
+   for every symbol to be bound at startup, as the GOT entry always is,
+   and only when the GOT entry holds the address of H itself, which it
+   does not for the canonical PLT entries of position-dependent
+   executables.  Such entries do not use the PLT header.  */
+
+static bfd_boolean
+riscv_elf_use_plt_got (struct bfd_link_info *info,
+		       struct elf_link_hash_entry *h)
+{
+  return ((info->flags & DF_BIND_NOW) != 0
+	  && bfd_link_pic (info)
+	  && h->got.refcount > 0
+	  && riscv_elf_hash_entry (h)->tls_type == GOT_NORMAL
+	  && h->type != STT_GNU_IFUNC);
+}
+
 /* Allocate space in .plt, .got and associated reloc sections for
    dynamic relocs.  */
 
@@ -1026,7 +1219,15 @@ allocate_dynrelocs (struct elf_link_hash_entry *h, void *inf)
 	    return FALSE;
 	}
 
-      if (WILL_CALL_FINISH_DYNAMIC_SYMBOL (1, bfd_link_pic (info), h))
+      if (WILL_CALL_FINISH_DYNAMIC_SYMBOL (1, bfd_link_pic (info), h)
+	  && riscv_elf_use_plt_got (info, h))
+	{
+	  /* The entry is placed by riscv_elf_place_plt_got.  */
+	  riscv_elf_hash_entry (h)->plt_got = TRUE;
+	  h->plt.offset = htab->plt_got_size;
+	  htab->plt_got_size += PLT_ENTRY_SIZE;
+	}
+      else if (WILL_CALL_FINISH_DYNAMIC_SYMBOL (1, bfd_link_pic (info), h))
 	{
 	  asection *s = htab->elf.splt;
 
@@ -1222,1792 +1423,4316 @@ readonly_dynrelocs (struct elf_link_hash_entry *h, void *inf)
   return TRUE;
 }
 
+/* The ways in which a GOT access may be converted when linking an
+   executable.  */
+
+enum riscv_got_conversion
+{
+  /* AUIPC+LW/LD of a symbol's address to AUIPC+ADDI.  */
+  riscv_got_to_pcrel,
+  /* TLS initial exec to local exec.  */
+  riscv_tls_ie_to_le,
+  /* TLS general dynamic to local exec.  */
+  riscv_tls_gd_to_le,
+  /* TLS general dynamic to initial exec.  */
+  riscv_tls_gd_to_ie
+};
+
+/* A relaxable R_RISCV_GOT_HI20, R_RISCV_TLS_GOT_HI20 or
+   R_RISCV_TLS_GD_HI20 reloc that may be converted, and what uses it.  */
+
+struct riscv_got_load
+{
+  Elf_Internal_Rela *hi;
+  enum riscv_got_conversion conversion;
+  unsigned int uses;
+  bfd_boolean convert;
+
+  /* For general dynamic TLS, the only use of HI, the call to
+     __tls_get_addr that follows it, and __tls_get_addr if the call was
+     counted as a PLT reference to it.  */
+  Elf_Internal_Rela *lo;
+  Elf_Internal_Rela *call;
+  struct elf_link_hash_entry *plt_h;
+};
+
+static int
+riscv_got_load_compare (const void *a, const void *b)
+{
+  const struct riscv_got_load *x = (const struct riscv_got_load *) a;
+  const struct riscv_got_load *y = (const struct riscv_got_load *) b;
+
+  if (x->hi->r_offset != y->hi->r_offset)
+    return x->hi->r_offset < y->hi->r_offset ? -1 : 1;
+  return 0;
+}
+
+/* Return the section of local symbol SYM of ABFD, or of H if it is not
+   NULL and is defined, or NULL.  */
+
+static asection *
+riscv_got_symbol_section (bfd *abfd, struct elf_link_hash_entry *h,
+			  Elf_Internal_Sym *sym)
+{
+  if (h == NULL)
+    return bfd_section_from_elf_index (abfd, sym->st_shndx);
+  if (h->root.type == bfd_link_hash_defined
+      || h->root.type == bfd_link_hash_defweak)
+    return h->root.u.def.section;
+  return NULL;
+}
+
+/* Return TRUE if the address of H, or of local symbol SYM of ABFD if H is
+   NULL, can be computed pc-relatively in the executable being linked
+   instead of being loaded from the GOT.  */
+
 static bfd_boolean
-riscv_elf_size_dynamic_sections (bfd *output_bfd, struct bfd_link_info *info)
+riscv_got_ref_local_p (bfd *abfd, struct bfd_link_info *info,
+		       struct elf_link_hash_entry *h, Elf_Internal_Sym *sym)
 {
-  struct riscv_elf_link_hash_table *htab;
-  bfd *dynobj;
-  asection *s;
-  bfd *ibfd;
+  asection *sec = riscv_got_symbol_section (abfd, h, sym);
 
-  htab = riscv_elf_hash_table (info);
-  BFD_ASSERT (htab != NULL);
-  dynobj = htab->elf.dynobj;
-  BFD_ASSERT (dynobj != NULL);
+  if (sec == NULL
+      || bfd_is_und_section (sec)
+      || bfd_is_com_section (sec))
+    return FALSE;
 
-  if (elf_hash_table (info)->dynamic_sections_created)
+  if (h != NULL
+      ? h->type == STT_GNU_IFUNC || !SYMBOL_REFERENCES_LOCAL (info, h)
+      : ELF_ST_TYPE (sym->st_info) == STT_GNU_IFUNC)
+    return FALSE;
+
+  /* An absolute address does not move with a PIE.  */
+  if (bfd_is_abs_section (sec))
+    return !bfd_link_pic (info);
+
+  return sec->output_section != NULL && !discarded_section (sec);
+}
+
+static bfd_vma riscv_relax_span_alignment
+  (struct bfd_link_info *, bfd_vma, bfd_vma, bfd_vma);
+
+/* Return TRUE if an AUIPC at address PC can reach SYMVAL in SYM_SEC, and
+   will still reach it however relaxation moves the two, given that no
+   section is aligned to more than MAX_ALIGNMENT.  */
+
+static bfd_boolean
+riscv_got_pcrel_reach_p (struct bfd_link_info *info, bfd_vma pc,
+			 asection *sym_sec, bfd_vma symval,
+			 bfd_vma max_alignment)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  bfd_vma low = pc, slack;
+
+  if (ARCH_SIZE == 32)
+    return TRUE;
+
+  /* An absolute address stays put while deleting bytes moves the AUIPC
+     down, at most to the start of the image.  */
+  if (bfd_is_abs_section (sym_sec))
     {
-      /* Set the contents of the .interp section to the interpreter.  */
-      if (bfd_link_executable (info) && !info->nointerp)
-	{
-	  s = bfd_get_linker_section (dynobj, ".interp");
-	  BFD_ASSERT (s != NULL);
-	  s->size = strlen (ELFNN_DYNAMIC_INTERPRETER) + 1;
-	  s->contents = (unsigned char *) ELFNN_DYNAMIC_INTERPRETER;
-	}
+      if (htab != NULL && htab->relax_osec_count != 0)
+	low = htab->relax_osecs[0]->vma;
+      return (VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (symval - pc))
+	      && VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (symval - low)));
     }
 
-  /* Set up .got offsets for local syms, and space for local dynamic
-     relocs.  */
-  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+  /* Otherwise both move down, and only padding can push them apart.  */
+  slack = riscv_relax_span_alignment (info, pc, symval, max_alignment);
+  return (VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (symval - pc + slack))
+	  && VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (symval - pc - slack)));
+}
+
+/* Return the global symbol that reloc REL of ABFD is against, or NULL if
+   it is against a local symbol.  */
+
+static struct elf_link_hash_entry *
+riscv_got_reloc_hash (bfd *abfd, const Elf_Internal_Rela *rel)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+  struct elf_link_hash_entry *h;
+
+  if (r_symndx < symtab_hdr->sh_info)
+    return NULL;
+
+  h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+  while (h->root.type == bfd_link_hash_indirect
+	 || h->root.type == bfd_link_hash_warning)
+    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+  return h;
+}
+
+/* Return TRUE if REL, one of the NREL relocs that start at RELOCS, is
+   followed by an R_RISCV_RELAX reloc at the same offset.  */
+
+static bfd_boolean
+riscv_got_relaxable_p (const Elf_Internal_Rela *relocs, unsigned int nrel,
+		       const Elf_Internal_Rela *rel)
+{
+  return (rel + 1 < relocs + nrel
+	  && ELFNN_R_TYPE (rel[1].r_info) == R_RISCV_RELAX
+	  && rel[1].r_offset == rel->r_offset);
+}
+
+/* Return the R_RISCV_CALL or R_RISCV_CALL_PLT reloc of a call to
+   __tls_get_addr in SEC of ABFD that immediately follows the general
+   dynamic TLS access whose ADDI is relocated by LO, or NULL.  */
+
+static Elf_Internal_Rela *
+riscv_tls_get_addr_call (bfd *abfd, asection *sec, bfd_byte *contents,
+			 Elf_Internal_Rela *relocs, Elf_Internal_Rela *lo)
+{
+  Elf_Internal_Rela *relend = relocs + sec->reloc_count, *rel;
+  bfd_vma offset = lo->r_offset + 4;
+  struct elf_link_hash_entry *h;
+  bfd_vma auipc, jalr;
+
+  if (offset + 8 > sec->size)
+    return NULL;
+
+  for (rel = lo + 1; rel < relend && rel->r_offset <= offset; rel++)
+    if (rel->r_offset == offset
+	&& (ELFNN_R_TYPE (rel->r_info) == R_RISCV_CALL
+	    || ELFNN_R_TYPE (rel->r_info) == R_RISCV_CALL_PLT))
+      break;
+  if (rel == relend
+      || rel->r_offset != offset
+      || !riscv_got_relaxable_p (relocs, sec->reloc_count, rel))
+    return NULL;
+
+  h = riscv_got_reloc_hash (abfd, rel);
+  if (h == NULL || strcmp (h->root.root.string, "__tls_get_addr") != 0)
+    return NULL;
+
+  auipc = bfd_get_32 (abfd, contents + offset);
+  jalr = bfd_get_32 (abfd, contents + offset + 4);
+  if ((auipc & MASK_AUIPC) != MATCH_AUIPC
+      || ((auipc >> OP_SH_RD) & OP_MASK_RD) != X_RA
+      || (jalr & MASK_JALR) != MATCH_JALR
+      || ((jalr >> OP_SH_RD) & OP_MASK_RD) != X_RA
+      || ((jalr >> OP_SH_RS1) & OP_MASK_RS1) != X_RA)
+    return NULL;
+
+  return rel;
+}
+
+/* Rewrite the GOT accesses in SEC of ABFD that an executable does not need
+   to make.  Only relaxable accesses are converted, and only if every
+   instruction that uses the AUIPC is part of the expected sequence.
+
+   When RELAXING, which pass 0 of relaxation does once addresses are
+   known, AUIPC+LW/LD of the address of a symbol that resolves within the
+   executable becomes AUIPC+ADDI if the AUIPC can reach the symbol with
+   MAX_ALIGNMENT of slack, and the pass may then make it gp-relative.  The
+   GOT entry has already been allocated; riscv_elf_shrink_got removes it
+   afterwards if no other load uses it.
+
+   Otherwise, while the dynamic sections are sized, TLS accesses are
+   converted and dropped from the GOT reference counts so that entries
+   nothing else uses are not allocated:
+
+   - A TLS initial exec access to a symbol defined in the executable
+     becomes LUI+ADDI of its tp offset; the ADD of tp that follows is
+     left alone.
+   - A TLS general dynamic access and the call to __tls_get_addr that
+     follows it become LUI, ADD of tp, ADDI and a NOP for a symbol defined
+     in the executable, which pass 0 of relaxation may then shrink to
+     ADDI+NOP, or become an initial exec access, ADD of tp and a NOP
+     otherwise.  Shared objects keep general dynamic accesses, since
+     initial exec ones would stop them being loaded with dlopen.  */
+
+static bfd_boolean
+riscv_elf_convert_got_loads (bfd *abfd, asection *sec,
+			     struct bfd_link_info *info, bfd_boolean relaxing,
+			     bfd_vma max_alignment)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  struct bfd_elf_section_data *data = elf_section_data (sec);
+  Elf_Internal_Sym *isymbuf = (Elf_Internal_Sym *) symtab_hdr->contents;
+  Elf_Internal_Rela *relocs, *rel, *relend;
+  struct riscv_got_load *loads = NULL, key, *load;
+  unsigned int count = 0, converted = 0;
+  bfd_byte *contents = data->this_hdr.contents;
+  bfd_vma load_match = ARCH_SIZE == 64 ? MATCH_LD : MATCH_LW;
+  bfd_boolean ret = FALSE;
+
+  if ((sec->flags & (SEC_ALLOC | SEC_CODE | SEC_RELOC))
+      != (SEC_ALLOC | SEC_CODE | SEC_RELOC)
+      || sec->reloc_count == 0
+      || sec->size == 0
+      || sec->output_section == NULL
+      || discarded_section (sec))
+    return TRUE;
+
+  relocs = _bfd_elf_link_read_relocs (abfd, sec, NULL, NULL,
+				      info->keep_memory);
+  if (relocs == NULL)
+    return FALSE;
+  relend = relocs + sec->reloc_count;
+
+  for (rel = relocs; rel < relend; rel++)
     {
-      bfd_signed_vma *local_got;
-      bfd_signed_vma *end_local_got;
-      char *local_tls_type;
-      bfd_size_type locsymcount;
-      Elf_Internal_Shdr *symtab_hdr;
-      asection *srel;
+      unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+      int r_type = ELFNN_R_TYPE (rel->r_info);
+      enum riscv_got_conversion conversion;
+      struct elf_link_hash_entry *h;
+      bfd_boolean local;
 
-      if (! is_riscv_elf (ibfd))
+      if ((relaxing
+	   ? r_type != R_RISCV_GOT_HI20
+	   : (r_type != R_RISCV_TLS_GOT_HI20
+	      && r_type != R_RISCV_TLS_GD_HI20))
+	  || !riscv_got_relaxable_p (relocs, sec->reloc_count, rel))
 	continue;
 
-      for (s = ibfd->sections; s != NULL; s = s->next)
+      h = riscv_got_reloc_hash (abfd, rel);
+      if (h == NULL && isymbuf == NULL)
 	{
-	  struct riscv_elf_dyn_relocs *p;
+	  isymbuf = bfd_elf_get_elf_syms (abfd, symtab_hdr,
+					  symtab_hdr->sh_info, 0,
+					  NULL, NULL, NULL);
+	  if (isymbuf == NULL)
+	    goto fail;
+	}
 
-	  for (p = elf_section_data (s)->local_dynrel; p != NULL; p = p->next)
+      local = riscv_got_ref_local_p (abfd, info, h,
+				     h == NULL ? isymbuf + r_symndx : NULL);
+      if (r_type == R_RISCV_GOT_HI20 && local)
+	{
+	  asection *sym_sec;
+	  bfd_vma symval;
+
+	  if (h != NULL)
 	    {
-	      if (!bfd_is_abs_section (p->sec)
-		  && bfd_is_abs_section (p->sec->output_section))
-		{
-		  /* Input section has been discarded, either because
-		     it is a copy of a linkonce section or due to
-		     linker script /DISCARD/, so we'll be discarding
-		     the relocs too.  */
-		}
-	      else if (p->count != 0)
-		{
-		  srel = elf_section_data (p->sec)->sreloc;
-		  srel->size += p->count * sizeof (ElfNN_External_Rela);
-		  if ((p->sec->output_section->flags & SEC_READONLY) != 0)
-		    info->flags |= DF_TEXTREL;
-		}
+	      sym_sec = h->root.u.def.section;
+	      symval = sec_addr (sym_sec) + h->root.u.def.value;
 	    }
-	}
+	  else
+	    {
+	      Elf_Internal_Sym *isym = isymbuf + r_symndx;
 
-      local_got = elf_local_got_refcounts (ibfd);
-      if (!local_got)
+	      sym_sec = bfd_section_from_elf_index (abfd, isym->st_shndx);
+	      if (sym_sec->sec_info_type == SEC_INFO_TYPE_MERGE)
+		symval = (_bfd_elf_rel_local_sym (abfd, isym, &sym_sec,
+						  rel->r_addend)
+			  - rel->r_addend);
+	      else
+		symval = isym->st_value;
+	      symval += sec_addr (sym_sec);
+	    }
+
+	  if (!riscv_got_pcrel_reach_p (info, sec_addr (sec) + rel->r_offset,
+					sym_sec, symval + rel->r_addend,
+					max_alignment))
+	    continue;
+	  conversion = riscv_got_to_pcrel;
+	}
+      else if (r_type == R_RISCV_TLS_GOT_HI20 && local)
+	conversion = riscv_tls_ie_to_le;
+      else if (r_type == R_RISCV_TLS_GD_HI20 && local)
+	conversion = riscv_tls_gd_to_le;
+      else if (r_type == R_RISCV_TLS_GD_HI20
+	       && h != NULL
+	       && h->root.type != bfd_link_hash_undefweak)
+	conversion = riscv_tls_gd_to_ie;
+      else
 	continue;
 
-      symtab_hdr = &elf_symtab_hdr (ibfd);
-      locsymcount = symtab_hdr->sh_info;
-      end_local_got = local_got + locsymcount;
-      local_tls_type = _bfd_riscv_elf_local_got_tls_type (ibfd);
-      s = htab->elf.sgot;
-      srel = htab->elf.srelgot;
-      for (; local_got < end_local_got; ++local_got, ++local_tls_type)
+      if (loads == NULL)
 	{
-	  if (*local_got > 0)
-	    {
-	      *local_got = s->size;
-	      s->size += RISCV_ELF_WORD_BYTES;
-	      if (*local_tls_type & GOT_TLS_GD)
-		s->size += RISCV_ELF_WORD_BYTES;
-	      if (bfd_link_pic (info)
-		  || (*local_tls_type & (GOT_TLS_GD | GOT_TLS_IE)))
-		srel->size += sizeof (ElfNN_External_Rela);
-	    }
-	  else
-	    *local_got = (bfd_vma) -1;
+	  loads = bfd_malloc (sec->reloc_count * sizeof (*loads));
+	  if (loads == NULL)
+	    goto fail;
 	}
+      loads[count].hi = rel;
+      loads[count].conversion = conversion;
+      loads[count].uses = 0;
+      loads[count].convert = TRUE;
+      loads[count].lo = NULL;
+      loads[count].call = NULL;
+      loads[count].plt_h = NULL;
+      count++;
     }
 
-  /* Allocate global sym .plt and .got entries, and space for global
-     sym dynamic relocs.  */
-  elf_link_hash_traverse (&htab->elf, allocate_dynrelocs, info);
-
-  if (htab->elf.sgotplt)
+  if (count == 0)
     {
-      struct elf_link_hash_entry *got;
-      got = elf_link_hash_lookup (elf_hash_table (info),
-				  "_GLOBAL_OFFSET_TABLE_",
-				  FALSE, FALSE, FALSE);
-
-      /* Don't allocate .got.plt section if there are no GOT nor PLT
-	 entries and there is no refeence to _GLOBAL_OFFSET_TABLE_.  */
-      if ((got == NULL
-	   || !got->ref_regular_nonweak)
-	  && (htab->elf.sgotplt->size == GOTPLT_HEADER_SIZE)
-	  && (htab->elf.splt == NULL
-	      || htab->elf.splt->size == 0)
-	  && (htab->elf.sgot == NULL
-	      || (htab->elf.sgot->size
-		  == get_elf_backend_data (output_bfd)->got_header_size)))
-	htab->elf.sgotplt->size = 0;
+      ret = TRUE;
+      goto fail;
     }
 
-  /* The check_relocs and adjust_dynamic_symbol entry points have
-     determined the sizes of the various dynamic sections.  Allocate
-     memory for them.  */
-  for (s = dynobj->sections; s != NULL; s = s->next)
+  qsort (loads, count, sizeof (*loads), riscv_got_load_compare);
+
+  if (contents == NULL
+      && !bfd_malloc_and_get_section (abfd, sec, &contents))
+    goto fail;
+
+  /* Find the users of each AUIPC, and make sure they are what the
+     conversion expects.  */
+  for (rel = relocs; rel < relend; rel++)
     {
-      if ((s->flags & SEC_LINKER_CREATED) == 0)
+      int r_type = ELFNN_R_TYPE (rel->r_info);
+      unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+      struct elf_link_hash_entry *h;
+      Elf_Internal_Rela hi;
+      bfd_vma insn, auipc;
+
+      if (r_type != R_RISCV_PCREL_LO12_I && r_type != R_RISCV_PCREL_LO12_S)
 	continue;
 
-      if (s == htab->elf.splt
-	  || s == htab->elf.sgot
-	  || s == htab->elf.sgotplt
-	  || s == htab->elf.sdynbss
-	  || s == htab->elf.sdynrelro)
+      h = riscv_got_reloc_hash (abfd, rel);
+      if (h == NULL && isymbuf == NULL)
 	{
-	  /* Strip this section if we don't need it; see the
-	     comment below.  */
+	  isymbuf = bfd_elf_get_elf_syms (abfd, symtab_hdr,
+					  symtab_hdr->sh_info, 0,
+					  NULL, NULL, NULL);
+	  if (isymbuf == NULL)
+	    goto fail;
 	}
-      else if (strncmp (s->name, ".rela", 5) == 0)
+
+      if (riscv_got_symbol_section (abfd, h,
+				    h == NULL ? isymbuf + r_symndx : NULL)
+	  != sec)
+	continue;
+
+      hi.r_offset = h != NULL ? h->root.u.def.value
+			      : isymbuf[r_symndx].st_value;
+      key.hi = &hi;
+      load = bsearch (&key, loads, count, sizeof (*loads),
+		      riscv_got_load_compare);
+      if (load == NULL)
+	continue;
+
+      load->uses++;
+      load->lo = rel;
+      if (r_type != R_RISCV_PCREL_LO12_I || rel->r_offset + 4 > sec->size)
 	{
-	  if (s->size != 0)
-	    {
-	      /* We use the reloc_count field as a counter if we need
-		 to copy relocs into the output file.  */
-	      s->reloc_count = 0;
-	    }
+	  load->convert = FALSE;
+	  continue;
 	}
-      else
+
+      insn = bfd_get_32 (abfd, contents + rel->r_offset);
+      auipc = bfd_get_32 (abfd, contents + load->hi->r_offset);
+      switch (load->conversion)
 	{
-	  /* It's not one of our sections.  */
-	  continue;
+	case riscv_got_to_pcrel:
+	case riscv_tls_ie_to_le:
+	  if ((insn & MASK_LD) != load_match)
+	    load->convert = FALSE;
+	  break;
+
+	case riscv_tls_gd_to_le:
+	case riscv_tls_gd_to_ie:
+	  if ((insn & MASK_ADDI) != MATCH_ADDI
+	      || ((insn >> OP_SH_RD) & OP_MASK_RD) != X_A0
+	      || (((insn >> OP_SH_RS1) & OP_MASK_RS1)
+		  != ((auipc >> OP_SH_RD) & OP_MASK_RD))
+	      || !riscv_got_relaxable_p (relocs, sec->reloc_count, rel))
+	    load->convert = FALSE;
+	  break;
 	}
+    }
 
-      if (s->size == 0)
+  for (load = loads; load < loads + count; load++)
+    {
+      if (!load->convert || load->uses == 0)
+	load->convert = FALSE;
+      else if (load->conversion == riscv_tls_gd_to_le
+	       || load->conversion == riscv_tls_gd_to_ie)
 	{
-	  /* If we don't need this section, strip it from the
-	     output file.  This is mostly to handle .rela.bss and
-	     .rela.plt.  We must create both sections in
-	     create_dynamic_sections, because they must be created
-	     before the linker maps input sections to output
-	     sections.  The linker does that before
-	     adjust_dynamic_symbol is called, and it is that
-	     function which decides whether anything needs to go
-	     into these sections.  */
-	  s->flags |= SEC_EXCLUDE;
-	  continue;
+	  if (load->uses == 1)
+	    load->call = riscv_tls_get_addr_call (abfd, sec, contents,
+						  relocs, load->lo);
+	  load->convert = load->call != NULL;
+	  if (load->call != NULL
+	      && (ELFNN_R_TYPE (load->call->r_info) == R_RISCV_CALL_PLT
+		  || !bfd_link_pic (info)))
+	    load->plt_h = riscv_got_reloc_hash (abfd, load->call);
 	}
+    }
 
-      if ((s->flags & SEC_HAS_CONTENTS) == 0)
+  /* Rewrite the users.  */
+  for (rel = relocs; rel < relend; rel++)
+    {
+      int r_type = ELFNN_R_TYPE (rel->r_info);
+      unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+      struct elf_link_hash_entry *h;
+      Elf_Internal_Rela hi;
+      bfd_vma insn;
+
+      if (r_type != R_RISCV_PCREL_LO12_I)
 	continue;
 
-      /* Allocate memory for the section contents.  Zero the memory
-	 for the benefit of .rela.plt, which has 4 unused entries
-	 at the beginning, and we don't want garbage.  */
-      s->contents = (bfd_byte *) bfd_zalloc (dynobj, s->size);
-      if (s->contents == NULL)
-	return FALSE;
-    }
+      h = riscv_got_reloc_hash (abfd, rel);
+      if (riscv_got_symbol_section (abfd, h,
+				    h == NULL ? isymbuf + r_symndx : NULL)
+	  != sec)
+	continue;
 
-  if (elf_hash_table (info)->dynamic_sections_created)
-    {
-      /* Add some entries to the .dynamic section.  We fill in the
-	 values later, in riscv_elf_finish_dynamic_sections, but we
-	 must add the entries now so that we get the correct size for
-	 the .dynamic section.  The DT_DEBUG entry is filled in by the
-	 dynamic linker and used by the debugger.  */
-#define add_dynamic_entry(TAG, VAL) \
-  _bfd_elf_add_dynamic_entry (info, TAG, VAL)
+      hi.r_offset = h != NULL ? h->root.u.def.value
+			      : isymbuf[r_symndx].st_value;
+      key.hi = &hi;
+      load = bsearch (&key, loads, count, sizeof (*loads),
+		      riscv_got_load_compare);
+      if (load == NULL || !load->convert)
+	continue;
 
-      if (bfd_link_executable (info))
+      insn = bfd_get_32 (abfd, contents + rel->r_offset);
+      switch (load->conversion)
 	{
-	  if (!add_dynamic_entry (DT_DEBUG, 0))
-	    return FALSE;
+	case riscv_got_to_pcrel:
+	  insn = (insn & ~(bfd_vma) MASK_LD) | MATCH_ADDI;
+	  break;
+
+	case riscv_tls_ie_to_le:
+	  /* The ADD of tp is elsewhere, so the LUI must stay even if the
+	     tp offset is small: don't relax the pair.  */
+	  insn = (insn & ~(bfd_vma) MASK_LD) | MATCH_ADDI;
+	  rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (load->hi->r_info),
+				      R_RISCV_TPREL_LO12_I);
+	  rel->r_addend = load->hi->r_addend;
+	  if (riscv_got_relaxable_p (relocs, sec->reloc_count, rel))
+	    rel[1].r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+	  break;
+
+	case riscv_tls_gd_to_le:
+	  /* ADD a0, rX, tp; ADDI a0, a0, %tprel_lo; NOP.  */
+	  insn = (MATCH_ADD
+		  | (X_A0 << OP_SH_RD)
+		  | (insn & (OP_MASK_RS1 << OP_SH_RS1))
+		  | (X_TP << OP_SH_RS2));
+	  rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (load->hi->r_info),
+				      R_RISCV_TPREL_ADD);
+	  rel->r_addend = load->hi->r_addend;
+	  bfd_put_32 (abfd, MATCH_ADDI | (X_A0 << OP_SH_RD)
+			    | (X_A0 << OP_SH_RS1),
+		      contents + load->call->r_offset);
+	  load->call->r_info = ELFNN_R_INFO (ELFNN_R_SYM (load->hi->r_info),
+					     R_RISCV_TPREL_LO12_I);
+	  load->call->r_addend = load->hi->r_addend;
+	  bfd_put_32 (abfd, MATCH_ADDI, contents + load->call->r_offset + 4);
+	  break;
+
+	case riscv_tls_gd_to_ie:
+	  /* LD a0, %pcrel_lo(rX); ADD a0, a0, tp; NOP.  */
+	  insn = (insn & ~(bfd_vma) MASK_LD) | load_match;
+	  bfd_put_32 (abfd, MATCH_ADD | (X_A0 << OP_SH_RD)
+			    | (X_A0 << OP_SH_RS1) | (X_TP << OP_SH_RS2),
+		      contents + load->call->r_offset);
+	  bfd_put_32 (abfd, MATCH_ADDI, contents + load->call->r_offset + 4);
+	  load->call->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+	  load->call[1].r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+	  break;
 	}
+      bfd_put_32 (abfd, insn, contents + rel->r_offset);
+    }
 
-      if (htab->elf.srelplt->size != 0)
+  /* Rewrite the AUIPCs, and drop the references they made.  */
+  for (load = loads; load < loads + count; load++)
+    {
+      unsigned long r_symndx = ELFNN_R_SYM (load->hi->r_info);
+      struct elf_link_hash_entry *h = riscv_got_reloc_hash (abfd, load->hi);
+      bfd_byte *loc = contents + load->hi->r_offset;
+      int r_type = R_RISCV_PCREL_HI20;
+
+      if (!load->convert)
+	continue;
+
+      switch (load->conversion)
 	{
-	  if (!add_dynamic_entry (DT_PLTGOT, 0)
-	      || !add_dynamic_entry (DT_PLTRELSZ, 0)
-	      || !add_dynamic_entry (DT_PLTREL, DT_RELA)
-	      || !add_dynamic_entry (DT_JMPREL, 0))
-	    return FALSE;
+	case riscv_got_to_pcrel:
+	  riscv_elf_hash_table (info)->got_loads_converted++;
+	  break;
+
+	case riscv_tls_ie_to_le:
+	  load->hi[1].r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+	  /* Fall through.  */
+
+	case riscv_tls_gd_to_le:
+	  bfd_put_32 (abfd, MATCH_LUI | (bfd_get_32 (abfd, loc)
+					 & (OP_MASK_RD << OP_SH_RD)), loc);
+	  r_type = R_RISCV_TPREL_HI20;
+	  break;
+
+	case riscv_tls_gd_to_ie:
+	  r_type = R_RISCV_TLS_GOT_HI20;
+	  riscv_elf_hash_entry (h)->tls_type |= GOT_TLS_IE;
+	  break;
 	}
+      load->hi->r_info = ELFNN_R_INFO (r_symndx, r_type);
 
-      if (!add_dynamic_entry (DT_RELA, 0)
-	  || !add_dynamic_entry (DT_RELASZ, 0)
-	  || !add_dynamic_entry (DT_RELAENT, sizeof (ElfNN_External_Rela)))
-	return FALSE;
+      if (load->conversion == riscv_tls_gd_to_le
+	  || load->conversion == riscv_tls_gd_to_ie)
+	{
+	  if (load->plt_h != NULL && load->plt_h->plt.refcount > 0)
+	    load->plt_h->plt.refcount--;
 
-      /* If any dynamic relocs apply to a read-only section,
-	 then we need a DT_TEXTREL entry.  */
-      if ((info->flags & DF_TEXTREL) == 0)
-	elf_link_hash_traverse (&htab->elf, readonly_dynrelocs, info);
+	  if (h != NULL
+	      && riscv_elf_hash_entry (h)->tls_gd_refcount > 0
+	      && --riscv_elf_hash_entry (h)->tls_gd_refcount == 0)
+	    riscv_elf_hash_entry (h)->tls_type &= ~GOT_TLS_GD;
+	}
 
-      if (info->flags & DF_TEXTREL)
+      if (load->conversion != riscv_tls_gd_to_ie
+	  && load->conversion != riscv_got_to_pcrel)
 	{
-	  if (!add_dynamic_entry (DT_TEXTREL, 0))
-	    return FALSE;
+	  if (h != NULL)
+	    {
+	      if (h->got.refcount > 0)
+		h->got.refcount--;
+	    }
+	  else if (elf_local_got_refcounts (abfd) != NULL
+		   && elf_local_got_refcounts (abfd)[r_symndx] > 0)
+	    elf_local_got_refcounts (abfd)[r_symndx]--;
 	}
+
+      converted++;
     }
-#undef add_dynamic_entry
 
-  return TRUE;
-}
+  ret = TRUE;
 
-#define TP_OFFSET 0
-#define DTP_OFFSET 0x800
+fail:
+  if (converted != 0)
+    {
+      data->relocs = relocs;
+      data->this_hdr.contents = contents;
+    }
+  else
+    {
+      if (data->relocs != relocs)
+	free (relocs);
+      if (data->this_hdr.contents != contents)
+	free (contents);
+    }
 
-/* Return the relocation value for a TLS dtp-relative reloc.  */
+  if (isymbuf != NULL && symtab_hdr->contents != (unsigned char *) isymbuf)
+    {
+      if (info->keep_memory)
+	symtab_hdr->contents = (unsigned char *) isymbuf;
+      else
+	free (isymbuf);
+    }
 
-static bfd_vma
-dtpoff (struct bfd_link_info *info, bfd_vma address)
-{
-  /* If tls_sec is NULL, we should have signalled an error already.  */
-  if (elf_hash_table (info)->tls_sec == NULL)
-    return 0;
-  return address - elf_hash_table (info)->tls_sec->vma - DTP_OFFSET;
+  free (loads);
+  return ret;
 }
 
-/* Return the relocation value for a static TLS tp-relative relocation.  */
+/* A GOT entry that riscv_elf_shrink_got may move or remove.  */
 
-static bfd_vma
-tpoff (struct bfd_link_info *info, bfd_vma address)
+struct riscv_got_entry
 {
-  /* If tls_sec is NULL, we should have signalled an error already.  */
-  if (elf_hash_table (info)->tls_sec == NULL)
-    return 0;
-  return address - elf_hash_table (info)->tls_sec->vma - TP_OFFSET;
-}
+  /* Where the offset of the entry is kept.  */
+  bfd_vma *offsetp;
+  bfd_vma size;
+  /* TRUE if no reloc loads from the entry any more.  */
+  bfd_boolean unused;
+};
 
-/* Return the global pointer's value, or 0 if it is not in use.  */
+/* The GOT entries of the link, as riscv_elf_shrink_got collects them.
+   RELOCS is the number of dynamic relocs that the unused entries would
+   have needed.  */
 
-static bfd_vma
-riscv_global_pointer_value (struct bfd_link_info *info)
+struct riscv_got_entries
 {
-  struct bfd_link_hash_entry *h;
+  struct bfd_link_info *info;
+  struct riscv_got_entry *entries;
+  size_t count;
+  size_t size;
+  bfd_size_type relocs;
+  bfd_boolean failed;
+};
 
-  h = bfd_link_hash_lookup (info->hash, RISCV_GP_SYMBOL, FALSE, FALSE, TRUE);
-  if (h == NULL || h->type != bfd_link_hash_defined)
-    return 0;
+/* Add the GOT entry whose offset is at OFFSETP to E.  */
 
-  return h->u.def.value + sec_addr (h->u.def.section);
+static bfd_boolean
+riscv_got_entries_add (struct riscv_got_entries *e, bfd_vma *offsetp,
+		       bfd_vma size, bfd_boolean unused, bfd_boolean reloc)
+{
+  if (e->count == e->size)
+    {
+      size_t amt = e->size == 0 ? 64 : e->size * 2;
+      struct riscv_got_entry *entries;
+
+      entries = bfd_realloc (e->entries, amt * sizeof (*entries));
+      if (entries == NULL)
+	{
+	  e->failed = TRUE;
+	  return FALSE;
+	}
+      e->entries = entries;
+      e->size = amt;
+    }
+
+  e->entries[e->count].offsetp = offsetp;
+  e->entries[e->count].size = size;
+  e->entries[e->count].unused = unused;
+  e->count++;
+  if (unused && reloc)
+    e->relocs++;
+  return TRUE;
 }
 
-/* Emplace a static relocation.  */
+/* Add the GOT entry of global symbol H, if it has one, to the
+   riscv_got_entries INF.  Entries used by TLS accesses or by a PLT
+   entry are never unused.  */
 
-static bfd_reloc_status_type
-perform_relocation (const reloc_howto_type *howto,
-		    const Elf_Internal_Rela *rel,
-		    bfd_vma value,
-		    asection *input_section,
-		    bfd *input_bfd,
-		    bfd_byte *contents)
+static bfd_boolean
+riscv_elf_add_got_entry (struct elf_link_hash_entry *h, void *inf)
 {
-  if (howto->pc_relative)
-    value -= sec_addr (input_section) + rel->r_offset;
-  value += rel->r_addend;
+  struct riscv_got_entries *e = (struct riscv_got_entries *) inf;
+  struct riscv_elf_link_hash_entry *eh = riscv_elf_hash_entry (h);
+  bfd_boolean dyn = elf_hash_table (e->info)->dynamic_sections_created;
+  bfd_vma size = 0;
 
-  switch (ELFNN_R_TYPE (rel->r_info))
+  if (h->root.type == bfd_link_hash_indirect
+      || h->got.offset == (bfd_vma) -1)
+    return TRUE;
+
+  if (eh->tls_type & (GOT_TLS_GD | GOT_TLS_IE))
     {
-    case R_RISCV_HI20:
-    case R_RISCV_TPREL_HI20:
-    case R_RISCV_PCREL_HI20:
-    case R_RISCV_GOT_HI20:
-    case R_RISCV_TLS_GOT_HI20:
-    case R_RISCV_TLS_GD_HI20:
-      if (ARCH_SIZE > 32 && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (value)))
-	return bfd_reloc_overflow;
-      value = ENCODE_UTYPE_IMM (RISCV_CONST_HIGH_PART (value));
-      break;
+      if (eh->tls_type & GOT_TLS_GD)
+	size += 2 * RISCV_ELF_WORD_BYTES;
+      if (eh->tls_type & GOT_TLS_IE)
+	size += RISCV_ELF_WORD_BYTES;
+      return riscv_got_entries_add (e, &h->got.offset, size, FALSE, FALSE);
+    }
 
-    case R_RISCV_LO12_I:
-    case R_RISCV_GPREL_I:
-    case R_RISCV_TPREL_LO12_I:
-    case R_RISCV_TPREL_I:
-    case R_RISCV_PCREL_LO12_I:
-      value = ENCODE_ITYPE_IMM (value);
-      break;
+  return riscv_got_entries_add (e, &h->got.offset, RISCV_ELF_WORD_BYTES,
+				!eh->got_used && !eh->plt_got,
+				WILL_CALL_FINISH_DYNAMIC_SYMBOL
+				  (dyn, bfd_link_pic (e->info), h));
+}
 
-    case R_RISCV_LO12_S:
-    case R_RISCV_GPREL_S:
-    case R_RISCV_TPREL_LO12_S:
-    case R_RISCV_TPREL_S:
-    case R_RISCV_PCREL_LO12_S:
-      value = ENCODE_STYPE_IMM (value);
-      break;
+static int
+riscv_got_entry_compare (const void *a, const void *b)
+{
+  const struct riscv_got_entry *x = (const struct riscv_got_entry *) a;
+  const struct riscv_got_entry *y = (const struct riscv_got_entry *) b;
 
-    case R_RISCV_CALL:
-    case R_RISCV_CALL_PLT:
-      if (ARCH_SIZE > 32 && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (value)))
-	return bfd_reloc_overflow;
-      value = ENCODE_UTYPE_IMM (RISCV_CONST_HIGH_PART (value))
-	      | (ENCODE_ITYPE_IMM (value) << 32);
-      break;
+  if (*x->offsetp != *y->offsetp)
+    return *x->offsetp < *y->offsetp ? -1 : 1;
+  return 0;
+}
 
-    case R_RISCV_JAL:
-      if (!VALID_UJTYPE_IMM (value))
-	return bfd_reloc_overflow;
-      value = ENCODE_UJTYPE_IMM (value);
-      break;
+/* Remove the GOT entries that no reloc loads from any more, now that
+   pass 0 of relaxation has turned GOT loads into address computations,
+   along with the dynamic relocs that would have set them up.  The other
+   entries move down, keeping their order.  Set *SHRUNK if the GOT is
+   now smaller.  */
 
-    case R_RISCV_BRANCH:
-      if (!VALID_SBTYPE_IMM (value))
-	return bfd_reloc_overflow;
-      value = ENCODE_SBTYPE_IMM (value);
-      break;
+static bfd_boolean
+riscv_elf_shrink_got (struct bfd_link_info *info, bfd_boolean *shrunk)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  struct riscv_got_entries e;
+  bfd_vma removed = 0;
+  bfd_boolean ret = FALSE;
+  bfd *ibfd;
+  size_t i;
 
-    case R_RISCV_RVC_BRANCH:
-      if (!VALID_RVC_B_IMM (value))
-	return bfd_reloc_overflow;
-      value = ENCODE_RVC_B_IMM (value);
-      break;
+  *shrunk = FALSE;
+  if (htab->elf.sgot == NULL)
+    return TRUE;
 
-    case R_RISCV_RVC_JUMP:
-      if (!VALID_RVC_J_IMM (value))
-	return bfd_reloc_overflow;
-      value = ENCODE_RVC_J_IMM (value);
-      break;
+  memset (&e, 0, sizeof (e));
+  e.info = info;
 
-    case R_RISCV_RVC_LUI:
-      if (!VALID_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (value)))
-	return bfd_reloc_overflow;
-      value = ENCODE_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (value));
-      break;
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      Elf_Internal_Shdr *symtab_hdr;
+      bfd_vma *local_got;
+      char *local_tls_type;
+      char *local_used = NULL;
+      unsigned long r_symndx;
+      asection *sec;
 
-    case R_RISCV_32:
-    case R_RISCV_64:
-    case R_RISCV_ADD8:
-    case R_RISCV_ADD16:
-    case R_RISCV_ADD32:
-    case R_RISCV_ADD64:
-    case R_RISCV_SUB6:
-    case R_RISCV_SUB8:
-    case R_RISCV_SUB16:
-    case R_RISCV_SUB32:
-    case R_RISCV_SUB64:
-    case R_RISCV_SET6:
-    case R_RISCV_SET8:
-    case R_RISCV_SET16:
-    case R_RISCV_SET32:
-    case R_RISCV_32_PCREL:
-    case R_RISCV_TLS_DTPREL32:
-    case R_RISCV_TLS_DTPREL64:
-      break;
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
 
-    case R_RISCV_DELETE:
-      return bfd_reloc_ok;
+      symtab_hdr = &elf_symtab_hdr (ibfd);
+      local_got = elf_local_got_offsets (ibfd);
+      if (local_got != NULL)
+	{
+	  local_used = bfd_zmalloc (symtab_hdr->sh_info);
+	  if (local_used == NULL)
+	    goto fail;
+	}
 
-    default:
-      return bfd_reloc_notsupported;
-    }
+      /* Mark the symbols that are still loaded from the GOT.  */
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	{
+	  Elf_Internal_Rela *relocs, *rel, *relend;
 
-  bfd_vma word = bfd_get (howto->bitsize, input_bfd, contents + rel->r_offset);
-  word = (word & ~howto->dst_mask) | (value & howto->dst_mask);
-  bfd_put (howto->bitsize, input_bfd, word, contents + rel->r_offset);
+	  if ((sec->flags & SEC_RELOC) == 0
+	      || sec->reloc_count == 0
+	      || sec->output_section == NULL
+	      || discarded_section (sec))
+	    continue;
 
-  return bfd_reloc_ok;
-}
+	  relocs = _bfd_elf_link_read_relocs (ibfd, sec, NULL, NULL, FALSE);
+	  if (relocs == NULL)
+	    {
+	      free (local_used);
+	      goto fail;
+	    }
 
-/* Remember all PC-relative high-part relocs we've encountered to help us
-   later resolve the corresponding low-part relocs.  */
+	  relend = relocs + sec->reloc_count;
+	  for (rel = relocs; rel < relend; rel++)
+	    if (ELFNN_R_TYPE (rel->r_info) == R_RISCV_GOT_HI20)
+	      {
+		struct elf_link_hash_entry *h = riscv_got_reloc_hash (ibfd, rel);
 
-typedef struct
-{
-  bfd_vma address;
-  bfd_vma value;
-} riscv_pcrel_hi_reloc;
+		if (h != NULL)
+		  riscv_elf_hash_entry (h)->got_used = TRUE;
+		else if (local_used != NULL)
+		  local_used[ELFNN_R_SYM (rel->r_info)] = 1;
+	      }
 
-typedef struct riscv_pcrel_lo_reloc
-{
-  asection *                     input_section;
-  struct bfd_link_info *         info;
-  reloc_howto_type *             howto;
-  const Elf_Internal_Rela *      reloc;
-  bfd_vma                        addr;
-  const char *                   name;
-  bfd_byte *                     contents;
-  struct riscv_pcrel_lo_reloc *  next;
-} riscv_pcrel_lo_reloc;
+	  if (elf_section_data (sec)->relocs != relocs)
+	    free (relocs);
+	}
 
-typedef struct
-{
-  htab_t hi_relocs;
-  riscv_pcrel_lo_reloc *lo_relocs;
-} riscv_pcrel_relocs;
+      if (local_got == NULL)
+	continue;
 
-static hashval_t
-riscv_pcrel_reloc_hash (const void *entry)
-{
-  const riscv_pcrel_hi_reloc *e = entry;
-  return (hashval_t)(e->address >> 2);
-}
+      local_tls_type = _bfd_riscv_elf_local_got_tls_type (ibfd);
+      for (r_symndx = 0; r_symndx < symtab_hdr->sh_info; r_symndx++)
+	{
+	  int tls_type = local_tls_type[r_symndx];
+	  bfd_vma size = RISCV_ELF_WORD_BYTES;
 
-static bfd_boolean
-riscv_pcrel_reloc_eq (const void *entry1, const void *entry2)
-{
-  const riscv_pcrel_hi_reloc *e1 = entry1, *e2 = entry2;
-  return e1->address == e2->address;
-}
+	  if (local_got[r_symndx] == (bfd_vma) -1)
+	    continue;
 
-static bfd_boolean
-riscv_init_pcrel_relocs (riscv_pcrel_relocs *p)
-{
+	  if (tls_type & GOT_TLS_GD)
+	    size += RISCV_ELF_WORD_BYTES;
+	  if (!riscv_got_entries_add (&e, &local_got[r_symndx], size,
+				      (!local_used[r_symndx]
+				       && !(tls_type & (GOT_TLS_GD
+							| GOT_TLS_IE))),
+				      bfd_link_pic (info)))
+	    {
+	      free (local_used);
+	      goto fail;
+	    }
+	}
+      free (local_used);
+    }
 
-  p->lo_relocs = NULL;
-  p->hi_relocs = htab_create (1024, riscv_pcrel_reloc_hash,
-			      riscv_pcrel_reloc_eq, free);
-  return p->hi_relocs != NULL;
-}
+  elf_link_hash_traverse (&htab->elf, riscv_elf_add_got_entry, &e);
+  if (e.failed)
+    goto fail;
 
-static void
-riscv_free_pcrel_relocs (riscv_pcrel_relocs *p)
-{
-  riscv_pcrel_lo_reloc *cur = p->lo_relocs;
+  /* Move the entries that are left down over those that are not.  */
+  qsort (e.entries, e.count, sizeof (*e.entries), riscv_got_entry_compare);
+  for (i = 0; i < e.count; i++)
+    if (e.entries[i].unused)
+      {
+	*e.entries[i].offsetp = (bfd_vma) -1;
+	removed += e.entries[i].size;
+      }
+    else
+      *e.entries[i].offsetp -= removed;
 
-  while (cur != NULL)
+  if (removed != 0)
     {
-      riscv_pcrel_lo_reloc *next = cur->next;
-      free (cur);
-      cur = next;
+      htab->elf.sgot->size -= removed;
+      htab->elf.srelgot->size -= e.relocs * sizeof (ElfNN_External_Rela);
+      *shrunk = TRUE;
     }
+  ret = TRUE;
 
-  htab_delete (p->hi_relocs);
+fail:
+  free (e.entries);
+  return ret;
 }
 
+/* Turn the GOT loads of the whole link whose symbols are known to be in
+   reach, given that no section is aligned to more than MAX_ALIGNMENT,
+   into address computations, and remove the GOT entries that are no
+   longer used.  This is done on the first trip of pass 0 of relaxation
+   only; set *AGAIN if the GOT shrank.  */
+
 static bfd_boolean
-riscv_zero_pcrel_hi_reloc (Elf_Internal_Rela *rel,
-			   struct bfd_link_info *info,
-			   bfd_vma pc,
-			   bfd_vma addr,
-			   bfd_byte *contents,
-			   const reloc_howto_type *howto,
-			   bfd *input_bfd)
+riscv_elf_relax_got_loads (struct bfd_link_info *info,
+			   bfd_vma max_alignment, bfd_boolean *again)
 {
-  /* We may need to reference low addreses in PC-relative modes even when the
-   * PC is far away from these addresses.  For example, undefweak references
-   * need to produce the address 0 when linked.  As 0 is far from the arbitrary
-   * addresses that we can link PC-relative programs at, the linker can't
-   * actually relocate references to those symbols.  In order to allow these
-   * programs to work we simply convert the PC-relative auipc sequences to
-   * 0-relative lui sequences.  */
-  if (bfd_link_pic (info))
-    return FALSE;
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  bfd_boolean shrunk;
+  bfd *ibfd;
+  asection *sec;
 
-  /* If it's possible to reference the symbol using auipc we do so, as that's
-   * more in the spirit of the PC-relative relocations we're processing.  */
-  bfd_vma offset = addr - pc;
-  if (ARCH_SIZE == 32 || VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (offset)))
-    return FALSE;
+  htab->got_loads_done = TRUE;
 
-  /* If it's impossible to reference this with a LUI-based offset then don't
-   * bother to convert it at all so users still see the PC-relative relocation
-   * in the truncation message.  */
-  if (ARCH_SIZE > 32 && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (addr)))
-    return FALSE;
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
 
-  rel->r_info = ELFNN_R_INFO(addr, R_RISCV_HI20);
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (!riscv_elf_convert_got_loads (ibfd, sec, info, TRUE,
+					  max_alignment))
+	  return FALSE;
+    }
 
-  bfd_vma insn = bfd_get(howto->bitsize, input_bfd, contents + rel->r_offset);
-  insn = (insn & ~MASK_AUIPC) | MATCH_LUI;
-  bfd_put(howto->bitsize, input_bfd, insn, contents + rel->r_offset);
+  if (htab->got_loads_converted == 0)
+    return TRUE;
+
+  if (!riscv_elf_shrink_got (info, &shrunk))
+    return FALSE;
+  if (shrunk)
+    *again = TRUE;
   return TRUE;
 }
 
+/* Place the PLT entries that load from the GOT after the others, now
+   that those have all been allocated.  INF is the .plt section.  */
+
 static bfd_boolean
-riscv_record_pcrel_hi_reloc (riscv_pcrel_relocs *p, bfd_vma addr,
-			     bfd_vma value, bfd_boolean absolute)
+riscv_elf_place_plt_got (struct elf_link_hash_entry *h, void *inf)
 {
-  bfd_vma offset = absolute ? value : value - addr;
-  riscv_pcrel_hi_reloc entry = {addr, offset};
-  riscv_pcrel_hi_reloc **slot =
-    (riscv_pcrel_hi_reloc **) htab_find_slot (p->hi_relocs, &entry, INSERT);
+  asection *splt = (asection *) inf;
 
-  BFD_ASSERT (*slot == NULL);
-  *slot = (riscv_pcrel_hi_reloc *) bfd_malloc (sizeof (riscv_pcrel_hi_reloc));
-  if (*slot == NULL)
-    return FALSE;
-  **slot = entry;
+  if (riscv_elf_hash_entry (h)->plt_got)
+    h->plt.offset += splt->size;
   return TRUE;
 }
 
+/* Return TRUE if the relative relocs in SEC may be packed into .relr.dyn.
+   Only sections whose contents neither relaxation nor .eh_frame editing
+   can move, and whose words stay naturally aligned, qualify.  */
+
 static bfd_boolean
-riscv_record_pcrel_lo_reloc (riscv_pcrel_relocs *p,
-			     asection *input_section,
-			     struct bfd_link_info *info,
-			     reloc_howto_type *howto,
-			     const Elf_Internal_Rela *reloc,
-			     bfd_vma addr,
-			     const char *name,
-			     bfd_byte *contents)
+riscv_elf_relr_section_p (struct riscv_elf_link_hash_table *htab,
+			  asection *sec)
 {
-  riscv_pcrel_lo_reloc *entry;
-  entry = (riscv_pcrel_lo_reloc *) bfd_malloc (sizeof (riscv_pcrel_lo_reloc));
-  if (entry == NULL)
+  return (htab->srelr != NULL
+	  && (sec->flags & (SEC_ALLOC | SEC_CODE)) == SEC_ALLOC
+	  && sec->alignment_power >= RISCV_ELF_LOG_WORD_BYTES
+	  && sec->sec_info_type == SEC_INFO_TYPE_NONE
+	  && strcmp (sec->name, ".eh_frame") != 0);
+}
+
+/* Return TRUE if an R_RISCV_32 or R_RISCV_64 reloc in an allocated
+   section that is copied into the output as a dynamic reloc becomes an
+   R_RISCV_RELATIVE reloc rather than one against symbol H.  H is NULL
+   for a local symbol.  Weak undefined symbols that are not dynamic get
+   no dynamic reloc at all.  */
+
+static bfd_boolean
+riscv_elf_relative_reloc_p (struct bfd_link_info *info,
+			    struct elf_link_hash_entry *h)
+{
+  if (!bfd_link_pic (info))
     return FALSE;
-  *entry = (riscv_pcrel_lo_reloc) {input_section, info, howto, reloc, addr,
-				   name, contents, p->lo_relocs};
-  p->lo_relocs = entry;
-  return TRUE;
+  if (h == NULL)
+    return TRUE;
+  if (ELF_ST_VISIBILITY (h->other) != STV_DEFAULT
+      && h->root.type == bfd_link_hash_undefweak)
+    return FALSE;
+  return (h->dynindx == -1
+	  || (SYMBOLIC_BIND (info, h) && h->def_regular));
 }
 
+/* Return TRUE if reloc REL against SEC, which would otherwise become an
+   R_RISCV_RELATIVE dynamic reloc, is packed into .relr.dyn instead.  */
+
 static bfd_boolean
-riscv_resolve_pcrel_lo_relocs (riscv_pcrel_relocs *p)
+riscv_elf_relr_reloc_p (struct riscv_elf_link_hash_table *htab,
+			asection *sec, const Elf_Internal_Rela *rel)
+{
+  return (ELFNN_R_TYPE (rel->r_info) == R_RISCV_NN
+	  && (rel->r_offset & (RISCV_ELF_WORD_BYTES - 1)) == 0
+	  && riscv_elf_relr_section_p (htab, sec));
+}
+
+/* Find the relocs that riscv_elf_relocate_section will pack into
+   .relr.dyn, making the same decisions it does.  If ADDRS is NULL, count
+   them in HTAB->relr_count and take them out of the size of .rela.dyn,
+   otherwise store their final addresses in ADDRS.  */
+
+static bfd_boolean
+riscv_elf_scan_relr (bfd *output_bfd, struct bfd_link_info *info,
+		     bfd_vma *addrs)
 {
-  riscv_pcrel_lo_reloc *r;
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  bfd_size_type count = 0;
+  bfd *ibfd;
 
-  for (r = p->lo_relocs; r != NULL; r = r->next)
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
     {
-      bfd *input_bfd = r->input_section->owner;
+      Elf_Internal_Shdr *symtab_hdr;
+      Elf_Internal_Sym *isymbuf = NULL;
+      struct elf_link_hash_entry **sym_hashes;
+      asection *sec;
 
-      riscv_pcrel_hi_reloc search = {r->addr, 0};
-      riscv_pcrel_hi_reloc *entry = htab_find (p->hi_relocs, &search);
-      if (entry == NULL)
-        {
-	  ((*r->info->callbacks->reloc_overflow)
-	   (r->info, NULL, r->name, r->howto->name, (bfd_vma) 0,
-	    input_bfd, r->input_section, r->reloc->r_offset));
-	  return TRUE;
-        }
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
 
-      perform_relocation (r->howto, r->reloc, entry->value, r->input_section,
-			  input_bfd, r->contents);
+      symtab_hdr = &elf_symtab_hdr (ibfd);
+      sym_hashes = elf_sym_hashes (ibfd);
+
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	{
+	  Elf_Internal_Rela *relocs, *rel, *relend;
+	  asection *sreloc = elf_section_data (sec)->sreloc;
+	  bfd_size_type sec_count = 0;
+
+	  if (sreloc == NULL
+	      || (sec->flags & (SEC_RELOC | SEC_EXCLUDE)) != SEC_RELOC
+	      || sec->reloc_count == 0
+	      || sec->output_section == NULL
+	      || discarded_section (sec)
+	      || !riscv_elf_relr_section_p (htab, sec))
+	    continue;
+
+	  relocs = _bfd_elf_link_read_relocs (ibfd, sec, NULL, NULL,
+					      info->keep_memory);
+	  if (relocs == NULL)
+	    return FALSE;
+
+	  relend = relocs + sec->reloc_count;
+	  for (rel = relocs; rel < relend; rel++)
+	    {
+	      unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+	      bfd_vma offset;
+
+	      if (!riscv_elf_relr_reloc_p (htab, sec, rel))
+		continue;
+
+	      if (r_symndx < symtab_hdr->sh_info)
+		{
+		  asection *sym_sec;
+
+		  if (isymbuf == NULL)
+		    {
+		      isymbuf = (Elf_Internal_Sym *) symtab_hdr->contents;
+		      if (isymbuf == NULL)
+			isymbuf = bfd_elf_get_elf_syms (ibfd, symtab_hdr,
+							symtab_hdr->sh_info,
+							0, NULL, NULL, NULL);
+		      if (isymbuf == NULL)
+			{
+			  if (elf_section_data (sec)->relocs != relocs)
+			    free (relocs);
+			  return FALSE;
+			}
+		    }
+
+		  sym_sec = bfd_section_from_elf_index
+		    (ibfd, isymbuf[r_symndx].st_shndx);
+		  if (sym_sec != NULL && discarded_section (sym_sec))
+		    continue;
+		}
+	      else
+		{
+		  struct elf_link_hash_entry *h;
+
+		  h = sym_hashes[r_symndx - symtab_hdr->sh_info];
+		  while (h->root.type == bfd_link_hash_indirect
+			 || h->root.type == bfd_link_hash_warning)
+		    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+
+		  if ((h->root.type == bfd_link_hash_defined
+		       || h->root.type == bfd_link_hash_defweak)
+		      && discarded_section (h->root.u.def.section))
+		    continue;
+
+		  if (!riscv_elf_relative_reloc_p (info, h))
+		    continue;
+		}
+
+	      offset = _bfd_elf_section_offset (output_bfd, info, sec,
+						rel->r_offset);
+	      if (offset >= (bfd_vma) -2)
+		continue;
+
+	      if (addrs == NULL)
+		sec_count++;
+	      else if (count + sec_count < htab->relr_count)
+		addrs[count + sec_count++] = sec_addr (sec) + offset;
+	      else
+		{
+		  sec_count++;
+		  break;
+		}
+	    }
+
+	  if (elf_section_data (sec)->relocs != relocs)
+	    free (relocs);
+
+	  if (addrs == NULL)
+	    {
+	      BFD_ASSERT (sreloc->size
+			  >= sec_count * sizeof (ElfNN_External_Rela));
+	      sreloc->size -= sec_count * sizeof (ElfNN_External_Rela);
+	    }
+	  count += sec_count;
+	}
+
+      if (isymbuf != NULL
+	  && symtab_hdr->contents != (unsigned char *) isymbuf)
+	free (isymbuf);
     }
 
+  if (addrs == NULL)
+    htab->relr_count = count;
+  else if (count != htab->relr_count)
+    {
+      _bfd_error_handler (_("%B: packed relative relocs changed after"
+			    " sizing"), output_bfd);
+      bfd_set_error (bfd_error_bad_value);
+      return FALSE;
+    }
   return TRUE;
 }
 
-/* Relocate a RISC-V ELF section.
+/* Order the addresses of the packed relocs.  */
 
-   The RELOCATE_SECTION function is called by the new ELF backend linker
-   to handle the relocations for a section.
+static int
+riscv_elf_relr_compare (const void *a, const void *b)
+{
+  bfd_vma va = *(const bfd_vma *) a, vb = *(const bfd_vma *) b;
 
-   The relocs are always passed as Rela structures.
+  return va < vb ? -1 : va > vb;
+}
 
-   This function is responsible for adjusting the section contents as
-   necessary, and (if generating a relocatable output file) adjusting
-   the reloc addend as necessary.
+/* Encode the sorted addresses of the packed relocs into CONTENTS, unless
+   it is NULL, and return the size of the encoding.  An entry with the
+   low bit clear is the address of a word to relocate.  An entry with the
+   low bit set is a bitmap of which of the next NN-1 words to relocate,
+   starting after the last address or where the last bitmap ended.  When
+   writing CONTENTS, pad the encoding to the size of .relr.dyn with empty
+   bitmaps, which relocate nothing, and return that size.  */
+
+static bfd_size_type
+riscv_elf_encode_relr (bfd *abfd, struct riscv_elf_link_hash_table *htab,
+		       bfd_byte *contents)
+{
+  const bfd_vma nbits = RISCV_ELF_WORD_BYTES * 8 - 1;
+  bfd_vma *addrs = htab->relr_addrs;
+  bfd_size_type i = 0, size = 0;
 
-   This function does not have to worry about setting the reloc
-   address or the reloc symbol index.
+  while (i < htab->relr_count)
+    {
+      bfd_vma base = addrs[i++];
 
-   LOCAL_SYMS is a pointer to the swapped in local symbols.
+      if (contents != NULL)
+	bfd_put_NN (abfd, base, contents + size);
+      size += RISCV_ELF_WORD_BYTES;
+      base += RISCV_ELF_WORD_BYTES;
 
-   LOCAL_SECTIONS is an array giving the section in the input file
-   corresponding to the st_shndx field of each local symbol.
+      for (;;)
+	{
+	  bfd_vma bitmap = 0;
 
-   The global hash table entry for the global symbols can be found
-   via elf_sym_hashes (input_bfd).
+	  for (; (i < htab->relr_count
+		  && addrs[i] - base < nbits * RISCV_ELF_WORD_BYTES); i++)
+	    bitmap |= (bfd_vma) 1 << ((addrs[i] - base)
+				      >> RISCV_ELF_LOG_WORD_BYTES);
+	  if (bitmap == 0)
+	    break;
 
-   When generating relocatable output, this function must handle
-   STB_LOCAL/STT_SECTION symbols specially.  The output symbol is
-   going to be the section symbol corresponding to the output
-   section, which means that the addend must be adjusted
-   accordingly.  */
+	  if (contents != NULL)
+	    bfd_put_NN (abfd, (bitmap << 1) | 1, contents + size);
+	  size += RISCV_ELF_WORD_BYTES;
+	  base += nbits * RISCV_ELF_WORD_BYTES;
+	}
+    }
+
+  /* The section never shrinks while it is sized, so the final encoding
+     may be shorter than it.  */
+  if (contents != NULL)
+    for (; size < htab->srelr->size; size += RISCV_ELF_WORD_BYTES)
+      bfd_put_NN (abfd, 1, contents + size);
+
+  return size;
+}
 
 static bfd_boolean
-riscv_elf_relocate_section (bfd *output_bfd,
-			    struct bfd_link_info *info,
-			    bfd *input_bfd,
-			    asection *input_section,
-			    bfd_byte *contents,
-			    Elf_Internal_Rela *relocs,
-			    Elf_Internal_Sym *local_syms,
-			    asection **local_sections)
+riscv_elf_size_dynamic_sections (bfd *output_bfd, struct bfd_link_info *info)
 {
-  Elf_Internal_Rela *rel;
-  Elf_Internal_Rela *relend;
-  riscv_pcrel_relocs pcrel_relocs;
-  bfd_boolean ret = FALSE;
-  asection *sreloc = elf_section_data (input_section)->sreloc;
-  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
-  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (input_bfd);
-  struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (input_bfd);
-  bfd_vma *local_got_offsets = elf_local_got_offsets (input_bfd);
-  bfd_boolean absolute;
+  struct riscv_elf_link_hash_table *htab;
+  bfd *dynobj;
+  asection *s;
+  bfd *ibfd;
 
-  if (!riscv_init_pcrel_relocs (&pcrel_relocs))
-    return FALSE;
+  htab = riscv_elf_hash_table (info);
+  BFD_ASSERT (htab != NULL);
+  dynobj = htab->elf.dynobj;
+  BFD_ASSERT (dynobj != NULL);
 
-  relend = relocs + input_section->reloc_count;
-  for (rel = relocs; rel < relend; rel++)
+  if (elf_hash_table (info)->dynamic_sections_created)
     {
-      unsigned long r_symndx;
-      struct elf_link_hash_entry *h;
-      Elf_Internal_Sym *sym;
-      asection *sec;
-      bfd_vma relocation;
-      bfd_reloc_status_type r = bfd_reloc_ok;
-      const char *name;
-      bfd_vma off, ie_off;
-      bfd_boolean unresolved_reloc, is_ie = FALSE;
-      bfd_vma pc = sec_addr (input_section) + rel->r_offset;
-      int r_type = ELFNN_R_TYPE (rel->r_info), tls_type;
-      reloc_howto_type *howto = riscv_elf_rtype_to_howto (r_type);
-      const char *msg = NULL;
+      /* Set the contents of the .interp section to the interpreter.  */
+      if (bfd_link_executable (info) && !info->nointerp)
+	{
+	  s = bfd_get_linker_section (dynobj, ".interp");
+	  BFD_ASSERT (s != NULL);
+	  s->size = strlen (ELFNN_DYNAMIC_INTERPRETER) + 1;
+	  s->contents = (unsigned char *) ELFNN_DYNAMIC_INTERPRETER;
+	}
+    }
 
-      if (r_type == R_RISCV_GNU_VTINHERIT || r_type == R_RISCV_GNU_VTENTRY)
+  /* Set up .got offsets for local syms, and space for local dynamic
+     relocs.  */
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      bfd_signed_vma *local_got;
+      bfd_signed_vma *end_local_got;
+      char *local_tls_type;
+      bfd_size_type locsymcount;
+      Elf_Internal_Shdr *symtab_hdr;
+      asection *srel;
+
+      if (! is_riscv_elf (ibfd))
 	continue;
 
-      /* This is a final link.  */
-      r_symndx = ELFNN_R_SYM (rel->r_info);
-      h = NULL;
-      sym = NULL;
-      sec = NULL;
-      unresolved_reloc = FALSE;
-      if (r_symndx < symtab_hdr->sh_info)
+      /* Drop the TLS references that need not go through the GOT before
+	 GOT entries are allocated.  */
+      if (bfd_link_executable (info)
+	  && !info->disable_target_specific_optimizations)
+	for (s = ibfd->sections; s != NULL; s = s->next)
+	  if (!riscv_elf_convert_got_loads (ibfd, s, info, FALSE, 0))
+	    return FALSE;
+
+      for (s = ibfd->sections; s != NULL; s = s->next)
 	{
-	  sym = local_syms + r_symndx;
-	  sec = local_sections[r_symndx];
-	  relocation = _bfd_elf_rela_local_sym (output_bfd, sym, &sec, rel);
+	  struct riscv_elf_dyn_relocs *p;
+
+	  for (p = elf_section_data (s)->local_dynrel; p != NULL; p = p->next)
+	    {
+	      if (!bfd_is_abs_section (p->sec)
+		  && bfd_is_abs_section (p->sec->output_section))
+		{
+		  /* Input section has been discarded, either because
+		     it is a copy of a linkonce section or due to
+		     linker script /DISCARD/, so we'll be discarding
+		     the relocs too.  */
+		}
+	      else if (p->count != 0)
+		{
+		  srel = elf_section_data (p->sec)->sreloc;
+		  srel->size += p->count * sizeof (ElfNN_External_Rela);
+		  if ((p->sec->output_section->flags & SEC_READONLY) != 0)
+		    info->flags |= DF_TEXTREL;
+		}
+	    }
 	}
-      else
-	{
-	  bfd_boolean warned, ignored;
 
-	  RELOC_FOR_GLOBAL_SYMBOL (info, input_bfd, input_section, rel,
-				   r_symndx, symtab_hdr, sym_hashes,
-				   h, sec, relocation,
-				   unresolved_reloc, warned, ignored);
-	  if (warned)
+      local_got = elf_local_got_refcounts (ibfd);
+      if (!local_got)
+	continue;
+
+      symtab_hdr = &elf_symtab_hdr (ibfd);
+      locsymcount = symtab_hdr->sh_info;
+      end_local_got = local_got + locsymcount;
+      local_tls_type = _bfd_riscv_elf_local_got_tls_type (ibfd);
+      s = htab->elf.sgot;
+      srel = htab->elf.srelgot;
+      for (; local_got < end_local_got; ++local_got, ++local_tls_type)
+	{
+	  if (*local_got > 0)
 	    {
-	      /* To avoid generating warning messages about truncated
-		 relocations, set the relocation's address to be the same as
-		 the start of this section.  */
-	      if (input_section->output_section != NULL)
-		relocation = input_section->output_section->vma;
-	      else
-		relocation = 0;
+	      *local_got = s->size;
+	      s->size += RISCV_ELF_WORD_BYTES;
+	      if (*local_tls_type & GOT_TLS_GD)
+		s->size += RISCV_ELF_WORD_BYTES;
+	      if (bfd_link_pic (info)
+		  || (*local_tls_type & (GOT_TLS_GD | GOT_TLS_IE)))
+		srel->size += sizeof (ElfNN_External_Rela);
 	    }
+	  else
+	    *local_got = (bfd_vma) -1;
 	}
+    }
 
-      if (sec != NULL && discarded_section (sec))
-	RELOC_AGAINST_DISCARDED_SECTION (info, input_bfd, input_section,
-					 rel, 1, relend, howto, 0, contents);
+  /* Allocate global sym .plt and .got entries, and space for global
+     sym dynamic relocs.  */
+  htab->plt_got_size = 0;
+  elf_link_hash_traverse (&htab->elf, allocate_dynrelocs, info);
 
-      if (bfd_link_relocatable (info))
+  if (htab->plt_got_size != 0)
+    {
+      elf_link_hash_traverse (&htab->elf, riscv_elf_place_plt_got,
+			      htab->elf.splt);
+      htab->elf.splt->size += htab->plt_got_size;
+    }
+
+  /* Move the relative relocs that can be packed out of .rela.dyn.  Their
+     encoding is sized once their addresses are known, starting from a
+     single entry, by bfd_elfNN_riscv_size_relative_relocs.  */
+  if (htab->srelr != NULL)
+    {
+      if (!riscv_elf_scan_relr (output_bfd, info, NULL))
+	return FALSE;
+      htab->srelr->size = htab->relr_count != 0 ? RISCV_ELF_WORD_BYTES : 0;
+    }
+
+  if (htab->elf.sgotplt)
+    {
+      struct elf_link_hash_entry *got;
+      got = elf_link_hash_lookup (elf_hash_table (info),
+				  "_GLOBAL_OFFSET_TABLE_",
+				  FALSE, FALSE, FALSE);
+
+      /* Don't allocate .got.plt section if there are no GOT nor PLT
+	 entries and there is no refeence to _GLOBAL_OFFSET_TABLE_.  */
+      if ((got == NULL
+	   || !got->ref_regular_nonweak)
+	  && (htab->elf.sgotplt->size == GOTPLT_HEADER_SIZE)
+	  && (htab->elf.splt == NULL
+	      || htab->elf.splt->size == 0)
+	  && (htab->elf.sgot == NULL
+	      || (htab->elf.sgot->size
+		  == get_elf_backend_data (output_bfd)->got_header_size)))
+	htab->elf.sgotplt->size = 0;
+    }
+
+  /* The check_relocs and adjust_dynamic_symbol entry points have
+     determined the sizes of the various dynamic sections.  Allocate
+     memory for them.  */
+  for (s = dynobj->sections; s != NULL; s = s->next)
+    {
+      if ((s->flags & SEC_LINKER_CREATED) == 0)
 	continue;
 
-      if (h != NULL)
-	name = h->root.root.string;
+      if (s == htab->elf.splt
+	  || s == htab->elf.sgot
+	  || s == htab->elf.sgotplt
+	  || s == htab->elf.sdynbss
+	  || s == htab->elf.sdynrelro
+	  || s == htab->srelr)
+	{
+	  /* Strip this section if we don't need it; see the
+	     comment below.  */
+	}
+      else if (strncmp (s->name, ".rela", 5) == 0)
+	{
+	  if (s->size != 0)
+	    {
+	      /* We use the reloc_count field as a counter if we need
+		 to copy relocs into the output file.  */
+	      s->reloc_count = 0;
+	    }
+	}
       else
 	{
-	  name = (bfd_elf_string_from_elf_section
-		  (input_bfd, symtab_hdr->sh_link, sym->st_name));
-	  if (name == NULL || *name == '\0')
-	    name = bfd_section_name (input_bfd, sec);
+	  /* It's not one of our sections.  */
+	  continue;
 	}
 
-      switch (r_type)
+      if (s->size == 0)
 	{
-	case R_RISCV_NONE:
-	case R_RISCV_RELAX:
-	case R_RISCV_TPREL_ADD:
-	case R_RISCV_COPY:
-	case R_RISCV_JUMP_SLOT:
-	case R_RISCV_RELATIVE:
-	  /* These require nothing of us at all.  */
+	  /* If we don't need this section, strip it from the
+	     output file.  This is mostly to handle .rela.bss and
+	     .rela.plt.  We must create both sections in
+	     create_dynamic_sections, because they must be created
+	     before the linker maps input sections to output
+	     sections.  The linker does that before
+	     adjust_dynamic_symbol is called, and it is that
+	     function which decides whether anything needs to go
+	     into these sections.  */
+	  s->flags |= SEC_EXCLUDE;
 	  continue;
+	}
 
-	case R_RISCV_HI20:
-	case R_RISCV_BRANCH:
-	case R_RISCV_RVC_BRANCH:
-	case R_RISCV_RVC_LUI:
-	case R_RISCV_LO12_I:
-	case R_RISCV_LO12_S:
-	case R_RISCV_SET6:
-	case R_RISCV_SET8:
-	case R_RISCV_SET16:
-	case R_RISCV_SET32:
-	case R_RISCV_32_PCREL:
-	case R_RISCV_DELETE:
-	  /* These require no special handling beyond perform_relocation.  */
-	  break;
+      if ((s->flags & SEC_HAS_CONTENTS) == 0)
+	continue;
 
-	case R_RISCV_GOT_HI20:
-	  if (h != NULL)
-	    {
-	      bfd_boolean dyn, pic;
+      /* Allocate memory for the section contents.  Zero the memory
+	 for the benefit of .rela.plt, which has 4 unused entries
+	 at the beginning, and we don't want garbage.  */
+      s->contents = (bfd_byte *) bfd_zalloc (dynobj, s->size);
+      if (s->contents == NULL)
+	return FALSE;
+    }
 
-	      off = h->got.offset;
-	      BFD_ASSERT (off != (bfd_vma) -1);
-	      dyn = elf_hash_table (info)->dynamic_sections_created;
-	      pic = bfd_link_pic (info);
+  if (elf_hash_table (info)->dynamic_sections_created)
+    {
+      /* Add some entries to the .dynamic section.  We fill in the
+	 values later, in riscv_elf_finish_dynamic_sections, but we
+	 must add the entries now so that we get the correct size for
+	 the .dynamic section.  The DT_DEBUG entry is filled in by the
+	 dynamic linker and used by the debugger.  */
+#define add_dynamic_entry(TAG, VAL) \
+  _bfd_elf_add_dynamic_entry (info, TAG, VAL)
 
-	      if (! WILL_CALL_FINISH_DYNAMIC_SYMBOL (dyn, pic, h)
-		  || (pic && SYMBOL_REFERENCES_LOCAL (info, h)))
-		{
-		  /* This is actually a static link, or it is a
-		     -Bsymbolic link and the symbol is defined
-		     locally, or the symbol was forced to be local
-		     because of a version file.  We must initialize
-		     this entry in the global offset table.  Since the
-		     offset must always be a multiple of the word size,
-		     we use the least significant bit to record whether
-		     we have initialized it already.
+      if (bfd_link_executable (info))
+	{
+	  if (!add_dynamic_entry (DT_DEBUG, 0))
+	    return FALSE;
+	}
 
-		     When doing a dynamic link, we create a .rela.got
-		     relocation entry to initialize the value.  This
+      if (htab->elf.srelplt->size != 0)
+	{
+	  if (!add_dynamic_entry (DT_PLTGOT, 0)
+	      || !add_dynamic_entry (DT_PLTRELSZ, 0)
+	      || !add_dynamic_entry (DT_PLTREL, DT_RELA)
+	      || !add_dynamic_entry (DT_JMPREL, 0))
+	    return FALSE;
+	}
+
+      if (!add_dynamic_entry (DT_RELA, 0)
+	  || !add_dynamic_entry (DT_RELASZ, 0)
+	  || !add_dynamic_entry (DT_RELAENT, sizeof (ElfNN_External_Rela)))
+	return FALSE;
+
+      if (htab->relr_count != 0)
+	{
+	  if (!add_dynamic_entry (DT_RELR, 0)
+	      || !add_dynamic_entry (DT_RELRSZ, 0)
+	      || !add_dynamic_entry (DT_RELRENT, RISCV_ELF_WORD_BYTES))
+	    return FALSE;
+
+	  /* A glibc that does not know DT_RELR would silently skip these
+	     relocs, so make the output refuse to load with one.  */
+	  if (!_bfd_elf_link_add_glibc_version_dependency
+		(output_bfd, info, "GLIBC_ABI_DT_RELR"))
+	    return FALSE;
+	}
+
+      /* If any dynamic relocs apply to a read-only section,
+	 then we need a DT_TEXTREL entry.  */
+      if ((info->flags & DF_TEXTREL) == 0)
+	elf_link_hash_traverse (&htab->elf, readonly_dynrelocs, info);
+
+      if (info->flags & DF_TEXTREL)
+	{
+	  if (!add_dynamic_entry (DT_TEXTREL, 0))
+	    return FALSE;
+	}
+    }
+#undef add_dynamic_entry
+
+  return TRUE;
+}
+
+#define TP_OFFSET 0
+#define DTP_OFFSET 0x800
+
+/* Return the relocation value for a TLS dtp-relative reloc.  */
+
+static bfd_vma
+dtpoff (struct bfd_link_info *info, bfd_vma address)
+{
+  /* If tls_sec is NULL, we should have signalled an error already.  */
+  if (elf_hash_table (info)->tls_sec == NULL)
+    return 0;
+  return address - elf_hash_table (info)->tls_sec->vma - DTP_OFFSET;
+}
+
+/* Return the relocation value for a static TLS tp-relative relocation.  */
+
+static bfd_vma
+tpoff (struct bfd_link_info *info, bfd_vma address)
+{
+  /* If tls_sec is NULL, we should have signalled an error already.  */
+  if (elf_hash_table (info)->tls_sec == NULL)
+    return 0;
+  return address - elf_hash_table (info)->tls_sec->vma - TP_OFFSET;
+}
+
+/* Return the global pointer's value, or 0 if it is not in use.  */
+
+static bfd_vma
+riscv_global_pointer_value (struct bfd_link_info *info)
+{
+  struct bfd_link_hash_entry *h;
+
+  h = bfd_link_hash_lookup (info->hash, RISCV_GP_SYMBOL, FALSE, FALSE, TRUE);
+  if (h == NULL || h->type != bfd_link_hash_defined)
+    return 0;
+
+  return h->u.def.value + sec_addr (h->u.def.section);
+}
+
+/* Emplace a static relocation.  */
+
+static bfd_reloc_status_type
+perform_relocation (const reloc_howto_type *howto,
+		    const Elf_Internal_Rela *rel,
+		    bfd_vma value,
+		    asection *input_section,
+		    bfd *input_bfd,
+		    bfd_byte *contents)
+{
+  if (howto->pc_relative)
+    value -= sec_addr (input_section) + rel->r_offset;
+  value += rel->r_addend;
+
+  switch (ELFNN_R_TYPE (rel->r_info))
+    {
+    case R_RISCV_HI20:
+    case R_RISCV_TPREL_HI20:
+    case R_RISCV_PCREL_HI20:
+    case R_RISCV_GOT_HI20:
+    case R_RISCV_TLS_GOT_HI20:
+    case R_RISCV_TLS_GD_HI20:
+      if (ARCH_SIZE > 32 && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (value)))
+	return bfd_reloc_overflow;
+      value = ENCODE_UTYPE_IMM (RISCV_CONST_HIGH_PART (value));
+      break;
+
+    case R_RISCV_LO12_I:
+    case R_RISCV_GPREL_I:
+    case R_RISCV_TPREL_LO12_I:
+    case R_RISCV_TPREL_I:
+    case R_RISCV_PCREL_LO12_I:
+      value = ENCODE_ITYPE_IMM (value);
+      break;
+
+    case R_RISCV_LO12_S:
+    case R_RISCV_GPREL_S:
+    case R_RISCV_TPREL_LO12_S:
+    case R_RISCV_TPREL_S:
+    case R_RISCV_PCREL_LO12_S:
+      value = ENCODE_STYPE_IMM (value);
+      break;
+
+    case R_RISCV_CALL:
+    case R_RISCV_CALL_PLT:
+      if (ARCH_SIZE > 32 && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (value)))
+	return bfd_reloc_overflow;
+      value = ENCODE_UTYPE_IMM (RISCV_CONST_HIGH_PART (value))
+	      | (ENCODE_ITYPE_IMM (value) << 32);
+      break;
+
+    case R_RISCV_JAL:
+      if (!VALID_UJTYPE_IMM (value))
+	return bfd_reloc_overflow;
+      value = ENCODE_UJTYPE_IMM (value);
+      break;
+
+    case R_RISCV_BRANCH:
+      if (!VALID_SBTYPE_IMM (value))
+	return bfd_reloc_overflow;
+      value = ENCODE_SBTYPE_IMM (value);
+      break;
+
+    case R_RISCV_RVC_BRANCH:
+      if (!VALID_RVC_B_IMM (value))
+	return bfd_reloc_overflow;
+      value = ENCODE_RVC_B_IMM (value);
+      break;
+
+    case R_RISCV_RVC_JUMP:
+      if (!VALID_RVC_J_IMM (value))
+	return bfd_reloc_overflow;
+      value = ENCODE_RVC_J_IMM (value);
+      break;
+
+    case R_RISCV_RVC_LUI:
+      if (!VALID_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (value)))
+	return bfd_reloc_overflow;
+      value = ENCODE_RVC_LUI_IMM (RISCV_CONST_HIGH_PART (value));
+      break;
+
+    case R_RISCV_32:
+    case R_RISCV_64:
+    case R_RISCV_ADD8:
+    case R_RISCV_ADD16:
+    case R_RISCV_ADD32:
+    case R_RISCV_ADD64:
+    case R_RISCV_SUB6:
+    case R_RISCV_SUB8:
+    case R_RISCV_SUB16:
+    case R_RISCV_SUB32:
+    case R_RISCV_SUB64:
+    case R_RISCV_SET6:
+    case R_RISCV_SET8:
+    case R_RISCV_SET16:
+    case R_RISCV_SET32:
+    case R_RISCV_32_PCREL:
+    case R_RISCV_TLS_DTPREL32:
+    case R_RISCV_TLS_DTPREL64:
+      break;
+
+    case R_RISCV_DELETE:
+      return bfd_reloc_ok;
+
+    default:
+      return bfd_reloc_notsupported;
+    }
+
+  bfd_vma word = bfd_get (howto->bitsize, input_bfd, contents + rel->r_offset);
+  word = (word & ~howto->dst_mask) | (value & howto->dst_mask);
+  bfd_put (howto->bitsize, input_bfd, word, contents + rel->r_offset);
+
+  return bfd_reloc_ok;
+}
+
+/* Call islands.
+
+   A call whose target is beyond the reach of a JAL keeps its AUIPC+JALR
+   pair, and a JAL that cannot reach its target does not link at all.
+   Before relaxation starts, bfd_elfNN_riscv_size_call_islands splits the
+   code of each output section into groups of input sections, and gives
+   each group with such calls an island: a linker created section after the
+   group's last input section, with one stub for each target
+
+	auipc	t1, %pcrel_hi(target)
+	jalr	x0, %pcrel_lo(target)(t1)
+
+   The calls can then be made by a JAL to the closest stub for their target.
+   The stubs clobber t1, which is not preserved across calls, so only calls
+   that link through ra are routed through them.  Relaxation only ever
+   brings code closer together, so a stub within reach when the islands are
+   sized stays within reach.  */
+
+#define RISCV_CALL_ISLAND_STUB_SIZE 8
+
+/* The largest span of input sections that one island serves, leaving the
+   island room to grow while staying within reach of all of them.  */
+#define RISCV_CALL_ISLAND_GROUP_SIZE (RISCV_JUMP_REACH / 4)
+
+/* A stub in a call island.  */
+
+struct riscv_call_island_stub
+{
+  asection *island;
+  bfd_vma offset;
+  struct riscv_call_island_stub *next;
+};
+
+/* The stubs that jump to one target, which is global symbol H, or else
+   local symbol R_SYMNDX of ABFD, plus ADDEND.  */
+
+struct riscv_call_island_target
+{
+  struct elf_link_hash_entry *h;
+  bfd *abfd;
+  unsigned long r_symndx;
+  bfd_vma addend;
+  struct riscv_call_island_stub *stubs;
+
+  /* While sizing the island of a group: the number of calls of the group
+     that need a stub for this target, whether one of them is a jump that
+     cannot link otherwise, and the next target the group's calls need.  */
+  unsigned int group_calls;
+  bfd_boolean group_jumps;
+  struct riscv_call_island_target *group_next;
+};
+
+static hashval_t
+riscv_call_island_target_hash (const void *entry)
+{
+  const struct riscv_call_island_target *t
+    = (const struct riscv_call_island_target *) entry;
+  hashval_t hash;
+
+  hash = htab_hash_pointer (t->h != NULL ? (void *) t->h : (void *) t->abfd);
+  return hash ^ (t->r_symndx * 31) ^ (hashval_t) t->addend;
+}
+
+static int
+riscv_call_island_target_eq (const void *entry1, const void *entry2)
+{
+  const struct riscv_call_island_target *t1
+    = (const struct riscv_call_island_target *) entry1;
+  const struct riscv_call_island_target *t2
+    = (const struct riscv_call_island_target *) entry2;
+
+  return (t1->h == t2->h
+	  && t1->abfd == t2->abfd
+	  && t1->r_symndx == t2->r_symndx
+	  && t1->addend == t2->addend);
+}
+
+/* Return the stubs for the target of REL, a reloc in ABFD.  If CREATE,
+   add an entry for the target if there is none yet.  Return NULL if there
+   is none, or on error.  */
+
+static struct riscv_call_island_target *
+riscv_call_island_lookup (struct riscv_elf_link_hash_table *htab, bfd *abfd,
+			  const Elf_Internal_Rela *rel, bfd_boolean create)
+{
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+  struct riscv_call_island_target key, *target;
+  void **slot;
+
+  if (htab->call_island_targets == NULL)
+    {
+      if (!create)
+	return NULL;
+      htab->call_island_targets
+	= htab_try_create (64, riscv_call_island_target_hash,
+			   riscv_call_island_target_eq, NULL);
+      if (htab->call_island_targets == NULL)
+	return NULL;
+    }
+
+  memset (&key, 0, sizeof (key));
+  if (r_symndx < symtab_hdr->sh_info)
+    {
+      key.abfd = abfd;
+      key.r_symndx = r_symndx;
+    }
+  else
+    {
+      key.h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+      while (key.h->root.type == bfd_link_hash_indirect
+	     || key.h->root.type == bfd_link_hash_warning)
+	key.h = (struct elf_link_hash_entry *) key.h->root.u.i.link;
+    }
+  key.addend = rel->r_addend;
+
+  slot = htab_find_slot (htab->call_island_targets, &key,
+			 create ? INSERT : NO_INSERT);
+  if (slot == NULL)
+    return NULL;
+  if (*slot != NULL)
+    return (struct riscv_call_island_target *) *slot;
+
+  target = (struct riscv_call_island_target *)
+    bfd_alloc (htab->elf.dynobj, sizeof (*target));
+  if (target == NULL)
+    return NULL;
+  *target = key;
+  *slot = target;
+  return target;
+}
+
+/* Return the address that a call to global symbol H, or else to local
+   symbol R_SYMNDX of ABFD, jumps to before its addend, and set *SYM_SEC
+   to the section it is in.  Return MINUS_ONE if a call island cannot jump
+   there.  */
+
+static bfd_vma
+riscv_call_island_symval (struct riscv_elf_link_hash_table *htab,
+			  struct elf_link_hash_entry *h, bfd *abfd,
+			  unsigned long r_symndx, asection **sym_sec)
+{
+  if (h != NULL)
+    {
+      if (h->plt.offset != MINUS_ONE)
+	{
+	  *sym_sec = htab->elf.splt;
+	  return sec_addr (htab->elf.splt) + h->plt.offset;
+	}
+      if ((h->root.type != bfd_link_hash_defined
+	   && h->root.type != bfd_link_hash_defweak)
+	  || h->root.u.def.section->output_section == NULL
+	  || discarded_section (h->root.u.def.section))
+	return MINUS_ONE;
+      *sym_sec = h->root.u.def.section;
+      return sec_addr (*sym_sec) + h->root.u.def.value;
+    }
+  else
+    {
+      Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+      Elf_Internal_Sym *isym;
+
+      /* Read the local symbols the same way relaxation does, so that the
+	 values it adjusts are the ones used here.  */
+      if (symtab_hdr->contents == NULL)
+	symtab_hdr->contents = (unsigned char *)
+	  bfd_elf_get_elf_syms (abfd, symtab_hdr, symtab_hdr->sh_info,
+				0, NULL, NULL, NULL);
+      if (symtab_hdr->contents == NULL)
+	return MINUS_ONE;
+
+      isym = (Elf_Internal_Sym *) symtab_hdr->contents + r_symndx;
+      if (isym->st_shndx == SHN_UNDEF
+	  || isym->st_shndx >= elf_numsections (abfd))
+	return MINUS_ONE;
+      *sym_sec = elf_elfsections (abfd)[isym->st_shndx]->bfd_section;
+      if (*sym_sec == NULL
+	  || (*sym_sec)->output_section == NULL
+	  || discarded_section (*sym_sec)
+	  || (*sym_sec)->sec_info_type == SEC_INFO_TYPE_MERGE)
+	return MINUS_ONE;
+      return sec_addr (*sym_sec) + isym->st_value;
+    }
+}
+
+/* Return the address of the closest stub for the target of REL, a reloc
+   in SEC, that a jump with reach REACH can get to even if the distance
+   grows by SLACK bytes.  Return MINUS_ONE if there is none.  */
+
+static bfd_vma
+riscv_find_call_island (struct riscv_elf_link_hash_table *htab, bfd *abfd,
+			asection *sec, const Elf_Internal_Rela *rel,
+			bfd_vma reach, bfd_vma slack)
+{
+  struct riscv_call_island_target *target;
+  struct riscv_call_island_stub *stub;
+  bfd_vma pc = sec_addr (sec) + rel->r_offset;
+  bfd_vma island = MINUS_ONE, best = reach / 2 + 1;
+
+  target = riscv_call_island_lookup (htab, abfd, rel, FALSE);
+  if (target == NULL)
+    return MINUS_ONE;
+
+  for (stub = target->stubs; stub != NULL; stub = stub->next)
+    {
+      bfd_vma addr = sec_addr (stub->island) + stub->offset;
+      bfd_vma dist = addr > pc ? addr - pc + slack : pc - addr + slack;
+
+      /* A jump reaches REACH / 2 bytes back, but not as far forward.
+	 Stubs of islands that have not been laid out yet do not count.  */
+      if (stub->island->output_section != sec->output_section
+	  || stub->offset >= stub->island->size
+	  || (addr > pc && dist == reach / 2)
+	  || dist >= best)
+	continue;
+
+      island = addr;
+      best = dist;
+    }
+
+  return island;
+}
+
+/* REL is a JAL or C.JAL that cannot reach its target at RELOCATION.
+   Redirect it to a call island stub in reach if there is one, returning
+   the status of doing so.  */
+
+static bfd_reloc_status_type
+riscv_relocate_via_call_island (struct riscv_elf_link_hash_table *htab,
+				const reloc_howto_type *howto,
+				const Elf_Internal_Rela *rel,
+				asection *input_section,
+				bfd *input_bfd,
+				bfd_byte *contents)
+{
+  Elf_Internal_Rela island_rel = *rel;
+  bfd_vma reach, island, insn;
+
+  if (ELFNN_R_TYPE (rel->r_info) == R_RISCV_JAL)
+    {
+      insn = bfd_get_32 (input_bfd, contents + rel->r_offset);
+      if (((insn >> OP_SH_RD) & OP_MASK_RD) != X_RA)
+	return bfd_reloc_overflow;
+      reach = RISCV_JUMP_REACH;
+    }
+  else
+    {
+      insn = bfd_get_16 (input_bfd, contents + rel->r_offset);
+      if ((insn & MASK_C_JAL) != MATCH_C_JAL || ARCH_SIZE != 32)
+	return bfd_reloc_overflow;
+      reach = RVC_JUMP_REACH;
+    }
+
+  island = riscv_find_call_island (htab, input_bfd, input_section, rel,
+				   reach, 0);
+  if (island == MINUS_ONE)
+    return bfd_reloc_overflow;
+
+  island_rel.r_addend = 0;
+  return perform_relocation (howto, &island_rel, island,
+			     input_section, input_bfd, contents);
+}
+
+/* Remember all PC-relative high-part relocs we've encountered to help us
+   later resolve the corresponding low-part relocs.  */
+
+typedef struct riscv_pcrel_hi_reloc
+{
+  bfd_vma address;
+  bfd_vma value;
+} riscv_pcrel_hi_reloc;
+
+typedef struct riscv_pcrel_lo_reloc
+{
+  asection *                     input_section;
+  struct bfd_link_info *         info;
+  reloc_howto_type *             howto;
+  const Elf_Internal_Rela *      reloc;
+  bfd_vma                        addr;
+  struct elf_link_hash_entry *   h;
+  Elf_Internal_Sym *             sym;
+  asection *                     sym_sec;
+  bfd_byte *                     contents;
+} riscv_pcrel_lo_reloc;
+
+/* The high-part relocs of the section being relocated, in address order
+   unless HI_SORTED is FALSE, and the low-part relocs that refer to them.
+   One of these is kept in the link hash table and reused for every
+   section.  Its arrays are allocated on the output BFD and only grow.  */
+
+typedef struct riscv_pcrel_relocs
+{
+  bfd *abfd;
+  riscv_pcrel_hi_reloc *hi_relocs;
+  size_t hi_count;
+  size_t hi_size;
+  bfd_boolean hi_sorted;
+  riscv_pcrel_lo_reloc *lo_relocs;
+  size_t lo_count;
+  size_t lo_size;
+} riscv_pcrel_relocs;
+
+static riscv_pcrel_relocs *
+riscv_init_pcrel_relocs (bfd *output_bfd,
+			 struct riscv_elf_link_hash_table *htab)
+{
+  riscv_pcrel_relocs *p = htab->pcrel_relocs;
+
+  if (p == NULL)
+    {
+      p = (riscv_pcrel_relocs *) bfd_zalloc (output_bfd, sizeof (*p));
+      if (p == NULL)
+	return NULL;
+      p->abfd = output_bfd;
+      htab->pcrel_relocs = p;
+    }
+
+  p->hi_count = 0;
+  p->hi_sorted = TRUE;
+  p->lo_count = 0;
+  return p;
+}
+
+/* Return ARRAY, which has room for *SIZE elements of ELSIZE bytes of which
+   COUNT are used, or a copy of it with room for more, allocated on ABFD.
+   Return NULL if out of memory.  */
+
+static void *
+riscv_pcrel_grow (bfd *abfd, void *array, size_t *size, size_t count,
+		  size_t elsize)
+{
+  size_t new_size;
+  void *ret;
+
+  if (count < *size)
+    return array;
+
+  new_size = *size != 0 ? *size * 2 : 256;
+  ret = bfd_alloc (abfd, new_size * elsize);
+  if (ret == NULL)
+    return NULL;
+  if (count != 0)
+    memcpy (ret, array, count * elsize);
+  *size = new_size;
+  return ret;
+}
+
+static int
+riscv_pcrel_hi_reloc_compare (const void *a, const void *b)
+{
+  const riscv_pcrel_hi_reloc *ra = (const riscv_pcrel_hi_reloc *) a;
+  const riscv_pcrel_hi_reloc *rb = (const riscv_pcrel_hi_reloc *) b;
+
+  return ra->address < rb->address ? -1 : ra->address > rb->address;
+}
+
+/* Return the high-part reloc at ADDR, or NULL if there is none.  */
+
+static riscv_pcrel_hi_reloc *
+riscv_find_pcrel_hi_reloc (riscv_pcrel_relocs *p, bfd_vma addr)
+{
+  size_t lo = 0, hi = p->hi_count;
+
+  while (lo < hi)
+    {
+      size_t mid = lo + (hi - lo) / 2;
+
+      if (p->hi_relocs[mid].address < addr)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+
+  if (lo < p->hi_count && p->hi_relocs[lo].address == addr)
+    return &p->hi_relocs[lo];
+  return NULL;
+}
+
+static bfd_boolean
+riscv_zero_pcrel_hi_reloc (Elf_Internal_Rela *rel,
+			   struct bfd_link_info *info,
+			   bfd_vma pc,
+			   bfd_vma addr,
+			   bfd_byte *contents,
+			   const reloc_howto_type *howto,
+			   bfd *input_bfd)
+{
+  /* We may need to reference low addreses in PC-relative modes even when the
+   * PC is far away from these addresses.  For example, undefweak references
+   * need to produce the address 0 when linked.  As 0 is far from the arbitrary
+   * addresses that we can link PC-relative programs at, the linker can't
+   * actually relocate references to those symbols.  In order to allow these
+   * programs to work we simply convert the PC-relative auipc sequences to
+   * 0-relative lui sequences.  */
+  if (bfd_link_pic (info))
+    return FALSE;
+
+  /* If it's possible to reference the symbol using auipc we do so, as that's
+   * more in the spirit of the PC-relative relocations we're processing.  */
+  bfd_vma offset = addr - pc;
+  if (ARCH_SIZE == 32 || VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (offset)))
+    return FALSE;
+
+  /* If it's impossible to reference this with a LUI-based offset then don't
+   * bother to convert it at all so users still see the PC-relative relocation
+   * in the truncation message.  */
+  if (ARCH_SIZE > 32 && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (addr)))
+    return FALSE;
+
+  rel->r_info = ELFNN_R_INFO(addr, R_RISCV_HI20);
+
+  bfd_vma insn = bfd_get(howto->bitsize, input_bfd, contents + rel->r_offset);
+  insn = (insn & ~MASK_AUIPC) | MATCH_LUI;
+  bfd_put(howto->bitsize, input_bfd, insn, contents + rel->r_offset);
+  return TRUE;
+}
+
+static bfd_boolean
+riscv_record_pcrel_hi_reloc (riscv_pcrel_relocs *p, bfd_vma addr,
+			     bfd_vma value, bfd_boolean absolute)
+{
+  bfd_vma offset = absolute ? value : value - addr;
+  riscv_pcrel_hi_reloc *entry;
+
+  entry = (riscv_pcrel_hi_reloc *)
+    riscv_pcrel_grow (p->abfd, p->hi_relocs, &p->hi_size, p->hi_count,
+		      sizeof (*entry));
+  if (entry == NULL)
+    return FALSE;
+  p->hi_relocs = entry;
+
+  /* The relocs of a section normally come in address order, and then
+     there is nothing to sort before looking them up.  */
+  if (p->hi_count != 0)
+    {
+      bfd_vma last = p->hi_relocs[p->hi_count - 1].address;
+
+      BFD_ASSERT (addr != last);
+      if (addr < last)
+	p->hi_sorted = FALSE;
+    }
+
+  entry += p->hi_count++;
+  entry->address = addr;
+  entry->value = offset;
+  return TRUE;
+}
+
+static bfd_boolean
+riscv_record_pcrel_lo_reloc (riscv_pcrel_relocs *p,
+			     asection *input_section,
+			     struct bfd_link_info *info,
+			     reloc_howto_type *howto,
+			     const Elf_Internal_Rela *reloc,
+			     bfd_vma addr,
+			     struct elf_link_hash_entry *h,
+			     Elf_Internal_Sym *sym,
+			     asection *sym_sec,
+			     bfd_byte *contents)
+{
+  riscv_pcrel_lo_reloc *entry;
+
+  entry = (riscv_pcrel_lo_reloc *)
+    riscv_pcrel_grow (p->abfd, p->lo_relocs, &p->lo_size, p->lo_count,
+		      sizeof (*entry));
+  if (entry == NULL)
+    return FALSE;
+  p->lo_relocs = entry;
+  p->lo_relocs[p->lo_count++]
+    = (riscv_pcrel_lo_reloc) {input_section, info, howto, reloc, addr,
+			      h, sym, sym_sec, contents};
+  return TRUE;
+}
+
+/* Return the name of the symbol that a reloc against H, or else against
+   the local symbol SYM in SEC, refers to, for use in diagnostics.  */
+
+static const char *
+riscv_reloc_sym_name (bfd *input_bfd, struct elf_link_hash_entry *h,
+		      Elf_Internal_Sym *sym, asection *sec)
+{
+  const char *name;
+
+  if (h != NULL)
+    return h->root.root.string;
+
+  name = bfd_elf_string_from_elf_section (input_bfd,
+					  elf_symtab_hdr (input_bfd).sh_link,
+					  sym->st_name);
+  if (name == NULL || *name == '\0')
+    name = bfd_section_name (input_bfd, sec);
+  return name;
+}
+
+static bfd_boolean
+riscv_resolve_pcrel_lo_relocs (riscv_pcrel_relocs *p)
+{
+  size_t i;
+
+  if (!p->hi_sorted)
+    {
+      qsort (p->hi_relocs, p->hi_count, sizeof (*p->hi_relocs),
+	     riscv_pcrel_hi_reloc_compare);
+      for (i = 1; i < p->hi_count; i++)
+	BFD_ASSERT (p->hi_relocs[i - 1].address != p->hi_relocs[i].address);
+    }
+
+  for (i = 0; i < p->lo_count; i++)
+    {
+      riscv_pcrel_lo_reloc *r = &p->lo_relocs[i];
+      bfd *input_bfd = r->input_section->owner;
+      riscv_pcrel_hi_reloc *entry = riscv_find_pcrel_hi_reloc (p, r->addr);
+
+      if (entry == NULL)
+        {
+	  ((*r->info->callbacks->reloc_overflow)
+	   (r->info, NULL,
+	    riscv_reloc_sym_name (input_bfd, r->h, r->sym, r->sym_sec),
+	    r->howto->name, (bfd_vma) 0, input_bfd, r->input_section,
+	    r->reloc->r_offset));
+	  return TRUE;
+        }
+
+      perform_relocation (r->howto, r->reloc, entry->value, r->input_section,
+			  input_bfd, r->contents);
+    }
+
+  return TRUE;
+}
+
+/* Relocate a RISC-V ELF section.
+
+   The RELOCATE_SECTION function is called by the new ELF backend linker
+   to handle the relocations for a section.
+
+   The relocs are always passed as Rela structures.
+
+   This function is responsible for adjusting the section contents as
+   necessary, and (if generating a relocatable output file) adjusting
+   the reloc addend as necessary.
+
+   This function does not have to worry about setting the reloc
+   address or the reloc symbol index.
+
+   LOCAL_SYMS is a pointer to the swapped in local symbols.
+
+   LOCAL_SECTIONS is an array giving the section in the input file
+   corresponding to the st_shndx field of each local symbol.
+
+   The global hash table entry for the global symbols can be found
+   via elf_sym_hashes (input_bfd).
+
+   When generating relocatable output, this function must handle
+   STB_LOCAL/STT_SECTION symbols specially.  The output symbol is
+   going to be the section symbol corresponding to the output
+   section, which means that the addend must be adjusted
+   accordingly.  */
+
+static bfd_boolean
+riscv_elf_relocate_section (bfd *output_bfd,
+			    struct bfd_link_info *info,
+			    bfd *input_bfd,
+			    asection *input_section,
+			    bfd_byte *contents,
+			    Elf_Internal_Rela *relocs,
+			    Elf_Internal_Sym *local_syms,
+			    asection **local_sections)
+{
+  Elf_Internal_Rela *rel;
+  Elf_Internal_Rela *relend;
+  riscv_pcrel_relocs *pcrel_relocs;
+  asection *sreloc = elf_section_data (input_section)->sreloc;
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (input_bfd);
+  struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (input_bfd);
+  bfd_vma *local_got_offsets = elf_local_got_offsets (input_bfd);
+  bfd_boolean absolute;
+
+  pcrel_relocs = riscv_init_pcrel_relocs (output_bfd, htab);
+  if (pcrel_relocs == NULL)
+    return FALSE;
+
+  relend = relocs + input_section->reloc_count;
+  for (rel = relocs; rel < relend; rel++)
+    {
+      unsigned long r_symndx;
+      struct elf_link_hash_entry *h;
+      Elf_Internal_Sym *sym;
+      asection *sec;
+      bfd_vma relocation;
+      bfd_reloc_status_type r = bfd_reloc_ok;
+      const char *name;
+      bfd_vma off, ie_off;
+      bfd_boolean unresolved_reloc, is_ie = FALSE;
+      bfd_vma pc = sec_addr (input_section) + rel->r_offset;
+      int r_type = ELFNN_R_TYPE (rel->r_info), tls_type;
+      reloc_howto_type *howto = riscv_elf_rtype_to_howto (r_type);
+      const char *msg = NULL;
+
+      if (r_type == R_RISCV_GNU_VTINHERIT || r_type == R_RISCV_GNU_VTENTRY)
+	continue;
+
+      /* This is a final link.  */
+      r_symndx = ELFNN_R_SYM (rel->r_info);
+      h = NULL;
+      sym = NULL;
+      sec = NULL;
+      unresolved_reloc = FALSE;
+      if (r_symndx < symtab_hdr->sh_info)
+	{
+	  sym = local_syms + r_symndx;
+	  sec = local_sections[r_symndx];
+	  relocation = _bfd_elf_rela_local_sym (output_bfd, sym, &sec, rel);
+	}
+      else
+	{
+	  bfd_boolean warned, ignored;
+
+	  RELOC_FOR_GLOBAL_SYMBOL (info, input_bfd, input_section, rel,
+				   r_symndx, symtab_hdr, sym_hashes,
+				   h, sec, relocation,
+				   unresolved_reloc, warned, ignored);
+	  if (warned)
+	    {
+	      /* To avoid generating warning messages about truncated
+		 relocations, set the relocation's address to be the same as
+		 the start of this section.  */
+	      if (input_section->output_section != NULL)
+		relocation = input_section->output_section->vma;
+	      else
+		relocation = 0;
+	    }
+	}
+
+      if (sec != NULL && discarded_section (sec))
+	RELOC_AGAINST_DISCARDED_SECTION (info, input_bfd, input_section,
+					 rel, 1, relend, howto, 0, contents);
+
+      if (bfd_link_relocatable (info))
+	continue;
+
+      switch (r_type)
+	{
+	case R_RISCV_ALIGN:
+	  /* Relaxation has left just the padding that is needed.  */
+	  rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+	  continue;
+
+	case R_RISCV_NONE:
+	case R_RISCV_RELAX:
+	case R_RISCV_TPREL_ADD:
+	case R_RISCV_COPY:
+	case R_RISCV_JUMP_SLOT:
+	case R_RISCV_RELATIVE:
+	  /* These require nothing of us at all.  */
+	  continue;
+
+	case R_RISCV_HI20:
+	case R_RISCV_BRANCH:
+	case R_RISCV_RVC_BRANCH:
+	case R_RISCV_RVC_LUI:
+	case R_RISCV_LO12_I:
+	case R_RISCV_LO12_S:
+	case R_RISCV_SET6:
+	case R_RISCV_SET8:
+	case R_RISCV_SET16:
+	case R_RISCV_SET32:
+	case R_RISCV_32_PCREL:
+	case R_RISCV_DELETE:
+	  /* These require no special handling beyond perform_relocation.  */
+	  break;
+
+	case R_RISCV_GOT_HI20:
+	  if (h != NULL)
+	    {
+	      bfd_boolean dyn, pic;
+
+	      off = h->got.offset;
+	      BFD_ASSERT (off != (bfd_vma) -1);
+	      dyn = elf_hash_table (info)->dynamic_sections_created;
+	      pic = bfd_link_pic (info);
+
+	      if (! WILL_CALL_FINISH_DYNAMIC_SYMBOL (dyn, pic, h)
+		  || (pic && SYMBOL_REFERENCES_LOCAL (info, h)))
+		{
+		  /* This is actually a static link, or it is a
+		     -Bsymbolic link and the symbol is defined
+		     locally, or the symbol was forced to be local
+		     because of a version file.  We must initialize
+		     this entry in the global offset table.  Since the
+		     offset must always be a multiple of the word size,
+		     we use the least significant bit to record whether
+		     we have initialized it already.
+
+		     When doing a dynamic link, we create a .rela.got
+		     relocation entry to initialize the value.  This
 		     is done in the finish_dynamic_symbol routine.  */
 		  if ((off & 1) != 0)
 		    off &= ~1;
 		  else
 		    {
-		      bfd_put_NN (output_bfd, relocation,
+		      bfd_put_NN (output_bfd, relocation,
+				  htab->elf.sgot->contents + off);
+		      h->got.offset |= 1;
+		    }
+		}
+	      else
+		unresolved_reloc = FALSE;
+	    }
+	  else
+	    {
+	      BFD_ASSERT (local_got_offsets != NULL
+			  && local_got_offsets[r_symndx] != (bfd_vma) -1);
+
+	      off = local_got_offsets[r_symndx];
+
+	      /* The offset must always be a multiple of the word size.
+		 So, we can use the least significant bit to record
+		 whether we have already processed this entry.  */
+	      if ((off & 1) != 0)
+		off &= ~1;
+	      else
+		{
+		  if (bfd_link_pic (info))
+		    {
+		      asection *s;
+		      Elf_Internal_Rela outrel;
+
+		      /* We need to generate a R_RISCV_RELATIVE reloc
+			 for the dynamic linker.  */
+		      s = htab->elf.srelgot;
+		      BFD_ASSERT (s != NULL);
+
+		      outrel.r_offset = sec_addr (htab->elf.sgot) + off;
+		      outrel.r_info =
+			ELFNN_R_INFO (0, R_RISCV_RELATIVE);
+		      outrel.r_addend = relocation;
+		      relocation = 0;
+		      riscv_elf_append_rela (output_bfd, s, &outrel);
+		    }
+
+		  bfd_put_NN (output_bfd, relocation,
+			      htab->elf.sgot->contents + off);
+		  local_got_offsets[r_symndx] |= 1;
+		}
+	    }
+	  relocation = sec_addr (htab->elf.sgot) + off;
+	  absolute = riscv_zero_pcrel_hi_reloc (rel,
+						info,
+						pc,
+						relocation,
+						contents,
+						howto,
+						input_bfd);
+	  r_type = ELFNN_R_TYPE (rel->r_info);
+	  howto = riscv_elf_rtype_to_howto (r_type);
+	  if (!riscv_record_pcrel_hi_reloc (pcrel_relocs, pc,
+					    relocation, absolute))
+	    r = bfd_reloc_overflow;
+	  break;
+
+	case R_RISCV_ADD8:
+	case R_RISCV_ADD16:
+	case R_RISCV_ADD32:
+	case R_RISCV_ADD64:
+	  {
+	    bfd_vma old_value = bfd_get (howto->bitsize, input_bfd,
+					 contents + rel->r_offset);
+	    relocation = old_value + relocation;
+	  }
+	  break;
+
+	case R_RISCV_SUB6:
+	case R_RISCV_SUB8:
+	case R_RISCV_SUB16:
+	case R_RISCV_SUB32:
+	case R_RISCV_SUB64:
+	  {
+	    bfd_vma old_value = bfd_get (howto->bitsize, input_bfd,
+					 contents + rel->r_offset);
+	    relocation = old_value - relocation;
+	  }
+	  break;
+
+	case R_RISCV_CALL_PLT:
+	case R_RISCV_CALL:
+	case R_RISCV_JAL:
+	case R_RISCV_RVC_JUMP:
+	  if (bfd_link_pic (info) && h != NULL && h->plt.offset != MINUS_ONE)
+	    {
+	      /* Refer to the PLT entry.  */
+	      relocation = sec_addr (htab->elf.splt) + h->plt.offset;
+	      unresolved_reloc = FALSE;
+	    }
+	  break;
+
+	case R_RISCV_TPREL_HI20:
+	  relocation = tpoff (info, relocation);
+	  break;
+
+	case R_RISCV_TPREL_LO12_I:
+	case R_RISCV_TPREL_LO12_S:
+	  relocation = tpoff (info, relocation);
+	  break;
+
+	case R_RISCV_TPREL_I:
+	case R_RISCV_TPREL_S:
+	  relocation = tpoff (info, relocation);
+	  if (VALID_ITYPE_IMM (relocation + rel->r_addend))
+	    {
+	      /* We can use tp as the base register.  */
+	      bfd_vma insn = bfd_get_32 (input_bfd, contents + rel->r_offset);
+	      insn &= ~(OP_MASK_RS1 << OP_SH_RS1);
+	      insn |= X_TP << OP_SH_RS1;
+	      bfd_put_32 (input_bfd, insn, contents + rel->r_offset);
+	    }
+	  else
+	    r = bfd_reloc_overflow;
+	  break;
+
+	case R_RISCV_GPREL_I:
+	case R_RISCV_GPREL_S:
+	  {
+	    bfd_vma gp = riscv_global_pointer_value (info);
+	    bfd_boolean x0_base = VALID_ITYPE_IMM (relocation + rel->r_addend);
+	    if (x0_base || VALID_ITYPE_IMM (relocation + rel->r_addend - gp))
+	      {
+		/* We can use x0 or gp as the base register.  */
+		bfd_vma insn = bfd_get_32 (input_bfd, contents + rel->r_offset);
+		insn &= ~(OP_MASK_RS1 << OP_SH_RS1);
+		if (!x0_base)
+		  {
+		    rel->r_addend -= gp;
+		    insn |= X_GP << OP_SH_RS1;
+		  }
+		bfd_put_32 (input_bfd, insn, contents + rel->r_offset);
+	      }
+	    else
+	      r = bfd_reloc_overflow;
+	    break;
+	  }
+
+	case R_RISCV_PCREL_HI20:
+	  absolute = riscv_zero_pcrel_hi_reloc (rel,
+						info,
+						pc,
+						relocation,
+						contents,
+						howto,
+						input_bfd);
+	  r_type = ELFNN_R_TYPE (rel->r_info);
+	  howto = riscv_elf_rtype_to_howto (r_type);
+	  if (!riscv_record_pcrel_hi_reloc (pcrel_relocs, pc,
+					    relocation + rel->r_addend,
+					    absolute))
+	    r = bfd_reloc_overflow;
+	  break;
+
+	case R_RISCV_PCREL_LO12_I:
+	case R_RISCV_PCREL_LO12_S:
+	  if (riscv_record_pcrel_lo_reloc (pcrel_relocs, input_section, info,
+					   howto, rel, relocation, h, sym, sec,
+					   contents))
+	    continue;
+	  r = bfd_reloc_overflow;
+	  break;
+
+	case R_RISCV_TLS_DTPREL32:
+	case R_RISCV_TLS_DTPREL64:
+	  relocation = dtpoff (info, relocation);
+	  break;
+
+	case R_RISCV_32:
+	case R_RISCV_64:
+	  if ((input_section->flags & SEC_ALLOC) == 0)
+	    break;
+
+	  if ((bfd_link_pic (info)
+	       && (h == NULL
+		   || ELF_ST_VISIBILITY (h->other) == STV_DEFAULT
+		   || h->root.type != bfd_link_hash_undefweak)
+	       && (! howto->pc_relative
+		   || !SYMBOL_CALLS_LOCAL (info, h)))
+	      || (!bfd_link_pic (info)
+		  && h != NULL
+		  && h->dynindx != -1
+		  && !h->non_got_ref
+		  && ((h->def_dynamic
+		       && !h->def_regular)
+		      || h->root.type == bfd_link_hash_undefweak
+		      || h->root.type == bfd_link_hash_undefined)))
+	    {
+	      Elf_Internal_Rela outrel;
+	      bfd_boolean skip_static_relocation, skip_dynamic_relocation;
+
+	      /* When generating a shared object, these relocations
+		 are copied into the output file to be resolved at run
+		 time.  */
+
+	      outrel.r_offset =
+		_bfd_elf_section_offset (output_bfd, info, input_section,
+					 rel->r_offset);
+	      skip_static_relocation = outrel.r_offset != (bfd_vma) -2;
+	      skip_dynamic_relocation = outrel.r_offset >= (bfd_vma) -2;
+	      outrel.r_offset += sec_addr (input_section);
+
+	      if (skip_dynamic_relocation)
+		memset (&outrel, 0, sizeof outrel);
+	      else if (!riscv_elf_relative_reloc_p (info, h))
+		{
+		  outrel.r_info = ELFNN_R_INFO (h->dynindx, r_type);
+		  outrel.r_addend = rel->r_addend;
+		}
+	      else if (riscv_elf_relr_reloc_p (htab, input_section, rel))
+		{
+		  /* The dynamic linker adds the load address to this word
+		     as directed by .relr.dyn, so it holds the link-time
+		     address instead.  */
+		  htab->relr_emitted++;
+		  break;
+		}
+	      else
+		{
+		  outrel.r_info = ELFNN_R_INFO (0, R_RISCV_RELATIVE);
+		  outrel.r_addend = relocation + rel->r_addend;
+		}
+
+	      riscv_elf_append_rela (output_bfd, sreloc, &outrel);
+	      if (skip_static_relocation)
+		continue;
+	    }
+	  break;
+
+	case R_RISCV_TLS_GOT_HI20:
+	  is_ie = TRUE;
+	  /* Fall through.  */
+
+	case R_RISCV_TLS_GD_HI20:
+	  if (h != NULL)
+	    {
+	      off = h->got.offset;
+	      h->got.offset |= 1;
+	    }
+	  else
+	    {
+	      off = local_got_offsets[r_symndx];
+	      local_got_offsets[r_symndx] |= 1;
+	    }
+
+	  tls_type = _bfd_riscv_elf_tls_type (input_bfd, h, r_symndx);
+	  BFD_ASSERT (tls_type & (GOT_TLS_IE | GOT_TLS_GD));
+	  /* If this symbol is referenced by both GD and IE TLS, the IE
+	     reference's GOT slot follows the GD reference's slots.  */
+	  ie_off = 0;
+	  if ((tls_type & GOT_TLS_GD) && (tls_type & GOT_TLS_IE))
+	    ie_off = 2 * GOT_ENTRY_SIZE;
+
+	  if ((off & 1) != 0)
+	    off &= ~1;
+	  else
+	    {
+	      Elf_Internal_Rela outrel;
+	      int indx = 0;
+	      bfd_boolean need_relocs = FALSE;
+
+	      if (htab->elf.srelgot == NULL)
+		abort ();
+
+	      if (h != NULL)
+		{
+		  bfd_boolean dyn, pic;
+		  dyn = htab->elf.dynamic_sections_created;
+		  pic = bfd_link_pic (info);
+
+		  if (WILL_CALL_FINISH_DYNAMIC_SYMBOL (dyn, pic, h)
+		      && (!pic || !SYMBOL_REFERENCES_LOCAL (info, h)))
+		    indx = h->dynindx;
+		}
+
+	      /* The GOT entries have not been initialized yet.  Do it
+	         now, and emit any relocations.  */
+	      if ((bfd_link_pic (info) || indx != 0)
+		  && (h == NULL
+		      || ELF_ST_VISIBILITY (h->other) == STV_DEFAULT
+		      || h->root.type != bfd_link_hash_undefweak))
+		    need_relocs = TRUE;
+
+	      if (tls_type & GOT_TLS_GD)
+		{
+		  if (need_relocs)
+		    {
+		      outrel.r_offset = sec_addr (htab->elf.sgot) + off;
+		      outrel.r_addend = 0;
+		      outrel.r_info = ELFNN_R_INFO (indx, R_RISCV_TLS_DTPMODNN);
+		      bfd_put_NN (output_bfd, 0,
+				  htab->elf.sgot->contents + off);
+		      riscv_elf_append_rela (output_bfd, htab->elf.srelgot, &outrel);
+		      if (indx == 0)
+			{
+			  BFD_ASSERT (! unresolved_reloc);
+			  bfd_put_NN (output_bfd,
+				      dtpoff (info, relocation),
+				      (htab->elf.sgot->contents + off +
+				       RISCV_ELF_WORD_BYTES));
+			}
+		      else
+			{
+			  bfd_put_NN (output_bfd, 0,
+				      (htab->elf.sgot->contents + off +
+				       RISCV_ELF_WORD_BYTES));
+			  outrel.r_info = ELFNN_R_INFO (indx, R_RISCV_TLS_DTPRELNN);
+			  outrel.r_offset += RISCV_ELF_WORD_BYTES;
+			  riscv_elf_append_rela (output_bfd, htab->elf.srelgot, &outrel);
+			}
+		    }
+		  else
+		    {
+		      /* If we are not emitting relocations for a
+			 general dynamic reference, then we must be in a
+			 static link or an executable link with the
+			 symbol binding locally.  Mark it as belonging
+			 to module 1, the executable.  */
+		      bfd_put_NN (output_bfd, 1,
 				  htab->elf.sgot->contents + off);
-		      h->got.offset |= 1;
+		      bfd_put_NN (output_bfd,
+				  dtpoff (info, relocation),
+				  (htab->elf.sgot->contents + off +
+				   RISCV_ELF_WORD_BYTES));
+		   }
+		}
+
+	      if (tls_type & GOT_TLS_IE)
+		{
+		  if (need_relocs)
+		    {
+		      bfd_put_NN (output_bfd, 0,
+				  htab->elf.sgot->contents + off + ie_off);
+		      outrel.r_offset = sec_addr (htab->elf.sgot)
+				       + off + ie_off;
+		      outrel.r_addend = 0;
+		      if (indx == 0)
+			outrel.r_addend = tpoff (info, relocation);
+		      outrel.r_info = ELFNN_R_INFO (indx, R_RISCV_TLS_TPRELNN);
+		      riscv_elf_append_rela (output_bfd, htab->elf.srelgot, &outrel);
+		    }
+		  else
+		    {
+		      bfd_put_NN (output_bfd, tpoff (info, relocation),
+				  htab->elf.sgot->contents + off + ie_off);
 		    }
 		}
-	      else
-		unresolved_reloc = FALSE;
 	    }
-	  else
+
+	  BFD_ASSERT (off < (bfd_vma) -2);
+	  relocation = sec_addr (htab->elf.sgot) + off + (is_ie ? ie_off : 0);
+	  if (!riscv_record_pcrel_hi_reloc (pcrel_relocs, pc,
+					    relocation, FALSE))
+	    r = bfd_reloc_overflow;
+	  unresolved_reloc = FALSE;
+	  break;
+
+	default:
+	  r = bfd_reloc_notsupported;
+	}
+
+      /* Dynamic relocs are not propagated for SEC_DEBUGGING sections
+	 because such sections are not SEC_ALLOC and thus ld.so will
+	 not process them.  */
+      if (unresolved_reloc
+	  && !((input_section->flags & SEC_DEBUGGING) != 0
+	       && h->def_dynamic)
+	  && _bfd_elf_section_offset (output_bfd, info, input_section,
+				      rel->r_offset) != (bfd_vma) -1)
+	{
+	  (*_bfd_error_handler)
+	    (_("%B(%A+0x%lx): unresolvable %s relocation against symbol `%s'"),
+	     input_bfd,
+	     input_section,
+	     (long) rel->r_offset,
+	     howto->name,
+	     h->root.root.string);
+	  continue;
+	}
+
+      if (r == bfd_reloc_ok)
+	r = perform_relocation (howto, rel, relocation, input_section,
+				input_bfd, contents);
+
+      /* A call that cannot reach its target may still reach a call
+	 island that does.  */
+      if (r == bfd_reloc_overflow
+	  && (r_type == R_RISCV_JAL || r_type == R_RISCV_RVC_JUMP))
+	r = riscv_relocate_via_call_island (htab, howto, rel, input_section,
+					    input_bfd, contents);
+
+      if (r == bfd_reloc_ok)
+	continue;
+
+      /* Only diagnostics need the symbol name.  */
+      name = riscv_reloc_sym_name (input_bfd, h, sym, sec);
+      switch (r)
+	{
+	case bfd_reloc_overflow:
+	  info->callbacks->reloc_overflow
+	    (info, (h ? &h->root : NULL), name, howto->name,
+	     (bfd_vma) 0, input_bfd, input_section, rel->r_offset);
+	  break;
+
+	case bfd_reloc_undefined:
+	  info->callbacks->undefined_symbol
+	    (info, name, input_bfd, input_section, rel->r_offset,
+	     TRUE);
+	  break;
+
+	case bfd_reloc_outofrange:
+	  msg = _("internal error: out of range error");
+	  break;
+
+	case bfd_reloc_notsupported:
+	  msg = _("internal error: unsupported relocation error");
+	  break;
+
+	case bfd_reloc_dangerous:
+	  msg = _("internal error: dangerous relocation");
+	  break;
+
+	default:
+	  msg = _("internal error: unknown error");
+	  break;
+	}
+
+      if (msg)
+	info->callbacks->warning
+	  (info, msg, name, input_bfd, input_section, rel->r_offset);
+      return FALSE;
+    }
+
+  return riscv_resolve_pcrel_lo_relocs (pcrel_relocs);
+}
+
+/* Finish up dynamic symbol handling.  We set the contents of various
+   dynamic sections here.  */
+
+static bfd_boolean
+riscv_elf_finish_dynamic_symbol (bfd *output_bfd,
+				 struct bfd_link_info *info,
+				 struct elf_link_hash_entry *h,
+				 Elf_Internal_Sym *sym)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
+
+  if (h->plt.offset != (bfd_vma) -1)
+    {
+      /* We've decided to create a PLT entry for this symbol.  */
+      bfd_byte *loc;
+      bfd_vma i, header_address, plt_idx, got_address;
+      uint32_t plt_entry[PLT_ENTRY_INSNS];
+      Elf_Internal_Rela rela;
+
+      BFD_ASSERT (h->dynindx != -1);
+
+      /* Calculate the address of the PLT header.  */
+      header_address = sec_addr (htab->elf.splt);
+
+      if (riscv_elf_hash_entry (h)->plt_got)
+	/* Load the address from the symbol's own GOT entry, which is set
+	   up below.  */
+	got_address = (sec_addr (htab->elf.sgot)
+		       + (h->got.offset & ~(bfd_vma) 1));
+      else
+	{
+	  /* Calculate the index of the entry.  */
+	  plt_idx = (h->plt.offset - PLT_HEADER_SIZE) / PLT_ENTRY_SIZE;
+
+	  /* Calculate the address of the .got.plt entry.  */
+	  got_address = riscv_elf_got_plt_val (plt_idx, info);
+
+	  /* Fill in the initial value of the .got.plt entry.  Even -z now
+	     links point it at the PLT header: the dynamic linker may still
+	     bind the entry lazily, as glibc does when profiling or
+	     auditing.  */
+	  loc = htab->elf.sgotplt->contents
+		+ (got_address - sec_addr (htab->elf.sgotplt));
+	  bfd_put_NN (output_bfd, sec_addr (htab->elf.splt), loc);
+
+	  /* Fill in the entry in the .rela.plt section.  */
+	  rela.r_offset = got_address;
+	  rela.r_addend = 0;
+	  rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_JUMP_SLOT);
+
+	  loc = (htab->elf.srelplt->contents
+		 + plt_idx * sizeof (ElfNN_External_Rela));
+	  bed->s->swap_reloca_out (output_bfd, &rela, loc);
+	}
+
+      /* Find out where the .plt entry should go.  */
+      loc = htab->elf.splt->contents + h->plt.offset;
+
+      /* Fill in the PLT entry itself.  */
+      riscv_make_plt_entry (got_address, header_address + h->plt.offset,
+			    plt_entry);
+      for (i = 0; i < PLT_ENTRY_INSNS; i++)
+	bfd_put_32 (output_bfd, plt_entry[i], loc + 4*i);
+
+      if (!h->def_regular)
+	{
+	  /* Mark the symbol as undefined, rather than as defined in
+	     the .plt section.  Leave the value alone.  */
+	  sym->st_shndx = SHN_UNDEF;
+	  /* If the symbol is weak, we do need to clear the value.
+	     Otherwise, the PLT entry would provide a definition for
+	     the symbol even if the symbol wasn't defined anywhere,
+	     and so the symbol would never be NULL.  */
+	  if (!h->ref_regular_nonweak)
+	    sym->st_value = 0;
+	}
+    }
+
+  if (h->got.offset != (bfd_vma) -1
+      && !(riscv_elf_hash_entry (h)->tls_type & (GOT_TLS_GD | GOT_TLS_IE)))
+    {
+      asection *sgot;
+      asection *srela;
+      Elf_Internal_Rela rela;
+
+      /* This symbol has an entry in the GOT.  Set it up.  */
+
+      sgot = htab->elf.sgot;
+      srela = htab->elf.srelgot;
+      BFD_ASSERT (sgot != NULL && srela != NULL);
+
+      rela.r_offset = sec_addr (sgot) + (h->got.offset &~ (bfd_vma) 1);
+
+      /* If this is a -Bsymbolic link, and the symbol is defined
+	 locally, we just want to emit a RELATIVE reloc.  Likewise if
+	 the symbol was forced to be local because of a version file.
+	 The entry in the global offset table will already have been
+	 initialized in the relocate_section function.  */
+      if (bfd_link_pic (info)
+	  && (info->symbolic || h->dynindx == -1)
+	  && h->def_regular)
+	{
+	  asection *sec = h->root.u.def.section;
+	  rela.r_info = ELFNN_R_INFO (0, R_RISCV_RELATIVE);
+	  rela.r_addend = (h->root.u.def.value
+			   + sec->output_section->vma
+			   + sec->output_offset);
+	}
+      else
+	{
+	  BFD_ASSERT (h->dynindx != -1);
+	  rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_NN);
+	  rela.r_addend = 0;
+	}
+
+      bfd_put_NN (output_bfd, 0,
+		  sgot->contents + (h->got.offset & ~(bfd_vma) 1));
+      riscv_elf_append_rela (output_bfd, srela, &rela);
+    }
+
+  if (h->needs_copy)
+    {
+      Elf_Internal_Rela rela;
+      asection *s;
+
+      /* This symbols needs a copy reloc.  Set it up.  */
+      BFD_ASSERT (h->dynindx != -1);
+
+      rela.r_offset = sec_addr (h->root.u.def.section) + h->root.u.def.value;
+      rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_COPY);
+      rela.r_addend = 0;
+      if (h->root.u.def.section == htab->elf.sdynrelro)
+	s = htab->elf.sreldynrelro;
+      else
+	s = htab->elf.srelbss;
+      riscv_elf_append_rela (output_bfd, s, &rela);
+    }
+
+  /* Mark some specially defined symbols as absolute.  */
+  if (h == htab->elf.hdynamic
+      || (h == htab->elf.hgot || h == htab->elf.hplt))
+    sym->st_shndx = SHN_ABS;
+
+  return TRUE;
+}
+
+/* Finish up the dynamic sections.  */
+
+static bfd_boolean
+riscv_finish_dyn (bfd *output_bfd, struct bfd_link_info *info,
+		  bfd *dynobj, asection *sdyn)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
+  size_t dynsize = bed->s->sizeof_dyn;
+  bfd_byte *dyncon, *dynconend;
+
+  dynconend = sdyn->contents + sdyn->size;
+  for (dyncon = sdyn->contents; dyncon < dynconend; dyncon += dynsize)
+    {
+      Elf_Internal_Dyn dyn;
+      asection *s;
+
+      bed->s->swap_dyn_in (dynobj, dyncon, &dyn);
+
+      switch (dyn.d_tag)
+	{
+	case DT_PLTGOT:
+	  s = htab->elf.sgotplt;
+	  dyn.d_un.d_ptr = s->output_section->vma + s->output_offset;
+	  break;
+	case DT_JMPREL:
+	  s = htab->elf.srelplt;
+	  dyn.d_un.d_ptr = s->output_section->vma + s->output_offset;
+	  break;
+	case DT_PLTRELSZ:
+	  s = htab->elf.srelplt;
+	  dyn.d_un.d_val = s->size;
+	  break;
+	case DT_RELR:
+	  s = htab->srelr;
+	  dyn.d_un.d_ptr = s->output_section->vma + s->output_offset;
+	  break;
+	case DT_RELRSZ:
+	  dyn.d_un.d_val = htab->relr_size;
+	  break;
+	default:
+	  continue;
+	}
+
+      bed->s->swap_dyn_out (output_bfd, &dyn, dyncon);
+    }
+  return TRUE;
+}
+
+/* What riscv_build_call_island_stubs needs.  */
+
+struct riscv_build_call_islands_info
+{
+  struct riscv_elf_link_hash_table *htab;
+  bfd_boolean failed;
+};
+
+/* Fill in the call island stubs of one target.  DATA points to a
+   riscv_build_call_islands_info, whose FAILED is set on error.  */
+
+static int
+riscv_build_call_island_stubs (void **slot, void *data)
+{
+  struct riscv_call_island_target *target
+    = (struct riscv_call_island_target *) *slot;
+  struct riscv_build_call_islands_info *binfo
+    = (struct riscv_build_call_islands_info *) data;
+  struct riscv_elf_link_hash_table *htab = binfo->htab;
+  struct riscv_call_island_stub *stub;
+  asection *sym_sec;
+  bfd_vma symval;
+
+  symval = riscv_call_island_symval (htab, target->h, target->abfd,
+				     target->r_symndx, &sym_sec);
+  if (symval == MINUS_ONE)
+    return 1;
+  symval += target->addend;
+
+  for (stub = target->stubs; stub != NULL; stub = stub->next)
+    {
+      asection *island = stub->island;
+      bfd_vma addr = sec_addr (island) + stub->offset;
+
+      if (island->contents == NULL)
+	{
+	  island->contents = (bfd_byte *) bfd_zalloc (island->owner,
+						      island->size);
+	  if (island->contents == NULL)
 	    {
-	      BFD_ASSERT (local_got_offsets != NULL
-			  && local_got_offsets[r_symndx] != (bfd_vma) -1);
+	      binfo->failed = TRUE;
+	      return 0;
+	    }
+	}
+
+      if (ARCH_SIZE > 32
+	  && !VALID_UTYPE_IMM (RISCV_CONST_HIGH_PART (symval - addr)))
+	{
+	  (*_bfd_error_handler)
+	    (_("%A+0x%lx: call island stub cannot reach its target"),
+	     island, (long) stub->offset);
+	  bfd_set_error (bfd_error_bad_value);
+	  binfo->failed = TRUE;
+	  return 0;
+	}
 
-	      off = local_got_offsets[r_symndx];
+      bfd_put_32 (island->owner,
+		  RISCV_UTYPE (AUIPC, X_T1, RISCV_PCREL_HIGH_PART (symval,
+								   addr)),
+		  island->contents + stub->offset);
+      bfd_put_32 (island->owner,
+		  RISCV_ITYPE (JALR, 0, X_T1, RISCV_PCREL_LOW_PART (symval,
+								    addr)),
+		  island->contents + stub->offset + 4);
+    }
 
-	      /* The offset must always be a multiple of the word size.
-		 So, we can use the least significant bit to record
-		 whether we have already processed this entry.  */
-	      if ((off & 1) != 0)
-		off &= ~1;
-	      else
-		{
-		  if (bfd_link_pic (info))
-		    {
-		      asection *s;
-		      Elf_Internal_Rela outrel;
+  return 1;
+}
 
-		      /* We need to generate a R_RISCV_RELATIVE reloc
-			 for the dynamic linker.  */
-		      s = htab->elf.srelgot;
-		      BFD_ASSERT (s != NULL);
+static bfd_boolean
+riscv_elf_finish_dynamic_sections (bfd *output_bfd,
+				   struct bfd_link_info *info)
+{
+  bfd *dynobj;
+  asection *sdyn;
+  struct riscv_elf_link_hash_table *htab;
 
-		      outrel.r_offset = sec_addr (htab->elf.sgot) + off;
-		      outrel.r_info =
-			ELFNN_R_INFO (0, R_RISCV_RELATIVE);
-		      outrel.r_addend = relocation;
-		      relocation = 0;
-		      riscv_elf_append_rela (output_bfd, s, &outrel);
-		    }
+  htab = riscv_elf_hash_table (info);
+  BFD_ASSERT (htab != NULL);
+  dynobj = htab->elf.dynobj;
 
-		  bfd_put_NN (output_bfd, relocation,
-			      htab->elf.sgot->contents + off);
-		  local_got_offsets[r_symndx] |= 1;
-		}
-	    }
-	  relocation = sec_addr (htab->elf.sgot) + off;
-	  absolute = riscv_zero_pcrel_hi_reloc (rel,
-						info,
-						pc,
-						relocation,
-						contents,
-						howto,
-						input_bfd);
-	  r_type = ELFNN_R_TYPE (rel->r_info);
-	  howto = riscv_elf_rtype_to_howto (r_type);
-	  if (!riscv_record_pcrel_hi_reloc (&pcrel_relocs, pc,
-					    relocation, absolute))
-	    r = bfd_reloc_overflow;
-	  break;
+  sdyn = bfd_get_linker_section (dynobj, ".dynamic");
 
-	case R_RISCV_ADD8:
-	case R_RISCV_ADD16:
-	case R_RISCV_ADD32:
-	case R_RISCV_ADD64:
-	  {
-	    bfd_vma old_value = bfd_get (howto->bitsize, input_bfd,
-					 contents + rel->r_offset);
-	    relocation = old_value + relocation;
-	  }
-	  break;
+  if (htab->call_island_targets != NULL)
+    {
+      struct riscv_build_call_islands_info binfo;
 
-	case R_RISCV_SUB6:
-	case R_RISCV_SUB8:
-	case R_RISCV_SUB16:
-	case R_RISCV_SUB32:
-	case R_RISCV_SUB64:
-	  {
-	    bfd_vma old_value = bfd_get (howto->bitsize, input_bfd,
-					 contents + rel->r_offset);
-	    relocation = old_value - relocation;
-	  }
-	  break;
+      binfo.htab = htab;
+      binfo.failed = FALSE;
+      htab_traverse (htab->call_island_targets,
+		     riscv_build_call_island_stubs, &binfo);
+      if (binfo.failed)
+	return FALSE;
+    }
 
-	case R_RISCV_CALL_PLT:
-	case R_RISCV_CALL:
-	case R_RISCV_JAL:
-	case R_RISCV_RVC_JUMP:
-	  if (bfd_link_pic (info) && h != NULL && h->plt.offset != MINUS_ONE)
+  if (elf_hash_table (info)->dynamic_sections_created)
+    {
+      asection *splt;
+      bfd_boolean ret;
+
+      splt = htab->elf.splt;
+      BFD_ASSERT (splt != NULL && sdyn != NULL);
+
+      if (htab->relr_count != 0)
+	{
+	  if (htab->relr_emitted != htab->relr_count
+	      || htab->relr_addrs == NULL)
 	    {
-	      /* Refer to the PLT entry.  */
-	      relocation = sec_addr (htab->elf.splt) + h->plt.offset;
-	      unresolved_reloc = FALSE;
+	      (*_bfd_error_handler)
+		(_("%B: packed relative relocs do not match their sizing"),
+		 output_bfd);
+	      bfd_set_error (bfd_error_bad_value);
+	      return FALSE;
 	    }
-	  break;
+	  htab->relr_size = riscv_elf_encode_relr (output_bfd, htab,
+						   htab->srelr->contents);
+	}
 
-	case R_RISCV_TPREL_HI20:
-	  relocation = tpoff (info, relocation);
-	  break;
+      ret = riscv_finish_dyn (output_bfd, info, dynobj, sdyn);
 
-	case R_RISCV_TPREL_LO12_I:
-	case R_RISCV_TPREL_LO12_S:
-	  relocation = tpoff (info, relocation);
-	  break;
+      if (!ret)
+	return ret;
 
-	case R_RISCV_TPREL_I:
-	case R_RISCV_TPREL_S:
-	  relocation = tpoff (info, relocation);
-	  if (VALID_ITYPE_IMM (relocation + rel->r_addend))
+      /* Fill in the head and tail entries in the procedure linkage table.  */
+      if (splt->size > 0)
+	{
+	  int i;
+	  uint32_t plt_header[PLT_HEADER_INSNS];
+
+	  /* Only the entries with a .got.plt entry need the header, and
+	     the entries that load from the GOT come after it.  */
+	  if (htab->elf.srelplt->size != 0)
 	    {
-	      /* We can use tp as the base register.  */
-	      bfd_vma insn = bfd_get_32 (input_bfd, contents + rel->r_offset);
-	      insn &= ~(OP_MASK_RS1 << OP_SH_RS1);
-	      insn |= X_TP << OP_SH_RS1;
-	      bfd_put_32 (input_bfd, insn, contents + rel->r_offset);
+	      riscv_make_plt_header (sec_addr (htab->elf.sgotplt),
+				     sec_addr (splt), plt_header);
+
+	      for (i = 0; i < PLT_HEADER_INSNS; i++)
+		bfd_put_32 (output_bfd, plt_header[i], splt->contents + 4*i);
 	    }
-	  else
-	    r = bfd_reloc_overflow;
-	  break;
 
-	case R_RISCV_GPREL_I:
-	case R_RISCV_GPREL_S:
-	  {
-	    bfd_vma gp = riscv_global_pointer_value (info);
-	    bfd_boolean x0_base = VALID_ITYPE_IMM (relocation + rel->r_addend);
-	    if (x0_base || VALID_ITYPE_IMM (relocation + rel->r_addend - gp))
-	      {
-		/* We can use x0 or gp as the base register.  */
-		bfd_vma insn = bfd_get_32 (input_bfd, contents + rel->r_offset);
-		insn &= ~(OP_MASK_RS1 << OP_SH_RS1);
-		if (!x0_base)
-		  {
-		    rel->r_addend -= gp;
-		    insn |= X_GP << OP_SH_RS1;
-		  }
-		bfd_put_32 (input_bfd, insn, contents + rel->r_offset);
-	      }
-	    else
-	      r = bfd_reloc_overflow;
-	    break;
-	  }
+	  elf_section_data (splt->output_section)->this_hdr.sh_entsize
+	    = PLT_ENTRY_SIZE;
+	}
+    }
+
+  if (htab->elf.sgotplt)
+    {
+      asection *output_section = htab->elf.sgotplt->output_section;
+
+      if (bfd_is_abs_section (output_section))
+	{
+	  (*_bfd_error_handler)
+	    (_("discarded output section: `%A'"), htab->elf.sgotplt);
+	  return FALSE;
+	}
+
+      if (htab->elf.sgotplt->size > 0)
+	{
+	  /* Write the first two entries in .got.plt, needed for the dynamic
+	     linker.  */
+	  bfd_put_NN (output_bfd, (bfd_vma) -1, htab->elf.sgotplt->contents);
+	  bfd_put_NN (output_bfd, (bfd_vma) 0,
+		      htab->elf.sgotplt->contents + GOT_ENTRY_SIZE);
+	}
+
+      elf_section_data (output_section)->this_hdr.sh_entsize = GOT_ENTRY_SIZE;
+    }
+
+  if (htab->elf.sgot)
+    {
+      asection *output_section = htab->elf.sgot->output_section;
+
+      if (htab->elf.sgot->size > 0)
+	{
+	  /* Set the first entry in the global offset table to the address of
+	     the dynamic section.  */
+	  bfd_vma val = sdyn ? sec_addr (sdyn) : 0;
+	  bfd_put_NN (output_bfd, val, htab->elf.sgot->contents);
+	}
+
+      elf_section_data (output_section)->this_hdr.sh_entsize = GOT_ENTRY_SIZE;
+    }
+
+  return TRUE;
+}
+
+/* Return address for Ith PLT stub in section PLT, for relocation REL
+   or (bfd_vma) -1 if it should not be included.  */
+
+static bfd_vma
+riscv_elf_plt_sym_val (bfd_vma i, const asection *plt,
+		       const arelent *rel ATTRIBUTE_UNUSED)
+{
+  return plt->vma + PLT_HEADER_SIZE + i * PLT_ENTRY_SIZE;
+}
+
+static enum elf_reloc_type_class
+riscv_reloc_type_class (const struct bfd_link_info *info ATTRIBUTE_UNUSED,
+			const asection *rel_sec ATTRIBUTE_UNUSED,
+			const Elf_Internal_Rela *rela)
+{
+  switch (ELFNN_R_TYPE (rela->r_info))
+    {
+    case R_RISCV_RELATIVE:
+      return reloc_class_relative;
+    case R_RISCV_JUMP_SLOT:
+      return reloc_class_plt;
+    case R_RISCV_COPY:
+      return reloc_class_copy;
+    default:
+      return reloc_class_normal;
+    }
+}
+
+/* Merge backend specific data from an object file to the output
+   object file when linking.  */
+
+static bfd_boolean
+_bfd_riscv_elf_merge_private_bfd_data (bfd *ibfd, struct bfd_link_info *info)
+{
+  bfd *obfd = info->output_bfd;
+  flagword new_flags = elf_elfheader (ibfd)->e_flags;
+  flagword old_flags = elf_elfheader (obfd)->e_flags;
+
+  if (!is_riscv_elf (ibfd) || !is_riscv_elf (obfd))
+    return TRUE;
+
+  if (strcmp (bfd_get_target (ibfd), bfd_get_target (obfd)) != 0)
+    {
+      (*_bfd_error_handler)
+	(_("%B: ABI is incompatible with that of the selected emulation:\n"
+	   "  target emulation `%s' does not match `%s'"),
+	 ibfd, bfd_get_target (ibfd), bfd_get_target (obfd));
+      return FALSE;
+    }
+
+  if (!_bfd_elf_merge_object_attributes (ibfd, info))
+    return FALSE;
+
+  if (! elf_flags_init (obfd))
+    {
+      elf_flags_init (obfd) = TRUE;
+      elf_elfheader (obfd)->e_flags = new_flags;
+      return TRUE;
+    }
+
+  /* Disallow linking different float ABIs.  */
+  if ((old_flags ^ new_flags) & EF_RISCV_FLOAT_ABI)
+    {
+      (*_bfd_error_handler)
+	(_("%B: can't link hard-float modules with soft-float modules"), ibfd);
+      goto fail;
+    }
 
-	case R_RISCV_PCREL_HI20:
-	  absolute = riscv_zero_pcrel_hi_reloc (rel,
-						info,
-						pc,
-						relocation,
-						contents,
-						howto,
-						input_bfd);
-	  r_type = ELFNN_R_TYPE (rel->r_info);
-	  howto = riscv_elf_rtype_to_howto (r_type);
-	  if (!riscv_record_pcrel_hi_reloc (&pcrel_relocs, pc,
-					    relocation + rel->r_addend,
-					    absolute))
-	    r = bfd_reloc_overflow;
-	  break;
+  /* Allow linking RVC and non-RVC, and keep the RVC flag.  */
+  elf_elfheader (obfd)->e_flags |= new_flags & EF_RISCV_RVC;
 
-	case R_RISCV_PCREL_LO12_I:
-	case R_RISCV_PCREL_LO12_S:
-	  if (riscv_record_pcrel_lo_reloc (&pcrel_relocs, input_section, info,
-					   howto, rel, relocation, name,
-					   contents))
-	    continue;
-	  r = bfd_reloc_overflow;
-	  break;
+  return TRUE;
 
-	case R_RISCV_TLS_DTPREL32:
-	case R_RISCV_TLS_DTPREL64:
-	  relocation = dtpoff (info, relocation);
-	  break;
+fail:
+  bfd_set_error (bfd_error_bad_value);
+  return FALSE;
+}
 
-	case R_RISCV_32:
-	case R_RISCV_64:
-	  if ((input_section->flags & SEC_ALLOC) == 0)
-	    break;
+/* Enable or disable the collection of relaxation statistics.  */
 
-	  if ((bfd_link_pic (info)
-	       && (h == NULL
-		   || ELF_ST_VISIBILITY (h->other) == STV_DEFAULT
-		   || h->root.type != bfd_link_hash_undefweak)
-	       && (! howto->pc_relative
-		   || !SYMBOL_CALLS_LOCAL (info, h)))
-	      || (!bfd_link_pic (info)
-		  && h != NULL
-		  && h->dynindx != -1
-		  && !h->non_got_ref
-		  && ((h->def_dynamic
-		       && !h->def_regular)
-		      || h->root.type == bfd_link_hash_undefweak
-		      || h->root.type == bfd_link_hash_undefined)))
-	    {
-	      Elf_Internal_Rela outrel;
-	      bfd_boolean skip_static_relocation, skip_dynamic_relocation;
+void
+bfd_elfNN_riscv_set_relax_stats (struct bfd_link_info *info,
+				 bfd_boolean enable)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
 
-	      /* When generating a shared object, these relocations
-		 are copied into the output file to be resolved at run
-		 time.  */
+  if (htab != NULL)
+    htab->relax_stats_enabled = enable;
+}
 
-	      outrel.r_offset =
-		_bfd_elf_section_offset (output_bfd, info, input_section,
-					 rel->r_offset);
-	      skip_static_relocation = outrel.r_offset != (bfd_vma) -2;
-	      skip_dynamic_relocation = outrel.r_offset >= (bfd_vma) -2;
-	      outrel.r_offset += sec_addr (input_section);
+/* Return the relaxation statistics collected so far, one entry per trip of
+   each pass in the order they were made, and store their number in
+   *COUNT.  */
 
-	      if (skip_dynamic_relocation)
-		memset (&outrel, 0, sizeof outrel);
-	      else if (h != NULL && h->dynindx != -1
-		       && !(bfd_link_pic (info)
-			    && SYMBOLIC_BIND (info, h)
-			    && h->def_regular))
-		{
-		  outrel.r_info = ELFNN_R_INFO (h->dynindx, r_type);
-		  outrel.r_addend = rel->r_addend;
-		}
-	      else
-		{
-		  outrel.r_info = ELFNN_R_INFO (0, R_RISCV_RELATIVE);
-		  outrel.r_addend = relocation + rel->r_addend;
-		}
+const struct riscv_relax_stats *
+bfd_elfNN_riscv_get_relax_stats (struct bfd_link_info *info,
+				 unsigned int *count)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
 
-	      riscv_elf_append_rela (output_bfd, sreloc, &outrel);
-	      if (skip_static_relocation)
-		continue;
-	    }
-	  break;
+  if (htab == NULL)
+    {
+      *count = 0;
+      return NULL;
+    }
 
-	case R_RISCV_TLS_GOT_HI20:
-	  is_ie = TRUE;
-	  /* Fall through.  */
+  *count = htab->relax_stats_count;
+  return htab->relax_stats;
+}
 
-	case R_RISCV_TLS_GD_HI20:
-	  if (h != NULL)
-	    {
-	      off = h->got.offset;
-	      h->got.offset |= 1;
-	    }
-	  else
-	    {
-	      off = local_got_offsets[r_symndx];
-	      local_got_offsets[r_symndx] |= 1;
-	    }
+/* Create the .relr.dyn section that R_RISCV_RELATIVE relocs in data are
+   packed into, if this link makes a shared object or PIE.  Called once
+   the input files are open, before sections are placed.  */
 
-	  tls_type = _bfd_riscv_elf_tls_type (input_bfd, h, r_symndx);
-	  BFD_ASSERT (tls_type & (GOT_TLS_IE | GOT_TLS_GD));
-	  /* If this symbol is referenced by both GD and IE TLS, the IE
-	     reference's GOT slot follows the GD reference's slots.  */
-	  ie_off = 0;
-	  if ((tls_type & GOT_TLS_GD) && (tls_type & GOT_TLS_IE))
-	    ie_off = 2 * GOT_ENTRY_SIZE;
+bfd_boolean
+bfd_elfNN_riscv_pack_relative_relocs (struct bfd_link_info *info)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  bfd *dynobj;
+  flagword flags;
 
-	  if ((off & 1) != 0)
-	    off &= ~1;
-	  else
-	    {
-	      Elf_Internal_Rela outrel;
-	      int indx = 0;
-	      bfd_boolean need_relocs = FALSE;
+  if (htab == NULL
+      || !bfd_link_pic (info)
+      || !htab->elf.dynamic_sections_created)
+    return TRUE;
 
-	      if (htab->elf.srelgot == NULL)
-		abort ();
+  dynobj = htab->elf.dynobj;
+  flags = get_elf_backend_data (dynobj)->dynamic_sec_flags | SEC_READONLY;
+  htab->srelr = bfd_make_section_anyway_with_flags (dynobj, ".relr.dyn",
+						    flags);
+  return (htab->srelr != NULL
+	  && bfd_set_section_alignment (dynobj, htab->srelr,
+					RISCV_ELF_LOG_WORD_BYTES));
+}
 
-	      if (h != NULL)
-		{
-		  bfd_boolean dyn, pic;
-		  dyn = htab->elf.dynamic_sections_created;
-		  pic = bfd_link_pic (info);
+/* Size .relr.dyn for the current layout of the output.  Set *AGAIN if it
+   grew, in which case the output must be laid out and sized again.  The
+   section never shrinks, so that this converges; riscv_elf_encode_relr
+   pads the final encoding to fill it.  */
 
-		  if (WILL_CALL_FINISH_DYNAMIC_SYMBOL (dyn, pic, h)
-		      && (!pic || !SYMBOL_REFERENCES_LOCAL (info, h)))
-		    indx = h->dynindx;
-		}
+bfd_boolean
+bfd_elfNN_riscv_size_relative_relocs (struct bfd_link_info *info,
+				      bfd_boolean *again)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  bfd_size_type size;
 
-	      /* The GOT entries have not been initialized yet.  Do it
-	         now, and emit any relocations.  */
-	      if ((bfd_link_pic (info) || indx != 0)
-		  && (h == NULL
-		      || ELF_ST_VISIBILITY (h->other) == STV_DEFAULT
-		      || h->root.type != bfd_link_hash_undefweak))
-		    need_relocs = TRUE;
+  *again = FALSE;
+  if (htab == NULL || htab->srelr == NULL || htab->relr_count == 0)
+    return TRUE;
 
-	      if (tls_type & GOT_TLS_GD)
-		{
-		  if (need_relocs)
-		    {
-		      outrel.r_offset = sec_addr (htab->elf.sgot) + off;
-		      outrel.r_addend = 0;
-		      outrel.r_info = ELFNN_R_INFO (indx, R_RISCV_TLS_DTPMODNN);
-		      bfd_put_NN (output_bfd, 0,
-				  htab->elf.sgot->contents + off);
-		      riscv_elf_append_rela (output_bfd, htab->elf.srelgot, &outrel);
-		      if (indx == 0)
-			{
-			  BFD_ASSERT (! unresolved_reloc);
-			  bfd_put_NN (output_bfd,
-				      dtpoff (info, relocation),
-				      (htab->elf.sgot->contents + off +
-				       RISCV_ELF_WORD_BYTES));
-			}
-		      else
-			{
-			  bfd_put_NN (output_bfd, 0,
-				      (htab->elf.sgot->contents + off +
-				       RISCV_ELF_WORD_BYTES));
-			  outrel.r_info = ELFNN_R_INFO (indx, R_RISCV_TLS_DTPRELNN);
-			  outrel.r_offset += RISCV_ELF_WORD_BYTES;
-			  riscv_elf_append_rela (output_bfd, htab->elf.srelgot, &outrel);
-			}
-		    }
-		  else
-		    {
-		      /* If we are not emitting relocations for a
-			 general dynamic reference, then we must be in a
-			 static link or an executable link with the
-			 symbol binding locally.  Mark it as belonging
-			 to module 1, the executable.  */
-		      bfd_put_NN (output_bfd, 1,
-				  htab->elf.sgot->contents + off);
-		      bfd_put_NN (output_bfd,
-				  dtpoff (info, relocation),
-				  (htab->elf.sgot->contents + off +
-				   RISCV_ELF_WORD_BYTES));
-		   }
-		}
+  if (htab->relr_addrs == NULL)
+    {
+      htab->relr_addrs = (bfd_vma *)
+	bfd_alloc (info->output_bfd, htab->relr_count * sizeof (bfd_vma));
+      if (htab->relr_addrs == NULL)
+	return FALSE;
+    }
 
-	      if (tls_type & GOT_TLS_IE)
-		{
-		  if (need_relocs)
-		    {
-		      bfd_put_NN (output_bfd, 0,
-				  htab->elf.sgot->contents + off + ie_off);
-		      outrel.r_offset = sec_addr (htab->elf.sgot)
-				       + off + ie_off;
-		      outrel.r_addend = 0;
-		      if (indx == 0)
-			outrel.r_addend = tpoff (info, relocation);
-		      outrel.r_info = ELFNN_R_INFO (indx, R_RISCV_TLS_TPRELNN);
-		      riscv_elf_append_rela (output_bfd, htab->elf.srelgot, &outrel);
-		    }
-		  else
-		    {
-		      bfd_put_NN (output_bfd, tpoff (info, relocation),
-				  htab->elf.sgot->contents + off + ie_off);
-		    }
-		}
-	    }
+  if (!riscv_elf_scan_relr (info->output_bfd, info, htab->relr_addrs))
+    return FALSE;
+  qsort (htab->relr_addrs, htab->relr_count, sizeof (bfd_vma),
+	 riscv_elf_relr_compare);
 
-	  BFD_ASSERT (off < (bfd_vma) -2);
-	  relocation = sec_addr (htab->elf.sgot) + off + (is_ie ? ie_off : 0);
-	  if (!riscv_record_pcrel_hi_reloc (&pcrel_relocs, pc,
-					    relocation, FALSE))
-	    r = bfd_reloc_overflow;
-	  unresolved_reloc = FALSE;
-	  break;
+  size = riscv_elf_encode_relr (info->output_bfd, htab, NULL);
+  if (size > htab->srelr->size)
+    {
+      htab->srelr->size = size;
+      htab->srelr->contents = (bfd_byte *) bfd_zalloc (htab->srelr->owner,
+						       size);
+      if (htab->srelr->contents == NULL)
+	return FALSE;
+      *again = TRUE;
+    }
 
-	default:
-	  r = bfd_reloc_notsupported;
-	}
+  return TRUE;
+}
 
-      /* Dynamic relocs are not propagated for SEC_DEBUGGING sections
-	 because such sections are not SEC_ALLOC and thus ld.so will
-	 not process them.  */
-      if (unresolved_reloc
-	  && !((input_section->flags & SEC_DEBUGGING) != 0
-	       && h->def_dynamic)
-	  && _bfd_elf_section_offset (output_bfd, info, input_section,
-				      rel->r_offset) != (bfd_vma) -1)
-	{
-	  (*_bfd_error_handler)
-	    (_("%B(%A+0x%lx): unresolvable %s relocation against symbol `%s'"),
-	     input_bfd,
-	     input_section,
-	     (long) rel->r_offset,
-	     howto->name,
-	     h->root.root.string);
-	  continue;
-	}
+/* Return the relaxation statistics entry for the current trip of the
+   current pass, adding one if need be.  */
+
+static struct riscv_relax_stats *
+riscv_relax_stats_entry (struct riscv_elf_link_hash_table *htab,
+			 struct bfd_link_info *info)
+{
+  struct riscv_relax_stats *stats;
+
+  if (htab->relax_stats_count != 0)
+    {
+      stats = &htab->relax_stats[htab->relax_stats_count - 1];
+      if (stats->pass == info->relax_pass && stats->trip == info->relax_trip)
+	return stats;
+    }
+
+  if (htab->relax_stats_count == htab->relax_stats_size)
+    {
+      unsigned int size = htab->relax_stats_size ? 2 * htab->relax_stats_size
+						 : 16;
 
-      if (r == bfd_reloc_ok)
-	r = perform_relocation (howto, rel, relocation, input_section,
-				input_bfd, contents);
+      stats = bfd_alloc (info->output_bfd, size * sizeof (*stats));
+      if (stats == NULL)
+	return NULL;
+      if (htab->relax_stats_count != 0)
+	memcpy (stats, htab->relax_stats,
+		htab->relax_stats_count * sizeof (*stats));
+      htab->relax_stats = stats;
+      htab->relax_stats_size = size;
+    }
 
-      switch (r)
-	{
-	case bfd_reloc_ok:
-	  continue;
+  stats = &htab->relax_stats[htab->relax_stats_count++];
+  memset (stats, 0, sizeof (*stats));
+  stats->pass = info->relax_pass;
+  stats->trip = info->relax_trip;
+  return stats;
+}
 
-	case bfd_reloc_overflow:
-	  info->callbacks->reloc_overflow
-	    (info, (h ? &h->root : NULL), name, howto->name,
-	     (bfd_vma) 0, input_bfd, input_section, rel->r_offset);
-	  break;
+/* Return a number that changes whenever STATS records a relaxation.  */
 
-	case bfd_reloc_undefined:
-	  info->callbacks->undefined_symbol
-	    (info, name, input_bfd, input_section, rel->r_offset,
-	     TRUE);
-	  break;
+static unsigned long
+riscv_relax_stats_changes (const struct riscv_relax_stats *stats)
+{
+  unsigned long changes = stats->bytes_saved;
+  int kind;
 
-	case bfd_reloc_outofrange:
-	  msg = _("internal error: out of range error");
-	  break;
+  for (kind = 0; kind < riscv_relax_kind_max; kind++)
+    changes += stats->count[kind];
+  return changes;
+}
 
-	case bfd_reloc_notsupported:
-	  msg = _("internal error: unsupported relocation error");
-	  break;
+/* Count a relaxation of kind KIND, if statistics are being collected.  */
 
-	case bfd_reloc_dangerous:
-	  msg = _("internal error: dangerous relocation");
-	  break;
+static void
+riscv_relax_note (struct bfd_link_info *info, enum riscv_relax_kind kind)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
 
-	default:
-	  msg = _("internal error: unknown error");
-	  break;
+  if (htab != NULL && htab->relax_stats_cur != NULL)
+    htab->relax_stats_cur->count[kind]++;
+}
+
+/* Adjust the symbols defined in SEC, a section of ABFD, for the deletion
+   of COUNT bytes at ADDR, moving those up to TOADDR.  */
+
+static bfd_boolean
+riscv_relax_adjust_symbols (bfd *abfd, asection *sec, bfd_vma addr,
+			    size_t count, bfd_vma toaddr)
+{
+  unsigned int i, symcount;
+  struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (abfd);
+  Elf_Internal_Shdr *symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
+  unsigned int sec_shndx = _bfd_elf_section_from_bfd_section (abfd, sec);
+
+  /* The symbols of a section folded by --icf may not have been read.  */
+  if (symtab_hdr->sh_info != 0
+      && !symtab_hdr->contents
+      && !(symtab_hdr->contents =
+	   (unsigned char *) bfd_elf_get_elf_syms (abfd, symtab_hdr,
+						   symtab_hdr->sh_info,
+						   0, NULL, NULL, NULL)))
+    return FALSE;
+
+  /* Adjust the local symbols defined in this section.  */
+  for (i = 0; i < symtab_hdr->sh_info; i++)
+    {
+      Elf_Internal_Sym *sym = (Elf_Internal_Sym *) symtab_hdr->contents + i;
+      if (sym->st_shndx == sec_shndx)
+	{
+	  /* If the symbol is in the range of memory we just moved, we
+	     have to adjust its value.  */
+	  if (sym->st_value > addr && sym->st_value <= toaddr)
+	    sym->st_value -= count;
+
+	  /* If the symbol *spans* the bytes we just deleted (i.e. its
+	     *end* is in the moved bytes but its *start* isn't), then we
+	     must adjust its size.  */
+	  if (sym->st_value <= addr
+	      && sym->st_value + sym->st_size > addr
+	      && sym->st_value + sym->st_size <= toaddr)
+	    sym->st_size -= count;
 	}
+    }
 
-      if (msg)
-	info->callbacks->warning
-	  (info, msg, name, input_bfd, input_section, rel->r_offset);
-      goto out;
+  /* Now adjust the global symbols defined in this section.  */
+  symcount = ((symtab_hdr->sh_size / sizeof (ElfNN_External_Sym))
+	      - symtab_hdr->sh_info);
+
+  for (i = 0; i < symcount; i++)
+    {
+      struct elf_link_hash_entry *sym_hash = sym_hashes[i];
+
+      if ((sym_hash->root.type == bfd_link_hash_defined
+	   || sym_hash->root.type == bfd_link_hash_defweak)
+	  && sym_hash->root.u.def.section == sec)
+	{
+	  /* As above, adjust the value if needed.  */
+	  if (sym_hash->root.u.def.value > addr
+	      && sym_hash->root.u.def.value <= toaddr)
+	    sym_hash->root.u.def.value -= count;
+
+	  /* As above, adjust the size if needed.  */
+	  if (sym_hash->root.u.def.value <= addr
+	      && sym_hash->root.u.def.value + sym_hash->size > addr
+	      && sym_hash->root.u.def.value + sym_hash->size <= toaddr)
+	    sym_hash->size -= count;
+	}
     }
 
-  ret = riscv_resolve_pcrel_lo_relocs (&pcrel_relocs);
-out:
-  riscv_free_pcrel_relocs (&pcrel_relocs);
-  return ret;
+  return TRUE;
 }
 
-/* Finish up dynamic symbol handling.  We set the contents of various
-   dynamic sections here.  */
+/* Delete some bytes from a section while relaxing.  */
 
 static bfd_boolean
-riscv_elf_finish_dynamic_symbol (bfd *output_bfd,
-				 struct bfd_link_info *info,
-				 struct elf_link_hash_entry *h,
-				 Elf_Internal_Sym *sym)
+riscv_relax_delete_bytes (bfd *abfd, asection *sec, bfd_vma addr, size_t count,
+			  struct bfd_link_info *link_info)
 {
-  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
-  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (link_info);
+  unsigned int i;
+  bfd_vma toaddr = sec->size;
+  struct bfd_elf_section_data *data = elf_section_data (sec);
+  bfd_byte *contents = data->this_hdr.contents;
+  asection *folded;
 
-  if (h->plt.offset != (bfd_vma) -1)
+  if (htab != NULL && htab->relax_stats_cur != NULL)
+    htab->relax_stats_cur->bytes_saved += count;
+
+  /* Actually delete the bytes.  */
+  sec->size -= count;
+  memmove (contents + addr, contents + addr + count, toaddr - addr - count);
+
+  /* Adjust the location of all of the relocs.  Note that we need not
+     adjust the addends, since all PC-relative references must be against
+     symbols, which we will adjust below.  */
+  for (i = 0; i < sec->reloc_count; i++)
+    if (data->relocs[i].r_offset > addr && data->relocs[i].r_offset < toaddr)
+      data->relocs[i].r_offset -= count;
+
+  if (!riscv_relax_adjust_symbols (abfd, sec, addr, count, toaddr))
+    return FALSE;
+
+  /* The sections folded into this one by --icf share its code, so their
+     symbols move with it.  */
+  for (folded = data->icf_folded;
+       folded != NULL;
+       folded = elf_section_data (folded)->icf_folded)
     {
-      /* We've decided to create a PLT entry for this symbol.  */
-      bfd_byte *loc;
-      bfd_vma i, header_address, plt_idx, got_address;
-      uint32_t plt_entry[PLT_ENTRY_INSNS];
-      Elf_Internal_Rela rela;
+      folded->size = sec->size;
+      if (!riscv_relax_adjust_symbols (folded->owner, folded, addr, count,
+				       toaddr))
+	return FALSE;
+    }
 
-      BFD_ASSERT (h->dynindx != -1);
+  return TRUE;
+}
 
-      /* Calculate the address of the PLT header.  */
-      header_address = sec_addr (htab->elf.splt);
+/* A second format for recording PC-relative hi relocations.  This stores the
+   information required to relax them to GP-relative addresses.  */
 
-      /* Calculate the index of the entry.  */
-      plt_idx = (h->plt.offset - PLT_HEADER_SIZE) / PLT_ENTRY_SIZE;
+typedef struct riscv_pcgp_hi_reloc riscv_pcgp_hi_reloc;
+struct riscv_pcgp_hi_reloc
+{
+  bfd_vma hi_sec_off;
+  bfd_vma hi_addend;
+  bfd_vma hi_addr;
+  unsigned hi_sym;
+  asection *sym_sec;
+  riscv_pcgp_hi_reloc *next;
+};
 
-      /* Calculate the address of the .got.plt entry.  */
-      got_address = riscv_elf_got_plt_val (plt_idx, info);
+typedef struct riscv_pcgp_lo_reloc riscv_pcgp_lo_reloc;
+struct riscv_pcgp_lo_reloc
+{
+  bfd_vma hi_sec_off;
+  riscv_pcgp_lo_reloc *next;
+};
 
-      /* Find out where the .plt entry should go.  */
-      loc = htab->elf.splt->contents + h->plt.offset;
+typedef struct
+{
+  riscv_pcgp_hi_reloc *hi;
+  riscv_pcgp_lo_reloc *lo;
 
-      /* Fill in the PLT entry itself.  */
-      riscv_make_plt_entry (got_address, header_address + h->plt.offset,
-			    plt_entry);
-      for (i = 0; i < PLT_ENTRY_INSNS; i++)
-	bfd_put_32 (output_bfd, plt_entry[i], loc + 4*i);
+  /* The records to take new ones from, with room for one of each per
+     reloc of the section, or NULL to use malloc.  */
+  riscv_pcgp_hi_reloc *hi_pool;
+  riscv_pcgp_lo_reloc *lo_pool;
+  bfd_size_type hi_used;
+  bfd_size_type lo_used;
+} riscv_pcgp_relocs;
 
-      /* Fill in the initial value of the .got.plt entry.  */
-      loc = htab->elf.sgotplt->contents
-	    + (got_address - sec_addr (htab->elf.sgotplt));
-      bfd_put_NN (output_bfd, sec_addr (htab->elf.splt), loc);
+/* Prepare P for the relocs of SEC.  Take its records from the pools in
+   HTAB, if there is one, growing them on OUTPUT_BFD if SEC has more
+   relocs than riscv_relax_arena_init made room for.  */
 
-      /* Fill in the entry in the .rela.plt section.  */
-      rela.r_offset = got_address;
-      rela.r_addend = 0;
-      rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_JUMP_SLOT);
+static bfd_boolean
+riscv_init_pcgp_relocs (riscv_pcgp_relocs *p,
+			struct riscv_elf_link_hash_table *htab,
+			bfd *output_bfd,
+			asection *sec)
+{
+  p->hi = NULL;
+  p->lo = NULL;
+  p->hi_pool = NULL;
+  p->lo_pool = NULL;
+  p->hi_used = 0;
+  p->lo_used = 0;
+
+  if (htab == NULL)
+    return TRUE;
 
-      loc = htab->elf.srelplt->contents + plt_idx * sizeof (ElfNN_External_Rela);
-      bed->s->swap_reloca_out (output_bfd, &rela, loc);
+  if (sec->reloc_count > htab->pcgp_pool_size)
+    {
+      bfd_size_type count = sec->reloc_count;
 
-      if (!h->def_regular)
+      htab->pcgp_hi_pool = (riscv_pcgp_hi_reloc *)
+	bfd_alloc (output_bfd, count * sizeof (riscv_pcgp_hi_reloc));
+      htab->pcgp_lo_pool = (riscv_pcgp_lo_reloc *)
+	bfd_alloc (output_bfd, count * sizeof (riscv_pcgp_lo_reloc));
+      if (htab->pcgp_hi_pool == NULL || htab->pcgp_lo_pool == NULL)
 	{
-	  /* Mark the symbol as undefined, rather than as defined in
-	     the .plt section.  Leave the value alone.  */
-	  sym->st_shndx = SHN_UNDEF;
-	  /* If the symbol is weak, we do need to clear the value.
-	     Otherwise, the PLT entry would provide a definition for
-	     the symbol even if the symbol wasn't defined anywhere,
-	     and so the symbol would never be NULL.  */
-	  if (!h->ref_regular_nonweak)
-	    sym->st_value = 0;
+	  htab->pcgp_pool_size = 0;
+	  return FALSE;
 	}
+      htab->pcgp_pool_size = count;
     }
 
-  if (h->got.offset != (bfd_vma) -1
-      && !(riscv_elf_hash_entry (h)->tls_type & (GOT_TLS_GD | GOT_TLS_IE)))
+  p->hi_pool = htab->pcgp_hi_pool;
+  p->lo_pool = htab->pcgp_lo_pool;
+  return TRUE;
+}
+
+static void
+riscv_free_pcgp_relocs (riscv_pcgp_relocs *p,
+			bfd *abfd ATTRIBUTE_UNUSED,
+			asection *sec ATTRIBUTE_UNUSED)
+{
+  riscv_pcgp_hi_reloc *c;
+  riscv_pcgp_lo_reloc *l;
+
+  /* Records taken from the pools are simply reused by the next section.  */
+  if (p->hi_pool != NULL)
+    return;
+
+  for (c = p->hi; c != NULL;)
     {
-      asection *sgot;
-      asection *srela;
-      Elf_Internal_Rela rela;
+      riscv_pcgp_hi_reloc *next = c->next;
+      free (c);
+      c = next;
+    }
 
-      /* This symbol has an entry in the GOT.  Set it up.  */
+  for (l = p->lo; l != NULL;)
+    {
+      riscv_pcgp_lo_reloc *next = l->next;
+      free (l);
+      l = next;
+    }
+}
 
-      sgot = htab->elf.sgot;
-      srela = htab->elf.srelgot;
-      BFD_ASSERT (sgot != NULL && srela != NULL);
+static bfd_boolean
+riscv_record_pcgp_hi_reloc (riscv_pcgp_relocs *p, bfd_vma hi_sec_off,
+			    bfd_vma hi_addend, bfd_vma hi_addr,
+			    unsigned hi_sym, asection *sym_sec)
+{
+  riscv_pcgp_hi_reloc *new;
+
+  if (p->hi_pool != NULL)
+    new = &p->hi_pool[p->hi_used++];
+  else
+    new = bfd_malloc (sizeof (*new));
+  if (!new)
+    return FALSE;
+  new->hi_sec_off = hi_sec_off;
+  new->hi_addend = hi_addend;
+  new->hi_addr = hi_addr;
+  new->hi_sym = hi_sym;
+  new->sym_sec = sym_sec;
+  new->next = p->hi;
+  p->hi = new;
+  return TRUE;
+}
+
+static riscv_pcgp_hi_reloc *
+riscv_find_pcgp_hi_reloc(riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
+{
+  riscv_pcgp_hi_reloc *c;
+
+  for (c = p->hi; c != NULL; c = c->next)
+    if (c->hi_sec_off == hi_sec_off)
+      return c;
+  return NULL;
+}
+
+static bfd_boolean
+riscv_delete_pcgp_hi_reloc(riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
+{
+  bfd_boolean out = FALSE;
+  riscv_pcgp_hi_reloc *c;
+
+  for (c = p->hi; c != NULL; c = c->next)
+      if (c->hi_sec_off == hi_sec_off)
+	out = TRUE;
 
-      rela.r_offset = sec_addr (sgot) + (h->got.offset &~ (bfd_vma) 1);
+  return out;
+}
 
-      /* If this is a -Bsymbolic link, and the symbol is defined
-	 locally, we just want to emit a RELATIVE reloc.  Likewise if
-	 the symbol was forced to be local because of a version file.
-	 The entry in the global offset table will already have been
-	 initialized in the relocate_section function.  */
-      if (bfd_link_pic (info)
-	  && (info->symbolic || h->dynindx == -1)
-	  && h->def_regular)
-	{
-	  asection *sec = h->root.u.def.section;
-	  rela.r_info = ELFNN_R_INFO (0, R_RISCV_RELATIVE);
-	  rela.r_addend = (h->root.u.def.value
-			   + sec->output_section->vma
-			   + sec->output_offset);
-	}
-      else
-	{
-	  BFD_ASSERT (h->dynindx != -1);
-	  rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_NN);
-	  rela.r_addend = 0;
-	}
+static bfd_boolean
+riscv_use_pcgp_hi_reloc(riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
+{
+  bfd_boolean out = FALSE;
+  riscv_pcgp_hi_reloc *c;
 
-      bfd_put_NN (output_bfd, 0,
-		  sgot->contents + (h->got.offset & ~(bfd_vma) 1));
-      riscv_elf_append_rela (output_bfd, srela, &rela);
-    }
+  for (c = p->hi; c != NULL; c = c->next)
+    if (c->hi_sec_off == hi_sec_off)
+      out = TRUE;
 
-  if (h->needs_copy)
-    {
-      Elf_Internal_Rela rela;
-      asection *s;
+  return out;
+}
 
-      /* This symbols needs a copy reloc.  Set it up.  */
-      BFD_ASSERT (h->dynindx != -1);
+static bfd_boolean
+riscv_record_pcgp_lo_reloc (riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
+{
+  riscv_pcgp_lo_reloc *new;
 
-      rela.r_offset = sec_addr (h->root.u.def.section) + h->root.u.def.value;
-      rela.r_info = ELFNN_R_INFO (h->dynindx, R_RISCV_COPY);
-      rela.r_addend = 0;
-      if (h->root.u.def.section == htab->elf.sdynrelro)
-	s = htab->elf.sreldynrelro;
-      else
-	s = htab->elf.srelbss;
-      riscv_elf_append_rela (output_bfd, s, &rela);
-    }
+  if (p->lo_pool != NULL)
+    new = &p->lo_pool[p->lo_used++];
+  else
+    new = bfd_malloc (sizeof (*new));
+  if (!new)
+    return FALSE;
+  new->hi_sec_off = hi_sec_off;
+  new->next = p->lo;
+  p->lo = new;
+  return TRUE;
+}
 
-  /* Mark some specially defined symbols as absolute.  */
-  if (h == htab->elf.hdynamic
-      || (h == htab->elf.hgot || h == htab->elf.hplt))
-    sym->st_shndx = SHN_ABS;
+static bfd_boolean
+riscv_find_pcgp_lo_reloc (riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
+{
+  riscv_pcgp_lo_reloc *c;
+
+  for (c = p->lo; c != NULL; c = c->next)
+    if (c->hi_sec_off == hi_sec_off)
+      return TRUE;
+  return FALSE;
+}
 
+static bfd_boolean
+riscv_delete_pcgp_lo_reloc (riscv_pcgp_relocs *p ATTRIBUTE_UNUSED,
+			    bfd_vma lo_sec_off ATTRIBUTE_UNUSED,
+			    size_t bytes ATTRIBUTE_UNUSED)
+{
   return TRUE;
 }
 
-/* Finish up the dynamic sections.  */
+typedef bfd_boolean (*relax_func_t) (bfd *, asection *, asection *,
+				     struct bfd_link_info *,
+				     Elf_Internal_Rela *,
+				     bfd_vma, bfd_vma, bfd_vma, bfd_boolean *,
+				     riscv_pcgp_relocs *);
+
+/* Record the allocated output sections of OUTPUT_BFD in HTAB.  */
 
 static bfd_boolean
-riscv_finish_dyn (bfd *output_bfd, struct bfd_link_info *info,
-		  bfd *dynobj, asection *sdyn)
+riscv_record_relax_output_sections (bfd *output_bfd,
+				    struct riscv_elf_link_hash_table *htab)
 {
-  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
-  const struct elf_backend_data *bed = get_elf_backend_data (output_bfd);
-  size_t dynsize = bed->s->sizeof_dyn;
-  bfd_byte *dyncon, *dynconend;
+  unsigned int count = 0;
+  asection *o;
 
-  dynconend = sdyn->contents + sdyn->size;
-  for (dyncon = sdyn->contents; dyncon < dynconend; dyncon += dynsize)
-    {
-      Elf_Internal_Dyn dyn;
-      asection *s;
+  for (o = output_bfd->sections; o != NULL; o = o->next)
+    if (o->flags & SEC_ALLOC)
+      count++;
 
-      bed->s->swap_dyn_in (dynobj, dyncon, &dyn);
+  htab->relax_osecs = bfd_alloc (output_bfd, (count + 1) * sizeof (asection *));
+  if (htab->relax_osecs == NULL)
+    return FALSE;
 
-      switch (dyn.d_tag)
-	{
-	case DT_PLTGOT:
-	  s = htab->elf.sgotplt;
-	  dyn.d_un.d_ptr = s->output_section->vma + s->output_offset;
-	  break;
-	case DT_JMPREL:
-	  s = htab->elf.srelplt;
-	  dyn.d_un.d_ptr = s->output_section->vma + s->output_offset;
-	  break;
-	case DT_PLTRELSZ:
-	  s = htab->elf.srelplt;
-	  dyn.d_un.d_val = s->size;
-	  break;
-	default:
-	  continue;
-	}
+  count = 0;
+  for (o = output_bfd->sections; o != NULL; o = o->next)
+    if (o->flags & SEC_ALLOC)
+      htab->relax_osecs[count++] = o;
+  htab->relax_osec_count = count;
+  htab->relax_osec_pass = -1;
+  htab->relax_osec_trip = -1;
 
-      bed->s->swap_dyn_out (output_bfd, &dyn, dyncon);
-    }
   return TRUE;
 }
 
-static bfd_boolean
-riscv_elf_finish_dynamic_sections (bfd *output_bfd,
-				   struct bfd_link_info *info)
+/* Sort the recorded output sections of HTAB by address, unless that has
+   already been done for the current relaxation trip of INFO.  Addresses
+   only change between trips, and rarely change the order, so an insertion
+   sort is cheap here.  */
+
+static void
+riscv_sort_relax_output_sections (struct bfd_link_info *info,
+				  struct riscv_elf_link_hash_table *htab)
 {
-  bfd *dynobj;
-  asection *sdyn;
-  struct riscv_elf_link_hash_table *htab;
+  unsigned int i, j;
 
-  htab = riscv_elf_hash_table (info);
-  BFD_ASSERT (htab != NULL);
-  dynobj = htab->elf.dynobj;
+  if (htab->relax_osec_pass == info->relax_pass
+      && htab->relax_osec_trip == info->relax_trip)
+    return;
 
-  sdyn = bfd_get_linker_section (dynobj, ".dynamic");
+  htab->relax_osec_pass = info->relax_pass;
+  htab->relax_osec_trip = info->relax_trip;
 
-  if (elf_hash_table (info)->dynamic_sections_created)
+  for (i = 1; i < htab->relax_osec_count; i++)
     {
-      asection *splt;
-      bfd_boolean ret;
+      asection *o = htab->relax_osecs[i];
 
-      splt = htab->elf.splt;
-      BFD_ASSERT (splt != NULL && sdyn != NULL);
+      for (j = i; j > 0 && htab->relax_osecs[j - 1]->vma > o->vma; j--)
+	htab->relax_osecs[j] = htab->relax_osecs[j - 1];
+      htab->relax_osecs[j] = o;
+    }
+}
 
-      ret = riscv_finish_dyn (output_bfd, info, dynobj, sdyn);
+/* Return the sum of the alignments of the output sections that can add
+   padding between addresses A and B.  Deleting bytes can only grow the
+   alignment padding in front of the sections that start above the lower
+   address, and between the input sections of a code section.  That padding
+   can grow at every such section at once, so this bounds how much further
+   apart A and B can drift during relaxation.  Return zero if no section
+   can, and MAX_ALIGNMENT if the output sections were not recorded.  */
 
-      if (!ret)
-	return ret;
+static bfd_vma
+riscv_relax_span_alignment (struct bfd_link_info *info, bfd_vma a, bfd_vma b,
+			    bfd_vma max_alignment)
+{
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  unsigned int lo, hi;
+  bfd_vma slack = 0;
+  bfd_vma low = a < b ? a : b, high = a < b ? b : a;
+  asection *o;
 
-      /* Fill in the head and tail entries in the procedure linkage table.  */
-      if (splt->size > 0)
-	{
-	  int i;
-	  uint32_t plt_header[PLT_HEADER_INSNS];
-	  riscv_make_plt_header (sec_addr (htab->elf.sgotplt),
-				 sec_addr (splt), plt_header);
+  if (htab == NULL || htab->relax_osecs == NULL)
+    return max_alignment;
 
-	  for (i = 0; i < PLT_HEADER_INSNS; i++)
-	    bfd_put_32 (output_bfd, plt_header[i], splt->contents + 4*i);
+  /* Find the first section that starts above LOW.  */
+  lo = 0;
+  hi = htab->relax_osec_count;
+  while (lo < hi)
+    {
+      unsigned int mid = (lo + hi) / 2;
 
-	  elf_section_data (splt->output_section)->this_hdr.sh_entsize
-	    = PLT_ENTRY_SIZE;
-	}
+      if (htab->relax_osecs[mid]->vma <= low)
+	lo = mid + 1;
+      else
+	hi = mid;
     }
 
-  if (htab->elf.sgotplt)
+  /* The section holding LOW matters only if bytes can be deleted in it.  */
+  if (lo > 0)
     {
-      asection *output_section = htab->elf.sgotplt->output_section;
-
-      if (bfd_is_abs_section (output_section))
-	{
-	  (*_bfd_error_handler)
-	    (_("discarded output section: `%A'"), htab->elf.sgotplt);
-	  return FALSE;
-	}
-
-      if (htab->elf.sgotplt->size > 0)
-	{
-	  /* Write the first two entries in .got.plt, needed for the dynamic
-	     linker.  */
-	  bfd_put_NN (output_bfd, (bfd_vma) -1, htab->elf.sgotplt->contents);
-	  bfd_put_NN (output_bfd, (bfd_vma) 0,
-		      htab->elf.sgotplt->contents + GOT_ENTRY_SIZE);
-	}
-
-      elf_section_data (output_section)->this_hdr.sh_entsize = GOT_ENTRY_SIZE;
+      o = htab->relax_osecs[lo - 1];
+      if ((o->flags & SEC_CODE) != 0
+	  && o->vma + o->size >= low)
+	slack += (bfd_vma) 1 << o->alignment_power;
     }
 
-  if (htab->elf.sgot)
+  for (; lo < htab->relax_osec_count; lo++)
     {
-      asection *output_section = htab->elf.sgot->output_section;
-
-      if (htab->elf.sgot->size > 0)
-	{
-	  /* Set the first entry in the global offset table to the address of
-	     the dynamic section.  */
-	  bfd_vma val = sdyn ? sec_addr (sdyn) : 0;
-	  bfd_put_NN (output_bfd, val, htab->elf.sgot->contents);
-	}
-
-      elf_section_data (output_section)->this_hdr.sh_entsize = GOT_ENTRY_SIZE;
+      o = htab->relax_osecs[lo];
+      if (o->vma > high)
+	break;
+      slack += (bfd_vma) 1 << o->alignment_power;
     }
 
-  return TRUE;
+  return slack;
 }
 
-/* Return address for Ith PLT stub in section PLT, for relocation REL
-   or (bfd_vma) -1 if it should not be included.  */
+/* Return the alignment requested by R_RISCV_ALIGN reloc REL of SEC.  */
 
 static bfd_vma
-riscv_elf_plt_sym_val (bfd_vma i, const asection *plt,
-		       const arelent *rel ATTRIBUTE_UNUSED)
+riscv_relax_align_alignment (asection *sec, const Elf_Internal_Rela *rel)
 {
-  return plt->vma + PLT_HEADER_SIZE + i * PLT_ENTRY_SIZE;
+  struct _bfd_riscv_elf_section_data *sdata = riscv_elf_section_data (sec);
+  bfd_vma alignment = 1;
+
+  if (sdata->relax_alignments != NULL
+      && sdata->relax_alignments[rel - sdata->elf.relocs] != 0)
+    return sdata->relax_alignments[rel - sdata->elf.relocs];
+
+  while (alignment <= (bfd_vma) rel->r_addend)
+    alignment *= 2;
+  return alignment;
 }
 
-static enum elf_reloc_type_class
-riscv_reloc_type_class (const struct bfd_link_info *info ATTRIBUTE_UNUSED,
-			const asection *rel_sec ATTRIBUTE_UNUSED,
-			const Elf_Internal_Rela *rela)
+/* Return TRUE if every R_RISCV_ALIGN reloc of SEC after ADDR would still
+   have enough padding if COUNT bytes were deleted at ADDR.  Relaxations
+   that would delete bytes are only done if this holds, so that sections
+   stay relaxable after their alignment has been handled.  */
+
+static bfd_boolean
+riscv_relax_keeps_alignment_p (asection *sec, bfd_vma addr, size_t count)
 {
-  switch (ELFNN_R_TYPE (rela->r_info))
+  struct _bfd_riscv_elf_section_data *sdata = riscv_elf_section_data (sec);
+  unsigned int i;
+
+  for (i = sdata->relax_align_check_count; i-- > 0; )
     {
-    case R_RISCV_RELATIVE:
-      return reloc_class_relative;
-    case R_RISCV_JUMP_SLOT:
-      return reloc_class_plt;
-    case R_RISCV_COPY:
-      return reloc_class_copy;
-    default:
-      return reloc_class_normal;
+      Elf_Internal_Rela *rel;
+      bfd_vma alignment, pos;
+
+      rel = sdata->elf.relocs + sdata->relax_align_checks[i];
+
+      if (rel->r_offset <= addr)
+	break;
+
+      alignment = riscv_relax_align_alignment (sec, rel);
+      pos = sec_addr (sec) + rel->r_offset - count;
+      if (((-pos) & (alignment - 1)) > (bfd_vma) rel->r_addend)
+	return FALSE;
     }
+
+  return TRUE;
 }
 
-/* Merge backend specific data from an object file to the output
-   object file when linking.  */
+/* Add R_RISCV_ALIGN reloc REL of SEC to the ones that
+   riscv_relax_keeps_alignment_p checks.  */
 
-static bfd_boolean
-_bfd_riscv_elf_merge_private_bfd_data (bfd *ibfd, struct bfd_link_info *info)
+static void
+riscv_relax_add_align_check (asection *sec, Elf_Internal_Rela *rel)
 {
-  bfd *obfd = info->output_bfd;
-  flagword new_flags = elf_elfheader (ibfd)->e_flags;
-  flagword old_flags = elf_elfheader (obfd)->e_flags;
-
-  if (!is_riscv_elf (ibfd) || !is_riscv_elf (obfd))
-    return TRUE;
+  struct _bfd_riscv_elf_section_data *sdata = riscv_elf_section_data (sec);
+  unsigned int i = sdata->relax_align_check_count;
 
-  if (strcmp (bfd_get_target (ibfd), bfd_get_target (obfd)) != 0)
+  while (i > 0
+	 && (sdata->elf.relocs[sdata->relax_align_checks[i - 1]].r_offset
+	     > rel->r_offset))
     {
-      (*_bfd_error_handler)
-	(_("%B: ABI is incompatible with that of the selected emulation:\n"
-	   "  target emulation `%s' does not match `%s'"),
-	 ibfd, bfd_get_target (ibfd), bfd_get_target (obfd));
-      return FALSE;
+      sdata->relax_align_checks[i] = sdata->relax_align_checks[i - 1];
+      i--;
     }
+  sdata->relax_align_checks[i] = rel - sdata->elf.relocs;
+  sdata->relax_align_check_count++;
+}
 
-  if (!_bfd_elf_merge_object_attributes (ibfd, info))
-    return FALSE;
+/* Find the R_RISCV_ALIGN relocs of SEC that riscv_relax_keeps_alignment_p
+   must check before any of them have been handled.  */
 
-  if (! elf_flags_init (obfd))
-    {
-      elf_flags_init (obfd) = TRUE;
-      elf_elfheader (obfd)->e_flags = new_flags;
-      return TRUE;
-    }
+static bfd_boolean
+riscv_relax_count_aligns (bfd *abfd, asection *sec)
+{
+  struct _bfd_riscv_elf_section_data *sdata = riscv_elf_section_data (sec);
+  Elf_Internal_Rela *relocs = sdata->elf.relocs;
+  unsigned int i, count = 0;
+
+  if (sdata->relax_aligns_counted)
+    return TRUE;
 
-  /* Disallow linking different float ABIs.  */
-  if ((old_flags ^ new_flags) & EF_RISCV_FLOAT_ABI)
+  for (i = 0; i < sec->reloc_count; i++)
+    if (ELFNN_R_TYPE (relocs[i].r_info) == R_RISCV_ALIGN)
+      count++;
+
+  if (count != 0)
     {
-      (*_bfd_error_handler)
-	(_("%B: can't link hard-float modules with soft-float modules"), ibfd);
-      goto fail;
+      sdata->relax_align_checks = bfd_alloc (abfd,
+					     count * sizeof (unsigned int));
+      if (sdata->relax_align_checks == NULL)
+	return FALSE;
     }
 
-  /* Allow linking RVC and non-RVC, and keep the RVC flag.  */
-  elf_elfheader (obfd)->e_flags |= new_flags & EF_RISCV_RVC;
+  for (i = 0; i < sec->reloc_count; i++)
+    if (ELFNN_R_TYPE (relocs[i].r_info) == R_RISCV_ALIGN
+	&& ((bfd_vma) relocs[i].r_addend + 2
+	    < riscv_relax_align_alignment (sec, relocs + i)))
+      riscv_relax_add_align_check (sec, relocs + i);
 
+  sdata->relax_aligns_counted = TRUE;
   return TRUE;
-
-fail:
-  bfd_set_error (bfd_error_bad_value);
-  return FALSE;
 }
 
-/* Delete some bytes from a section while relaxing.  */
+/* Relax AUIPC + JALR into JAL.  */
 
 static bfd_boolean
-riscv_relax_delete_bytes (bfd *abfd, asection *sec, bfd_vma addr, size_t count)
+_bfd_riscv_relax_call (bfd *abfd, asection *sec, asection *sym_sec,
+		       struct bfd_link_info *link_info,
+		       Elf_Internal_Rela *rel,
+		       bfd_vma symval,
+		       bfd_vma max_alignment,
+		       bfd_vma reserve_size ATTRIBUTE_UNUSED,
+		       bfd_boolean *again,
+		       riscv_pcgp_relocs *pcgp_relocs ATTRIBUTE_UNUSED)
 {
-  unsigned int i, symcount;
-  bfd_vma toaddr = sec->size;
-  struct elf_link_hash_entry **sym_hashes = elf_sym_hashes (abfd);
-  Elf_Internal_Shdr *symtab_hdr = &elf_tdata (abfd)->symtab_hdr;
-  unsigned int sec_shndx = _bfd_elf_section_from_bfd_section (abfd, sec);
-  struct bfd_elf_section_data *data = elf_section_data (sec);
-  bfd_byte *contents = data->this_hdr.contents;
+  bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
+  bfd_signed_vma foff = symval - (sec_addr (sec) + rel->r_offset);
+  bfd_boolean near_zero = (symval + RISCV_IMM_REACH/2) < RISCV_IMM_REACH;
+  bfd_vma auipc, jalr;
+  int rd, r_type, len = 4, rvc = elf_elfheader (abfd)->e_flags & EF_RISCV_RVC;
+  enum riscv_relax_kind kind;
+  bfd_boolean island_p = FALSE;
+  bfd_vma island_slack = max_alignment;
 
-  /* Actually delete the bytes.  */
-  sec->size -= count;
-  memmove (contents + addr, contents + addr + count, toaddr - addr - count);
+  /* If the call crosses section boundaries, an alignment directive could
+     cause the PC-relative offset to later increase.  Only the sections
+     between the call and its target can contribute such padding.  */
+  if (VALID_UJTYPE_IMM (foff) && sym_sec->output_section != sec->output_section)
+    {
+      max_alignment = riscv_relax_span_alignment (link_info, symval,
+						  symval - foff,
+						  max_alignment);
+      foff += (foff < 0 ? -max_alignment : max_alignment);
+    }
 
-  /* Adjust the location of all of the relocs.  Note that we need not
-     adjust the addends, since all PC-relative references must be against
-     symbols, which we will adjust below.  */
-  for (i = 0; i < sec->reloc_count; i++)
-    if (data->relocs[i].r_offset > addr && data->relocs[i].r_offset < toaddr)
-      data->relocs[i].r_offset -= count;
+  BFD_ASSERT (rel->r_offset + 8 <= sec->size);
 
-  /* Adjust the local symbols defined in this section.  */
-  for (i = 0; i < symtab_hdr->sh_info; i++)
+  auipc = bfd_get_32 (abfd, contents + rel->r_offset);
+  jalr = bfd_get_32 (abfd, contents + rel->r_offset + 4);
+  rd = (jalr >> OP_SH_RD) & OP_MASK_RD;
+
+  /* See if this function call can be shortened, either directly or by
+     jumping through a call island stub.  The stub may be in another input
+     section, so allow for alignment padding growing in between.  */
+  if (!VALID_UJTYPE_IMM (foff) && !(!bfd_link_pic (link_info) && near_zero))
     {
-      Elf_Internal_Sym *sym = (Elf_Internal_Sym *) symtab_hdr->contents + i;
-      if (sym->st_shndx == sec_shndx)
-	{
-	  /* If the symbol is in the range of memory we just moved, we
-	     have to adjust its value.  */
-	  if (sym->st_value > addr && sym->st_value <= toaddr)
-	    sym->st_value -= count;
+      struct riscv_elf_link_hash_table *htab
+	= riscv_elf_hash_table (link_info);
+      bfd_vma island = MINUS_ONE;
 
-	  /* If the symbol *spans* the bytes we just deleted (i.e. its
-	     *end* is in the moved bytes but its *start* isn't), then we
-	     must adjust its size.  */
-	  if (sym->st_value <= addr
-	      && sym->st_value + sym->st_size > addr
-	      && sym->st_value + sym->st_size <= toaddr)
-	    sym->st_size -= count;
+      if (rd != X_RA || htab == NULL)
+	return TRUE;
+
+      if (rvc && ARCH_SIZE == 32)
+	island = riscv_find_call_island (htab, abfd, sec, rel,
+					 RVC_JUMP_REACH, island_slack);
+      /* A stub found for the longer reach may only be in reach of C.JAL
+	 without the slack, so do not use C.JAL for it.  */
+      if (island == MINUS_ONE)
+	{
+	  rvc = FALSE;
+	  island = riscv_find_call_island (htab, abfd, sec, rel,
+					   RISCV_JUMP_REACH, island_slack);
 	}
+      if (island == MINUS_ONE)
+	return TRUE;
+
+      foff = island - (sec_addr (sec) + rel->r_offset);
+      near_zero = FALSE;
+      island_p = TRUE;
     }
 
-  /* Now adjust the global symbols defined in this section.  */
-  symcount = ((symtab_hdr->sh_size / sizeof (ElfNN_External_Sym))
-	      - symtab_hdr->sh_info);
+  /* Shorten the function call.  */
+  rvc = rvc && VALID_RVC_J_IMM (foff) && ARCH_SIZE == 32;
 
-  for (i = 0; i < symcount; i++)
+  if (rvc && (rd == 0 || rd == X_RA))
     {
-      struct elf_link_hash_entry *sym_hash = sym_hashes[i];
+      /* Relax to C.J[AL] rd, addr.  */
+      r_type = R_RISCV_RVC_JUMP;
+      auipc = rd == 0 ? MATCH_C_J : MATCH_C_JAL;
+      len = 2;
+      kind = riscv_relax_call_rvc;
+    }
+  else if (VALID_UJTYPE_IMM (foff))
+    {
+      /* Relax to JAL rd, addr.  */
+      r_type = R_RISCV_JAL;
+      auipc = MATCH_JAL | (rd << OP_SH_RD);
+      kind = riscv_relax_call_jal;
+    }
+  else /* near_zero */
+    {
+      /* Relax to JALR rd, x0, addr.  */
+      r_type = R_RISCV_LO12_I;
+      auipc = MATCH_JALR | (rd << OP_SH_RD);
+      kind = riscv_relax_call_abs;
+    }
 
-      if ((sym_hash->root.type == bfd_link_hash_defined
-	   || sym_hash->root.type == bfd_link_hash_defweak)
-	  && sym_hash->root.u.def.section == sec)
-	{
-	  /* As above, adjust the value if needed.  */
-	  if (sym_hash->root.u.def.value > addr
-	      && sym_hash->root.u.def.value <= toaddr)
-	    sym_hash->root.u.def.value -= count;
+  /* Deleting the JALR must not leave later alignment short of padding.  */
+  if (!riscv_relax_keeps_alignment_p (sec, rel->r_offset + len, 8 - len))
+    return TRUE;
 
-	  /* As above, adjust the size if needed.  */
-	  if (sym_hash->root.u.def.value <= addr
-	      && sym_hash->root.u.def.value + sym_hash->size > addr
-	      && sym_hash->root.u.def.value + sym_hash->size <= toaddr)
-	    sym_hash->size -= count;
-	}
-    }
+  riscv_relax_note (link_info, island_p ? riscv_relax_call_island : kind);
 
-  return TRUE;
+  /* Replace the R_RISCV_CALL reloc.  */
+  rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info), r_type);
+  /* Replace the AUIPC.  */
+  bfd_put (8 * len, abfd, auipc, contents + rel->r_offset);
+
+  /* Delete unnecessary JALR.  */
+  *again = TRUE;
+  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + len, 8 - len,
+				   link_info);
 }
 
-/* A second format for recording PC-relative hi relocations.  This stores the
-   information required to relax them to GP-relative addresses.  */
+/* Traverse all output sections and return the max alignment.  */
 
-typedef struct riscv_pcgp_hi_reloc riscv_pcgp_hi_reloc;
-struct riscv_pcgp_hi_reloc
+static bfd_vma
+_bfd_riscv_get_max_alignment (asection *sec)
 {
-  bfd_vma hi_sec_off;
-  bfd_vma hi_addend;
-  bfd_vma hi_addr;
-  unsigned hi_sym;
-  asection *sym_sec;
-  riscv_pcgp_hi_reloc *next;
-};
+  unsigned int max_alignment_power = 0;
+  asection *o;
 
-typedef struct riscv_pcgp_lo_reloc riscv_pcgp_lo_reloc;
-struct riscv_pcgp_lo_reloc
+  for (o = sec->output_section->owner->sections; o != NULL; o = o->next)
+    {
+      if (o->alignment_power > max_alignment_power)
+	max_alignment_power = o->alignment_power;
+    }
+
+  return (bfd_vma) 1 << max_alignment_power;
+}
+
+/* Routing a call that relaxation would otherwise leave as AUIPC+JALR
+   through a stub saves four bytes, while the stub takes eight, so calls
+   only get a stub of their own if this many in a group share it.  Jumps
+   that cannot link otherwise always get one.  */
+#define RISCV_CALL_ISLAND_MIN_CALLS 3
+
+/* A group of input sections served by one call island, which follows
+   LAST once the group needs one.  SIZE is what the island needs to hold
+   all the stubs added to it so far.  TARGETS lists the targets that the
+   calls of the group need stubs for, while the group is being looked
+   at, and PENDING is the most that their stubs can add to SIZE.  */
+
+struct riscv_call_island_group
 {
-  bfd_vma hi_sec_off;
-  riscv_pcgp_lo_reloc *next;
+  asection *last;
+  asection *island;
+  bfd_size_type size;
+  bfd_size_type pending;
+  struct riscv_call_island_target *targets;
 };
 
-typedef struct
-{
-  riscv_pcgp_hi_reloc *hi;
-  riscv_pcgp_lo_reloc *lo;
-} riscv_pcgp_relocs;
+/* Return TRUE if SEC is input code that a call island may serve.  */
 
 static bfd_boolean
-riscv_init_pcgp_relocs (riscv_pcgp_relocs *p)
+riscv_call_island_section_p (asection *sec)
 {
-  p->hi = NULL;
-  p->lo = NULL;
-  return TRUE;
+  return ((sec->flags & (SEC_ALLOC | SEC_CODE | SEC_LINKER_CREATED))
+	  == (SEC_ALLOC | SEC_CODE)
+	  && sec->size != 0
+	  && sec->output_section != NULL
+	  && !discarded_section (sec)
+	  && sec->kept_section == NULL);
 }
 
-static void
-riscv_free_pcgp_relocs (riscv_pcgp_relocs *p,
-			bfd *abfd ATTRIBUTE_UNUSED,
-			asection *sec ATTRIBUTE_UNUSED)
-{
-  riscv_pcgp_hi_reloc *c;
-  riscv_pcgp_lo_reloc *l;
+/* Order input sections by their place in the output.  */
 
-  for (c = p->hi; c != NULL;)
-    {
-      riscv_pcgp_hi_reloc *next = c->next;
-      free (c);
-      c = next;
-    }
+static int
+riscv_call_island_section_compare (const void *a, const void *b)
+{
+  const asection *sa = *(const asection **) a;
+  const asection *sb = *(const asection **) b;
 
-  for (l = p->lo; l != NULL;)
+  if (sa->output_section != sb->output_section)
     {
-      riscv_pcgp_lo_reloc *next = l->next;
-      free (l);
-      l = next;
+      if (sa->output_section->vma != sb->output_section->vma)
+	return sa->output_section->vma < sb->output_section->vma ? -1 : 1;
+      return sa->output_section->id < sb->output_section->id ? -1 : 1;
     }
+  if (sa->output_offset != sb->output_offset)
+    return sa->output_offset < sb->output_offset ? -1 : 1;
+  return sa->id < sb->id ? -1 : sa->id > sb->id;
 }
 
+/* Note the targets of the calls in SEC, a member of GROUP, that cannot
+   reach them directly or through an existing call island stub.  */
+
 static bfd_boolean
-riscv_record_pcgp_hi_reloc (riscv_pcgp_relocs *p, bfd_vma hi_sec_off,
-			    bfd_vma hi_addend, bfd_vma hi_addr,
-			    unsigned hi_sym, asection *sym_sec)
+riscv_size_call_islands_for_section
+  (struct bfd_link_info *info, struct riscv_elf_link_hash_table *htab,
+   bfd *abfd, asection *sec, struct riscv_call_island_group *group,
+   bfd_vma max_alignment)
 {
-  riscv_pcgp_hi_reloc *new = bfd_malloc (sizeof(*new));
-  if (!new)
+  Elf_Internal_Shdr *symtab_hdr = &elf_symtab_hdr (abfd);
+  Elf_Internal_Rela *relocs, *rel, *relend;
+  bfd_boolean ret = FALSE;
+
+  if ((sec->flags & SEC_RELOC) == 0 || sec->reloc_count == 0)
+    return TRUE;
+
+  relocs = _bfd_elf_link_read_relocs (abfd, sec, NULL, NULL,
+				      info->keep_memory);
+  if (relocs == NULL)
     return FALSE;
-  new->hi_sec_off = hi_sec_off;
-  new->hi_addend = hi_addend;
-  new->hi_addr = hi_addr;
-  new->hi_sym = hi_sym;
-  new->sym_sec = sym_sec;
-  new->next = p->hi;
-  p->hi = new;
-  return TRUE;
-}
 
-static riscv_pcgp_hi_reloc *
-riscv_find_pcgp_hi_reloc(riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
-{
-  riscv_pcgp_hi_reloc *c;
+  relend = relocs + sec->reloc_count;
+  for (rel = relocs; rel < relend; rel++)
+    {
+      int r_type = ELFNN_R_TYPE (rel->r_info);
+      unsigned long r_symndx = ELFNN_R_SYM (rel->r_info);
+      struct elf_link_hash_entry *h = NULL;
+      struct riscv_call_island_target *target;
+      struct riscv_call_island_stub *stub;
+      asection *sym_sec;
+      bfd_vma symval, pc, reach;
+      bfd_signed_vma foff;
+      bfd_boolean call_p;
+
+      /* Calls that relaxation may shorten, and jumps that may link.  Only
+	 those that link through ra will use a stub, but that is not known
+	 until their contents are read.  */
+      call_p = r_type == R_RISCV_CALL || r_type == R_RISCV_CALL_PLT;
+      if (call_p)
+	{
+	  if (info->disable_target_specific_optimizations
+	      || rel + 1 == relend
+	      || ELFNN_R_TYPE (rel[1].r_info) != R_RISCV_RELAX
+	      || rel[1].r_offset != rel->r_offset)
+	    continue;
+	}
+      else if (r_type != R_RISCV_JAL
+	       && (r_type != R_RISCV_RVC_JUMP || ARCH_SIZE != 32))
+	continue;
 
-  for (c = p->hi; c != NULL; c = c->next)
-    if (c->hi_sec_off == hi_sec_off)
-      return c;
-  return NULL;
-}
+      if (r_symndx >= symtab_hdr->sh_info)
+	{
+	  h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+	  while (h->root.type == bfd_link_hash_indirect
+		 || h->root.type == bfd_link_hash_warning)
+	    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+	}
+      symval = riscv_call_island_symval (htab, h, abfd, r_symndx, &sym_sec);
+      if (symval == MINUS_ONE)
+	continue;
+      symval += rel->r_addend;
 
-static bfd_boolean
-riscv_delete_pcgp_hi_reloc(riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
-{
-  bfd_boolean out = FALSE;
-  riscv_pcgp_hi_reloc *c;
+      /* Calls that reach their target need no stub.  Nor do those that
+	 relaxation turns into jumps off x0.  */
+      pc = sec_addr (sec) + rel->r_offset;
+      foff = symval - pc;
+      if (sym_sec->output_section != sec->output_section)
+	foff += foff < 0 ? -max_alignment : max_alignment;
+      if (VALID_UJTYPE_IMM (foff)
+	  || (call_p
+	      && !bfd_link_pic (info)
+	      && symval + RISCV_IMM_REACH / 2 < RISCV_IMM_REACH))
+	continue;
 
-  for (c = p->hi; c != NULL; c = c->next)
-      if (c->hi_sec_off == hi_sec_off)
-	out = TRUE;
+      target = riscv_call_island_lookup (htab, abfd, rel, TRUE);
+      if (target == NULL)
+	goto fail;
 
-  return out;
-}
+      /* A stub in this group's island, or in reach in another island of
+	 the same output section, will do.  */
+      reach = r_type == R_RISCV_RVC_JUMP ? RVC_JUMP_REACH : RISCV_JUMP_REACH;
+      for (stub = target->stubs; stub != NULL; stub = stub->next)
+	if (stub->island == group->island && stub->island != NULL)
+	  break;
+      if (stub != NULL
+	  || riscv_find_call_island (htab, abfd, sec, rel, reach,
+				     max_alignment) != MINUS_ONE)
+	continue;
 
-static bfd_boolean
-riscv_use_pcgp_hi_reloc(riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
-{
-  bfd_boolean out = FALSE;
-  riscv_pcgp_hi_reloc *c;
+      /* A C.JAL can only use a new stub if this group's island, which
+	 follows all of its code, will be in its short reach.  */
+      if (r_type == R_RISCV_RVC_JUMP)
+	{
+	  bfd_vma addr = (group->island != NULL
+			  ? sec_addr (group->island)
+			  : sec_addr (group->last) + group->last->size);
 
-  for (c = p->hi; c != NULL; c = c->next)
-    if (c->hi_sec_off == hi_sec_off)
-      out = TRUE;
+	  addr += group->size + group->pending;
+	  if (addr - pc + max_alignment >= reach / 2)
+	    continue;
+	}
+
+      if (target->group_calls++ == 0)
+	{
+	  target->group_next = group->targets;
+	  group->targets = target;
+	  group->pending += RISCV_CALL_ISLAND_STUB_SIZE;
+	}
+      if (!call_p)
+	target->group_jumps = TRUE;
+    }
 
-  return out;
-}
+  ret = TRUE;
 
-static bfd_boolean
-riscv_record_pcgp_lo_reloc (riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
-{
-  riscv_pcgp_lo_reloc *new = bfd_malloc (sizeof(*new));
-  if (!new)
-    return FALSE;
-  new->hi_sec_off = hi_sec_off;
-  new->next = p->lo;
-  p->lo = new;
-  return TRUE;
+ fail:
+  if (elf_section_data (sec)->relocs != relocs)
+    free (relocs);
+  return ret;
 }
 
+/* Add the stubs that the calls of GROUP need to its island, making the
+   island if need be.  ADD_ISLAND places a new island in the output.  Set
+   *ADDED if a stub was added.  */
+
 static bfd_boolean
-riscv_find_pcgp_lo_reloc (riscv_pcgp_relocs *p, bfd_vma hi_sec_off)
+riscv_add_call_island_stubs (struct riscv_elf_link_hash_table *htab,
+			     struct riscv_call_island_group *group,
+			     bfd_boolean (*add_island) (asection *,
+							asection *),
+			     bfd_boolean *added)
 {
-  riscv_pcgp_lo_reloc *c;
+  struct riscv_call_island_target *target, *next;
 
-  for (c = p->lo; c != NULL; c = c->next)
-    if (c->hi_sec_off == hi_sec_off)
-      return TRUE;
-  return FALSE;
-}
+  for (target = group->targets; target != NULL; target = next)
+    {
+      struct riscv_call_island_stub *stub;
+      bfd_boolean wanted;
+
+      next = target->group_next;
+      wanted = (target->group_jumps
+		|| target->group_calls >= RISCV_CALL_ISLAND_MIN_CALLS);
+      target->group_calls = 0;
+      target->group_jumps = FALSE;
+      target->group_next = NULL;
+      if (!wanted)
+	continue;
 
-static bfd_boolean
-riscv_delete_pcgp_lo_reloc (riscv_pcgp_relocs *p ATTRIBUTE_UNUSED,
-			    bfd_vma lo_sec_off ATTRIBUTE_UNUSED,
-			    size_t bytes ATTRIBUTE_UNUSED)
-{
-  return TRUE;
-}
+      if (group->island == NULL)
+	{
+	  flagword flags = (SEC_ALLOC | SEC_LOAD | SEC_READONLY | SEC_CODE
+			    | SEC_HAS_CONTENTS | SEC_IN_MEMORY
+			    | SEC_LINKER_CREATED | SEC_KEEP);
+
+	  group->island
+	    = bfd_make_section_anyway_with_flags (htab->elf.dynobj,
+						  ".riscv.island", flags);
+	  if (group->island == NULL
+	      || !bfd_set_section_alignment (htab->elf.dynobj, group->island,
+					     2)
+	      || !add_island (group->island, group->last))
+	    return FALSE;
+	}
 
-typedef bfd_boolean (*relax_func_t) (bfd *, asection *, asection *,
-				     struct bfd_link_info *,
-				     Elf_Internal_Rela *,
-				     bfd_vma, bfd_vma, bfd_vma, bfd_boolean *,
-				     riscv_pcgp_relocs *);
+      stub = (struct riscv_call_island_stub *)
+	bfd_alloc (htab->elf.dynobj, sizeof (*stub));
+      if (stub == NULL)
+	return FALSE;
+      stub->island = group->island;
+      stub->offset = group->size;
+      stub->next = target->stubs;
+      target->stubs = stub;
+      group->size += RISCV_CALL_ISLAND_STUB_SIZE;
+      *added = TRUE;
+    }
 
-/* Relax AUIPC + JALR into JAL.  */
+  group->targets = NULL;
+  group->pending = 0;
+  return TRUE;
+}
 
-static bfd_boolean
-_bfd_riscv_relax_call (bfd *abfd, asection *sec, asection *sym_sec,
-		       struct bfd_link_info *link_info,
-		       Elf_Internal_Rela *rel,
-		       bfd_vma symval,
-		       bfd_vma max_alignment,
-		       bfd_vma reserve_size ATTRIBUTE_UNUSED,
-		       bfd_boolean *again,
-		       riscv_pcgp_relocs *pcgp_relocs ATTRIBUTE_UNUSED)
+/* Give the calls of this link that cannot reach their targets call island
+   stubs in reach, before relaxation starts.  ADD_ISLAND places a new
+   island in the output right after an input section, and
+   LAYOUT_SECTIONS_AGAIN lays the output out again once islands have grown.
+   Islands only ever grow, so that this converges.  */
+
+bfd_boolean
+bfd_elfNN_riscv_size_call_islands
+  (struct bfd_link_info *info,
+   bfd_boolean (*add_island) (asection *, asection *),
+   void (*layout_sections_again) (void))
 {
-  bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
-  bfd_signed_vma foff = symval - (sec_addr (sec) + rel->r_offset);
-  bfd_boolean near_zero = (symval + RISCV_IMM_REACH/2) < RISCV_IMM_REACH;
-  bfd_vma auipc, jalr;
-  int rd, r_type, len = 4, rvc = elf_elfheader (abfd)->e_flags & EF_RISCV_RVC;
-
-  /* If the call crosses section boundaries, an alignment directive could
-     cause the PC-relative offset to later increase.  */
-  if (VALID_UJTYPE_IMM (foff) && sym_sec->output_section != sec->output_section)
-    foff += (foff < 0 ? -max_alignment : max_alignment);
+  struct riscv_elf_link_hash_table *htab = riscv_elf_hash_table (info);
+  struct riscv_call_island_group *groups = NULL;
+  unsigned int *group_of = NULL;
+  asection **secs = NULL;
+  unsigned int i, start, count, group_count;
+  bfd_vma max_alignment;
+  bfd_boolean added, ret = FALSE;
+  bfd *ibfd;
 
-  /* See if this function call can be shortened.  */
-  if (!VALID_UJTYPE_IMM (foff) && !(!bfd_link_pic (link_info) && near_zero))
+  if (htab == NULL || bfd_link_relocatable (info))
     return TRUE;
 
-  /* Shorten the function call.  */
-  BFD_ASSERT (rel->r_offset + 8 <= sec->size);
-
-  auipc = bfd_get_32 (abfd, contents + rel->r_offset);
-  jalr = bfd_get_32 (abfd, contents + rel->r_offset + 4);
-  rd = (jalr >> OP_SH_RD) & OP_MASK_RD;
-  rvc = rvc && VALID_RVC_J_IMM (foff) && ARCH_SIZE == 32;
-
-  if (rvc && (rd == 0 || rd == X_RA))
+  count = 0;
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
     {
-      /* Relax to C.J[AL] rd, addr.  */
-      r_type = R_RISCV_RVC_JUMP;
-      auipc = rd == 0 ? MATCH_C_J : MATCH_C_JAL;
-      len = 2;
+      asection *sec;
+
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (riscv_call_island_section_p (sec))
+	  count++;
     }
-  else if (VALID_UJTYPE_IMM (foff))
+  if (count == 0)
+    return TRUE;
+
+  secs = (asection **) bfd_malloc (count * sizeof (*secs));
+  group_of = (unsigned int *) bfd_malloc (count * sizeof (*group_of));
+  groups = (struct riscv_call_island_group *)
+    bfd_zmalloc (count * sizeof (*groups));
+  if (secs == NULL || group_of == NULL || groups == NULL)
+    goto fail;
+
+  i = 0;
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
     {
-      /* Relax to JAL rd, addr.  */
-      r_type = R_RISCV_JAL;
-      auipc = MATCH_JAL | (rd << OP_SH_RD);
+      asection *sec;
+
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
+      if (htab->elf.dynobj == NULL)
+	htab->elf.dynobj = ibfd;
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (riscv_call_island_section_p (sec))
+	  secs[i++] = sec;
     }
-  else /* near_zero */
+  qsort (secs, count, sizeof (*secs), riscv_call_island_section_compare);
+
+  /* Split the code of each output section into groups, each small enough
+     for all of its calls to reach an island at its end.  */
+  group_count = 0;
+  start = 0;
+  for (i = 0; i < count; i++)
     {
-      /* Relax to JALR rd, x0, addr.  */
-      r_type = R_RISCV_LO12_I;
-      auipc = MATCH_JALR | (rd << OP_SH_RD);
+      if (i == 0
+	  || secs[i]->output_section != secs[start]->output_section
+	  || (secs[i]->output_offset + secs[i]->size
+	      - secs[start]->output_offset > RISCV_CALL_ISLAND_GROUP_SIZE))
+	{
+	  start = i;
+	  group_count++;
+	}
+      group_of[i] = group_count - 1;
+      groups[group_count - 1].last = secs[i];
     }
 
-  /* Replace the R_RISCV_CALL reloc.  */
-  rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info), r_type);
-  /* Replace the AUIPC.  */
-  bfd_put (8 * len, abfd, auipc, contents + rel->r_offset);
-
-  /* Delete unnecessary JALR.  */
-  *again = TRUE;
-  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + len, 8 - len);
-}
+  max_alignment = _bfd_riscv_get_max_alignment (secs[0]);
 
-/* Traverse all output sections and return the max alignment.  */
+  do
+    {
+      unsigned int g;
 
-static bfd_vma
-_bfd_riscv_get_max_alignment (asection *sec)
-{
-  unsigned int max_alignment_power = 0;
-  asection *o;
+      added = FALSE;
+      for (i = 0; i < count; i++)
+	{
+	  struct riscv_call_island_group *group = &groups[group_of[i]];
+
+	  if (!riscv_size_call_islands_for_section (info, htab,
+						    secs[i]->owner, secs[i],
+						    group, max_alignment))
+	    goto fail;
+	  if ((i + 1 == count || group_of[i + 1] != group_of[i])
+	      && !riscv_add_call_island_stubs (htab, group, add_island,
+					       &added))
+	    goto fail;
+	}
 
-  for (o = sec->output_section->owner->sections; o != NULL; o = o->next)
-    {
-      if (o->alignment_power > max_alignment_power)
-	max_alignment_power = o->alignment_power;
+      if (added)
+	{
+	  for (g = 0; g < group_count; g++)
+	    if (groups[g].island != NULL)
+	      groups[g].island->size = groups[g].size;
+	  layout_sections_again ();
+	}
     }
+  while (added);
 
-  return (bfd_vma) 1 << max_alignment_power;
+  ret = TRUE;
+
+ fail:
+  free (secs);
+  free (group_of);
+  free (groups);
+  return ret;
 }
 
 /* Relax non-PIC global variable references.  */
@@ -3028,22 +5753,19 @@ _bfd_riscv_relax_lui (bfd *abfd,
   bfd_vma gp = riscv_global_pointer_value (link_info);
   int use_rvc = elf_elfheader (abfd)->e_flags & EF_RISCV_RVC;
 
-  /* Mergeable symbols and code might later move out of range.  */
-  if (sym_sec->flags & (SEC_MERGE | SEC_CODE))
+  /* Code might later move out of range.  Merged constants are placed
+     before relaxation starts, so they stay put.  */
+  if (sym_sec->flags & SEC_CODE)
     return TRUE;
 
   BFD_ASSERT (rel->r_offset + 4 <= sec->size);
 
+  /* Only the output sections between gp and the symbol can add padding
+     between them; if both are in the same output section, this is just that
+     section's alignment.  */
   if (gp)
-    {
-      /* If gp and the symbol are in the same output section, then
-	 consider only that section's alignment.  */
-      struct bfd_link_hash_entry *h =
-	bfd_link_hash_lookup (link_info->hash, RISCV_GP_SYMBOL, FALSE, FALSE,
-			      TRUE);
-      if (h->u.def.section->output_section == sym_sec->output_section)
-	max_alignment = (bfd_vma) 1 << sym_sec->output_section->alignment_power;
-    }
+    max_alignment = riscv_relax_span_alignment (link_info, gp, symval,
+						max_alignment);
 
   /* Is the reference in range of x0 or gp?
      Valid gp range conservatively because of alignment issue.  */
@@ -3065,10 +5787,15 @@ _bfd_riscv_relax_lui (bfd *abfd,
 	  return TRUE;
 
 	case R_RISCV_HI20:
+	  if (!riscv_relax_keeps_alignment_p (sec, rel->r_offset, 4))
+	    return TRUE;
+
 	  /* We can delete the unnecessary LUI and reloc.  */
 	  rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
 	  *again = TRUE;
-	  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset, 4);
+	  riscv_relax_note (link_info, riscv_relax_lui_gp);
+	  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset, 4,
+					   link_info);
 
 	default:
 	  abort ();
@@ -3085,7 +5812,8 @@ _bfd_riscv_relax_lui (bfd *abfd,
       /* Replace LUI with C.LUI if legal (i.e., rd != x0 and rd != x2/sp).  */
       bfd_vma lui = bfd_get_32 (abfd, contents + rel->r_offset);
       unsigned rd = ((unsigned)lui >> OP_SH_RD) & OP_MASK_RD;
-      if (rd == 0 || rd == X_SP)
+      if (rd == 0 || rd == X_SP
+	  || !riscv_relax_keeps_alignment_p (sec, rel->r_offset + 2, 2))
 	return TRUE;
 
       lui = (lui & (OP_MASK_RD << OP_SH_RD)) | MATCH_C_LUI;
@@ -3095,7 +5823,9 @@ _bfd_riscv_relax_lui (bfd *abfd,
       rel->r_info = ELFNN_R_INFO (ELFNN_R_SYM (rel->r_info), R_RISCV_RVC_LUI);
 
       *again = TRUE;
-      return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + 2, 2);
+      riscv_relax_note (link_info, riscv_relax_lui_rvc);
+      return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + 2, 2,
+				       link_info);
     }
 
   return TRUE;
@@ -3132,22 +5862,32 @@ _bfd_riscv_relax_tls_le (bfd *abfd,
 
     case R_RISCV_TPREL_HI20:
     case R_RISCV_TPREL_ADD:
+      if (!riscv_relax_keeps_alignment_p (sec, rel->r_offset, 4))
+	return TRUE;
+
+      if (ELFNN_R_TYPE (rel->r_info) == R_RISCV_TPREL_HI20)
+	riscv_relax_note (link_info, riscv_relax_tprel);
+
       /* We can delete the unnecessary instruction and reloc.  */
       rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
       *again = TRUE;
-      return riscv_relax_delete_bytes (abfd, sec, rel->r_offset, 4);
+      return riscv_relax_delete_bytes (abfd, sec, rel->r_offset, 4,
+				       link_info);
 
     default:
       abort ();
     }
 }
 
-/* Implement R_RISCV_ALIGN by deleting excess alignment NOPs.  */
+/* Implement R_RISCV_ALIGN by deleting excess alignment NOPs.  The reloc
+   is kept, with the padding that is left as its addend, so that the
+   alignment is honored by later relaxation and checked again on later
+   trips.  */
 
 static bfd_boolean
 _bfd_riscv_relax_align (bfd *abfd, asection *sec,
 			asection *sym_sec,
-			struct bfd_link_info *link_info ATTRIBUTE_UNUSED,
+			struct bfd_link_info *link_info,
 			Elf_Internal_Rela *rel,
 			bfd_vma symval,
 			bfd_vma max_alignment ATTRIBUTE_UNUSED,
@@ -3155,17 +5895,15 @@ _bfd_riscv_relax_align (bfd *abfd, asection *sec,
 			bfd_boolean *again ATTRIBUTE_UNUSED,
 			riscv_pcgp_relocs *pcrel_relocs ATTRIBUTE_UNUSED)
 {
-  bfd_byte *contents = elf_section_data (sec)->this_hdr.contents;
-  bfd_vma alignment = 1, pos;
-  while (alignment <= rel->r_addend)
-    alignment *= 2;
+  struct _bfd_riscv_elf_section_data *sdata = riscv_elf_section_data (sec);
+  bfd_byte *contents = sdata->elf.this_hdr.contents;
+  unsigned int idx = rel - sdata->elf.relocs;
+  bfd_vma alignment = riscv_relax_align_alignment (sec, rel);
+  bfd_vma pos, nop_bytes, padding, excess;
 
   symval -= rel->r_addend;
   bfd_vma aligned_addr = ((symval - 1) & ~(alignment - 1)) + alignment;
-  bfd_vma nop_bytes = aligned_addr - symval;
-
-  /* Once we've handled an R_RISCV_ALIGN, we can't relax anything else.  */
-  sec->sec_flg0 = TRUE;
+  nop_bytes = aligned_addr - symval;
 
   /* Make sure there are enough NOPs to actually achieve the alignment.  */
   if (rel->r_addend < nop_bytes)
@@ -3178,24 +5916,50 @@ _bfd_riscv_relax_align (bfd *abfd, asection *sec,
       return FALSE;
     }
 
-  /* Delete the reloc.  */
-  rel->r_info = ELFNN_R_INFO (0, R_RISCV_NONE);
+  /* Record the alignment, since the addend will no longer give it.  */
+  if (sdata->relax_alignments == NULL)
+    {
+      sdata->relax_alignments = bfd_zalloc (abfd, sec->reloc_count
+						  * sizeof (bfd_vma));
+      if (sdata->relax_alignments == NULL)
+	return FALSE;
+    }
+  if (sdata->relax_alignments[idx] == 0)
+    {
+      if ((bfd_vma) rel->r_addend + 2 >= alignment)
+	riscv_relax_add_align_check (sec, rel);
+      sdata->relax_alignments[idx] = alignment;
+    }
 
   /* If the number of NOPs is already correct, there's nothing to do.  */
-  if (nop_bytes == rel->r_addend)
+  if (nop_bytes == (bfd_vma) rel->r_addend)
     return TRUE;
 
+  /* Deleting all of the excess could leave an alignment later in the
+     section short of padding; keep whole multiples of ALIGNMENT then.  */
+  excess = rel->r_addend - nop_bytes;
+  while (excess >= alignment
+	 && !riscv_relax_keeps_alignment_p (sec, rel->r_offset + nop_bytes,
+					    excess))
+    excess -= alignment;
+  padding = rel->r_addend - excess;
+
   /* Write as many RISC-V NOPs as we need.  */
-  for (pos = 0; pos < (nop_bytes & -4); pos += 4)
+  for (pos = 0; pos < (padding & -4); pos += 4)
     bfd_put_32 (abfd, RISCV_NOP, contents + rel->r_offset + pos);
 
   /* Write a final RVC NOP if need be.  */
-  if (nop_bytes % 4 != 0)
+  if (padding % 4 != 0)
     bfd_put_16 (abfd, RVC_NOP, contents + rel->r_offset + pos);
 
+  rel->r_addend = padding;
+  if (excess == 0)
+    return TRUE;
+
   /* Delete the excess bytes.  */
-  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + nop_bytes,
-				   rel->r_addend - nop_bytes);
+  riscv_relax_note (link_info, riscv_relax_align);
+  return riscv_relax_delete_bytes (abfd, sec, rel->r_offset + padding,
+				   excess, link_info);
 }
 
 /* Relax PC-relative references to GP-relative references.  */
@@ -3244,8 +6008,9 @@ _bfd_riscv_relax_pc  (bfd *abfd,
       break;
 
     case R_RISCV_PCREL_HI20:
-      /* Mergeable symbols and code might later move out of range.  */
-      if (sym_sec->flags & (SEC_MERGE | SEC_CODE))
+      /* Code might later move out of range.  Merged constants are
+	 placed before relaxation starts, so they stay put.  */
+      if (sym_sec->flags & SEC_CODE)
 	return TRUE;
 
       /* If the cooresponding lo relocation has already been seen then it's not
@@ -3259,15 +6024,12 @@ _bfd_riscv_relax_pc  (bfd *abfd,
       abort ();
     }
 
+  /* Only the output sections between gp and the symbol can add padding
+     between them; if both are in the same output section, this is just that
+     section's alignment.  */
   if (gp)
-    {
-      /* If gp and the symbol are in the same output section, then
-	 consider only that section's alignment.  */
-      struct bfd_link_hash_entry *h =
-	bfd_link_hash_lookup (link_info->hash, RISCV_GP_SYMBOL, FALSE, FALSE, TRUE);
-      if (h->u.def.section->output_section == sym_sec->output_section)
-	max_alignment = (bfd_vma) 1 << sym_sec->output_section->alignment_power;
-    }
+    max_alignment = riscv_relax_span_alignment (link_info, gp, symval,
+						max_alignment);
 
   /* Is the reference in range of x0 or gp?
      Valid gp range conservatively because of alignment issue.  */
@@ -3298,6 +6060,7 @@ _bfd_riscv_relax_pc  (bfd *abfd,
 				      ELFNN_R_SYM(rel->r_info),
 				      sym_sec);
 	  /* We can delete the unnecessary AUIPC and reloc.  */
+	  riscv_relax_note (link_info, riscv_relax_pcrel_gp);
 	  rel->r_info = ELFNN_R_INFO (0, R_RISCV_DELETE);
 	  rel->r_addend = 4;
 	  return riscv_delete_pcgp_hi_reloc (pcgp_relocs, rel->r_offset);
@@ -3316,7 +6079,7 @@ static bfd_boolean
 _bfd_riscv_relax_delete (bfd *abfd,
 			 asection *sec,
 			 asection *sym_sec ATTRIBUTE_UNUSED,
-			 struct bfd_link_info *link_info ATTRIBUTE_UNUSED,
+			 struct bfd_link_info *link_info,
 			 Elf_Internal_Rela *rel,
 			 bfd_vma symval ATTRIBUTE_UNUSED,
 			 bfd_vma max_alignment ATTRIBUTE_UNUSED,
@@ -3324,12 +6087,219 @@ _bfd_riscv_relax_delete (bfd *abfd,
 			 bfd_boolean *again ATTRIBUTE_UNUSED,
 			 riscv_pcgp_relocs *pcgp_relocs ATTRIBUTE_UNUSED)
 {
-  if (!riscv_relax_delete_bytes(abfd, sec, rel->r_offset, rel->r_addend))
+  /* If the bytes cannot go without upsetting later alignment, leave the
+     instruction in place; nothing uses its result.  */
+  if (riscv_relax_keeps_alignment_p (sec, rel->r_offset, rel->r_addend)
+      && !riscv_relax_delete_bytes(abfd, sec, rel->r_offset, rel->r_addend,
+				   link_info))
     return FALSE;
   rel->r_info = ELFNN_R_INFO(0, R_RISCV_NONE);
   return TRUE;
 }
 
+/* Return TRUE if relaxation looks at the relocs and contents of input
+   section SEC.  */
+
+static bfd_boolean
+riscv_relax_section_wanted_p (asection *sec)
+{
+  return ((sec->flags & (SEC_CODE | SEC_RELOC)) == (SEC_CODE | SEC_RELOC)
+	  && sec->reloc_count != 0
+	  && sec->output_section != NULL
+	  && !discarded_section (sec)
+	  && sec->kept_section == NULL);
+}
+
+/* Return TRUE if the contents of input section SEC can be read straight
+   from the file.  */
+
+static bfd_boolean
+riscv_relax_contents_wanted_p (asection *sec)
+{
+  return ((sec->flags & (SEC_HAS_CONTENTS | SEC_IN_MEMORY)) == SEC_HAS_CONTENTS
+	  && sec->size != 0
+	  && sec->compress_status == COMPRESS_SECTION_NONE);
+}
+
+/* Read the contents of SEC for relaxation, if riscv_relax_arena_init did
+   not.  If they can be read straight from the file, read them into a
+   buffer of their own allocated on ABFD, so that it is released along
+   with ABFD instead of needing a malloc and free per section.  */
+
+static bfd_boolean
+riscv_relax_get_contents (bfd *abfd, asection *sec)
+{
+  struct bfd_elf_section_data *data = elf_section_data (sec);
+  bfd_byte *buf;
+
+  if (!riscv_relax_contents_wanted_p (sec))
+    return bfd_malloc_and_get_section (abfd, sec, &data->this_hdr.contents);
+
+  buf = (bfd_byte *) bfd_alloc (abfd, sec->size);
+  if (buf == NULL
+      || !bfd_get_section_contents (abfd, sec, buf, 0, sec->size))
+    return FALSE;
+
+  data->this_hdr.contents = buf;
+  return TRUE;
+}
+
+/* Return TRUE if riscv_relax_arena_init reads in the contents of input
+   section SEC.  */
+
+static bfd_boolean
+riscv_relax_arena_contents_p (asection *sec)
+{
+  return (riscv_relax_section_wanted_p (sec)
+	  && riscv_relax_contents_wanted_p (sec)
+	  && elf_section_data (sec)->this_hdr.contents == NULL);
+}
+
+/* Return the number of bytes that riscv_relax_arena_init needs for the
+   contents of the sections of ABFD.  If they lie close enough together
+   in the file to be read with a single read, set *START to the file
+   position of the first and *ONE_READ to TRUE.  */
+
+static bfd_size_type
+riscv_relax_arena_contents_size (bfd *abfd, file_ptr *start,
+				 bfd_boolean *one_read)
+{
+  file_ptr end = 0;
+  bfd_size_type total = 0;
+  asection *sec;
+
+  *start = 0;
+  for (sec = abfd->sections; sec != NULL; sec = sec->next)
+    if (riscv_relax_arena_contents_p (sec))
+      {
+	if (total == 0 || sec->filepos < *start)
+	  *start = sec->filepos;
+	if (total == 0 || sec->filepos + (file_ptr) sec->size > end)
+	  end = sec->filepos + sec->size;
+	total += sec->size;
+      }
+
+  *one_read = total != 0 && (bfd_size_type) (end - *start) <= 2 * total;
+  return *one_read ? (bfd_size_type) (end - *start) : total;
+}
+
+/* Read in what relaxation needs for the whole link, into a single block
+   allocated on the output BFD and sized up front: the relocs of the
+   sections it looks at that have not been read yet, from their total
+   reloc_count; the pcgp records of the section with the most relocs;
+   and the contents of the sections, with one read per input file when
+   they are not too sparse in it.  The block is released along with the
+   output BFD, after the relaxed contents and relocs have been used to
+   write it.  */
+
+static bfd_boolean
+riscv_relax_arena_init (struct bfd_link_info *info,
+			struct riscv_elf_link_hash_table *htab)
+{
+  bfd_size_type relocs_size = 0, contents_size = 0, max_relocs = 0;
+  bfd_size_type pool_size, size;
+  bfd_byte *arena;
+  bfd *ibfd;
+  asection *sec;
+
+  htab->relax_arena_ready = TRUE;
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      file_ptr start;
+      bfd_boolean one_read;
+
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
+
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (riscv_relax_section_wanted_p (sec))
+	  {
+	    if (sec->reloc_count > max_relocs)
+	      max_relocs = sec->reloc_count;
+	    if (elf_section_data (sec)->relocs == NULL)
+	      relocs_size += sec->reloc_count * sizeof (Elf_Internal_Rela);
+	  }
+
+      contents_size += riscv_relax_arena_contents_size (ibfd, &start,
+							&one_read);
+    }
+
+  /* Put the relocs and records first, so that they are aligned.  */
+  pool_size = max_relocs * (sizeof (riscv_pcgp_hi_reloc)
+			    + sizeof (riscv_pcgp_lo_reloc));
+  size = relocs_size + pool_size + contents_size;
+  if (size == 0)
+    return TRUE;
+
+  arena = (bfd_byte *) bfd_alloc (info->output_bfd, size);
+  if (arena == NULL)
+    return FALSE;
+
+  htab->pcgp_hi_pool = (riscv_pcgp_hi_reloc *) arena;
+  arena += max_relocs * sizeof (riscv_pcgp_hi_reloc);
+  htab->pcgp_lo_pool = (riscv_pcgp_lo_reloc *) arena;
+  arena += max_relocs * sizeof (riscv_pcgp_lo_reloc);
+  htab->pcgp_pool_size = max_relocs;
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
+
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (riscv_relax_section_wanted_p (sec)
+	    && elf_section_data (sec)->relocs == NULL)
+	  {
+	    if (_bfd_elf_link_read_relocs (ibfd, sec, NULL,
+					   (Elf_Internal_Rela *) arena,
+					   TRUE) == NULL)
+	      return FALSE;
+	    arena += sec->reloc_count * sizeof (Elf_Internal_Rela);
+	  }
+    }
+
+  for (ibfd = info->input_bfds; ibfd != NULL; ibfd = ibfd->link.next)
+    {
+      file_ptr start;
+      bfd_boolean one_read;
+
+      if (!is_riscv_elf (ibfd) || (ibfd->flags & DYNAMIC) != 0)
+	continue;
+
+      size = riscv_relax_arena_contents_size (ibfd, &start, &one_read);
+      if (size == 0)
+	continue;
+
+      if (one_read
+	  && (bfd_seek (ibfd, start, SEEK_SET) != 0
+	      || bfd_bread (arena, size, ibfd) != size))
+	return FALSE;
+
+      for (sec = ibfd->sections; sec != NULL; sec = sec->next)
+	if (riscv_relax_arena_contents_p (sec))
+	  {
+	    bfd_byte *contents = arena;
+
+	    if (one_read)
+	      contents += sec->filepos - start;
+	    else
+	      {
+		if (!bfd_get_section_contents (ibfd, sec, contents, 0,
+					       sec->size))
+		  return FALSE;
+		arena += sec->size;
+	      }
+	    elf_section_data (sec)->this_hdr.contents = contents;
+	  }
+
+      if (one_read)
+	arena += size;
+    }
+
+  return TRUE;
+}
+
 /* Relax a section.  Pass 0 shortens code sequences unless disabled.  Pass 1
    deletes the bytes that pass 0 made obselete.  Pass 2, which cannot be
    disabled, handles code alignment directives.  */
@@ -3347,18 +6317,40 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
   unsigned int i;
   bfd_vma max_alignment, reserve_size = 0;
   riscv_pcgp_relocs pcgp_relocs;
+  struct riscv_relax_stats *stats = NULL;
+  unsigned long changes = 0;
+  long start_time = 0;
 
   *again = FALSE;
 
   if (bfd_link_relocatable (info)
-      || sec->sec_flg0
       || (sec->flags & SEC_RELOC) == 0
       || sec->reloc_count == 0
       || (info->disable_target_specific_optimizations
 	  && info->relax_pass == 0))
     return TRUE;
 
-  riscv_init_pcgp_relocs (&pcgp_relocs);
+  /* The first time through, read in what relaxation needs for the whole
+     link.  */
+  if (htab != NULL
+      && !htab->relax_arena_ready
+      && !riscv_relax_arena_init (info, htab))
+    return FALSE;
+
+  if (!riscv_init_pcgp_relocs (&pcgp_relocs, htab, info->output_bfd, sec))
+    return FALSE;
+
+  if (htab != NULL && htab->relax_stats_enabled)
+    {
+      stats = riscv_relax_stats_entry (htab, info);
+      htab->relax_stats_cur = stats;
+      if (stats != NULL)
+	{
+	  start_time = get_run_time ();
+	  changes = riscv_relax_stats_changes (stats);
+	  stats->sections_examined++;
+	}
+    }
 
   /* Read this BFD's relocs if we haven't done so already.  */
   if (data->relocs)
@@ -3367,6 +6359,10 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 						 info->keep_memory)))
     goto fail;
 
+  data->relocs = relocs;
+  if (!riscv_relax_count_aligns (abfd, sec))
+    goto fail;
+
   if (htab)
     {
       max_alignment = htab->max_alignment;
@@ -3374,11 +6370,23 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 	{
 	  max_alignment = _bfd_riscv_get_max_alignment (sec);
 	  htab->max_alignment = max_alignment;
+	  if (!riscv_record_relax_output_sections (info->output_bfd, htab))
+	    goto fail;
 	}
+      riscv_sort_relax_output_sections (info, htab);
     }
   else
     max_alignment = _bfd_riscv_get_max_alignment (sec);
 
+  /* Turn the GOT loads whose symbols are now known to be in reach into
+     address computations, for this pass to relax further.  */
+  if (info->relax_pass == 0
+      && htab != NULL
+      && !htab->got_loads_done
+      && bfd_link_executable (info)
+      && !riscv_elf_relax_got_loads (info, max_alignment, again))
+    goto fail;
+
   /* Examine and consider relaxing each reloc.  */
   for (i = 0; i < sec->reloc_count; i++)
     {
@@ -3430,7 +6438,7 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 
       /* Read this BFD's contents if we haven't done so already.  */
       if (!data->this_hdr.contents
-	  && !bfd_malloc_and_get_section (abfd, sec, &data->this_hdr.contents))
+	  && !riscv_relax_get_contents (abfd, sec))
 	goto fail;
 
       /* Read this BFD's symbols if we haven't done so already.  */
@@ -3457,9 +6465,23 @@ _bfd_riscv_relax_section (bfd *abfd, asection *sec,
 	    {
 	      BFD_ASSERT (isym->st_shndx < elf_numsections (abfd));
 	      sym_sec = elf_elfsections (abfd)[isym->st_shndx]->bfd_section;
-	      if (sec_addr (sym_sec) == 0)
-		continue;
-	      symval = sec_addr (sym_sec) + isym->st_value;
+	      if (sym_sec->sec_info_type == SEC_INFO_TYPE_MERGE)
+		{
+		  /* Find where the constant ended up once merged.  The
+		     addend is part of the offset being looked up, so
+		     take it back off; it is added again below.  */
+		  bfd_vma off = _bfd_elf_rel_local_sym (abfd, isym, &sym_sec,
+							rel->r_addend);
+		  if (sec_addr (sym_sec) == 0)
+		    continue;
+		  symval = sec_addr (sym_sec) + off - rel->r_addend;
+		}
+	      else
+		{
+		  if (sec_addr (sym_sec) == 0)
+		    continue;
+		  symval = sec_addr (sym_sec) + isym->st_value;
+		}
 	    }
 	}
       else
@@ -3504,6 +6526,14 @@ fail:
     free (relocs);
   riscv_free_pcgp_relocs(&pcgp_relocs, abfd, sec);
 
+  if (stats != NULL)
+    {
+      if (riscv_relax_stats_changes (stats) != changes)
+	stats->sections_changed++;
+      stats->time += get_run_time () - start_time;
+      htab->relax_stats_cur = NULL;
+    }
+
   return ret;
 }
 
@@ -3614,6 +6644,7 @@ riscv_elf_object_p (bfd *abfd)
 
 #define bfd_elfNN_bfd_reloc_name_lookup	     riscv_reloc_name_lookup
 #define bfd_elfNN_bfd_link_hash_table_create riscv_elf_link_hash_table_create
+#define bfd_elfNN_mkobject		     elfNN_riscv_mkobject
 #define bfd_elfNN_bfd_reloc_type_lookup	     riscv_reloc_type_lookup
 #define bfd_elfNN_bfd_merge_private_bfd_data \
   _bfd_riscv_elf_merge_private_bfd_data
@@ -3628,10 +6659,12 @@ riscv_elf_object_p (bfd *abfd)
 #define elf_backend_finish_dynamic_sections  riscv_elf_finish_dynamic_sections
 #define elf_backend_gc_mark_hook	     riscv_elf_gc_mark_hook
 #define elf_backend_gc_sweep_hook	     riscv_elf_gc_sweep_hook
+#define elf_backend_icf_address_reloc_p	riscv_elf_icf_address_reloc_p
 #define elf_backend_plt_sym_val		     riscv_elf_plt_sym_val
 #define elf_backend_grok_prstatus            riscv_elf_grok_prstatus
 #define elf_backend_grok_psinfo              riscv_elf_grok_psinfo
 #define elf_backend_object_p                 riscv_elf_object_p
+#define bfd_elfNN_new_section_hook	     riscv_elf_new_section_hook
 #define elf_info_to_howto_rel		     NULL
 #define elf_info_to_howto		     riscv_info_to_howto_rela
 #define bfd_elfNN_bfd_relax_section	     _bfd_riscv_relax_section
@@ -31,3 +31,74 @@ riscv_reloc_type_lookup (bfd *, bfd_reloc_code_real_type);
 
 extern reloc_howto_type *
 riscv_elf_rtype_to_howto (unsigned int r_type);
+
+/* The kinds of relaxation counted for --print-relax-stats.  */
+
+enum riscv_relax_kind
+{
+  riscv_relax_call_jal,		/* AUIPC+JALR to JAL.  */
+  riscv_relax_call_rvc,		/* AUIPC+JALR to C.J or C.JAL.  */
+  riscv_relax_call_abs,		/* AUIPC+JALR to JALR off x0.  */
+  riscv_relax_call_island,	/* AUIPC+JALR to a jump to a call island.  */
+  riscv_relax_lui_gp,		/* LUI deleted, LO12 made gp-relative.  */
+  riscv_relax_lui_rvc,		/* LUI to C.LUI.  */
+  riscv_relax_pcrel_gp,		/* AUIPC deleted, LO12 made gp-relative.  */
+  riscv_relax_tprel,		/* LUI+ADD deleted, LO12 made tp-relative.  */
+  riscv_relax_align,		/* Excess alignment NOPs deleted.  */
+  riscv_relax_kind_max
+};
+
+/* Relaxation statistics for one trip of one relaxation pass.  */
+
+struct riscv_relax_stats
+{
+  int pass;
+  int trip;
+
+  /* The number of relaxations of each kind.  */
+  unsigned long count[riscv_relax_kind_max];
+
+  /* The number of bytes deleted.  */
+  bfd_vma bytes_saved;
+
+  /* The number of input sections examined and changed.  */
+  unsigned long sections_examined;
+  unsigned long sections_changed;
+
+  /* Run time spent in the backend, in microseconds.  */
+  long time;
+};
+
+extern void
+bfd_elf32_riscv_set_relax_stats (struct bfd_link_info *, bfd_boolean);
+
+extern void
+bfd_elf64_riscv_set_relax_stats (struct bfd_link_info *, bfd_boolean);
+
+extern const struct riscv_relax_stats *
+bfd_elf32_riscv_get_relax_stats (struct bfd_link_info *, unsigned int *);
+
+extern const struct riscv_relax_stats *
+bfd_elf64_riscv_get_relax_stats (struct bfd_link_info *, unsigned int *);
+
+extern bfd_boolean
+bfd_elf32_riscv_pack_relative_relocs (struct bfd_link_info *);
+
+extern bfd_boolean
+bfd_elf64_riscv_pack_relative_relocs (struct bfd_link_info *);
+
+extern bfd_boolean
+bfd_elf32_riscv_size_relative_relocs (struct bfd_link_info *, bfd_boolean *);
+
+extern bfd_boolean
+bfd_elf64_riscv_size_relative_relocs (struct bfd_link_info *, bfd_boolean *);
+
+extern bfd_boolean
+bfd_elf32_riscv_size_call_islands (struct bfd_link_info *,
+				   bfd_boolean (*) (asection *, asection *),
+				   void (*) (void));
+
+extern bfd_boolean
+bfd_elf64_riscv_size_call_islands (struct bfd_link_info *,
+				   bfd_boolean (*) (asection *, asection *),
+				   void (*) (void));
@@ -177,6 +177,9 @@
 #ifndef elf_backend_gc_sweep_hook
 #define elf_backend_gc_sweep_hook	NULL
 #endif
+#ifndef elf_backend_icf_address_reloc_p
+#define elf_backend_icf_address_reloc_p	NULL
+#endif
 #ifndef bfd_elfNN_bfd_gc_sections
 #define bfd_elfNN_bfd_gc_sections bfd_elf_gc_sections
 #endif
@@ -802,6 +805,7 @@ static struct elf_backend_data elfNN_bed =
   elf_backend_gc_mark_hook,
   elf_backend_gc_mark_extra_sections,
   elf_backend_gc_sweep_hook,
+  elf_backend_icf_address_reloc_p,
   elf_backend_post_process_headers,
   elf_backend_print_symbol_all,
   elf_backend_output_arch_local_syms,
@@ -192,6 +192,8 @@ static unsigned int dynamic_syminfo_nent;
 static char program_interpreter[PATH_MAX];
 static bfd_vma dynamic_info[DT_ENCODING];
 static bfd_vma dynamic_info_DT_GNU_HASH;
+static bfd_vma dynamic_info_DT_RELR;
+static bfd_vma dynamic_info_DT_RELRSZ;
 static bfd_vma version_info[16];
 static Elf_Internal_Ehdr elf_header;
 static Elf_Internal_Shdr * section_headers;
@@ -2056,6 +2058,9 @@ get_dynamic_type (unsigned long type)
     case DT_PREINIT_ARRAY: return "PREINIT_ARRAY";
     case DT_PREINIT_ARRAYSZ: return "PREINIT_ARRAYSZ";
     case DT_SYMTAB_SHNDX: return "SYMTAB_SHNDX";
+    case DT_RELRSZ:	return "RELRSZ";
+    case DT_RELR:	return "RELR";
+    case DT_RELRENT:	return "RELRENT";
 
     case DT_CHECKSUM:	return "CHECKSUM";
     case DT_PLTPADSZ:	return "PLTPADSZ";
@@ -4122,6 +4127,7 @@ get_section_type_name (unsigned int sh_type)
     case SHT_GNU_HASH:		return "GNU_HASH";
     case SHT_GROUP:		return "GROUP";
     case SHT_SYMTAB_SHNDX:	return "SYMTAB SECTION INDICIES";
+    case SHT_RELR:		return "RELR";
     case SHT_GNU_verdef:	return "VERDEF";
     case SHT_GNU_verneed:	return "VERNEED";
     case SHT_GNU_versym:	return "VERSYM";
@@ -6970,6 +6976,82 @@ static struct
 
 /* Process the reloc section.  */
 
+/* Display the packed relative relocations of RELR_SIZE bytes at file
+   offset RELR_OFFSET.  An entry with the low bit clear is the address
+   of a word to be relocated; an entry with the low bit set is a bitmap
+   of which of the following 63 (or 31) words are relocated too.  */
+
+static void
+dump_relr_relocations (FILE *         file,
+		       unsigned long  relr_offset,
+		       unsigned long  relr_size)
+{
+  unsigned int entsize = is_32bit_elf ? 4 : 8;
+  unsigned int width = is_32bit_elf ? 8 : 16;
+  unsigned long nentries = relr_size / entsize;
+  unsigned long nlocs = 0;
+  unsigned long i;
+  unsigned char * data;
+  bfd_vma base = 0;
+
+  data = (unsigned char *) get_data (NULL, file, relr_offset, nentries,
+				     entsize, _("packed relocs"));
+  if (data == NULL)
+    return;
+
+  for (i = 0; i < nentries; i++)
+    {
+      bfd_vma entry = byte_get (data + i * entsize, entsize);
+
+      if ((entry & 1) == 0)
+	nlocs++;
+      else
+	for (entry >>= 1; entry != 0; entry >>= 1)
+	  nlocs += entry & 1;
+    }
+
+  printf (_(" at offset 0x%lx contains %lu entries which relocate"
+	    " %lu locations:\n"), relr_offset, nentries, nlocs);
+  printf (_(" Index: %-*s %s\n"), width, _("Entry"), _("Address"));
+
+  for (i = 0; i < nentries; i++)
+    {
+      bfd_vma entry = byte_get (data + i * entsize, entsize);
+      bfd_vma addr;
+      bfd_boolean first = TRUE;
+
+      printf ("%6lu: ", i);
+      print_vma (entry, LONG_HEX);
+
+      if ((entry & 1) == 0)
+	{
+	  putchar (' ');
+	  print_vma (entry, LONG_HEX);
+	  putchar ('\n');
+	  base = entry + entsize;
+	  continue;
+	}
+
+      for (addr = base, entry >>= 1; entry != 0; entry >>= 1, addr += entsize)
+	if (entry & 1)
+	  {
+	    if (!first)
+	      printf ("%*s", 8 + width, "");
+	    putchar (' ');
+	    print_vma (addr, LONG_HEX);
+	    putchar ('\n');
+	    first = FALSE;
+	  }
+      /* A bitmap with no bits set, such as the padding the linker
+	 adds, relocates nothing but still ends its line.  */
+      if (first)
+	putchar ('\n');
+      base += (entsize * 8 - 1) * entsize;
+    }
+
+  free (data);
+}
+
 static bfd_boolean
 process_relocs (FILE * file)
 {
@@ -7027,6 +7109,16 @@ process_relocs (FILE * file)
 	    }
 	}
 
+      if (dynamic_info_DT_RELRSZ)
+	{
+	  has_dynamic_reloc = TRUE;
+	  printf (_("\n'RELR' relocation section"));
+	  dump_relr_relocations (file,
+				 offset_from_vma (file, dynamic_info_DT_RELR,
+						  dynamic_info_DT_RELRSZ),
+				 dynamic_info_DT_RELRSZ);
+	}
+
       if (is_ia64_vms ())
         if (process_ia64_vms_dynamic_relocs (file))
 	  has_dynamic_reloc = TRUE;
@@ -7045,7 +7137,8 @@ process_relocs (FILE * file)
 	   i++, section++)
 	{
 	  if (   section->sh_type != SHT_RELA
-	      && section->sh_type != SHT_REL)
+	      && section->sh_type != SHT_REL
+	      && section->sh_type != SHT_RELR)
 	    continue;
 
 	  rel_offset = section->sh_offset;
@@ -7063,6 +7156,13 @@ process_relocs (FILE * file)
 	      else
 		printf ("'%s'", printable_section_name (section));
 
+	      if (section->sh_type == SHT_RELR)
+		{
+		  dump_relr_relocations (file, rel_offset, rel_size);
+		  found = TRUE;
+		  continue;
+		}
+
 	      printf (_(" at offset 0x%lx contains %lu entries:\n"),
 		 rel_offset, (unsigned long) (rel_size / section->sh_entsize));
 
@@ -10061,6 +10161,26 @@ process_dynamic_section (FILE * file)
 	    }
 	  break;
 
+	case DT_RELR:
+	  dynamic_info_DT_RELR = entry->d_un.d_val;
+	  if (do_dynamic)
+	    {
+	      print_vma (entry->d_un.d_val, PREFIX_HEX);
+	      putchar ('\n');
+	    }
+	  break;
+
+	case DT_RELRSZ:
+	  dynamic_info_DT_RELRSZ = entry->d_un.d_val;
+	  /* Fall through.  */
+	case DT_RELRENT:
+	  if (do_dynamic)
+	    {
+	      print_vma (entry->d_un.d_val, UNSIGNED);
+	      printf (_(" (bytes)\n"));
+	    }
+	  break;
+
 	default:
 	  if ((entry->d_tag >= DT_VERSYM) && (entry->d_tag <= DT_VERNEEDNUM))
 	    version_info[DT_VERSIONTAGIDX (entry->d_tag)] =
@@ -18018,6 +18138,8 @@ process_object (char * file_name, FILE * file)
   for (i = ARRAY_SIZE (dynamic_info); i--;)
     dynamic_info[i] = 0;
   dynamic_info_DT_GNU_HASH = 0;
+  dynamic_info_DT_RELR = 0;
+  dynamic_info_DT_RELRSZ = 0;
 
   /* Process the file.  */
   if (show_name)
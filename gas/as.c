@@ -39,6 +39,7 @@
 #include "dwarf2dbg.h"
 #include "dw2gencfi.h"
 #include "bfdver.h"
+#include "safe-ctype.h"
 
 #ifdef HAVE_ITBL_CPU
 #include "itbl-ops.h"
@@ -46,6 +47,11 @@
 #define itbl_init()
 #endif
 
+#if defined (HAVE_FORK) && defined (HAVE_SYS_WAIT_H)
+#include <sys/wait.h>
+#define HAVE_BATCH 1
+#endif
+
 #ifdef HAVE_SBRK
 #ifdef NEED_DECLARATION_SBRK
 extern void *sbrk ();
@@ -131,6 +137,17 @@ char *start_sbrk;
 
 static int flag_macro_alternate;
 
+/* The file named by --batch, and the number of objects to assemble
+   from it at once.  */
+static const char *batch_file_name;
+static int batch_jobs = 1;
+
+/* Set if --MD was given.  */
+static int flag_depfile;
+
+/* Set if -o was given.  */
+static int flag_output;
+
 
 #ifdef USE_EMULATIONS
 #define EMULATION_ENVIRON "AS_EMULATION"
@@ -255,6 +272,11 @@ Options:\n\
 
   fprintf (stream, _("\
   --alternate             initially turn on alternate macro syntax\n"));
+  fprintf (stream, _("\
+  --batch=FILE            assemble each line of FILE, an output file\n\
+                          followed by its input files, as a separate object\n"));
+  fprintf (stream, _("\
+  --batch-jobs=NUM        assemble up to NUM objects from --batch at once\n"));
 #ifdef DEFAULT_FLAG_COMPRESS_DEBUG
   fprintf (stream, _("\
   --compress-debug-sections[={none|zlib|zlib-gnu|zlib-gabi}]\n\
@@ -322,7 +344,7 @@ Options:\n\
   fprintf (stream, _("\
   --gdwarf-sections       generate per-function section names for DWARF line information\n"));
   fprintf (stream, _("\
-  --hash-size=<value>     set the hash table size close to <value>\n"));
+  --hash-size=<value>     size hash tables for <value> entries initially\n"));
   fprintf (stream, _("\
   --help                  show this message and exit\n"));
   fprintf (stream, _("\
@@ -356,6 +378,8 @@ Options:\n\
   fprintf (stream, _("\
   --strip-local-absolute  strip local absolute symbols\n"));
   fprintf (stream, _("\
+  --threads=NUM           build the relocations of up to NUM sections at once\n"));
+  fprintf (stream, _("\
   --traditional-format    Use same format as native assembler when possible\n"));
   fprintf (stream, _("\
   --version               print assembler version number and exit\n"));
@@ -482,7 +506,10 @@ parse_args (int * pargc, char *** pargv)
       OPTION_WARN_FATAL,
       OPTION_COMPRESS_DEBUG,
       OPTION_NOCOMPRESS_DEBUG,
-      OPTION_NO_PAD_SECTIONS /* = STD_BASE + 40 */
+      OPTION_NO_PAD_SECTIONS,
+      OPTION_BATCH,
+      OPTION_BATCH_JOBS,
+      OPTION_THREADS /* = STD_BASE + 43 */
     /* When you add options here, check that they do
        not collide with OPTION_MD_BASE.  See as.h.  */
     };
@@ -500,6 +527,8 @@ parse_args (int * pargc, char *** pargv)
     ,{"a", optional_argument, NULL, 'a'}
     /* Handle -al=<FILE>.  */
     ,{"al", optional_argument, NULL, OPTION_AL}
+    ,{"batch", required_argument, NULL, OPTION_BATCH}
+    ,{"batch-jobs", required_argument, NULL, OPTION_BATCH_JOBS}
     ,{"compress-debug-sections", optional_argument, NULL, OPTION_COMPRESS_DEBUG}
     ,{"nocompress-debug-sections", no_argument, NULL, OPTION_NOCOMPRESS_DEBUG}
     ,{"debug-prefix-map", required_argument, NULL, OPTION_DEBUG_PREFIX_MAP}
@@ -553,6 +582,7 @@ parse_args (int * pargc, char *** pargv)
     ,{"version", no_argument, NULL, OPTION_VERSION}
     ,{"verbose", no_argument, NULL, OPTION_VERBOSE}
     ,{"target-help", no_argument, NULL, OPTION_TARGET_HELP}
+    ,{"threads", required_argument, NULL, OPTION_THREADS}
     ,{"traditional-format", no_argument, NULL, OPTION_TRADITIONAL_FORMAT}
     ,{"warn", no_argument, NULL, OPTION_WARN}
   };
@@ -780,6 +810,23 @@ This program has absolutely no warranty.\n"));
 
 	case OPTION_DEPFILE:
 	  start_dependencies (optarg);
+	  flag_depfile = 1;
+	  break;
+
+	case OPTION_BATCH:
+	  batch_file_name = optarg;
+	  break;
+
+	case OPTION_BATCH_JOBS:
+	  batch_jobs = atoi (optarg);
+	  if (batch_jobs <= 0)
+	    as_fatal (_("--batch-jobs needs a positive numeric argument"));
+	  break;
+
+	case OPTION_THREADS:
+	  flag_threads = atoi (optarg);
+	  if (flag_threads <= 0)
+	    as_fatal (_("--threads needs a positive numeric argument"));
 	  break;
 
 	case 'g':
@@ -1000,6 +1047,7 @@ This program has absolutely no warranty.\n"));
 
 	case 'o':
 	  out_file_name = xstrdup (optarg);
+	  flag_output = 1;
 	  break;
 
 	case 'w':
@@ -1010,9 +1058,8 @@ This program has absolutely no warranty.\n"));
 	  break;
 
 	case OPTION_REDUCE_MEMORY_OVERHEADS:
-	  /* The only change we make at the moment is to reduce
-	     the size of the hash tables that we use.  */
-	  set_gas_hash_table_size (4051);
+	  /* Nothing to do at the moment: hash tables start small and
+	     only grow as they fill up.  */
 	  break;
 
 	case OPTION_HASH_TABLE_SIZE:
@@ -1077,6 +1124,147 @@ close_output_file (void)
     unlink_if_ordinary (out_file_name);
 }
 
+/* Read the --batch file.  Return a NULL terminated vector with one
+   entry per object, each the output file name followed by the input
+   file names.  */
+
+static char ***
+read_batch_file (void)
+{
+  char ***jobs;
+  size_t njobs = 0, max_jobs = 16;
+  size_t size = 0, alloc = 4096, n;
+  unsigned int lineno = 0;
+  char *buf, *line, *next;
+  FILE *f;
+
+  f = fopen (batch_file_name, FOPEN_RT);
+  if (f == NULL)
+    as_fatal (_("can't open batch file `%s': %s"), batch_file_name,
+	      xstrerror (errno));
+
+  buf = XNEWVEC (char, alloc);
+  while ((n = fread (buf + size, 1, alloc - size - 1, f)) > 0)
+    {
+      size += n;
+      if (size + 1 == alloc)
+	{
+	  alloc *= 2;
+	  buf = XRESIZEVEC (char, buf, alloc);
+	}
+    }
+  if (ferror (f))
+    as_fatal (_("can't read batch file `%s': %s"), batch_file_name,
+	      xstrerror (errno));
+  fclose (f);
+  buf[size] = '\0';
+
+  jobs = XNEWVEC (char **, max_jobs + 1);
+  for (line = buf; *line != '\0'; line = next)
+    {
+      char **args;
+
+      lineno++;
+      next = strchr (line, '\n');
+      if (next != NULL)
+	*next++ = '\0';
+      else
+	next = line + strlen (line);
+
+      while (ISSPACE (*line))
+	line++;
+      if (*line == '\0' || *line == '#')
+	continue;
+
+      args = buildargv (line);
+      if (args == NULL || args[0] == NULL || args[1] == NULL)
+	as_fatal (_("%s:%u: expected an output file and input files"),
+		  batch_file_name, lineno);
+
+      if (njobs == max_jobs)
+	{
+	  max_jobs *= 2;
+	  jobs = XRESIZEVEC (char **, jobs, max_jobs + 1);
+	}
+      jobs[njobs++] = args;
+    }
+  jobs[njobs] = NULL;
+
+  free (buf);
+  return jobs;
+}
+
+/* Assemble each object named in the --batch file in a child process,
+   running up to batch_jobs of them at once.  The children start from
+   this process's state, so everything set up before the call is done
+   only once.  In each child, set the output file name and point
+   *PARGC and *PARGV at the input files, and return.  The parent exits
+   once every child has finished.  */
+
+static void
+run_batch (int *pargc, char ***pargv)
+{
+#ifdef HAVE_BATCH
+  char ***jobs, ***job;
+  int running = 0;
+  int failed = 0;
+  int status;
+
+  if (*pargc > 1)
+    as_fatal (_("input files can't be given with --batch"));
+  if (flag_output || listing_filename != NULL || flag_depfile)
+    as_fatal (_("--batch can't be used with -o, -a=FILE or --MD"));
+
+  jobs = read_batch_file ();
+
+  for (job = jobs; *job != NULL || running > 0; )
+    {
+      pid_t pid;
+
+      if (*job == NULL || running == batch_jobs)
+	{
+	  if (wait (&status) < 0)
+	    as_fatal (_("wait: %s"), xstrerror (errno));
+	  if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+	    failed = 1;
+	  running--;
+	  continue;
+	}
+
+      fflush (stdout);
+      fflush (stderr);
+      pid = fork ();
+      if (pid < 0)
+	as_fatal (_("fork: %s"), xstrerror (errno));
+      if (pid == 0)
+	{
+	  char **args = *job;
+	  int i;
+
+	  /* The child's run time starts from zero, so --statistics must
+	     measure from here.  */
+	  start_time = get_run_time ();
+	  out_file_name = args[0];
+	  for (i = 1; args[i] != NULL; i++)
+	    ;
+	  *pargv = XNEWVEC (char *, i + 1);
+	  (*pargv)[0] = myname;
+	  memcpy (*pargv + 1, args + 1, i * sizeof (char *));
+	  *pargc = i;
+	  return;
+	}
+      running++;
+      job++;
+    }
+
+  xexit (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+#else
+  (void) pargc;
+  (void) pargv;
+  as_fatal (_("--batch is not supported on this host"));
+#endif
+}
+
 /* The interface between the macro code and gas expression handling.  */
 
 static size_t
@@ -1238,12 +1426,9 @@ main (int argc, char ** argv)
   read_begin ();
   input_scrub_begin ();
   expr_begin ();
-
-  /* It has to be called after dump_statistics ().  */
-  xatexit (close_output_file);
-
-  if (flag_print_statistics)
-    xatexit (dump_statistics);
+#ifdef md_begin_tables
+  md_begin_tables ();
+#endif
 
   macro_strip_at = 0;
 #ifdef TC_I960
@@ -1252,6 +1437,19 @@ main (int argc, char ** argv)
 
   macro_init (flag_macro_alternate, flag_mri, macro_strip_at, macro_expr);
 
+  /* Everything up to here is the same for every object in a batch.  The
+     parent exits from run_batch, so only the children register the exit
+     handlers below: the parent has no output file of its own and does
+     not repeat the statistics of the objects.  */
+  if (batch_file_name != NULL)
+    run_batch (&argc, &argv);
+
+  /* It has to be called after dump_statistics ().  */
+  xatexit (close_output_file);
+
+  if (flag_print_statistics)
+    xatexit (dump_statistics);
+
   PROGRESS (1);
 
   output_file_create (out_file_name);
@@ -363,6 +363,9 @@ COMMON int flag_execstack;
 /* TRUE if .note.GNU-stack section with SEC_CODE should be created */
 COMMON int flag_noexecstack;
 
+/* Number of threads to build relocations on: --threads=NUM.  */
+COMMON int flag_threads;
+
 /* name of emitted object file */
 COMMON const char *out_file_name;
 
@@ -76,6 +76,7 @@ struct riscv_set_options
   int pic; /* Generate position-independent code.  */
   int rvc; /* Generate RVC code.  */
   int relax; /* Emit relocs the linker is allowed to relax.  */
+  int const_pool; /* Load long constants from a mergeable pool.  */
 };
 
 static struct riscv_set_options riscv_opts =
@@ -83,6 +84,7 @@ static struct riscv_set_options riscv_opts =
   0,	/* pic */
   0,	/* rvc */
   1,	/* relax */
+  0,	/* const_pool */
 };
 
 static void
@@ -94,52 +96,105 @@ riscv_set_rvc (bfd_boolean rvc_value)
   riscv_opts.rvc = rvc_value;
 }
 
-struct riscv_subset
+/* The ISA subsets that are enabled: one bit for each single-letter
+   standard extension, plus RISCV_SUBSET_X if -march names any
+   non-standard extensions.  Those are kept by name in
+   RISCV_EXTENSIONS.  */
+static unsigned riscv_subsets;
+
+struct riscv_extension
 {
-  const char *name;
+  char *name;
+  struct riscv_extension *next;
+};
+
+static struct riscv_extension *riscv_extensions;
 
-  struct riscv_subset *next;
+#define RISCV_SUBSET_X		(1u << 26)
+#define RISCV_SUBSET_UNKNOWN	(1u << 27)
+
+/* The subset requirements of each riscv_opcodes entry, precomputed by
+   riscv_begin_tables so that riscv_ip need not parse the subset names.  */
+struct riscv_opcode_subset
+{
+  /* The subsets that must all be enabled.  */
+  unsigned mask;
+  /* The required XLEN, or 0 if any will do.  */
+  unsigned xlen;
 };
 
-static struct riscv_subset *riscv_subsets;
+static struct riscv_opcode_subset *riscv_opcode_subsets;
+
+/* Return the bit for the ISA subset called NAME.  */
+
+static unsigned
+riscv_subset_mask (const char *name)
+{
+  if (TOLOWER (name[0]) == 'x')
+    {
+      struct riscv_extension *e;
+
+      for (e = riscv_extensions; e != NULL; e = e->next)
+	if (strcasecmp (name, e->name) == 0)
+	  return RISCV_SUBSET_X;
+      return RISCV_SUBSET_UNKNOWN;
+    }
+  if (ISALPHA (name[0]) && name[1] == '\0')
+    return 1u << (TOLOWER (name[0]) - 'a');
+  return RISCV_SUBSET_UNKNOWN;
+}
 
 static bfd_boolean
 riscv_subset_supports (const char *feature)
 {
-  struct riscv_subset *s;
   char *p;
   unsigned xlen_required = strtoul (feature, &p, 10);
 
   if (xlen_required && xlen != xlen_required)
     return FALSE;
 
-  for (s = riscv_subsets; s != NULL; s = s->next)
-    if (strcasecmp (s->name, p) == 0)
-      return TRUE;
+  return (riscv_subset_mask (p) & ~riscv_subsets) == 0;
+}
 
-  return FALSE;
+/* Return true if the ISA subsets that are enabled include INSN.  */
+
+static inline bfd_boolean
+riscv_insn_supported (const struct riscv_opcode *insn)
+{
+  const struct riscv_opcode_subset *subset
+    = &riscv_opcode_subsets[insn - riscv_opcodes];
+
+  return ((subset->xlen == 0 || subset->xlen == xlen)
+	  && (subset->mask & ~riscv_subsets) == 0);
 }
 
 static void
 riscv_clear_subsets (void)
 {
-  while (riscv_subsets != NULL)
+  riscv_subsets = 0;
+  while (riscv_extensions != NULL)
     {
-      struct riscv_subset *next = riscv_subsets->next;
-      free ((void *) riscv_subsets->name);
-      free (riscv_subsets);
-      riscv_subsets = next;
+      struct riscv_extension *next = riscv_extensions->next;
+
+      free (riscv_extensions->name);
+      free (riscv_extensions);
+      riscv_extensions = next;
     }
 }
 
 static void
 riscv_add_subset (const char *subset)
 {
-  struct riscv_subset *s = xmalloc (sizeof *s);
+  if (TOLOWER (subset[0]) == 'x'
+      && riscv_subset_mask (subset) == RISCV_SUBSET_UNKNOWN)
+    {
+      struct riscv_extension *e = XNEW (struct riscv_extension);
 
-  s->name = xstrdup (subset);
-  s->next = riscv_subsets;
-  riscv_subsets = s;
+      e->name = xstrdup (subset);
+      e->next = riscv_extensions;
+      riscv_extensions = e;
+    }
+  riscv_subsets |= riscv_subset_mask (subset);
 }
 
 /* Set which ISA and extensions are available.  */
@@ -148,7 +203,6 @@ static void
 riscv_set_arch (const char *s)
 {
   const char *all_subsets = "imafdqc";
-  char *extension = NULL;
   const char *p = s;
 
   riscv_clear_subsets();
@@ -195,12 +249,9 @@ riscv_set_arch (const char *s)
 	    ;
 	  *q = '\0';
 
-	  if (extension)
-	    as_fatal ("-march=%s: only one non-standard extension is supported"
-		      " (found `%s' and `%s')", s, extension, subset);
-	  extension = subset;
 	  riscv_add_subset (subset);
 	  p += strlen (subset);
+	  free (subset);
 	}
       else if (*p == '_')
 	p++;
@@ -214,13 +265,8 @@ riscv_set_arch (const char *s)
       else
 	as_fatal ("-march=%s: unsupported ISA subset `%c'", s, *p);
     }
-
-  free (extension);
 }
 
-/* Handle of the OPCODE hash table.  */
-static struct hash_control *op_hash = NULL;
-
 /* This array holds the chars that always start a comment.  If the
     pre-processor is disabled, these aren't very useful */
 const char comment_chars[] = "#";
@@ -391,12 +437,6 @@ relaxed_branch_length (fragS *fragp, asection *sec, int update)
   return length;
 }
 
-struct regname
-{
-  const char *name;
-  unsigned int num;
-};
-
 enum reg_class
 {
   RCLASS_GPR,
@@ -406,47 +446,74 @@ enum reg_class
   RCLASS_MAX
 };
 
-static struct hash_control *reg_names_hash = NULL;
+/* Perfect hash tables for the mnemonics and register names, generated
+   by riscv-gen from riscv_opcodes and the DECLARE_CSR list.  */
+#include "opcodes/riscv-hash.h"
 
-#define ENCODE_REG_HASH(cls, n) \
-  ((void *)(uintptr_t)((n) * RCLASS_MAX + (cls) + 1))
-#define DECODE_REG_CLASS(hash) (((uintptr_t)(hash) - 1) % RCLASS_MAX)
-#define DECODE_REG_NUM(hash) (((uintptr_t)(hash) - 1) / RCLASS_MAX)
+/* Return the first riscv_opcodes entry for the LEN-character mnemonic at
+   NAME, which need not be NUL-terminated, or NULL if there is none.  */
 
-static void
-hash_reg_name (enum reg_class class, const char *name, unsigned n)
+static const struct riscv_opcode *
+riscv_opcode_lookup (const char *name, size_t len)
 {
-  void *hash = ENCODE_REG_HASH (class, n);
-  const char *retval = hash_insert (reg_names_hash, name, hash);
+  uint32_t hash = riscv_name_hash (name, len);
+  unsigned int disp =
+    riscv_opcode_hash_disp[hash & (RISCV_OPCODE_HASH_BUCKETS - 1)];
+  unsigned int index =
+    riscv_opcode_hash_index[riscv_name_slot (hash, disp,
+					     RISCV_OPCODE_HASH_SLOTS - 1)];
+  const struct riscv_opcode *insn;
 
-  if (retval != NULL)
-    as_fatal (_("internal error: can't hash `%s': %s"), name, retval);
+  if (index == RISCV_HASH_EMPTY)
+    return NULL;
+  insn = &riscv_opcodes[index];
+  if (strncmp (insn->name, name, len) != 0 || insn->name[len] != '\0')
+    return NULL;
+  return insn;
 }
 
-static void
-hash_reg_names (enum reg_class class, const char * const names[], unsigned n)
+/* Return the number of the LEN-character register name at S if it is
+   in CLASS, otherwise -1.  */
+
+static int
+reg_lookup_internal (const char *s, size_t len, enum reg_class class)
 {
-  unsigned i;
+  uint32_t hash = riscv_name_hash (s, len);
+  unsigned int disp = riscv_reg_hash_disp[hash & (RISCV_REG_HASH_BUCKETS - 1)];
+  const struct riscv_reg_hash_entry *r =
+    &riscv_reg_hash_table[riscv_name_slot (hash, disp,
+					   RISCV_REG_HASH_SLOTS - 1)];
 
-  for (i = 0; i < n; i++)
-    hash_reg_name (class, names[i], i);
+  if (r->name == NULL || r->rclass != class
+      || strncmp (r->name, s, len) != 0 || r->name[len] != '\0')
+    return -1;
+  return r->num;
 }
 
-static unsigned int
-reg_lookup_internal (const char *s, enum reg_class class)
+/* Check that the generated tables agree with the register name tables
+   gas was linked against.  */
+
+static void
+check_reg_name (enum reg_class class, const char *name, unsigned n)
 {
-  struct regname *r = (struct regname *) hash_find (reg_names_hash, s);
+  if (reg_lookup_internal (name, strlen (name), class) != (int) n)
+    as_fatal (_("internal error: opcodes/riscv-hash.h is out of date "
+		"for `%s'"), name);
+}
 
-  if (r == NULL || DECODE_REG_CLASS (r) != class)
-    return -1;
-  return DECODE_REG_NUM (r);
+static void
+check_reg_names (enum reg_class class, const char * const names[], unsigned n)
+{
+  unsigned i;
+
+  for (i = 0; i < n; i++)
+    check_reg_name (class, names[i], i);
 }
 
 static bfd_boolean
 reg_lookup (char **s, enum reg_class class, unsigned int *regnop)
 {
   char *e;
-  char save_c;
   int reg = -1;
 
   /* Find end of name.  */
@@ -456,15 +523,10 @@ reg_lookup (char **s, enum reg_class class, unsigned int *regnop)
   while (is_part_of_name (*e))
     ++e;
 
-  /* Terminate name.  */
-  save_c = *e;
-  *e = '\0';
-
   /* Look for the register.  Advance to next token if one was recognized.  */
-  if ((reg = reg_lookup_internal (*s, class)) >= 0)
+  if ((reg = reg_lookup_internal (*s, e - *s, class)) >= 0)
     *s = e;
 
-  *e = save_c;
   if (regnop)
     *regnop = reg;
   return reg >= 0;
@@ -622,35 +684,36 @@ struct percent_op_match
 };
 
 /* This function is called once, at assembler startup time.  It should set up
-   all the tables, etc. that the MD part of the assembler will need.  */
+   all the tables, etc. that the MD part of the assembler will need.  They
+   depend only on the command line, so with --batch this is done once for
+   all the objects.  */
 
 void
-md_begin (void)
+riscv_begin_tables (void)
 {
   int i = 0;
-  unsigned long mach = xlen == 64 ? bfd_mach_riscv64 : bfd_mach_riscv32;
 
-  if (! bfd_set_arch_mach (stdoutput, bfd_arch_riscv, mach))
-    as_warn (_("Could not set architecture and machine"));
-
-  op_hash = hash_new ();
+  while (riscv_opcodes[i].name)
+    i++;
+  riscv_opcode_subsets = XNEWVEC (struct riscv_opcode_subset, i);
+  i = 0;
 
   while (riscv_opcodes[i].name)
     {
       const char *name = riscv_opcodes[i].name;
-      const char *hash_error =
-	hash_insert (op_hash, name, (void *) &riscv_opcodes[i]);
 
-      if (hash_error)
-	{
-	  fprintf (stderr, _("internal error: can't hash `%s': %s\n"),
-		   riscv_opcodes[i].name, hash_error);
-	  /* Probably a memory allocation problem?  Give up now.  */
-	  as_fatal (_("Broken assembler.  No assembly attempted."));
-	}
+      if (riscv_opcode_lookup (name, strlen (name)) != &riscv_opcodes[i])
+	as_fatal (_("internal error: opcodes/riscv-hash.h is out of date "
+		    "for `%s'"), name);
 
       do
 	{
+	  char *subset;
+
+	  riscv_opcode_subsets[i].xlen = strtoul (riscv_opcodes[i].subset,
+						  &subset, 10);
+	  riscv_opcode_subsets[i].mask = riscv_subset_mask (subset);
+
 	  if (riscv_opcodes[i].pinfo != INSN_MACRO)
 	    {
 	      if (!validate_riscv_insn (&riscv_opcodes[i]))
@@ -661,17 +724,28 @@ md_begin (void)
       while (riscv_opcodes[i].name && !strcmp (riscv_opcodes[i].name, name));
     }
 
-  reg_names_hash = hash_new ();
-  hash_reg_names (RCLASS_GPR, riscv_gpr_names_numeric, NGPR);
-  hash_reg_names (RCLASS_GPR, riscv_gpr_names_abi, NGPR);
-  hash_reg_names (RCLASS_FPR, riscv_fpr_names_numeric, NFPR);
-  hash_reg_names (RCLASS_FPR, riscv_fpr_names_abi, NFPR);
-  hash_reg_names (RCLASS_VPR, riscv_vpr_names_numeric, 32);
+  check_reg_names (RCLASS_GPR, riscv_gpr_names_numeric, NGPR);
+  check_reg_names (RCLASS_GPR, riscv_gpr_names_abi, NGPR);
+  check_reg_names (RCLASS_FPR, riscv_fpr_names_numeric, NFPR);
+  check_reg_names (RCLASS_FPR, riscv_fpr_names_abi, NFPR);
+  check_reg_names (RCLASS_VPR, riscv_vpr_names_numeric, NVPR);
 
-#define DECLARE_CSR(name, num) hash_reg_name (RCLASS_CSR, #name, num);
+#define DECLARE_CSR(name, num) check_reg_name (RCLASS_CSR, #name, num);
 #define DECLARE_CSR_ALIAS(name, num) DECLARE_CSR(name, num);
 #include "opcode/riscv-opc.h"
 #undef DECLARE_CSR
+}
+
+/* This function is called at the start of each object, once its output
+   file has been opened.  */
+
+void
+md_begin (void)
+{
+  unsigned long mach = xlen == 64 ? bfd_mach_riscv64 : bfd_mach_riscv32;
+
+  if (! bfd_set_arch_mach (stdoutput, bfd_arch_riscv, mach))
+    as_warn (_("Could not set architecture and machine"));
 
   /* Set the default alignment for the text section.  */
   record_alignment (text_section, riscv_opts.rvc ? 1 : 2);
@@ -743,28 +817,80 @@ append_insn (struct riscv_cl_insn *ip, expressionS *address_expr,
   add_fixed_insn (ip);
   install_insn (ip);
 
-  /* We need to start a new frag after any instruction that can be
-     optimized away or compressed by the linker during relaxation, to prevent
-     the assembler from computing static offsets across such an instruction.
-     This is necessary to get correct EH info.  */
-  if (reloc_type == BFD_RELOC_RISCV_CALL
-      || reloc_type == BFD_RELOC_RISCV_CALL_PLT
-      || reloc_type == BFD_RELOC_RISCV_HI20
-      || reloc_type == BFD_RELOC_RISCV_PCREL_HI20
-      || reloc_type == BFD_RELOC_RISCV_TPREL_HI20
-      || reloc_type == BFD_RELOC_RISCV_TPREL_ADD)
+  /* The assembler must not compute static offsets across an instruction
+     that can be optimized away or compressed by the linker during
+     relaxation.  Only EH and line info do so, and only across frags not
+     so marked, so note the instruction here and let
+     riscv_close_relaxable_frag start a new frag if such info follows.  */
+  if (riscv_opts.relax
+      && (reloc_type == BFD_RELOC_RISCV_CALL
+	  || reloc_type == BFD_RELOC_RISCV_CALL_PLT
+	  || reloc_type == BFD_RELOC_RISCV_HI20
+	  || reloc_type == BFD_RELOC_RISCV_PCREL_HI20
+	  || reloc_type == BFD_RELOC_RISCV_GOT_HI20
+	  || reloc_type == BFD_RELOC_RISCV_TLS_GOT_HI20
+	  || reloc_type == BFD_RELOC_RISCV_TLS_GD_HI20
+	  || reloc_type == BFD_RELOC_RISCV_TPREL_HI20
+	  || reloc_type == BFD_RELOC_RISCV_TPREL_ADD))
+    frag_now->tc_frag_data = TRUE;
+}
+
+/* Replace the 32-bit instruction IP with its RVC equivalent, if it has
+   one that does the same thing with the same operands.  Only the forms
+   that macro expansions emit without a relocation are handled; riscv_ip
+   already picks the compressed variants of the user's instructions.  */
+
+static void
+riscv_compress_insn (struct riscv_cl_insn *ip)
+{
+  insn_t insn = ip->insn_opcode;
+  int rd = EXTRACT_OPERAND (RD, insn);
+  int rs1 = EXTRACT_OPERAND (RS1, insn);
+  offsetT imm;
+
+  if (rd == 0)
+    return;
+
+  if ((insn & MASK_LUI) == MATCH_LUI)
     {
-      frag_wane (frag_now);
-      frag_new (0);
+      imm = EXTRACT_UTYPE_IMM (insn);
+      if (rd != X_SP && VALID_RVC_LUI_IMM (imm))
+	ip->insn_opcode = (MATCH_C_LUI | (rd << OP_SH_RD)
+			   | ENCODE_RVC_LUI_IMM (imm));
+    }
+  else if ((insn & MASK_ADDI) == MATCH_ADDI
+	   || (xlen == 64 && (insn & MASK_ADDIW) == MATCH_ADDIW))
+    {
+      imm = EXTRACT_ITYPE_IMM (insn);
+      if (!VALID_RVC_IMM (imm))
+	return;
+      if (rs1 == 0)
+	ip->insn_opcode = MATCH_C_LI | (rd << OP_SH_RD) | ENCODE_RVC_IMM (imm);
+      else if (rs1 != rd)
+	return;
+      else if ((insn & MASK_ADDIW) == MATCH_ADDIW)
+	ip->insn_opcode = (MATCH_C_ADDIW | (rd << OP_SH_RD)
+			   | ENCODE_RVC_IMM (imm));
+      else if (imm != 0)
+	ip->insn_opcode = (MATCH_C_ADDI | (rd << OP_SH_RD)
+			   | ENCODE_RVC_IMM (imm));
+    }
+  else if ((insn & MASK_SLLI) == MATCH_SLLI)
+    {
+      imm = EXTRACT_OPERAND (SHAMT, insn);
+      if (rs1 == rd && imm != 0 && imm < xlen)
+	ip->insn_opcode = (MATCH_C_SLLI | (rd << OP_SH_RD)
+			   | ENCODE_RVC_IMM (imm));
     }
 }
 
 /* Build an instruction created by a macro expansion.  This is passed
    a pointer to the count of instructions created so far, an
    expression, the name of the instruction to build, an operand format
-   string, and corresponding arguments.  */
+   string, and corresponding arguments.  Return the fixup for the
+   expression, if any.  */
 
-static void
+static fixS *
 macro_build (expressionS *ep, const char *name, const char *fmt, ...)
 {
   const struct riscv_opcode *mo;
@@ -775,11 +901,11 @@ macro_build (expressionS *ep, const char *name, const char *fmt, ...)
   va_start (args, fmt);
 
   r = BFD_RELOC_UNUSED;
-  mo = (struct riscv_opcode *) hash_find (op_hash, name);
+  mo = riscv_opcode_lookup (name, strlen (name));
   gas_assert (mo);
 
-  /* Find a non-RVC variant of the instruction.  append_insn will compress
-     it if possible.  */
+  /* Find a non-RVC variant of the instruction.  It is compressed below
+     once its operands are known.  */
   while (riscv_insn_length (mo->match) < 4)
     mo++;
   gas_assert (strcmp (name, mo->name) == 0);
@@ -824,7 +950,27 @@ macro_build (expressionS *ep, const char *name, const char *fmt, ...)
   va_end (args);
   gas_assert (r == BFD_RELOC_UNUSED ? ep == NULL : ep != NULL);
 
+  /* The absolute relocations against a constant would be resolved by
+     md_apply_fix anyway; do it now so that the result can be compressed.
+     Leave values that do not fit for fixup_segment to complain about.  */
+  if (ep != NULL
+      && ep->X_op == O_constant
+      && (IS_SEXT_32BIT_NUM (ep->X_add_number)
+	  || IS_ZEXT_32BIT_NUM (ep->X_add_number))
+      && (r == BFD_RELOC_RISCV_HI20
+	  || r == BFD_RELOC_RISCV_LO12_I
+	  || r == BFD_RELOC_RISCV_LO12_S))
+    {
+      insn.insn_opcode |= riscv_apply_const_reloc (r, ep->X_add_number);
+      ep = NULL;
+      r = BFD_RELOC_UNUSED;
+    }
+
+  if (riscv_opts.rvc && r == BFD_RELOC_UNUSED)
+    riscv_compress_insn (&insn);
+
   append_insn (&insn, ep, r);
+  return insn.fixp;
 }
 
 /* Sign-extend 32-bit mode constants that have bit 31 set and all higher bits
@@ -860,7 +1006,9 @@ make_internal_label (void)
 					(valueT) frag_now_fix (), frag_now);
 }
 
-/* Load an entry from the GOT.  */
+/* Load an entry from the GOT.  The low part refers to the AUIPC by its
+   offset in the frag; md_apply_fix gives it a label only when the
+   relocation is written out.  */
 static void
 pcrel_access (int destreg, int tempreg, expressionS *ep,
 	      const char *lo_insn, const char *lo_pattern,
@@ -868,12 +1016,25 @@ pcrel_access (int destreg, int tempreg, expressionS *ep,
 	      bfd_reloc_code_real_type lo_reloc)
 {
   expressionS ep2;
-  ep2.X_op = O_symbol;
-  ep2.X_add_symbol = make_internal_label ();
-  ep2.X_add_number = 0;
+  fragS *anchor_frag;
+  fixS *lo_fix;
+
+  /* Keep both instructions in one frag.  A line entry for the AUIPC
+     could start a new frag, so do that first.  */
+  if (dwarf2_loc_directive_seen || debug_type == DEBUG_DWARF2)
+    riscv_close_relaxable_frag ();
+  frag_grow (8);
+  anchor_frag = frag_now;
+
+  ep2.X_op = O_constant;
+  ep2.X_add_symbol = NULL;
+  ep2.X_add_number = frag_now_fix ();
 
   macro_build (ep, "auipc", "d,u", tempreg, hi_reloc);
-  macro_build (&ep2, lo_insn, lo_pattern, destreg, tempreg, lo_reloc);
+  lo_fix = macro_build (&ep2, lo_insn, lo_pattern, destreg, tempreg,
+			lo_reloc);
+  gas_assert (lo_fix->fx_frag == anchor_frag);
+  lo_fix->fx_tcbit2 = 1;
 }
 
 static void
@@ -947,6 +1108,93 @@ load_const (int reg, expressionS *ep)
     }
 }
 
+/* Return the number of instructions load_const needs to build VALUE.  */
+
+static unsigned int
+load_const_insns (offsetT value)
+{
+  int shift = RISCV_IMM_BITS;
+  offsetT lower = (int32_t) value << (32-shift) >> (32-shift);
+  offsetT upper = value - lower;
+
+  if (xlen > 32 && !IS_SEXT_32BIT_NUM (value))
+    {
+      while (((upper >> shift) & 1) == 0)
+	shift++;
+
+      return (load_const_insns ((int64_t) upper >> shift)
+	      + 1 + (lower != 0));
+    }
+
+  return (upper != 0) + (lower != 0 || upper == 0);
+}
+
+/* The constant pool entries made so far, keyed by value.  */
+static struct hash_control *const_pool_hash = NULL;
+
+/* The section holding them.  */
+static segT const_pool_section = NULL;
+
+/* Return the label of the pool entry holding VALUE, emitting it into the
+   mergeable .srodata.cst8 section if this is the first use.  The linker
+   then shares it with the same constant from every other object.  */
+
+static symbolS *
+const_pool_entry (offsetT value)
+{
+  segT seg = now_seg;
+  subsegT subseg = now_subseg;
+  const char *retval;
+  char key[32];
+  symbolS *sym;
+  char *p;
+
+  if (const_pool_hash == NULL)
+    const_pool_hash = hash_new ();
+
+  sprintf (key, "%" BFD_VMA_FMT "x", (bfd_vma) value);
+  sym = (symbolS *) hash_find (const_pool_hash, key);
+  if (sym != NULL)
+    return sym;
+
+  if (const_pool_section == NULL)
+    {
+      const_pool_section = subseg_new (".srodata.cst8", 0);
+      bfd_set_section_flags (stdoutput, const_pool_section,
+			     (SEC_ALLOC | SEC_LOAD | SEC_READONLY | SEC_DATA
+			      | SEC_MERGE));
+      const_pool_section->entsize = 8;
+    }
+  else
+    subseg_set (const_pool_section, 0);
+
+  frag_align (3, 0, 0);
+  record_alignment (const_pool_section, 3);
+  sym = make_internal_label ();
+  p = frag_more (8);
+  md_number_to_chars (p, value, 8);
+  subseg_set (seg, subseg);
+
+  retval = hash_insert (const_pool_hash, xstrdup (key), sym);
+  if (retval != NULL)
+    as_fatal (_("internal error: can't hash `%s': %s"), key, retval);
+  return sym;
+}
+
+/* Load VALUE into REG from the constant pool.  */
+
+static void
+load_const_from_pool (int reg, offsetT value)
+{
+  expressionS ep;
+
+  ep.X_op = O_symbol;
+  ep.X_add_symbol = const_pool_entry (value);
+  ep.X_add_number = 0;
+  pcrel_load (reg, reg, &ep, "ld",
+	      BFD_RELOC_RISCV_PCREL_HI20, BFD_RELOC_RISCV_PCREL_LO12_I);
+}
+
 /* Expand RISC-V assembly macros into one or more instructions.  */
 static void
 macro (struct riscv_cl_insn *ip, expressionS *imm_expr,
@@ -960,7 +1208,16 @@ macro (struct riscv_cl_insn *ip, expressionS *imm_expr,
   switch (mask)
     {
     case M_LI:
-      load_const (rd, imm_expr);
+      /* AUIPC and LD, which relaxation may turn into just LD.  The
+	 AUIPC needs a base register, so x0 keeps the inline sequence.  */
+      if (riscv_opts.const_pool
+	  && xlen == 64
+	  && rd != 0
+	  && imm_expr->X_op == O_constant
+	  && load_const_insns (imm_expr->X_add_number) > 3)
+	load_const_from_pool (rd, imm_expr->X_add_number);
+      else
+	load_const (rd, imm_expr);
       break;
 
     case M_LA:
@@ -1272,7 +1529,7 @@ riscv_ip (char *str, struct riscv_cl_insn *ip, expressionS *imm_expr,
   char *s;
   const char *args;
   char c = 0;
-  struct riscv_opcode *insn;
+  const struct riscv_opcode *insn;
   char *argsStart;
   unsigned int regno;
   char save_c = 0;
@@ -1281,7 +1538,7 @@ riscv_ip (char *str, struct riscv_cl_insn *ip, expressionS *imm_expr,
   const char *error = "unrecognized opcode";
 
   /* Parse the name of the instruction.  Terminate the string if whitespace
-     is found so that hash_find only sees the name part of the string.  */
+     is found so that the strcmp below only sees the name part.  */
   for (s = str; *s != '\0'; ++s)
     if (ISSPACE (*s))
       {
@@ -1290,12 +1547,12 @@ riscv_ip (char *str, struct riscv_cl_insn *ip, expressionS *imm_expr,
 	break;
       }
 
-  insn = (struct riscv_opcode *) hash_find (op_hash, str);
+  insn = riscv_opcode_lookup (str, strlen (str));
 
   argsStart = s;
   for ( ; insn && insn->name && strcmp (insn->name, str) == 0; insn++)
     {
-      if (!riscv_subset_supports (insn->subset))
+      if (!riscv_insn_supported (insn))
 	continue;
 
       create_insn (ip, insn);
@@ -1905,6 +2162,8 @@ enum options
   OPTION_PIC,
   OPTION_NO_PIC,
   OPTION_MABI,
+  OPTION_CONST_POOL,
+  OPTION_NO_CONST_POOL,
   OPTION_END_OF_ENUM
 };
 
@@ -1915,6 +2174,8 @@ struct option md_longopts[] =
   {"fpic", no_argument, NULL, OPTION_PIC},
   {"fno-pic", no_argument, NULL, OPTION_NO_PIC},
   {"mabi", required_argument, NULL, OPTION_MABI},
+  {"mconst-pool", no_argument, NULL, OPTION_CONST_POOL},
+  {"mno-const-pool", no_argument, NULL, OPTION_NO_CONST_POOL},
 
   {NULL, no_argument, NULL, 0}
 };
@@ -1953,6 +2214,14 @@ md_parse_option (int c, const char *arg)
       riscv_opts.pic = TRUE;
       break;
 
+    case OPTION_CONST_POOL:
+      riscv_opts.const_pool = TRUE;
+      break;
+
+    case OPTION_NO_CONST_POOL:
+      riscv_opts.const_pool = FALSE;
+      break;
+
     case OPTION_MABI:
       if (strcmp (arg, "ilp32") == 0)
 	riscv_set_abi (32, FLOAT_ABI_SOFT);
@@ -1994,7 +2263,7 @@ riscv_after_parse_args (void)
 	as_bad ("unknown default architecture `%s'", default_arch);
     }
 
-  if (riscv_subsets == NULL)
+  if (riscv_subsets == 0)
     riscv_set_arch (xlen == 64 ? "rv64g" : "rv32g");
 
   /* Add the RVC extension, regardless of -march, to support .option rvc.  */
@@ -2014,18 +2283,13 @@ riscv_after_parse_args (void)
 
   if (float_abi == FLOAT_ABI_DEFAULT)
     {
-      struct riscv_subset *subset;
-
       /* Assume soft-float unless D extension is present.  */
       float_abi = FLOAT_ABI_SOFT;
 
-      for (subset = riscv_subsets; subset != NULL; subset = subset->next)
-	{
-	  if (strcasecmp (subset->name, "D") == 0)
-	    float_abi = FLOAT_ABI_DOUBLE;
-	  if (strcasecmp (subset->name, "Q") == 0)
-	    float_abi = FLOAT_ABI_QUAD;
-	}
+      if (riscv_subset_supports ("d"))
+	float_abi = FLOAT_ABI_DOUBLE;
+      else if (riscv_subset_supports ("q"))
+	float_abi = FLOAT_ABI_QUAD;
     }
 
   /* Insert float_abi into the EF_RISCV_FLOAT_ABI field of elf_flags.  */
@@ -2041,7 +2305,7 @@ md_pcrel_from (fixS *fixP)
 /* Apply a fixup to the object file.  */
 
 void
-md_apply_fix (fixS *fixP, valueT *valP, segT seg ATTRIBUTE_UNUSED)
+md_apply_fix (fixS *fixP, valueT *valP, segT seg)
 {
   unsigned int subtype;
   bfd_byte *buf = (bfd_byte *) (fixP->fx_frag->fr_literal + fixP->fx_where);
@@ -2064,7 +2328,6 @@ md_apply_fix (fixS *fixP, valueT *valP, segT seg ATTRIBUTE_UNUSED)
       relaxable = TRUE;
       break;
 
-    case BFD_RELOC_RISCV_GOT_HI20:
     case BFD_RELOC_RISCV_ADD8:
     case BFD_RELOC_RISCV_ADD16:
     case BFD_RELOC_RISCV_ADD32:
@@ -2081,11 +2344,11 @@ md_apply_fix (fixS *fixP, valueT *valP, segT seg ATTRIBUTE_UNUSED)
     case BFD_RELOC_RISCV_TPREL_LO12_I:
     case BFD_RELOC_RISCV_TPREL_LO12_S:
     case BFD_RELOC_RISCV_TPREL_ADD:
+    case BFD_RELOC_RISCV_TLS_GOT_HI20:
+    case BFD_RELOC_RISCV_TLS_GD_HI20:
       relaxable = TRUE;
       /* Fall through.  */
 
-    case BFD_RELOC_RISCV_TLS_GOT_HI20:
-    case BFD_RELOC_RISCV_TLS_GD_HI20:
     case BFD_RELOC_RISCV_TLS_DTPREL32:
     case BFD_RELOC_RISCV_TLS_DTPREL64:
       if (fixP->fx_addsy != NULL)
@@ -2257,9 +2520,22 @@ md_apply_fix (fixS *fixP, valueT *valP, segT seg ATTRIBUTE_UNUSED)
       relaxable = TRUE;
       break;
 
-    case BFD_RELOC_RISCV_PCREL_HI20:
     case BFD_RELOC_RISCV_PCREL_LO12_S:
     case BFD_RELOC_RISCV_PCREL_LO12_I:
+      if (fixP->fx_tcbit2)
+	{
+	  /* From pcrel_access: the value is the offset of the AUIPC in
+	     this frag.  Give the relocation a label there.  */
+	  fixP->fx_addsy = (symbolS *) local_symbol_make (FAKE_LABEL_NAME,
+							  seg, *valP,
+							  fixP->fx_frag);
+	  fixP->fx_offset = fixP->fx_addnumber = *valP = 0;
+	  fixP->fx_tcbit2 = 0;
+	}
+      /* Fall through.  */
+
+    case BFD_RELOC_RISCV_GOT_HI20:
+    case BFD_RELOC_RISCV_PCREL_HI20:
       relaxable = riscv_opts.relax;
       break;
 
@@ -2285,6 +2561,21 @@ md_apply_fix (fixS *fixP, valueT *valP, segT seg ATTRIBUTE_UNUSED)
     }
 }
 
+/* Start a new frag before a CFI directive or a line number entry takes
+   the current address if this frag holds an instruction that linker
+   relaxation may shrink or delete.  The advance across it is then left
+   to the linker.  */
+
+void
+riscv_close_relaxable_frag (void)
+{
+  if (frag_now->tc_frag_data)
+    {
+      frag_wane (frag_now);
+      frag_new (0);
+    }
+}
+
 /* Because the value of .cfi_remember_state may changed after relaxation,
    we insert a fix to relocate it again in link-time.  */
 
@@ -2355,6 +2646,10 @@ s_riscv_option (int x ATTRIBUTE_UNUSED)
     riscv_opts.relax = TRUE;
   else if (strcmp (name, "norelax") == 0)
     riscv_opts.relax = FALSE;
+  else if (strcmp (name, "constpool") == 0)
+    riscv_opts.const_pool = TRUE;
+  else if (strcmp (name, "noconstpool") == 0)
+    riscv_opts.const_pool = FALSE;
   else if (strcmp (name, "push") == 0)
     {
       struct riscv_option_stack *s;
@@ -2480,6 +2775,7 @@ riscv_frag_align_code (int n)
 
   fix_new_exp (frag_now, nops - frag_now->fr_literal, 0,
 	       &ex, FALSE, BFD_RELOC_RISCV_ALIGN);
+  frag_now->tc_frag_data = TRUE;
 
   return TRUE;
 }
@@ -2690,6 +2986,8 @@ RISC-V options:\n\
   -fno-pic       don't generate position-independent code (default)\n\
   -march=ISA     set the RISC-V architecture\n\
   -mabi=ABI      set the RISC-V ABI\n\
+  -mconst-pool   load long constants from a mergeable pool\n\
+  -mno-const-pool  build long constants inline (default)\n\
 "));
 }
 
@@ -2705,10 +3003,12 @@ tc_riscv_regname_to_dw2regnum (char *regname)
 {
   int reg;
 
-  if ((reg = reg_lookup_internal (regname, RCLASS_GPR)) >= 0)
+  size_t len = strlen (regname);
+
+  if ((reg = reg_lookup_internal (regname, len, RCLASS_GPR)) >= 0)
     return reg;
 
-  if ((reg = reg_lookup_internal (regname, RCLASS_FPR)) >= 0)
+  if ((reg = reg_lookup_internal (regname, len, RCLASS_FPR)) >= 0)
     return reg + 32;
 
   as_bad (_("unknown register `%s'"), regname);
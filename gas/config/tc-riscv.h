@@ -47,6 +47,11 @@ struct expressionS;
   riscv_relax_frag (segment, fragp, stretch)
 extern int riscv_relax_frag (asection *, struct frag *, long);
 
+/* By the time relocations are written, fixup_segment has converted
+   every symbol that a relocation refers to, so tc_gen_reloc only reads
+   shared state and may run for several sections at once.  */
+#define TC_GEN_RELOC_THREAD_SAFE 1
+
 #define md_section_align(seg,size)	(size)
 #define md_undefined_symbol(name)	(0)
 #define md_operand(x)
@@ -71,12 +76,19 @@ extern const char * riscv_target_format (void);
 #define md_after_parse_args() riscv_after_parse_args()
 extern void riscv_after_parse_args (void);
 
+#define md_begin_tables() riscv_begin_tables ()
+extern void riscv_begin_tables (void);
+
 #define md_parse_long_option(arg) riscv_parse_long_option (arg)
 extern int riscv_parse_long_option (const char *);
 
 #define md_pre_output_hook riscv_pre_output_hook()
 extern void riscv_pre_output_hook (void);
 
+/* Set for a frag that holds an instruction the linker may relax.  */
+#define TC_FRAG_TYPE bfd_boolean
+#define DWARF2_FRAG_LINKRELAX_P(FRAG) ((FRAG)->tc_frag_data)
+
 /* Let the linker resolve all the relocs due to relaxation.  */
 #define tc_fix_adjustable(fixp) 0
 #define md_allow_local_subtract(l,r,s) 0
@@ -106,6 +118,10 @@ extern void riscv_pop_insert (void);
 #define tc_cfi_frame_initial_instructions riscv_cfi_frame_initial_instructions
 extern void riscv_cfi_frame_initial_instructions (void);
 
+#define tc_cfi_before_advance_loc riscv_close_relaxable_frag
+#define tc_dwarf2_before_line_entry riscv_close_relaxable_frag
+extern void riscv_close_relaxable_frag (void);
+
 #define tc_regname_to_dw2regnum tc_riscv_regname_to_dw2regnum
 extern int tc_riscv_regname_to_dw2regnum (char *);
 
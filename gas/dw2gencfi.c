@@ -75,6 +75,11 @@
 # define tc_cfi_endproc(fde) ((void) (fde))
 #endif
 
+/* Called before a CFI directive records the current address.  */
+#ifndef tc_cfi_before_advance_loc
+# define tc_cfi_before_advance_loc() ((void) 0)
+#endif
+
 #define EH_FRAME_LINKONCE (SUPPORT_FRAME_LINKONCE || compact_eh)
 
 #ifndef DWARF2_FORMAT
@@ -830,6 +835,8 @@ dot_cfi (int arg)
       return;
     }
 
+  tc_cfi_before_advance_loc ();
+
   /* If the last address was not at the current PC, advance to current.  */
   if (symbol_get_frag (frchain_now->frch_cfi_data->last_address) != frag_now
       || (S_GET_VALUE (frchain_now->frch_cfi_data->last_address)
@@ -960,6 +967,8 @@ dot_cfi_escape (int ignored ATTRIBUTE_UNUSED)
       return;
     }
 
+  tc_cfi_before_advance_loc ();
+
   /* If the last address was not at the current PC, advance to current.  */
   if (symbol_get_frag (frchain_now->frch_cfi_data->last_address) != frag_now
       || (S_GET_VALUE (frchain_now->frch_cfi_data->last_address)
@@ -1142,6 +1151,8 @@ dot_cfi_val_encoded_addr (int ignored ATTRIBUTE_UNUSED)
       return;
     }
 
+  tc_cfi_before_advance_loc ();
+
   /* If the last address was not at the current PC, advance to current.  */
   if (symbol_get_frag (frchain_now->frch_cfi_data->last_address) != frag_now
       || (S_GET_VALUE (frchain_now->frch_cfi_data->last_address)
@@ -1203,6 +1214,8 @@ dot_cfi_label (int ignored ATTRIBUTE_UNUSED)
   if (name == NULL)
     return;
 
+  tc_cfi_before_advance_loc ();
+
   /* If the last address was not at the current PC, advance to current.  */
   if (symbol_get_frag (frchain_now->frch_cfi_data->last_address) != frag_now
       || (S_GET_VALUE (frchain_now->frch_cfi_data->last_address)
@@ -121,6 +121,22 @@
 # define DWARF2_USE_FIXED_ADVANCE_PC	linkrelax
 #endif
 
+/* Nonzero if linker relaxation might change the distance from a line
+   entry in FRAG to the end of FRAG.  Where it cannot, the address
+   advance between two entries can be computed here, as long as only
+   fixed-size frags lie between them.  A target that defines this must
+   also make sure that the linker relaxes nothing between the start of
+   a frag and a line entry in it.  It can do so by recording entries
+   before rather than after each instruction, and by starting a new
+   frag in tc_dwarf2_before_line_entry, which is called for an entry
+   at the end of the current frag.  */
+#ifdef DWARF2_FRAG_LINKRELAX_P
+# define DWARF2_LINKRELAX_IN_FRAG	0
+#else
+# define DWARF2_FRAG_LINKRELAX_P(FRAG)	DWARF2_USE_FIXED_ADVANCE_PC
+# define DWARF2_LINKRELAX_IN_FRAG	DWARF2_USE_FIXED_ADVANCE_PC
+#endif
+
 /* First special line opcode - leave room for the standard opcodes.
    Note: If you want to change this, you'll have to update the
    "standard_opcode_lengths" table that is emitted below in
@@ -162,18 +178,24 @@
 #define TC_PARSE_CONS_RETURN_NONE BFD_RELOC_NONE
 #endif
 
+/* A line entry is located at OFS within FRAG.  A symbol for the
+   location is only made if the line program needs one, unless LABEL
+   was given in the first place.  */
 struct line_entry {
-  struct line_entry *next;
   symbolS *label;
+  fragS *frag;
+  addressT ofs;
   struct dwarf2_line_info loc;
 };
 
 struct line_subseg {
   struct line_subseg *next;
   subsegT subseg;
-  struct line_entry *head;
-  struct line_entry **ptail;
-  struct line_entry **pmove_tail;
+  struct line_entry *entries;
+  unsigned int num_entries;
+  unsigned int max_entries;
+  /* The first entry that dwarf2_move_insn has not looked at.  */
+  unsigned int move_start;
 };
 
 struct line_seg {
@@ -274,31 +296,39 @@ get_line_subseg (segT seg, subsegT subseg, bfd_boolean create_p)
   lss = XNEW (struct line_subseg);
   lss->next = *pss;
   lss->subseg = subseg;
-  lss->head = NULL;
-  lss->ptail = &lss->head;
-  lss->pmove_tail = &lss->head;
+  lss->entries = NULL;
+  lss->num_entries = 0;
+  lss->max_entries = 0;
+  lss->move_start = 0;
   *pss = lss;
 
  found_subseg:
   return lss;
 }
 
-/* Record an entry for LOC occurring at LABEL.  */
+/* Record an entry for LOC occurring at LABEL, or if LABEL is NULL, at
+   OFS within FRAG.  */
 
 static void
-dwarf2_gen_line_info_1 (symbolS *label, struct dwarf2_line_info *loc)
+dwarf2_gen_line_info_1 (symbolS *label, fragS *frag, addressT ofs,
+			struct dwarf2_line_info *loc)
 {
   struct line_subseg *lss;
   struct line_entry *e;
 
-  e = XNEW (struct line_entry);
-  e->next = NULL;
+  lss = get_line_subseg (now_seg, now_subseg, TRUE);
+  if (lss->num_entries == lss->max_entries)
+    {
+      lss->max_entries = lss->max_entries ? lss->max_entries * 2 : 64;
+      lss->entries = XRESIZEVEC (struct line_entry, lss->entries,
+				 lss->max_entries);
+    }
+
+  e = &lss->entries[lss->num_entries++];
   e->label = label;
+  e->frag = frag;
+  e->ofs = ofs;
   e->loc = *loc;
-
-  lss = get_line_subseg (now_seg, now_subseg, TRUE);
-  *lss->ptail = e;
-  lss->ptail = &e->next;
 }
 
 /* Record an entry for LOC occurring at OFS within the current fragment.  */
@@ -309,8 +339,6 @@ dwarf2_gen_line_info (addressT ofs, struct dwarf2_line_info *loc)
   static unsigned int line = -1;
   static unsigned int filenum = -1;
 
-  symbolS *sym;
-
   /* Early out for as-yet incomplete location information.  */
   if (loc->filenum == 0 || loc->line == 0)
     return;
@@ -326,18 +354,17 @@ dwarf2_gen_line_info (addressT ofs, struct dwarf2_line_info *loc)
   line = loc->line;
   filenum = loc->filenum;
 
-  if (linkrelax)
+#ifdef tc_dwarf2_before_line_entry
+  /* The target may start a new frag for an entry at the end of the
+     current one.  */
+  if (ofs == (addressT) frag_now_fix ())
     {
-      char name[120];
-
-      /* Use a non-fake name for the line number location,
-	 so that it can be referred to by relocations.  */
-      sprintf (name, ".Loc.%u.%u", line, filenum);
-      sym = symbol_new (name, now_seg, ofs, frag_now);
+      tc_dwarf2_before_line_entry ();
+      ofs = frag_now_fix ();
     }
-  else
-    sym = symbol_temp_new (now_seg, ofs, frag_now);
-  dwarf2_gen_line_info_1 (sym, loc);
+#endif
+
+  dwarf2_gen_line_info_1 (NULL, frag_now, ofs, loc);
 }
 
 /* Returns the current source information.  If .file directives have
@@ -408,11 +435,16 @@ dwarf2_move_insn (int delta)
     return;
 
   now = frag_now_fix ();
-  while ((e = *lss->pmove_tail))
+  for (; lss->move_start < lss->num_entries; lss->move_start++)
     {
-      if (S_GET_VALUE (e->label) == now)
-	S_SET_VALUE (e->label, now + delta);
-      lss->pmove_tail = &e->next;
+      e = &lss->entries[lss->move_start];
+      if (e->label != NULL)
+	{
+	  if (S_GET_VALUE (e->label) == now)
+	    S_SET_VALUE (e->label, now + delta);
+	}
+      else if (e->ofs == now)
+	e->ofs = now + delta;
     }
 }
 
@@ -455,7 +487,7 @@ dwarf2_emit_label (symbolS *label)
 
   loc.flags |= DWARF2_FLAG_BASIC_BLOCK;
 
-  dwarf2_gen_line_info_1 (label, &loc);
+  dwarf2_gen_line_info_1 (label, NULL, 0, &loc);
   dwarf2_consume_line_info ();
 }
 
@@ -1259,11 +1291,70 @@ dwarf2dbg_convert_frag (fragS *frag)
   frag->fr_offset = 0;
 }
 
-/* Generate .debug_line content for the chain of line number entries
-   beginning at E, for segment SEG.  */
+/* Return the label for line entry E in segment SEG, making one if
+   need be.  */
+
+static symbolS *
+line_entry_label (segT seg, struct line_entry *e)
+{
+  if (e->label == NULL)
+    {
+      if (linkrelax)
+	{
+	  char name[120];
+
+	  /* Use a non-fake name for the line number location,
+	     so that it can be referred to by relocations.  */
+	  sprintf (name, ".Loc.%u.%u", e->loc.line, e->loc.filenum);
+	  e->label = symbol_new (name, seg, e->ofs, e->frag);
+	}
+      else
+	e->label = symbol_temp_new (seg, e->ofs, e->frag);
+    }
+  return e->label;
+}
+
+/* If the distance from FROM_OFS in FROM_FRAG to TO_OFS in TO_FRAG is
+   known now and cannot change later, set *DELTA to it and return TRUE.
+   That is the case if all frags from FROM_FRAG up to TO_FRAG have
+   fixed size, and the linker may not relax anything in them after
+   FROM_OFS.  If TO_LABEL, the end point was not placed by
+   dwarf2_emit_insn, so check TO_FRAG as well.  */
+
+static bfd_boolean
+fixed_addr_delta (fragS *from_frag, addressT from_ofs,
+		  fragS *to_frag, addressT to_ofs, bfd_boolean to_label,
+		  addressT *delta)
+{
+  fragS *frag;
+  addressT addr_delta = to_ofs - from_ofs;
+
+  for (frag = from_frag; frag != to_frag; frag = frag->fr_next)
+    {
+      if (frag == NULL
+	  || frag->fr_type != rs_fill
+	  || DWARF2_FRAG_LINKRELAX_P (frag))
+	return FALSE;
+      addr_delta += frag->fr_fix + frag->fr_var * frag->fr_offset;
+    }
+  if ((to_label && DWARF2_FRAG_LINKRELAX_P (to_frag))
+      || (to_frag == from_frag && DWARF2_LINKRELAX_IN_FRAG))
+    return FALSE;
+
+  /* Line number sequences cannot go backward in addresses.  Leave the
+     complaint to emit_inc_line_addr or emit_fixed_inc_line_addr.  */
+  if ((offsetT) addr_delta < 0)
+    return FALSE;
+
+  *delta = addr_delta;
+  return TRUE;
+}
+
+/* Generate .debug_line content for the line number entries of the
+   subsegments starting at HEAD, for segment SEG.  */
 
 static void
-process_entries (segT seg, struct line_entry *e)
+process_entries (segT seg, struct line_subseg *head)
 {
   unsigned filenum = 1;
   unsigned line = 1;
@@ -1271,9 +1362,10 @@ process_entries (segT seg, struct line_entry *e)
   unsigned isa = 0;
   unsigned flags = DWARF2_LINE_DEFAULT_IS_STMT ? DWARF2_FLAG_IS_STMT : 0;
   fragS *last_frag = NULL, *frag;
-  addressT last_frag_ofs = 0, frag_ofs;
-  symbolS *last_lab = NULL, *lab;
-  struct line_entry *next;
+  addressT last_frag_ofs = 0, frag_ofs, addr_delta;
+  struct line_subseg *lss;
+  struct line_entry *last_e = NULL, *e;
+  unsigned int i;
 
   if (flag_dwarf_sections)
     {
@@ -1305,93 +1397,105 @@ process_entries (segT seg, struct line_entry *e)
 	subseg_set (subseg_get (".debug_line", FALSE), 0);
     }
 
-  do
-    {
-      int line_delta;
-
-      if (filenum != e->loc.filenum)
-	{
-	  filenum = e->loc.filenum;
-	  out_opcode (DW_LNS_set_file);
-	  out_uleb128 (filenum);
-	}
-
-      if (column != e->loc.column)
-	{
-	  column = e->loc.column;
-	  out_opcode (DW_LNS_set_column);
-	  out_uleb128 (column);
-	}
+  for (lss = head; lss != NULL; lss = lss->next)
+    for (i = 0; i < lss->num_entries; i++)
+      {
+	int line_delta;
 
-      if (e->loc.discriminator != 0)
-	{
-	  out_opcode (DW_LNS_extended_op);
-	  out_leb128 (1 + sizeof_leb128 (e->loc.discriminator, 0));
-	  out_opcode (DW_LNE_set_discriminator);
-	  out_uleb128 (e->loc.discriminator);
-	}
+	e = &lss->entries[i];
+	if (filenum != e->loc.filenum)
+	  {
+	    filenum = e->loc.filenum;
+	    out_opcode (DW_LNS_set_file);
+	    out_uleb128 (filenum);
+	  }
 
-      if (isa != e->loc.isa)
-	{
-	  isa = e->loc.isa;
-	  out_opcode (DW_LNS_set_isa);
-	  out_uleb128 (isa);
-	}
+	if (column != e->loc.column)
+	  {
+	    column = e->loc.column;
+	    out_opcode (DW_LNS_set_column);
+	    out_uleb128 (column);
+	  }
 
-      if ((e->loc.flags ^ flags) & DWARF2_FLAG_IS_STMT)
-	{
-	  flags = e->loc.flags;
-	  out_opcode (DW_LNS_negate_stmt);
-	}
+	if (e->loc.discriminator != 0)
+	  {
+	    out_opcode (DW_LNS_extended_op);
+	    out_leb128 (1 + sizeof_leb128 (e->loc.discriminator, 0));
+	    out_opcode (DW_LNE_set_discriminator);
+	    out_uleb128 (e->loc.discriminator);
+	  }
 
-      if (e->loc.flags & DWARF2_FLAG_BASIC_BLOCK)
-	out_opcode (DW_LNS_set_basic_block);
+	if (isa != e->loc.isa)
+	  {
+	    isa = e->loc.isa;
+	    out_opcode (DW_LNS_set_isa);
+	    out_uleb128 (isa);
+	  }
 
-      if (e->loc.flags & DWARF2_FLAG_PROLOGUE_END)
-	out_opcode (DW_LNS_set_prologue_end);
+	if ((e->loc.flags ^ flags) & DWARF2_FLAG_IS_STMT)
+	  {
+	    flags = e->loc.flags;
+	    out_opcode (DW_LNS_negate_stmt);
+	  }
 
-      if (e->loc.flags & DWARF2_FLAG_EPILOGUE_BEGIN)
-	out_opcode (DW_LNS_set_epilogue_begin);
+	if (e->loc.flags & DWARF2_FLAG_BASIC_BLOCK)
+	  out_opcode (DW_LNS_set_basic_block);
 
-      /* Don't try to optimize away redundant entries; gdb wants two
-	 entries for a function where the code starts on the same line as
-	 the {, and there's no way to identify that case here.  Trust gcc
-	 to optimize appropriately.  */
-      line_delta = e->loc.line - line;
-      lab = e->label;
-      frag = symbol_get_frag (lab);
-      frag_ofs = S_GET_VALUE (lab);
+	if (e->loc.flags & DWARF2_FLAG_PROLOGUE_END)
+	  out_opcode (DW_LNS_set_prologue_end);
 
-      if (last_frag == NULL)
-	{
-	  out_set_addr (lab);
-	  out_inc_line_addr (line_delta, 0);
-	}
-      else if (frag == last_frag && ! DWARF2_USE_FIXED_ADVANCE_PC)
-	out_inc_line_addr (line_delta, frag_ofs - last_frag_ofs);
-      else
-	relax_inc_line_addr (line_delta, lab, last_lab);
+	if (e->loc.flags & DWARF2_FLAG_EPILOGUE_BEGIN)
+	  out_opcode (DW_LNS_set_epilogue_begin);
 
-      line = e->loc.line;
-      last_lab = lab;
-      last_frag = frag;
-      last_frag_ofs = frag_ofs;
+	/* Don't try to optimize away redundant entries; gdb wants two
+	   entries for a function where the code starts on the same line
+	   as the {, and there's no way to identify that case here.  Trust
+	   gcc to optimize appropriately.  */
+	line_delta = e->loc.line - line;
+	if (e->label != NULL)
+	  {
+	    frag = symbol_get_frag (e->label);
+	    frag_ofs = S_GET_VALUE (e->label);
+	  }
+	else
+	  {
+	    frag = e->frag;
+	    frag_ofs = e->ofs;
+	  }
 
-      next = e->next;
-      free (e);
-      e = next;
-    }
-  while (e);
+	if (last_frag == NULL)
+	  {
+	    out_set_addr (line_entry_label (seg, e));
+	    out_inc_line_addr (line_delta, 0);
+	  }
+	else if (fixed_addr_delta (last_frag, last_frag_ofs, frag, frag_ofs,
+				   e->label != NULL, &addr_delta))
+	  out_inc_line_addr (line_delta, addr_delta);
+	else
+	  relax_inc_line_addr (line_delta, line_entry_label (seg, e),
+			       line_entry_label (seg, last_e));
+
+	line = e->loc.line;
+	last_e = e;
+	last_frag = frag;
+	last_frag_ofs = frag_ofs;
+      }
 
   /* Emit a DW_LNE_end_sequence for the end of the section.  */
   frag = last_frag_for_seg (seg);
   frag_ofs = get_frag_fix (frag, seg);
-  if (frag == last_frag && ! DWARF2_USE_FIXED_ADVANCE_PC)
-    out_inc_line_addr (INT_MAX, frag_ofs - last_frag_ofs);
+  if (fixed_addr_delta (last_frag, last_frag_ofs, frag, frag_ofs, TRUE,
+			&addr_delta))
+    out_inc_line_addr (INT_MAX, addr_delta);
   else
+    relax_inc_line_addr (INT_MAX, symbol_temp_new (seg, frag_ofs, frag),
+			 line_entry_label (seg, last_e));
+
+  for (lss = head; lss != NULL; lss = lss->next)
     {
-      lab = symbol_temp_new (seg, frag_ofs, frag);
-      relax_inc_line_addr (INT_MAX, lab, last_lab);
+      free (lss->entries);
+      lss->entries = NULL;
+      lss->num_entries = lss->max_entries = 0;
     }
 }
 
@@ -1558,7 +1662,7 @@ out_debug_line (segT line_seg)
   /* For each section, emit a statement program.  */
   for (s = all_segs; s; s = s->next)
     if (SEG_NORMAL (s->seg))
-      process_entries (s->seg, s->head->head);
+      process_entries (s->seg, s->head);
     else
       as_warn ("dwarf line number information for %s ignored",
 	       segment_name (s->seg));
@@ -1881,7 +1985,6 @@ void
 dwarf2_finish (void)
 {
   segT line_seg;
-  struct line_seg *s;
   segT info_seg;
   int emit_other_sections = 0;
   int empty_debug_line = 0;
@@ -1911,19 +2014,6 @@ dwarf2_finish (void)
   line_seg = subseg_new (".debug_line", 0);
   bfd_set_section_flags (stdoutput, line_seg, SEC_READONLY | SEC_DEBUGGING);
 
-  /* For each subsection, chain the debug entries together.  */
-  for (s = all_segs; s; s = s->next)
-    {
-      struct line_subseg *lss = s->head;
-      struct line_entry **ptail = lss->ptail;
-
-      while ((lss = lss->next) != NULL)
-	{
-	  *ptail = lss->head;
-	  ptail = lss->ptail;
-	}
-    }
-
   out_debug_line (line_seg);
 
   /* If this is assembler generated line info, and there is no
@@ -1781,6 +1781,196 @@ subtract_from_result (expressionS *resultP, offsetT amount, int rhs_highbit)
     resultP->X_extrabit ^= 1;
 }
 
+#ifndef md_operator
+
+/* Scan the decimal or hexadecimal integer at *STRP into *VALP, moving
+   *STRP past it.  Return 0 for anything integer_constant would not
+   turn into a plain O_constant of the same value.  */
+
+static int
+simple_number (char **strp, valueT *valp)
+{
+#ifdef BFD64
+#define valuesize 64
+#else
+#define valuesize 32
+#endif
+  char *s = *strp;
+  valueT value = 0;
+  unsigned int radix = 10;
+  int too_many_digits = (valuesize + 11) / 4;
+  int ndigits;
+
+  if (s[0] == '0')
+    {
+      if (s[1] != 'x' && s[1] != 'X')
+	{
+	  /* A plain zero; octal constants take the long way.  */
+	  *strp = s + 1;
+	  *valp = 0;
+	  return 1;
+	}
+      radix = 16;
+      too_many_digits = (valuesize + 3) / 4 + 1;
+      s += 2;
+    }
+#undef valuesize
+
+  for (ndigits = 0; hex_value (*s) < radix; s++, ndigits++)
+    value = value * radix + hex_value (*s);
+  if (ndigits == 0 || ndigits >= too_many_digits)
+    return 0;
+
+  *strp = s;
+  *valp = value;
+  return 1;
+}
+
+/* Nonzero if C ends an operand without being the start of an operator
+   or of more of the operand.  */
+#define simple_expr_end_p(c) \
+  (is_end_of_line[(unsigned char) (c)] || (c) == ',' || (c) == '(' \
+   || (c) == ')')
+
+/* Parse the forms that make up almost every operand of compiler output:
+   an integer, optionally negated, or a symbol, optionally plus or minus
+   an integer.  Store the expression in *RESULTP and its section in
+   *SEGP, exactly as the general parser would, and return 1.  For
+   anything else, return 0 without moving input_line_pointer.  */
+
+static int
+simple_expr (expressionS *resultP, enum expr_mode mode, segT *segp)
+{
+  char *start = input_line_pointer;
+  char *s = start;
+  char *name = NULL;
+  valueT value = 0;
+  int negate = 0;
+  char op = 0;
+
+  if (NUMBERS_WITH_SUFFIX || flag_mri)
+    return 0;
+
+  if (*s == ' ')
+    s++;
+
+  if (*s == '-' && ISDIGIT (s[1]))
+    {
+      negate = 1;
+      s++;
+    }
+
+  if (ISDIGIT (*s))
+    {
+      if (!simple_number (&s, &value))
+	return 0;
+    }
+#ifndef md_parse_name
+  else if ((ISALPHA (*s) || *s == '_' || *s == '.')
+	   && is_name_beginner (*s)
+	   && !negate)
+    {
+      name = s;
+      if (*s == '.'
+	  && (!is_part_of_name (s[1])
+	      || strncasecmp (s + 1, "startof.", 8) == 0
+	      || strncasecmp (s + 1, "sizeof.", 7) == 0))
+	return 0;
+      while (is_part_of_name (*++s))
+	;
+      if (is_name_ender (*s))
+	return 0;
+      while (*s == ' ')
+	s++;
+      if (*s == '+' || *s == '-')
+	{
+	  op = *s++;
+	  if (*s == ' ')
+	    s++;
+	  if (!ISDIGIT (*s) || !simple_number (&s, &value))
+	    return 0;
+	}
+    }
+#endif
+  else
+    return 0;
+
+  while (*s == ' ')
+    s++;
+  if (!simple_expr_end_p (*s))
+    return 0;
+
+  resultP->X_unsigned = 1;
+  resultP->X_extrabit = 0;
+  resultP->X_op_symbol = NULL;
+
+  if (name == NULL)
+    {
+      resultP->X_op = O_constant;
+      resultP->X_add_symbol = NULL;
+      resultP->X_add_number = value;
+      if (negate)
+	{
+	  resultP->X_add_number = - (addressT) resultP->X_add_number;
+	  resultP->X_unsigned = 0;
+	  if (resultP->X_add_number)
+	    resultP->X_extrabit ^= 1;
+	}
+      *segp = absolute_section;
+    }
+  else
+    {
+      symbolS *symbolP;
+      segT segment;
+      char c;
+
+      input_line_pointer = name;
+      c = get_symbol_name (&name);
+      symbolP = symbol_find_or_make (name);
+      restore_line_pointer (c);
+
+      segment = S_GET_SEGMENT (symbolP);
+      if (mode != expr_defer && segment == reg_section)
+	{
+	  /* Leave register arithmetic to the target.  */
+	  input_line_pointer = start;
+	  return 0;
+	}
+      if (mode != expr_defer
+	  && segment == absolute_section
+	  && !S_FORCE_RELOC (symbolP, 0))
+	{
+	  resultP->X_op = O_constant;
+	  resultP->X_add_symbol = NULL;
+	  resultP->X_add_number = S_GET_VALUE (symbolP);
+	  *segp = absolute_section;
+	}
+      else
+	{
+	  symbol_mark_used (symbolP);
+	  if (mode != expr_defer)
+	    {
+	      symbolP = symbol_clone_if_forward_ref (symbolP);
+	      symbol_mark_used (symbolP);
+	    }
+	  resultP->X_op = O_symbol;
+	  resultP->X_add_symbol = symbolP;
+	  resultP->X_add_number = 0;
+	  *segp = S_GET_SEGMENT (symbolP);
+	}
+
+      if (op == '+')
+	add_to_result (resultP, value, 0);
+      else if (op == '-')
+	subtract_from_result (resultP, value, 0);
+    }
+
+  input_line_pointer = s;
+  return 1;
+}
+
+#endif /* md_operator */
+
 /* Parse an expression.  */
 
 segT
@@ -1802,6 +1992,15 @@ expr (int rankarg,		/* Larger # is higher rank.  */
     {
       dot_value = frag_now_fix ();
       dot_frag = frag_now;
+
+#ifndef md_operator
+      if (simple_expr (resultP, mode, &retval))
+	{
+	  if (mode == expr_evaluate)
+	    resolve_expression (resultP);
+	  return resultP->X_op == O_constant ? absolute_section : retval;
+	}
+#endif
     }
 
   retval = operand (resultP, mode);
@@ -18,42 +18,66 @@
    Software Foundation, 51 Franklin Street - Fifth Floor, Boston, MA
    02110-1301, USA.  */
 
-/* This version of the hash table code is a wholescale replacement of
-   the old hash table code, which was fairly bad.  This is based on
-   the hash table code in BFD, but optimized slightly for the
-   assembler.  The assembler does not need to derive structures that
-   are stored in the hash table.  Instead, it always stores a pointer.
-   The assembler uses the hash table mostly to store symbols, and we
-   don't need to confuse the symbol structure with a hash table
-   structure.  */
+/* This version of the hash table code uses open addressing: the
+   entries live directly in a power-of-two sized array, and a key that
+   collides takes the next free slot.  Each entry caches the full hash
+   code of its key, so probing only compares strings whose hash codes
+   match.  Tables start out sized for the number of entries the caller
+   expects and double whenever they become three quarters full, so small
+   tables stay small and large ones keep short probe sequences.  The
+   live entries are also linked in the order they were added, so that
+   hash_traverse visits them in that order however the table has
+   grown.
+
+   The assembler does not need to derive structures that are stored in
+   the hash table.  Instead, it always stores a pointer.  The assembler
+   uses the hash table mostly to store symbols, and we don't need to
+   confuse the symbol structure with a hash table structure.  */
 
 #include "as.h"
 #include "safe-ctype.h"
-#include "obstack.h"
 
 /* An entry in a hash table.  */
 
 struct hash_entry {
-  /* Next entry for this hash code.  */
-  struct hash_entry *next;
-  /* String being hashed.  */
+  /* String being hashed, NULL if this slot has never been used, or
+     DELETED_ENTRY if the entry in it was deleted.  */
   const char *string;
   /* Hash code.  This is the full hash code, not the index into the
      table.  */
   unsigned long hash;
   /* Pointer being stored in the hash table.  */
   void *data;
+  /* The indices of the slots of the entries added just before and
+     just after this one, or NO_ENTRY.  */
+  unsigned int prev;
+  unsigned int next;
 };
 
+/* The key of a slot whose entry has been deleted.  Lookups must probe
+   past it, but insertions may reuse it.  */
+
+static const char deleted_entry[] = "";
+#define DELETED_ENTRY deleted_entry
+
+/* The slot index that ends the entry-order chain.  */
+
+#define NO_ENTRY (~0U)
+
 /* A hash table.  */
 
 struct hash_control {
   /* The hash array.  */
-  struct hash_entry **table;
-  /* The number of slots in the hash table.  */
+  struct hash_entry *table;
+  /* The number of slots in the hash table, a power of two.  */
   unsigned int size;
-  /* An obstack for this hash table.  */
-  struct obstack memory;
+  /* The number of entries in the hash table.  */
+  unsigned int count;
+  /* The number of slots that are not empty, counting deleted ones.  */
+  unsigned int used;
+  /* The slots of the first and last entries added, or NO_ENTRY.  */
+  unsigned int first;
+  unsigned int last;
 
 #ifdef HASH_STATISTICS
   /* Statistics.  */
@@ -63,36 +87,54 @@ struct hash_control {
   unsigned long insertions;
   unsigned long replacements;
   unsigned long deletions;
+  unsigned long expansions;
 #endif /* HASH_STATISTICS */
 };
 
-/* The default number of entries to use when creating a hash table.
-   Note this value can be reduced to 4051 by using the command line
-   switch --reduce-memory-overheads, or set to other values by using
-   the --hash-size=<NUMBER> switch.  */
+/* The smallest number of slots in a hash table.  */
+
+#define HASH_MIN_SIZE 16
 
-static unsigned long gas_hash_table_size = 65537;
+/* The number of entries that hash_new sizes a table for.  Tables grow
+   as needed, so this need not be large; it can be set with the
+   --hash-size=<NUMBER> switch.  */
+
+static unsigned long gas_hash_table_size = 0;
 
 void
 set_gas_hash_table_size (unsigned long size)
 {
-  gas_hash_table_size = bfd_hash_set_default_size (size);
+  gas_hash_table_size = size;
 }
 
-/* Create a hash table.  This return a control block.  */
+/* Return the number of slots for a table that is to hold COUNT
+   entries without becoming more than half full.  */
+
+static unsigned int
+hash_size_for (unsigned long count)
+{
+  unsigned long size = HASH_MIN_SIZE;
+
+  while (size < count * 2 && size < (~0U >> 1) + 1)
+    size *= 2;
+  return size;
+}
+
+/* Create a hash table with room for SIZE entries before it has to
+   grow.  This return a control block.  */
 
 struct hash_control *
 hash_new_sized (unsigned long size)
 {
-  unsigned long alloc;
   struct hash_control *ret;
 
   ret = XNEW (struct hash_control);
-  obstack_begin (&ret->memory, chunksize);
-  alloc = size * sizeof (struct hash_entry *);
-  ret->table = (struct hash_entry **) obstack_alloc (&ret->memory, alloc);
-  memset (ret->table, 0, alloc);
-  ret->size = size;
+  ret->size = hash_size_for (size);
+  ret->table = XCNEWVEC (struct hash_entry, ret->size);
+  ret->count = 0;
+  ret->used = 0;
+  ret->first = NO_ENTRY;
+  ret->last = NO_ENTRY;
 
 #ifdef HASH_STATISTICS
   ret->lookups = 0;
@@ -101,6 +143,7 @@ hash_new_sized (unsigned long size)
   ret->insertions = 0;
   ret->replacements = 0;
   ret->deletions = 0;
+  ret->expansions = 0;
 #endif
 
   return ret;
@@ -117,34 +160,18 @@ hash_new (void)
 void
 hash_die (struct hash_control *table)
 {
-  obstack_free (&table->memory, 0);
+  free (table->table);
   free (table);
 }
 
-/* Look up a string in a hash table.  This returns a pointer to the
-   hash_entry, or NULL if the string is not in the table.  If PLIST is
-   not NULL, this sets *PLIST to point to the start of the list which
-   would hold this hash entry.  If PHASH is not NULL, this sets *PHASH
-   to the hash code for KEY.
-
-   Each time we look up a string, we move it to the start of the list
-   for its hash code, to take advantage of referential locality.  */
+/* Compute the hash code of the LEN bytes at KEY.  */
 
-static struct hash_entry *
-hash_lookup (struct hash_control *table, const char *key, size_t len,
-	     struct hash_entry ***plist, unsigned long *phash)
+static inline unsigned long
+hash_string (const char *key, size_t len)
 {
   unsigned long hash;
   size_t n;
   unsigned int c;
-  unsigned int hindex;
-  struct hash_entry **list;
-  struct hash_entry *p;
-  struct hash_entry *prev;
-
-#ifdef HASH_STATISTICS
-  ++table->lookups;
-#endif
 
   hash = 0;
   for (n = 0; n < len; n++)
@@ -156,18 +183,61 @@ hash_lookup (struct hash_control *table, const char *key, size_t len,
   hash += len + (len << 17);
   hash ^= hash >> 2;
 
+  return hash;
+}
+
+/* Return the slot at which to start probing for hash code HASH.  The
+   hash code is mixed first, since its low bits alone are weak.  */
+
+static inline unsigned int
+hash_start (const struct hash_control *table, unsigned long hash)
+{
+  unsigned int h = (unsigned int) (hash ^ (hash >> 16));
+
+  h *= 0x45d9f3bU;
+  h ^= h >> 16;
+  return h & (table->size - 1);
+}
+
+/* Look up a string in a hash table.  This returns a pointer to the
+   hash_entry, or NULL if the string is not in the table.  If PSLOT is
+   not NULL and the string is not found, this sets *PSLOT to the slot
+   where it should be inserted.  If PHASH is not NULL, this sets
+   *PHASH to the hash code for KEY.  */
+
+static struct hash_entry *
+hash_lookup (struct hash_control *table, const char *key, size_t len,
+	     struct hash_entry **pslot, unsigned long *phash)
+{
+  unsigned long hash;
+  unsigned int mask;
+  unsigned int i;
+  struct hash_entry *p;
+  struct hash_entry *free_slot;
+
+#ifdef HASH_STATISTICS
+  ++table->lookups;
+#endif
+
+  hash = hash_string (key, len);
   if (phash != NULL)
     *phash = hash;
 
-  hindex = hash % table->size;
-  list = table->table + hindex;
+  mask = table->size - 1;
+  free_slot = NULL;
+  for (i = hash_start (table, hash); ; i = (i + 1) & mask)
+    {
+      p = table->table + i;
+      if (p->string == NULL)
+	break;
 
-  if (plist != NULL)
-    *plist = list;
+      if (p->string == DELETED_ENTRY)
+	{
+	  if (free_slot == NULL)
+	    free_slot = p;
+	  continue;
+	}
 
-  prev = NULL;
-  for (p = *list; p != NULL; p = p->next)
-    {
 #ifdef HASH_STATISTICS
       ++table->hash_compares;
 #endif
@@ -179,24 +249,100 @@ hash_lookup (struct hash_control *table, const char *key, size_t len,
 #endif
 
 	  if (strncmp (p->string, key, len) == 0 && p->string[len] == '\0')
-	    {
-	      if (prev != NULL)
-		{
-		  prev->next = p->next;
-		  p->next = *list;
-		  *list = p;
-		}
-
-	      return p;
-	    }
+	    return p;
 	}
-
-      prev = p;
     }
 
+  if (pslot != NULL)
+    *pslot = free_slot != NULL ? free_slot : p;
+
   return NULL;
 }
 
+/* Link the entry in slot I of TABLE in after the last one added.  */
+
+static inline void
+hash_link (struct hash_control *table, unsigned int i)
+{
+  table->table[i].prev = table->last;
+  table->table[i].next = NO_ENTRY;
+  if (table->last == NO_ENTRY)
+    table->first = i;
+  else
+    table->table[table->last].next = i;
+  table->last = i;
+}
+
+/* Rehash TABLE into a table with room for its entries and as many
+   again.  Deleted entries are dropped.  The entries are rehashed in
+   the order they were added, which keeps that order.  */
+
+static void
+hash_expand (struct hash_control *table)
+{
+  struct hash_entry *old_table = table->table;
+  unsigned int mask;
+  unsigned int i;
+
+#ifdef HASH_STATISTICS
+  ++table->expansions;
+#endif
+
+  table->size = hash_size_for ((unsigned long) table->count * 2);
+  table->table = XCNEWVEC (struct hash_entry, table->size);
+  table->used = table->count;
+
+  mask = table->size - 1;
+  i = table->first;
+  table->first = NO_ENTRY;
+  table->last = NO_ENTRY;
+  while (i != NO_ENTRY)
+    {
+      struct hash_entry *p = old_table + i;
+      unsigned int j;
+
+      for (j = hash_start (table, p->hash);
+	   table->table[j].string != NULL;
+	   j = (j + 1) & mask)
+	;
+      table->table[j] = *p;
+      hash_link (table, j);
+      i = p->next;
+    }
+
+  free (old_table);
+}
+
+/* Add an entry for KEY, whose hash code is HASH, to TABLE at SLOT,
+   which hash_lookup returned.  */
+
+static void
+hash_add (struct hash_control *table, struct hash_entry *slot,
+	  const char *key, unsigned long hash, void *val)
+{
+#ifdef HASH_STATISTICS
+  ++table->insertions;
+#endif
+
+  if (slot->string == NULL)
+    {
+      /* Keep at least a quarter of the slots empty, so that probe
+	 sequences stay short and always end.  */
+      if ((table->used + 1) * 4 > table->size * 3)
+	{
+	  hash_expand (table);
+	  hash_lookup (table, key, strlen (key), &slot, NULL);
+	}
+      ++table->used;
+    }
+
+  slot->string = key;
+  slot->hash = hash;
+  slot->data = val;
+  hash_link (table, slot - table->table);
+  ++table->count;
+}
+
 /* Insert an entry into a hash table.  This returns NULL on success.
    On error, it returns a printable string indicating the error.  It
    is considered to be an error if the entry already exists in the
@@ -206,24 +352,14 @@ const char *
 hash_insert (struct hash_control *table, const char *key, void *val)
 {
   struct hash_entry *p;
-  struct hash_entry **list;
+  struct hash_entry *slot;
   unsigned long hash;
 
-  p = hash_lookup (table, key, strlen (key), &list, &hash);
+  p = hash_lookup (table, key, strlen (key), &slot, &hash);
   if (p != NULL)
     return "exists";
 
-#ifdef HASH_STATISTICS
-  ++table->insertions;
-#endif
-
-  p = (struct hash_entry *) obstack_alloc (&table->memory, sizeof (*p));
-  p->string = key;
-  p->hash = hash;
-  p->data = val;
-
-  p->next = *list;
-  *list = p;
+  hash_add (table, slot, key, hash, val);
 
   return NULL;
 }
@@ -236,10 +372,10 @@ const char *
 hash_jam (struct hash_control *table, const char *key, void *val)
 {
   struct hash_entry *p;
-  struct hash_entry **list;
+  struct hash_entry *slot;
   unsigned long hash;
 
-  p = hash_lookup (table, key, strlen (key), &list, &hash);
+  p = hash_lookup (table, key, strlen (key), &slot, &hash);
   if (p != NULL)
     {
 #ifdef HASH_STATISTICS
@@ -249,19 +385,7 @@ hash_jam (struct hash_control *table, const char *key, void *val)
       p->data = val;
     }
   else
-    {
-#ifdef HASH_STATISTICS
-      ++table->insertions;
-#endif
-
-      p = (struct hash_entry *) obstack_alloc (&table->memory, sizeof (*p));
-      p->string = key;
-      p->hash = hash;
-      p->data = val;
-
-      p->next = *list;
-      *list = p;
-    }
+    hash_add (table, slot, key, hash, val);
 
   return NULL;
 }
@@ -322,35 +446,41 @@ hash_find_n (struct hash_control *table, const char *key, size_t len)
 }
 
 /* Delete an entry from a hash table.  This returns the value stored
-   for that entry, or NULL if there is no such entry.  */
+   for that entry, or NULL if there is no such entry.  Entries are not
+   allocated separately, so there is never any memory to free.  */
 
 void *
-hash_delete (struct hash_control *table, const char *key, int freeme)
+hash_delete (struct hash_control *table, const char *key,
+	     int freeme ATTRIBUTE_UNUSED)
 {
   struct hash_entry *p;
-  struct hash_entry **list;
 
-  p = hash_lookup (table, key, strlen (key), &list, NULL);
+  p = hash_lookup (table, key, strlen (key), NULL, NULL);
   if (p == NULL)
     return NULL;
 
-  if (p != *list)
-    abort ();
-
 #ifdef HASH_STATISTICS
   ++table->deletions;
 #endif
 
-  *list = p->next;
+  if (p->prev == NO_ENTRY)
+    table->first = p->next;
+  else
+    table->table[p->prev].next = p->next;
+  if (p->next == NO_ENTRY)
+    table->last = p->prev;
+  else
+    table->table[p->next].prev = p->prev;
 
-  if (freeme)
-    obstack_free (&table->memory, p);
+  p->string = DELETED_ENTRY;
+  --table->count;
 
   return p->data;
 }
 
 /* Traverse a hash table.  Call the function on every entry in the
-   hash table.  */
+   hash table, in the order the entries were added.  The function may
+   delete the entry it is passed, but must not add entries.  */
 
 void
 hash_traverse (struct hash_control *table,
@@ -358,12 +488,13 @@ hash_traverse (struct hash_control *table,
 {
   unsigned int i;
 
-  for (i = 0; i < table->size; ++i)
+  for (i = table->first; i != NO_ENTRY; )
     {
-      struct hash_entry *p;
+      struct hash_entry *p = table->table + i;
 
-      for (p = table->table[i]; p != NULL; p = p->next)
-	(*pfn) (p->string, p->data);
+      /* Step past the entry first, in case PFN deletes it.  */
+      i = p->next;
+      (*pfn) (p->string, p->data);
     }
 }
 
@@ -376,10 +507,6 @@ hash_print_statistics (FILE *f ATTRIBUTE_UNUSED,
 		       struct hash_control *table ATTRIBUTE_UNUSED)
 {
 #ifdef HASH_STATISTICS
-  unsigned int i;
-  unsigned long total;
-  unsigned long empty;
-
   fprintf (f, "%s hash statistics:\n", name);
   fprintf (f, "\t%lu lookups\n", table->lookups);
   fprintf (f, "\t%lu hash comparisons\n", table->hash_compares);
@@ -387,209 +514,260 @@ hash_print_statistics (FILE *f ATTRIBUTE_UNUSED,
   fprintf (f, "\t%lu insertions\n", table->insertions);
   fprintf (f, "\t%lu replacements\n", table->replacements);
   fprintf (f, "\t%lu deletions\n", table->deletions);
-
-  total = 0;
-  empty = 0;
-  for (i = 0; i < table->size; ++i)
-    {
-      struct hash_entry *p;
-
-      if (table->table[i] == NULL)
-	++empty;
-      else
-	{
-	  for (p = table->table[i]; p != NULL; p = p->next)
-	    ++total;
-	}
-    }
-
-  fprintf (f, "\t%g average chain length\n", (double) total / table->size);
-  fprintf (f, "\t%lu empty slots\n", empty);
+  fprintf (f, "\t%lu expansions\n", table->expansions);
+  fprintf (f, "\t%u entries in %u slots (%u deleted)\n",
+	   table->count, table->size, table->used - table->count);
+  fprintf (f, "\t%g average probes per lookup\n",
+	   table->lookups ? (double) table->hash_compares / table->lookups : 0.0);
 #endif
 }
-
-#ifdef TEST
-
-/* This test program is left over from the old hash table code.  */
-
-/* Number of hash tables to maintain (at once) in any testing.  */
-#define TABLES (6)
-
-/* We can have 12 statistics.  */
-#define STATBUFSIZE (12)
-
-/* Display statistics here.  */
-int statbuf[STATBUFSIZE];
-
-/* Human farts here.  */
-char answer[100];
-
-/* We test many hash tables at once.  */
-char *hashtable[TABLES];
 
-/* Points to current hash_control.  */
-char *h;
-char **pp;
-char *p;
-char *name;
-char *value;
-int size;
-int used;
-char command;
-
-/* Number 0:TABLES-1 of current hashed symbol table.  */
-int number;
+#ifdef TEST
 
-int
-main ()
+/* A benchmark for the hash table code.  It collects the identifiers
+   in the assembler sources named on the command line, enters each of
+   them into a table the way the symbol table would, then looks all of
+   them up again, and prints the times taken and the table statistics.
+   Build it in the gas build directory with something like
+
+     gcc -O2 -DTEST -DHASH_STATISTICS -I. -I$srcdir -I../bfd \
+       -I$srcdir/config -I$srcdir/../include -I$srcdir/.. \
+       -I$srcdir/../bfd $srcdir/hash.c ../libiberty/libiberty.a \
+       -o hash-bench
+
+   and run it as "hash-bench [-s SIZE] [-r REPEAT] FILE...", where SIZE
+   is the number of entries to size the table for, as for --hash-size,
+   and REPEAT the number of times to look up every identifier.  It
+   first checks that hash_traverse keeps insertion order across
+   deletions and growth; without any FILE that is all it does.  */
+
+#include <time.h>
+
+/* The number of keys check_traverse uses.  This is enough to make the
+   table grow several times from its smallest size.  */
+#define CHECK_KEYS 1000
+
+/* The state of check_order: the table being traversed, the keys it
+   should visit in order, how many it has visited, whether to delete
+   each entry as it is visited, and whether anything went wrong.  */
+static struct hash_control *check_table;
+static char **check_expected;
+static unsigned int check_seen;
+static int check_delete_self;
+static int check_failed;
+
+/* A hash_traverse callback that checks that KEY is the next expected
+   key and that VALUE is the key itself.  */
+
+static void
+check_entry (const char *key, void *value)
 {
-  void applicatee ();
-  void destroy ();
-  char *what ();
-  int *ip;
-
-  number = 0;
-  h = 0;
-  printf ("type h <RETURN> for help\n");
-  for (;;)
+  if (strcmp (key, check_expected[check_seen]) != 0 || value != key)
     {
-      printf ("hash_test command: ");
-      gets (answer);
-      command = answer[0];
-      command = TOLOWER (command);	/* Ecch!  */
-      switch (command)
-	{
-	case '#':
-	  printf ("old hash table #=%d.\n", number);
-	  whattable ();
-	  break;
-	case '?':
-	  for (pp = hashtable; pp < hashtable + TABLES; pp++)
-	    {
-	      printf ("address of hash table #%d control block is %xx\n",
-		      pp - hashtable, *pp);
-	    }
-	  break;
-	case 'a':
-	  hash_traverse (h, applicatee);
-	  break;
-	case 'd':
-	  hash_traverse (h, destroy);
-	  hash_die (h);
-	  break;
-	case 'f':
-	  p = hash_find (h, name = what ("symbol"));
-	  printf ("value of \"%s\" is \"%s\"\n", name, p ? p : "NOT-PRESENT");
-	  break;
-	case 'h':
-	  printf ("# show old, select new default hash table number\n");
-	  printf ("? display all hashtable control block addresses\n");
-	  printf ("a apply a simple display-er to each symbol in table\n");
-	  printf ("d die: destroy hashtable\n");
-	  printf ("f find value of nominated symbol\n");
-	  printf ("h this help\n");
-	  printf ("i insert value into symbol\n");
-	  printf ("j jam value into symbol\n");
-	  printf ("n new hashtable\n");
-	  printf ("r replace a value with another\n");
-	  printf ("s say what %% of table is used\n");
-	  printf ("q exit this program\n");
-	  printf ("x delete a symbol from table, report its value\n");
-	  break;
-	case 'i':
-	  p = hash_insert (h, name = what ("symbol"), value = what ("value"));
-	  if (p)
-	    {
-	      printf ("symbol=\"%s\"  value=\"%s\"  error=%s\n", name, value,
-		      p);
-	    }
-	  break;
-	case 'j':
-	  p = hash_jam (h, name = what ("symbol"), value = what ("value"));
-	  if (p)
-	    {
-	      printf ("symbol=\"%s\"  value=\"%s\"  error=%s\n", name, value, p);
-	    }
-	  break;
-	case 'n':
-	  h = hashtable[number] = (char *) hash_new ();
-	  break;
-	case 'q':
-	  exit (EXIT_SUCCESS);
-	case 'r':
-	  p = hash_replace (h, name = what ("symbol"), value = what ("value"));
-	  printf ("old value was \"%s\"\n", p ? p : "{}");
-	  break;
-	case 's':
-	  hash_say (h, statbuf, STATBUFSIZE);
-	  for (ip = statbuf; ip < statbuf + STATBUFSIZE; ip++)
-	    {
-	      printf ("%d ", *ip);
-	    }
-	  printf ("\n");
-	  break;
-	case 'x':
-	  p = hash_delete (h, name = what ("symbol"));
-	  printf ("old value was \"%s\"\n", p ? p : "{}");
-	  break;
-	default:
-	  printf ("I can't understand command \"%c\"\n", command);
-	  break;
-	}
+      fprintf (stderr, "traverse: got %s, expected %s\n", key,
+	       check_expected[check_seen]);
+      check_failed = 1;
     }
+  check_seen++;
+  if (check_delete_self)
+    hash_delete (check_table, key, 0);
 }
 
-char *
-what (description)
-     char *description;
-{
-  printf ("   %s : ", description);
-  gets (answer);
-  return xstrdup (answer);
-}
+/* Traverse TABLE and check that it visits the N keys in EXPECTED in
+   that order.  */
 
-void
-destroy (string, value)
-     char *string;
-     char *value;
+static void
+check_order (struct hash_control *table, char **expected, unsigned int n,
+	     int delete_self)
 {
-  free (string);
-  free (value);
+  check_table = table;
+  check_expected = expected;
+  check_seen = 0;
+  check_delete_self = delete_self;
+  hash_traverse (table, check_entry);
+  if (check_seen != n)
+    {
+      fprintf (stderr, "traverse: visited %u entries, expected %u\n",
+	       check_seen, n);
+      check_failed = 1;
+    }
 }
 
-void
-applicatee (string, value)
-     char *string;
-     char *value;
+/* Check that hash_traverse visits entries in the order they were
+   added, after deleting entries, reusing their slots, and growing a
+   table that holds deleted entries.  Return nonzero on success.  */
+
+static int
+check_traverse (void)
 {
-  printf ("%.20s-%.20s\n", string, value);
+  struct hash_control *table;
+  char *keys[2 * CHECK_KEYS];
+  char *expected[2 * CHECK_KEYS];
+  unsigned int n;
+  unsigned int i;
+
+  for (i = 0; i < 2 * CHECK_KEYS; i++)
+    keys[i] = xasprintf ("key%u", i);
+
+  table = hash_new_sized (0);
+  for (i = 0; i < CHECK_KEYS; i++)
+    hash_insert (table, keys[i], keys[i]);
+  check_order (table, keys, CHECK_KEYS, 0);
+
+  /* Delete every third key, leaving deleted slots behind.  Replacing
+     the value of a key does not move it.  */
+  n = 0;
+  for (i = 0; i < CHECK_KEYS; i++)
+    if (i % 3 == 0)
+      hash_delete (table, keys[i], 0);
+    else
+      {
+	hash_jam (table, keys[i], keys[i]);
+	expected[n++] = keys[i];
+      }
+  check_order (table, expected, n, 0);
+
+  /* Add the deleted keys back, which may reuse their deleted slots,
+     then enough new ones to grow the table.  Both go at the end.  */
+  for (i = 0; i < CHECK_KEYS; i += 3)
+    {
+      hash_insert (table, keys[i], keys[i]);
+      expected[n++] = keys[i];
+    }
+  for (i = CHECK_KEYS; i < 2 * CHECK_KEYS; i++)
+    {
+      hash_insert (table, keys[i], keys[i]);
+      expected[n++] = keys[i];
+    }
+  check_order (table, expected, n, 0);
+
+  /* A traversal may delete the entry it is passed.  */
+  check_order (table, expected, n, 1);
+  check_order (table, expected, 0, 0);
+  for (i = 0; i < 2 * CHECK_KEYS; i++)
+    if (hash_find (table, keys[i]) != NULL)
+      {
+	fprintf (stderr, "traverse: %s not deleted\n", keys[i]);
+	check_failed = 1;
+      }
+
+  hash_die (table);
+  for (i = 0; i < 2 * CHECK_KEYS; i++)
+    free (keys[i]);
+
+  printf ("traverse order: %s\n", check_failed ? "FAILED" : "ok");
+  return !check_failed;
 }
 
-/* Determine number: what hash table to use.
-   Also determine h: points to hash_control.  */
+/* Whether C can start or continue an identifier.  */
+#define IS_IDENT_START(C) (ISALPHA (C) || (C) == '_' || (C) == '.' || (C) == '$')
+#define IS_IDENT_CHAR(C) (IS_IDENT_START (C) || ISDIGIT (C))
 
-void
-whattable ()
+/* Add the identifiers in FILENAME to the array *PWORDS of *PCOUNT
+   entries and room for *PALLOC.  */
+
+static void
+read_words (const char *filename, char ***pwords, size_t *pcount,
+	    size_t *palloc)
 {
-  for (;;)
+  FILE *f;
+  char *buf;
+  long len;
+  char *p;
+
+  f = fopen (filename, "rb");
+  if (f == NULL || fseek (f, 0, SEEK_END) != 0 || (len = ftell (f)) < 0)
     {
-      printf ("   what hash table (%d:%d) ?  ", 0, TABLES - 1);
-      gets (answer);
-      sscanf (answer, "%d", &number);
-      if (number >= 0 && number < TABLES)
+      perror (filename);
+      exit (EXIT_FAILURE);
+    }
+  rewind (f);
+  buf = XNEWVEC (char, len + 1);
+  if (fread (buf, 1, len, f) != (size_t) len)
+    {
+      perror (filename);
+      exit (EXIT_FAILURE);
+    }
+  fclose (f);
+  buf[len] = '\0';
+
+  for (p = buf; *p != '\0'; )
+    {
+      char *start;
+
+      if (!IS_IDENT_START (*p))
 	{
-	  h = hashtable[number];
-	  if (!h)
-	    {
-	      printf ("warning: current hash-table-#%d. has no hash-control\n", number);
-	    }
-	  return;
+	  p++;
+	  continue;
 	}
-      else
+      start = p;
+      while (IS_IDENT_CHAR (*p))
+	p++;
+      if (*p != '\0')
+	*p++ = '\0';
+
+      if (*pcount == *palloc)
 	{
-	  printf ("invalid hash table number: %d\n", number);
+	  *palloc = *palloc * 2 + 1024;
+	  *pwords = XRESIZEVEC (char *, *pwords, *palloc);
 	}
+      (*pwords)[(*pcount)++] = start;
     }
 }
 
+int
+main (int argc, char **argv)
+{
+  char **words = NULL;
+  size_t count = 0;
+  size_t alloc = 0;
+  unsigned long repeat = 10;
+  unsigned long r;
+  size_t i;
+  size_t found;
+  struct hash_control *table;
+  clock_t start;
+  double insert_time;
+  double find_time;
+  int arg;
+
+  for (arg = 1; arg < argc; arg++)
+    {
+      if (strcmp (argv[arg], "-s") == 0 && arg + 1 < argc)
+	set_gas_hash_table_size (strtoul (argv[++arg], NULL, 0));
+      else if (strcmp (argv[arg], "-r") == 0 && arg + 1 < argc)
+	repeat = strtoul (argv[++arg], NULL, 0);
+      else
+	read_words (argv[arg], &words, &count, &alloc);
+    }
+
+  if (!check_traverse ())
+    return EXIT_FAILURE;
+  if (count == 0)
+    return EXIT_SUCCESS;
+
+  start = clock ();
+  table = hash_new ();
+  for (i = 0; i < count; i++)
+    hash_jam (table, words[i], words[i]);
+  insert_time = (double) (clock () - start) / CLOCKS_PER_SEC;
+
+  start = clock ();
+  found = 0;
+  for (r = 0; r < repeat; r++)
+    for (i = 0; i < count; i++)
+      if (hash_find (table, words[i]) != NULL)
+	found++;
+  find_time = (double) (clock () - start) / CLOCKS_PER_SEC;
+
+  printf ("%lu identifiers\n", (unsigned long) count);
+  printf ("insert: %.3fs\n", insert_time);
+  printf ("find: %.3fs for %lu lookups (%lu found)\n", find_time,
+	  (unsigned long) (count * repeat), (unsigned long) found);
+  hash_print_statistics (stdout, "benchmark", table);
+
+  hash_die (table);
+  return found == count * repeat ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 #endif /* TEST */
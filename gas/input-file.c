@@ -35,7 +35,9 @@ int preprocess = 0;
    chunks of the file on demand.
    BUFFER_SIZE is supposed to be a number chosen for speed.
    The caller only asks once what BUFFER_SIZE is, and asks before
-   the nature of the input files (if any) is known.  */
+   the nature of the input files (if any) is known.
+   Reading the file costs next to nothing beside scrubbing it in app.c;
+   larger buffers, or mapping the file, do not make gas any faster.  */
 
 #define BUFFER_SIZE (32 * 1024)
 
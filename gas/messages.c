@@ -26,6 +26,19 @@
 extern const char *strsignal (int);
 #endif
 
+#ifdef ENABLE_THREADS
+#include <pthread.h>
+
+/* With --threads, write_relocs may report problems from several
+   threads at once.  Each message is printed and counted whole.  */
+static pthread_mutex_t messages_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_MESSAGES() pthread_mutex_lock (&messages_lock)
+#define UNLOCK_MESSAGES() pthread_mutex_unlock (&messages_lock)
+#else
+#define LOCK_MESSAGES()
+#define UNLOCK_MESSAGES()
+#endif
+
 static void identify (const char *);
 static void as_show_where (void);
 static void as_warn_internal (const char *, unsigned int, char *);
@@ -153,6 +166,7 @@ as_tsktsk (const char *format, ...)
 static void
 as_warn_internal (const char *file, unsigned int line, char *buffer)
 {
+  LOCK_MESSAGES ();
   ++warning_count;
 
   if (file == NULL)
@@ -171,6 +185,7 @@ as_warn_internal (const char *file, unsigned int line, char *buffer)
 #ifndef NO_LISTING
   listing_warning (buffer);
 #endif
+  UNLOCK_MESSAGES ();
 }
 
 /* Send to stderr a string as a warning, and locate warning
@@ -218,6 +233,7 @@ as_warn_where (const char *file, unsigned int line, const char *format, ...)
 static void
 as_bad_internal (const char *file, unsigned int line, char *buffer)
 {
+  LOCK_MESSAGES ();
   ++error_count;
 
   if (file == NULL)
@@ -236,6 +252,7 @@ as_bad_internal (const char *file, unsigned int line, char *buffer)
 #ifndef NO_LISTING
   listing_error (buffer);
 #endif
+  UNLOCK_MESSAGES ();
 }
 
 /* Send to stderr a string as a warning, and locate warning in input
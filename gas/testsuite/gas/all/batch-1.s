@@ -0,0 +1,5 @@
+	.data
+	.globl	one
+one:
+	.long	1
+	.long	one
@@ -0,0 +1,11 @@
+	.data
+	.globl	two
+two:
+	.long	2
+	.long	two
+	.section .rodata.two
+	.byte	2
+	.macro	twice v
+	.byte	\v, \v
+	.endm
+	twice	2
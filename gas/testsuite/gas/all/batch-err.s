@@ -0,0 +1,2 @@
+	.data
+	.error "this object fails"
@@ -0,0 +1,17 @@
+	.text
+	.align	2
+	.globl	_func1
+	.type	_func1, @function
+_func1:
+	.cfi_startproc
+	add	sp,sp,-16
+	.cfi_def_cfa_offset 16
+	call	_func2
+	.cfi_remember_state
+	add	sp,sp,16
+	.cfi_def_cfa_offset 0
+	ret
+	.cfi_restore_state
+	tail	_func2
+	.cfi_endproc
+	.size	_func1, .-_func1
@@ -0,0 +1,7 @@
+	.text
+	li	a0, 0x123456789abcdef0
+	li	a1, 0x123456789abcdef0
+	li	a2, 0x1234
+	li	a3, 0x100000000
+	li	a4, 0x0fedcba987654321
+	li	zero, 0x123456789abcdef
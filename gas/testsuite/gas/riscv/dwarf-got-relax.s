@@ -0,0 +1,11 @@
+	.text
+	.file 1 "dwarf-got-relax.c"
+	.option pic
+	.loc 1 1
+	la a0, sym
+	.loc 1 2
+	la.tls.gd a1, t
+	.loc 1 3
+	la.tls.ie a2, t
+	.loc 1 4
+	ret
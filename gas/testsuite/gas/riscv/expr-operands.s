@@ -0,0 +1,23 @@
+# Operands that expr parses without the general parser, and some that
+# look like them but must not be: an operator after the number, local
+# label references and octal.
+	.equ	abs, 100
+	.text
+	addi	a0, a0, -0x10
+	addi	a0, a0, 017
+	addi	a0, a0, abs+1
+	addi	a0, a0, abs - 1
+	addi	a0, a0, 2+3
+	lui	a0, %hi(sym+4)
+	addi	a0, a0, %lo(sym-4)
+
+	.data
+	.word	12, -12, 0x7f, -0x10, 0x7fffffff, -0x80000000
+	.word	0, 017, -017, 0x0
+	.word	abs+1, abs - 1, fwd, fwd+1
+	.word	sym+4, sym-4, sym + 8, sym - 8
+0:
+1:	.word	1b, 1f, 0f, 2+3
+0:
+1:	.word	1b
+	.equ	fwd, 5
@@ -0,0 +1,10 @@
+	.text
+	li	a0, 5
+	li	a1, -32
+	li	a2, 0x1f000
+	li	a3, -4096
+	li	a4, 0x12345
+	li	sp, 0x1f000
+	li	a5, 0x100000000
+	li	a0, 0x1234567890
+	li	a1, 0x100000001
@@ -0,0 +1,2 @@
+	add	a0, a1, a2
+	c.addi	a0, 1
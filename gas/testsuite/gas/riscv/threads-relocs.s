@@ -0,0 +1,22 @@
+# Relocations of several sections built at once, interleaved with
+# relocations from .reloc.
+	.text
+	.globl	f
+f:
+	call	g
+	.reloc	., R_RISCV_NONE, h
+	la	a0, d
+	ret
+
+	.section .text.g, "ax", @progbits
+	.globl	g
+g:
+	tail	h
+	bnez	a0, f
+
+	.data
+d:
+	.dword	f
+	.dword	g + 4
+	.reloc	., R_RISCV_NONE, d
+	.word	h - g
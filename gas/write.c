@@ -27,6 +27,14 @@
 #include "dwarf2dbg.h"
 #include "compress-debug.h"
 
+/* Relocations are built on several threads with --threads only if
+   the target says that its tc_gen_reloc may run for several sections
+   at once.  */
+#if defined (ENABLE_THREADS) && defined (TC_GEN_RELOC_THREAD_SAFE)
+#define WRITE_RELOCS_THREADS 1
+#include <pthread.h>
+#endif
+
 #ifndef TC_FORCE_RELOCATION
 #define TC_FORCE_RELOCATION(FIX)		\
   (generic_force_reloc (FIX))
@@ -1200,20 +1208,28 @@ get_frag_for_reloc (fragS *last_frag,
   return NULL;
 }
 
+/* The relocations of one section, while write_relocs builds them.  */
+
+struct section_relocs
+{
+  asection *sec;
+  /* The relocations from .reloc directives for SEC.  */
+  struct reloc_list *reloc_list;
+  /* The relocations built so far, and how many there are.  */
+  arelent **relocs;
+  unsigned int n;
+};
+
+/* Start building the relocations of SEC in SR.  This takes the
+   relocations for SEC from the global reloc_list.  */
+
 static void
-write_relocs (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
+start_section_relocs (asection *sec, struct section_relocs *sr)
 {
   segment_info_type *seginfo = seg_info (sec);
   unsigned int n;
   struct reloc_list *my_reloc_list, **rp, *r;
-  arelent **relocs;
   fixS *fixp;
-  fragS *last_frag;
-
-  /* If seginfo is NULL, we did not create this section; don't do
-     anything with it.  */
-  if (seginfo == NULL)
-    return;
 
   n = 0;
   for (fixp = seginfo->fix_root; fixp; fixp = fixp->fx_next)
@@ -1240,10 +1256,29 @@ write_relocs (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
 	rp = &r->next;
     }
 
-  relocs = XCNEWVEC (arelent *, n);
+  sr->sec = sec;
+  sr->reloc_list = my_reloc_list;
+  sr->relocs = XCNEWVEC (arelent *, n);
+  sr->n = 0;
+}
+
+/* Build the relocations of SR->sec from its fixups and .reloc
+   directives.  This touches nothing outside SR->sec but its frags, so
+   it may run for several sections at once if tc_gen_reloc allows.  */
+
+static void
+gen_section_relocs (struct section_relocs *sr)
+{
+  asection *sec = sr->sec;
+  segment_info_type *seginfo = seg_info (sec);
+  arelent **relocs = sr->relocs;
+  unsigned int n;
+  struct reloc_list *r;
+  fixS *fixp;
+  fragS *last_frag;
 
   n = 0;
-  r = my_reloc_list;
+  r = sr->reloc_list;
   last_frag = NULL;
   for (fixp = seginfo->fix_root; fixp != (fixS *) NULL; fixp = fixp->fx_next)
     {
@@ -1310,6 +1345,18 @@ write_relocs (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
       r = r->next;
     }
 
+  sr->n = n;
+}
+
+/* Attach the relocations built in SR to their section.  */
+
+static void
+finish_section_relocs (bfd *abfd, struct section_relocs *sr)
+{
+  asection *sec = sr->sec;
+  arelent **relocs = sr->relocs;
+  unsigned int n = sr->n;
+
 #ifdef DEBUG4
   {
     unsigned int k, j, nsyms;
@@ -1357,6 +1404,90 @@ write_relocs (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
 #endif
 }
 
+static void
+write_relocs (bfd *abfd, asection *sec, void *xxx ATTRIBUTE_UNUSED)
+{
+  struct section_relocs sr;
+
+  /* If seginfo is NULL, we did not create this section; don't do
+     anything with it.  */
+  if (seg_info (sec) == NULL)
+    return;
+
+  start_section_relocs (sec, &sr);
+  gen_section_relocs (&sr);
+  finish_section_relocs (abfd, &sr);
+}
+
+#ifdef WRITE_RELOCS_THREADS
+/* The sections whose relocations write_relocs_threaded is building,
+   the next one to start on, and a lock for that index.  */
+static struct section_relocs *relocs_work;
+static unsigned int relocs_work_count;
+static unsigned int relocs_work_next;
+static pthread_mutex_t relocs_work_lock;
+
+static void *
+write_relocs_thread (void *arg ATTRIBUTE_UNUSED)
+{
+  for (;;)
+    {
+      unsigned int i;
+
+      pthread_mutex_lock (&relocs_work_lock);
+      i = relocs_work_next++;
+      pthread_mutex_unlock (&relocs_work_lock);
+      if (i >= relocs_work_count)
+	break;
+      gen_section_relocs (&relocs_work[i]);
+    }
+  return NULL;
+}
+
+/* Do what write_relocs does for every section, but build the
+   relocations of up to flag_threads sections at once.  Taking the
+   .reloc directives of each section from reloc_list and attaching the
+   relocations to the sections are done in section order on this
+   thread, so the output is the same as write_relocs gives.  */
+
+static void
+write_relocs_threaded (void)
+{
+  asection *sec;
+  pthread_t *threads;
+  unsigned int i, nthreads;
+
+  relocs_work = XNEWVEC (struct section_relocs, stdoutput->section_count);
+  relocs_work_count = 0;
+  relocs_work_next = 0;
+  for (sec = stdoutput->sections; sec != NULL; sec = sec->next)
+    if (seg_info (sec) != NULL)
+      start_section_relocs (sec, &relocs_work[relocs_work_count++]);
+
+  /* This thread is one of the workers.  If a thread can't be created,
+     the ones that were do the rest.  */
+  pthread_mutex_init (&relocs_work_lock, NULL);
+  nthreads = flag_threads - 1;
+  if (nthreads > relocs_work_count)
+    nthreads = relocs_work_count;
+  threads = XNEWVEC (pthread_t, nthreads);
+  for (i = 0; i < nthreads; i++)
+    if (pthread_create (&threads[i], NULL, write_relocs_thread, NULL) != 0)
+      break;
+  nthreads = i;
+  write_relocs_thread (NULL);
+  for (i = 0; i < nthreads; i++)
+    pthread_join (threads[i], NULL);
+  pthread_mutex_destroy (&relocs_work_lock);
+  free (threads);
+
+  for (i = 0; i < relocs_work_count; i++)
+    finish_section_relocs (stdoutput, &relocs_work[i]);
+  free (relocs_work);
+  relocs_work = NULL;
+}
+#endif
+
 static int
 compress_frag (struct z_stream_s *strm, const char *contents, int in_size,
 	       fragS **last_newf, struct obstack *ob)
@@ -2201,7 +2332,12 @@ write_object_file (void)
 #ifdef obj_coff_generate_pdata
   obj_coff_generate_pdata ();
 #endif
-  bfd_map_over_sections (stdoutput, write_relocs, (char *) 0);
+#ifdef WRITE_RELOCS_THREADS
+  if (flag_threads > 1)
+    write_relocs_threaded ();
+  else
+#endif
+    bfd_map_over_sections (stdoutput, write_relocs, (char *) 0);
 
 #ifdef tc_frob_file_after_relocs
   tc_frob_file_after_relocs ();
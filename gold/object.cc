@@ -2200,8 +2200,11 @@ Sized_relobj_file<size, big_endian>::do_count_local_symbols(Stringpool* pool,
   psyms += sym_size;
   bool strip_all = parameters->options().strip_all();
   bool discard_all = parameters->options().discard_all();
-  bool discard_locals = parameters->options().discard_locals();
   bool discard_sec_merge = parameters->options().discard_sec_merge();
+  bool discard_locals =
+    (parameters->options().discard_locals()
+     || (discard_sec_merge
+	 && parameters->target().discard_local_labels_by_default()));
   for (unsigned int i = 1; i < loccount; ++i, psyms += sym_size)
     {
       elfcpp::Sym<size, big_endian> sym(psyms);
@@ -2268,8 +2271,9 @@ Sized_relobj_file<size, big_endian>::do_count_local_symbols(Stringpool* pool,
 	}
 
       // By default, discard temporary local symbols in merge sections.
-      // If --discard-locals option is used, discard all temporary local
-      // symbols.  These symbols start with system-specific local label
+      // If --discard-locals option is used, or the target discards
+      // local labels by default, discard all temporary local symbols.
+      // These symbols start with system-specific local label
       // prefixes, typically .L for ELF system.  We want to be compatible
       // with GNU ld so here we essentially use the same check in
       // bfd_is_local_label().  The code is different because we already
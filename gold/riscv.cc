@@ -0,0 +1,3647 @@
+// riscv.cc -- riscv target support for gold.
+
+// Copyright (C) 2017 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "elfcpp.h"
+#include "parameters.h"
+#include "reloc.h"
+#include "riscv.h"
+#include "object.h"
+#include "symtab.h"
+#include "layout.h"
+#include "output.h"
+#include "copy-relocs.h"
+#include "target.h"
+#include "target-reloc.h"
+#include "target-select.h"
+#include "tls.h"
+#include "gc.h"
+#include "icf.h"
+
+// The first two .got.plt entries are reserved for the dynamic linker.
+const int32_t RISCV_GOTPLT_RESERVE_COUNT = 2;
+
+// The bias applied to DTP-relative offsets by the RISC-V TLS ABI.
+const int32_t RISCV_DTP_OFFSET = 0x800;
+
+namespace
+{
+
+using namespace gold;
+
+template<int size, bool big_endian>
+class Output_data_plt_riscv;
+
+template<int size, bool big_endian>
+class Riscv_input_section;
+
+template<int size, bool big_endian>
+class Target_riscv;
+
+// Instruction encodings and immediate formats.  These follow
+// include/opcode/riscv.h; the linker only needs the handful of
+// instructions it rewrites or synthesizes.
+
+class Riscv_insn
+{
+ public:
+  typedef uint32_t Insntype;
+
+  // Integer registers.
+  enum
+  {
+    X_ZERO = 0,
+    X_RA = 1,
+    X_SP = 2,
+    X_GP = 3,
+    X_TP = 4,
+    X_T0 = 5,
+    X_T1 = 6,
+    X_T2 = 7,
+    X_T3 = 28
+  };
+
+  // Opcodes, with all register and immediate fields clear.
+  enum
+  {
+    MATCH_ADDI = 0x13,
+    MATCH_AUIPC = 0x17,
+    MATCH_LUI = 0x37,
+    MATCH_JALR = 0x67,
+    MATCH_JAL = 0x6f,
+    MATCH_SRLI = 0x5013,
+    MATCH_LW = 0x2003,
+    MATCH_LD = 0x3003,
+    MATCH_SUB = 0x40000033,
+    MATCH_C_NOP = 0x1,
+    MATCH_C_JAL = 0x2001,
+    MATCH_C_LI = 0x4001,
+    MATCH_C_LUI = 0x6001,
+    MATCH_C_J = 0xa001
+  };
+
+  // The bits of an instruction that hold each immediate format, and
+  // the rd and rs1 register fields.
+  static const Insntype ITYPE_MASK = 0xfff00000;
+  static const Insntype STYPE_MASK = 0xfe000f80;
+  static const Insntype SBTYPE_MASK = 0xfe000f80;
+  static const Insntype UTYPE_MASK = 0xfffff000;
+  static const Insntype UJTYPE_MASK = 0xfffff000;
+  static const Insntype RVC_IMM_MASK = 0x107c;
+  static const Insntype RVC_B_MASK = 0x1c7c;
+  static const Insntype RVC_J_MASK = 0x1ffc;
+  static const Insntype RVC_OPCODE_MASK = 0xe003;
+  static const Insntype RD_MASK = 0x1f << 7;
+  static const Insntype RS1_MASK = 0x1f << 15;
+
+  static const int RD_SHIFT = 7;
+  static const int RS1_SHIFT = 15;
+  static const int RS2_SHIFT = 20;
+
+  // The NOP instructions used for alignment padding.
+  static const Insntype NOP = MATCH_ADDI;
+  static const Insntype C_NOP = MATCH_C_NOP;
+
+  // Return N bits of X starting at bit S.
+  static inline Insntype
+  bits(uint64_t x, int s, int n)
+  { return (x >> s) & ((static_cast<uint64_t>(1) << n) - 1); }
+
+  static inline Insntype
+  encode_itype_imm(uint64_t x)
+  { return bits(x, 0, 12) << 20; }
+
+  static inline Insntype
+  encode_stype_imm(uint64_t x)
+  { return (bits(x, 0, 5) << 7) | (bits(x, 5, 7) << 25); }
+
+  static inline Insntype
+  encode_sbtype_imm(uint64_t x)
+  {
+    return ((bits(x, 1, 4) << 8) | (bits(x, 5, 6) << 25)
+	    | (bits(x, 11, 1) << 7) | (bits(x, 12, 1) << 31));
+  }
+
+  static inline Insntype
+  encode_utype_imm(uint64_t x)
+  { return bits(x, 12, 20) << 12; }
+
+  static inline Insntype
+  encode_ujtype_imm(uint64_t x)
+  {
+    return ((bits(x, 1, 10) << 21) | (bits(x, 11, 1) << 20)
+	    | (bits(x, 12, 8) << 12) | (bits(x, 20, 1) << 31));
+  }
+
+  static inline Insntype
+  encode_rvc_imm(uint64_t x)
+  { return (bits(x, 0, 5) << 2) | (bits(x, 5, 1) << 12); }
+
+  static inline Insntype
+  encode_rvc_lui_imm(uint64_t x)
+  { return encode_rvc_imm(x >> 12); }
+
+  static inline Insntype
+  encode_rvc_b_imm(uint64_t x)
+  {
+    return ((bits(x, 1, 2) << 3) | (bits(x, 3, 2) << 10) | (bits(x, 5, 1) << 2)
+	    | (bits(x, 6, 2) << 5) | (bits(x, 8, 1) << 12));
+  }
+
+  static inline Insntype
+  encode_rvc_j_imm(uint64_t x)
+  {
+    return ((bits(x, 1, 3) << 3) | (bits(x, 4, 1) << 11) | (bits(x, 5, 1) << 2)
+	    | (bits(x, 6, 1) << 7) | (bits(x, 7, 1) << 6) | (bits(x, 8, 2) << 9)
+	    | (bits(x, 10, 1) << 8) | (bits(x, 11, 1) << 12));
+  }
+
+  static inline bool
+  valid_itype_imm(int64_t x)
+  { return x >= -2048 && x < 2048; }
+
+  static inline bool
+  valid_sbtype_imm(int64_t x)
+  { return (x & 1) == 0 && x >= -4096 && x < 4096; }
+
+  static inline bool
+  valid_ujtype_imm(int64_t x)
+  { return (x & 1) == 0 && x >= -(1 << 20) && x < (1 << 20); }
+
+  static inline bool
+  valid_rvc_b_imm(int64_t x)
+  { return (x & 1) == 0 && x >= -256 && x < 256; }
+
+  static inline bool
+  valid_rvc_j_imm(int64_t x)
+  { return (x & 1) == 0 && x >= -2048 && x < 2048; }
+
+  // Whether X, whose low 12 bits are clear, fits in the 20-bit
+  // immediate of LUI or AUIPC.
+  static inline bool
+  valid_utype_imm(int64_t x)
+  {
+    return ((x & 0xfff) == 0
+	    && x >= -(static_cast<int64_t>(1) << 31)
+	    && x < (static_cast<int64_t>(1) << 31));
+  }
+
+  // Whether X fits in the nonzero 6-bit immediate of C.LUI.
+  static inline bool
+  valid_rvc_lui_imm(int64_t x)
+  { return (x & 0xfff) == 0 && x != 0 && x >= -(32 << 12) && x < (32 << 12); }
+
+  // The part of X that a LUI or AUIPC supplies, allowing for the sign
+  // extended 12-bit immediate of the instruction that follows.
+  static inline int64_t
+  const_high_part(int64_t x)
+  { return (x + 0x800) & ~static_cast<int64_t>(0xfff); }
+
+  // Build R, I and U type instructions.
+  static inline Insntype
+  rtype(Insntype match, unsigned int rd, unsigned int rs1, unsigned int rs2)
+  {
+    return (match | (rd << RD_SHIFT) | (rs1 << RS1_SHIFT)
+	    | (rs2 << RS2_SHIFT));
+  }
+
+  static inline Insntype
+  itype(Insntype match, unsigned int rd, unsigned int rs1, int64_t imm)
+  {
+    return (match | (rd << RD_SHIFT) | (rs1 << RS1_SHIFT)
+	    | encode_itype_imm(imm));
+  }
+
+  static inline Insntype
+  utype(Insntype match, unsigned int rd, int64_t imm)
+  { return match | (rd << RD_SHIFT) | encode_utype_imm(imm); }
+};
+
+// Reading and writing instructions and data.
+
+template<bool big_endian>
+class Riscv_relocate_functions
+{
+ public:
+  typedef Riscv_insn::Insntype Insntype;
+
+  template<int valsize>
+  static inline typename elfcpp::Swap_unaligned<valsize, big_endian>::Valtype
+  get(const unsigned char* view)
+  { return elfcpp::Swap_unaligned<valsize, big_endian>::readval(view); }
+
+  template<int valsize>
+  static inline void
+  put(unsigned char* view, uint64_t value)
+  {
+    typedef typename elfcpp::Swap_unaligned<valsize, big_endian>::Valtype
+      Valtype;
+    elfcpp::Swap_unaligned<valsize, big_endian>::writeval(
+	view, static_cast<Valtype>(value));
+  }
+
+  // Replace the MASK bits of the 32-bit instruction at VIEW with BITS.
+  static inline void
+  update_insn(unsigned char* view, Insntype mask, Insntype bits)
+  {
+    Insntype insn = get<32>(view);
+    put<32>(view, (insn & ~mask) | (bits & mask));
+  }
+
+  // Likewise for the 16-bit instruction at VIEW.
+  static inline void
+  update_rvc_insn(unsigned char* view, Insntype mask, Insntype bits)
+  {
+    Insntype insn = get<16>(view);
+    put<16>(view, (insn & ~mask) | (bits & mask));
+  }
+
+  // Apply an R_RISCV_GPREL_I or R_RISCV_GPREL_S for VALUE to the
+  // instruction at VIEW.  The instruction uses x0 as its base register
+  // if VALUE fits in its immediate, and the global pointer GP
+  // otherwise.  Return false if neither reaches VALUE.
+  static bool
+  gprel(unsigned char* view, unsigned int r_type, uint64_t value,
+	uint64_t gp)
+  {
+    int64_t offset = static_cast<int64_t>(value);
+    Insntype base = Riscv_insn::X_ZERO;
+    if (!Riscv_insn::valid_itype_imm(offset))
+      {
+	offset = static_cast<int64_t>(value - gp);
+	if (!Riscv_insn::valid_itype_imm(offset))
+	  return false;
+	base = Riscv_insn::X_GP;
+      }
+    if (r_type == elfcpp::R_RISCV_GPREL_I)
+      update_insn(view, Riscv_insn::RS1_MASK | Riscv_insn::ITYPE_MASK,
+		  ((base << Riscv_insn::RS1_SHIFT)
+		   | Riscv_insn::encode_itype_imm(offset)));
+    else
+      update_insn(view, Riscv_insn::RS1_MASK | Riscv_insn::STYPE_MASK,
+		  ((base << Riscv_insn::RS1_SHIFT)
+		   | Riscv_insn::encode_stype_imm(offset)));
+    return true;
+  }
+};
+
+// The RISC-V GOT.  Its first entry holds the address of the .dynamic
+// section.
+
+template<int size, bool big_endian>
+class Output_data_got_riscv : public Output_data_got<size, big_endian>
+{
+ public:
+  typedef typename elfcpp::Elf_types<size>::Elf_Addr Valtype;
+
+  Output_data_got_riscv(Layout* layout)
+    : Output_data_got<size, big_endian>(), layout_(layout)
+  { }
+
+ protected:
+  // Write out the GOT table.
+  void
+  do_write(Output_file* of)
+  {
+    gold_assert(this->data_size() >= size / 8);
+    Output_section* dynamic = this->layout_->dynamic_section();
+    Valtype dynamic_addr = dynamic == NULL ? 0 : dynamic->address();
+    this->replace_constant(0, dynamic_addr);
+    Output_data_got<size, big_endian>::do_write(of);
+  }
+
+ private:
+  Layout* layout_;
+};
+
+// The PLT.  The header calls the lazy resolver whose address the
+// dynamic linker stores in the first .got.plt entry; each following
+// 16-byte entry jumps through its own .got.plt slot, which initially
+// points back at the header.
+
+template<int size, bool big_endian>
+class Output_data_plt_riscv : public Output_section_data
+{
+ public:
+  typedef Output_data_reloc<elfcpp::SHT_RELA, true, size, big_endian>
+    Reloc_section;
+  typedef typename elfcpp::Elf_types<size>::Elf_Addr Address;
+
+  Output_data_plt_riscv(Layout* layout, Output_data_space* got_plt)
+    : Output_section_data(16), got_plt_(got_plt), count_(0)
+  {
+    this->rel_ = new Reloc_section(false);
+    layout->add_output_section_data(".rela.plt", elfcpp::SHT_RELA,
+				    elfcpp::SHF_ALLOC, this->rel_,
+				    ORDER_DYNAMIC_PLT_RELOCS, false);
+  }
+
+  // Add an entry to the PLT for GSYM.
+  void
+  add_entry(Symbol* gsym);
+
+  // Return the .rela.plt section data.
+  Reloc_section*
+  rela_plt()
+  { return this->rel_; }
+
+  // Return the address of the PLT entry of GSYM.
+  Address
+  address_for_global(const Symbol* gsym) const
+  { return this->address() + gsym->plt_offset(); }
+
+  // Return the number of PLT entries.
+  unsigned int
+  entry_count() const
+  { return this->count_; }
+
+  static const int plt_header_size = 32;
+  static const int plt_entry_size = 16;
+
+ protected:
+  void
+  do_adjust_output_section(Output_section* os)
+  { os->set_entsize(plt_entry_size); }
+
+  // Write to a map file.
+  void
+  do_print_to_mapfile(Mapfile* mapfile) const
+  { mapfile->print_output_data(this, _("** PLT")); }
+
+ private:
+  // Set the final size.
+  void
+  set_final_data_size()
+  {
+    this->set_data_size(plt_header_size
+			+ this->count_ * plt_entry_size);
+  }
+
+  // Write out the PLT data.
+  void
+  do_write(Output_file*);
+
+  // The reloc section.
+  Reloc_section* rel_;
+  // The .got.plt section.
+  Output_data_space* got_plt_;
+  // The number of PLT entries.
+  unsigned int count_;
+};
+
+template<int size, bool big_endian>
+void
+Output_data_plt_riscv<size, big_endian>::add_entry(Symbol* gsym)
+{
+  gold_assert(!gsym->has_plt_offset());
+
+  gsym->set_plt_offset(plt_header_size + this->count_ * plt_entry_size);
+  ++this->count_;
+
+  section_offset_type got_offset = this->got_plt_->current_data_size();
+
+  // Every PLT entry needs a .got.plt entry.
+  this->got_plt_->set_current_data_size(got_offset + size / 8);
+
+  // Every PLT entry needs a reloc.
+  gsym->set_needs_dynsym_entry();
+  this->rel_->add_global(gsym, elfcpp::R_RISCV_JUMP_SLOT, this->got_plt_,
+			 got_offset, 0);
+}
+
+template<int size, bool big_endian>
+void
+Output_data_plt_riscv<size, big_endian>::do_write(Output_file* of)
+{
+  typedef Riscv_relocate_functions<big_endian> Insn_writer;
+  typedef Riscv_insn::Insntype Insntype;
+
+  const off_t offset = this->offset();
+  const section_size_type oview_size =
+    convert_to_section_size_type(this->data_size());
+  unsigned char* const oview = of->get_output_view(offset, oview_size);
+
+  const off_t got_file_offset = this->got_plt_->offset();
+  const section_size_type got_size =
+    convert_to_section_size_type(this->got_plt_->data_size());
+  unsigned char* const got_view = of->get_output_view(got_file_offset,
+						      got_size);
+
+  const Address plt_address = this->address();
+  const Address got_address = this->got_plt_->address();
+  const Insntype lreg = size == 64 ? Riscv_insn::MATCH_LD : Riscv_insn::MATCH_LW;
+  const int word_bytes = size / 8;
+  const int log_word_bytes = size == 64 ? 3 : 2;
+
+  // auipc  t2, %hi(.got.plt)
+  // sub    t1, t1, t3		# shifted .got.plt offset + hdr size + 12
+  // l[w|d] t3, %lo(.got.plt)(t2)	# _dl_runtime_resolve
+  // addi   t1, t1, -(hdr size + 12)	# shifted .got.plt offset
+  // addi   t0, t2, %lo(.got.plt)	# &.got.plt
+  // srli   t1, t1, log2(16/PTRSIZE)	# .got.plt offset
+  // l[w|d] t0, PTRSIZE(t0)		# link map
+  // jr     t3
+  int64_t pcrel = static_cast<int64_t>(got_address - plt_address);
+  int64_t hi = Riscv_insn::const_high_part(pcrel);
+  int64_t lo = pcrel - hi;
+  Insntype header[plt_header_size / 4];
+  header[0] = Riscv_insn::utype(Riscv_insn::MATCH_AUIPC, Riscv_insn::X_T2, hi);
+  header[1] = Riscv_insn::rtype(Riscv_insn::MATCH_SUB, Riscv_insn::X_T1,
+				Riscv_insn::X_T1, Riscv_insn::X_T3);
+  header[2] = Riscv_insn::itype(lreg, Riscv_insn::X_T3, Riscv_insn::X_T2, lo);
+  header[3] = Riscv_insn::itype(Riscv_insn::MATCH_ADDI, Riscv_insn::X_T1,
+				Riscv_insn::X_T1, -(plt_header_size + 12));
+  header[4] = Riscv_insn::itype(Riscv_insn::MATCH_ADDI, Riscv_insn::X_T0,
+				Riscv_insn::X_T2, lo);
+  header[5] = Riscv_insn::itype(Riscv_insn::MATCH_SRLI, Riscv_insn::X_T1,
+				Riscv_insn::X_T1, 4 - log_word_bytes);
+  header[6] = Riscv_insn::itype(lreg, Riscv_insn::X_T0, Riscv_insn::X_T0,
+				word_bytes);
+  header[7] = Riscv_insn::itype(Riscv_insn::MATCH_JALR, Riscv_insn::X_ZERO,
+				Riscv_insn::X_T3, 0);
+
+  unsigned char* pov = oview;
+  for (int i = 0; i < plt_header_size / 4; ++i, pov += 4)
+    Insn_writer::template put<32>(pov, header[i]);
+
+  // The first .got.plt entry is for the lazy resolver and the second
+  // for the link map; ld.so fills both in.
+  unsigned char* got_pov = got_view;
+  elfcpp::Swap<size, big_endian>::writeval(got_pov, static_cast<Address>(-1));
+  got_pov += word_bytes;
+  elfcpp::Swap<size, big_endian>::writeval(got_pov, 0);
+  got_pov += word_bytes;
+
+  // auipc  t3, %hi(.got.plt entry)
+  // l[w|d] t3, %lo(.got.plt entry)(t3)
+  // jalr   t1, t3
+  // nop
+  Address entry_address = plt_address + plt_header_size;
+  Address slot_address = got_address + RISCV_GOTPLT_RESERVE_COUNT * word_bytes;
+  for (unsigned int i = 0;
+       i < this->count_;
+       ++i, pov += plt_entry_size, got_pov += word_bytes,
+	 entry_address += plt_entry_size, slot_address += word_bytes)
+    {
+      pcrel = static_cast<int64_t>(slot_address - entry_address);
+      hi = Riscv_insn::const_high_part(pcrel);
+      lo = pcrel - hi;
+      Insn_writer::template put<32>(
+	  pov, Riscv_insn::utype(Riscv_insn::MATCH_AUIPC, Riscv_insn::X_T3, hi));
+      Insn_writer::template put<32>(
+	  pov + 4, Riscv_insn::itype(lreg, Riscv_insn::X_T3, Riscv_insn::X_T3,
+				     lo));
+      Insn_writer::template put<32>(
+	  pov + 8, Riscv_insn::itype(Riscv_insn::MATCH_JALR, Riscv_insn::X_T1,
+				     Riscv_insn::X_T3, 0));
+      Insn_writer::template put<32>(pov + 12, Riscv_insn::NOP);
+
+      // Until the symbol is resolved, the slot sends calls to the header.
+      elfcpp::Swap<size, big_endian>::writeval(got_pov, plt_address);
+    }
+
+  gold_assert(static_cast<section_size_type>(pov - oview) == oview_size);
+  gold_assert(static_cast<section_size_type>(got_pov - got_view) == got_size);
+
+  of->write_output_view(offset, oview_size, oview);
+  of->write_output_view(got_file_offset, got_size, got_view);
+}
+
+// A RISC-V relocatable object.  It records the ELF header flags, which
+// say whether the code may use compressed instructions, and which
+// sections hold code, which relaxation needs to know about symbols
+// defined here.
+
+template<int size, bool big_endian>
+class Riscv_relobj : public Sized_relobj_file<size, big_endian>
+{
+ public:
+  Riscv_relobj(const std::string& name, Input_file* input_file, off_t offset,
+	       const elfcpp::Ehdr<size, big_endian>& ehdr)
+    : Sized_relobj_file<size, big_endian>(name, input_file, offset, ehdr),
+      e_flags_(ehdr.get_e_flags()), code_sections_()
+  { }
+
+  ~Riscv_relobj()
+  { }
+
+  // Return the ELF header flags of this object.
+  elfcpp::Elf_Word
+  e_flags() const
+  { return this->e_flags_; }
+
+  // Whether this object may contain compressed instructions.
+  bool
+  has_rvc() const
+  { return (this->e_flags_ & elfcpp::EF_RISCV_RVC) != 0; }
+
+  // Whether section SHNDX holds code.  Only valid once
+  // scan_sections_for_relaxation has run.
+  bool
+  is_code_section(unsigned int shndx) const
+  { return shndx < this->code_sections_.size() && this->code_sections_[shndx]; }
+
+  // Wrap each code section whose relocations ask for linker
+  // relaxation in a Riscv_input_section, and add it to NEW_SECTIONS.
+  void
+  scan_sections_for_relaxation(
+      Target_riscv<size, big_endian>*, const Symbol_table*,
+      std::vector<Riscv_input_section<size, big_endian>*>* new_sections);
+
+  // Convert regular input section with index SHNDX to a relaxed section.
+  void
+  convert_input_section_to_relaxed_section(unsigned shndx)
+  {
+    // The relaxed section is not copied from the input file: its
+    // Riscv_input_section writes the rewritten instructions, less the
+    // deleted bytes, into the output view.  Relocation patches that view
+    // in place, so it must wait for the write, or the write would undo
+    // it.  Offsets within the section are no longer linear, so they are
+    // mapped through the Riscv_input_section instead.
+    this->set_section_offset(shndx, -1ULL);
+    this->set_relocs_must_follow_section_writes();
+  }
+
+ private:
+  // The ELF header flags.
+  elfcpp::Elf_Word e_flags_;
+  // Which sections hold code, by section index.
+  std::vector<bool> code_sections_;
+};
+
+// A code section that linker relaxation may shrink.  Relaxation works
+// on a private copy of the contents and relocations: it rewrites
+// instructions and relocation types in place and records which byte
+// ranges of the original section are deleted.  Input offsets are
+// mapped to output offsets through the deletions, so symbols and
+// relocations need no adjusting.
+
+template<int size, bool big_endian>
+class Riscv_input_section : public Output_relaxed_input_section
+{
+ public:
+  typedef typename elfcpp::Elf_types<size>::Elf_Addr Address;
+  typedef typename elfcpp::Elf_types<size>::Elf_Swxword Addend;
+
+  // A relocation of this section, as rewritten by relaxation.
+  struct Reloc
+  {
+    // Offset of the relocation in the input section.
+    Address offset;
+    // Symbol index.
+    unsigned int r_sym;
+    // Relocation type, R_RISCV_NONE if relaxation made it redundant.
+    unsigned int r_type;
+    // Relocation type in the input file.
+    unsigned int orig_type;
+    // Addend.
+    Addend addend;
+    // For a %pcrel_lo relocation, the index of its %pcrel_hi, or -1U.
+    unsigned int hi_index;
+  };
+
+  typedef std::vector<Reloc> Relocs;
+  // Indexes of the %pcrel_lo relocations that go with a %pcrel_hi.
+  typedef std::vector<unsigned int> Lo_indexes;
+
+  Riscv_input_section(Relobj* relobj, unsigned int shndx)
+    : Output_relaxed_input_section(relobj, shndx, 1),
+      contents_(), relocs_(), lo_relocs_(), deletions_(), original_size_(0),
+      original_addralign_(1)
+  { }
+
+  ~Riscv_input_section()
+  { }
+
+  // Initialize from the RELOC_COUNT relocations at PRELOCS.
+  void
+  init(Sized_relobj_file<size, big_endian>* relobj,
+       const unsigned char* prelocs, size_t reloc_count);
+
+  // The relocations of this section.
+  const Relocs&
+  relocs() const
+  { return this->relocs_; }
+
+  Relocs&
+  relocs()
+  { return this->relocs_; }
+
+  // The %pcrel_lo relocations whose hi_index is HI_INDEX, or NULL if
+  // there are none.
+  const Lo_indexes*
+  lo_relocs(unsigned int hi_index) const
+  {
+    typename Lo_relocs_map::const_iterator p =
+      this->lo_relocs_.find(hi_index);
+    return p == this->lo_relocs_.end() ? NULL : &p->second;
+  }
+
+  // The contents of this section, before deletions are applied.
+  unsigned char*
+  contents()
+  { return &this->contents_[0]; }
+
+  // Return the original size of the section.
+  Address
+  original_size() const
+  { return this->original_size_; }
+
+  // Return the size of the section after deletions.
+  Address
+  current_size() const
+  {
+    return (this->original_size_
+	    - (this->deletions_.empty() ? 0 : this->deletions_.back().total));
+  }
+
+  // Return the output offset of input offset OFFSET.  Offsets inside a
+  // deleted range map to where the range was.
+  Address
+  output_offset_of(Address offset) const;
+
+  // Delete COUNT bytes at input offset OFFSET.
+  void
+  delete_bytes(Address offset, Address count);
+
+ protected:
+  // Write out this input section.
+  void
+  do_write(Output_file*);
+
+  // Return required alignment of this.
+  uint64_t
+  do_addralign() const
+  { return this->original_addralign_; }
+
+  // Finalize data size.
+  void
+  set_final_data_size()
+  { this->set_data_size(this->current_size()); }
+
+  // Reset address and file offset.
+  void
+  do_reset_address_and_file_offset()
+  { this->set_current_data_size(this->current_size()); }
+
+  // Output offset.
+  bool
+  do_output_offset(const Relobj* object, unsigned int shndx,
+		   section_offset_type offset,
+		   section_offset_type* poutput) const
+  {
+    if (object == this->relobj()
+	&& shndx == this->shndx()
+	&& offset >= 0
+	&& (offset
+	    <= convert_types<section_offset_type, Address>(this->original_size_)))
+      {
+	*poutput = this->output_offset_of(offset);
+	return true;
+      }
+    else
+      return false;
+  }
+
+ private:
+  // A range of deleted bytes.
+  struct Deletion
+  {
+    Deletion(Address a_offset, Address a_count)
+      : offset(a_offset), count(a_count), total(0)
+    { }
+
+    // Input offset of the first deleted byte.
+    Address offset;
+    // Number of bytes deleted.
+    Address count;
+    // Number of bytes deleted up to the end of this range.
+    Address total;
+  };
+
+  // Order deletions by offset.
+  struct Deletion_offset_less
+  {
+    bool
+    operator()(Address offset, const Deletion& d) const
+    { return offset < d.offset; }
+  };
+
+  // Map from the index of a %pcrel_hi to its %pcrel_lo relocations.
+  typedef std::map<unsigned int, Lo_indexes> Lo_relocs_map;
+
+  // Copying is not allowed.
+  Riscv_input_section(const Riscv_input_section&);
+  Riscv_input_section& operator=(const Riscv_input_section&);
+
+  // Section contents.  We have to make a copy here since the file
+  // containing the original section may not be locked when we need to
+  // access the contents, and since relaxation rewrites instructions.
+  std::vector<unsigned char> contents_;
+  // The relocations.
+  Relocs relocs_;
+  // The %pcrel_lo relocations of each %pcrel_hi.
+  Lo_relocs_map lo_relocs_;
+  // The deleted ranges, sorted by offset.
+  std::vector<Deletion> deletions_;
+  // Section size of the original input section.
+  Address original_size_;
+  // Address alignment of the original input section.
+  uint64_t original_addralign_;
+};
+
+template<int size, bool big_endian>
+void
+Riscv_input_section<size, big_endian>::init(
+    Sized_relobj_file<size, big_endian>* relobj,
+    const unsigned char* prelocs,
+    size_t reloc_count)
+{
+  unsigned int shndx = this->shndx();
+
+  this->original_addralign_ = relobj->section_addralign(shndx);
+
+  section_size_type section_size;
+  const unsigned char* section_contents =
+    relobj->section_contents(shndx, &section_size, false);
+  this->original_size_ = convert_types<Address, uint64_t>(
+      relobj->section_size(shndx));
+  this->contents_.assign(section_contents, section_contents + section_size);
+
+  // Copy the relocations, and note where each %pcrel_hi is.
+  const int reloc_size = elfcpp::Elf_sizes<size>::rela_size;
+  std::map<Address, unsigned int> hi_relocs;
+  this->relocs_.resize(reloc_count);
+  for (size_t i = 0; i < reloc_count; ++i, prelocs += reloc_size)
+    {
+      const elfcpp::Rela<size, big_endian> rela(prelocs);
+      Reloc& r(this->relocs_[i]);
+      r.offset = rela.get_r_offset();
+      r.r_sym = elfcpp::elf_r_sym<size>(rela.get_r_info());
+      r.r_type = elfcpp::elf_r_type<size>(rela.get_r_info());
+      r.orig_type = r.r_type;
+      r.addend = rela.get_r_addend();
+      r.hi_index = -1U;
+      switch (r.r_type)
+	{
+	case elfcpp::R_RISCV_PCREL_HI20:
+	case elfcpp::R_RISCV_GOT_HI20:
+	case elfcpp::R_RISCV_TLS_GOT_HI20:
+	case elfcpp::R_RISCV_TLS_GD_HI20:
+	  hi_relocs[r.offset] = i;
+	  break;
+	default:
+	  break;
+	}
+    }
+
+  // Link each %pcrel_lo to its %pcrel_hi.  The %pcrel_lo refers to a
+  // local label at the instruction that the %pcrel_hi applies to.
+  for (size_t i = 0; i < reloc_count; ++i)
+    {
+      Reloc& r(this->relocs_[i]);
+      if (r.r_type != elfcpp::R_RISCV_PCREL_LO12_I
+	  && r.r_type != elfcpp::R_RISCV_PCREL_LO12_S)
+	continue;
+      if (r.r_sym == 0 || r.r_sym >= relobj->local_symbol_count())
+	continue;
+      const Symbol_value<size>* psymval = relobj->local_symbol(r.r_sym);
+      bool is_ordinary;
+      if (psymval->input_shndx(&is_ordinary) != shndx || !is_ordinary)
+	continue;
+      typename std::map<Address, unsigned int>::const_iterator p =
+	hi_relocs.find(psymval->input_value() + r.addend);
+      if (p != hi_relocs.end())
+	{
+	  r.hi_index = p->second;
+	  this->lo_relocs_[r.hi_index].push_back(i);
+	}
+    }
+
+  // We want to make this look like the original input section after
+  // output sections are finalized.
+  Output_section* os = relobj->output_section(shndx);
+  off_t offset = relobj->output_section_offset(shndx);
+  gold_assert(os != NULL && !relobj->is_output_section_offset_invalid(shndx));
+  this->set_address(os->address() + offset);
+  this->set_file_offset(os->offset() + offset);
+  this->set_current_data_size(this->original_size_);
+  this->finalize_data_size();
+}
+
+template<int size, bool big_endian>
+typename Riscv_input_section<size, big_endian>::Address
+Riscv_input_section<size, big_endian>::output_offset_of(Address offset) const
+{
+  typename std::vector<Deletion>::const_iterator p =
+    std::upper_bound(this->deletions_.begin(), this->deletions_.end(),
+		     offset, Deletion_offset_less());
+  if (p == this->deletions_.begin())
+    return offset;
+  --p;
+  if (offset < p->offset + p->count)
+    return p->offset - (p->total - p->count);
+  return offset - p->total;
+}
+
+template<int size, bool big_endian>
+void
+Riscv_input_section<size, big_endian>::delete_bytes(Address offset,
+						     Address count)
+{
+  gold_assert(count > 0 && offset + count <= this->original_size_);
+  typename std::vector<Deletion>::iterator p =
+    std::upper_bound(this->deletions_.begin(), this->deletions_.end(),
+		     offset, Deletion_offset_less());
+  p = this->deletions_.insert(p, Deletion(offset, count));
+  Address total = (p == this->deletions_.begin() ? 0 : (p - 1)->total);
+  for (; p != this->deletions_.end(); ++p)
+    {
+      total += p->count;
+      p->total = total;
+    }
+}
+
+// Write data to output file.
+
+template<int size, bool big_endian>
+void
+Riscv_input_section<size, big_endian>::do_write(Output_file* of)
+{
+  const off_t offset = this->offset();
+  const section_size_type oview_size =
+    convert_to_section_size_type(this->data_size());
+  unsigned char* const oview = of->get_output_view(offset, oview_size);
+
+  // Copy the contents, leaving out the deleted ranges.
+  const unsigned char* contents = &this->contents_[0];
+  unsigned char* pov = oview;
+  Address from = 0;
+  for (typename std::vector<Deletion>::const_iterator p =
+	 this->deletions_.begin();
+       p != this->deletions_.end();
+       ++p)
+    {
+      memcpy(pov, contents + from, p->offset - from);
+      pov += p->offset - from;
+      from = p->offset + p->count;
+    }
+  memcpy(pov, contents + from, this->original_size_ - from);
+  pov += this->original_size_ - from;
+  gold_assert(static_cast<section_size_type>(pov - oview) == oview_size);
+
+  of->write_output_view(offset, oview_size, oview);
+}
+
+template<int size, bool big_endian>
+void
+Riscv_relobj<size, big_endian>::scan_sections_for_relaxation(
+    Target_riscv<size, big_endian>* target,
+    const Symbol_table* symtab,
+    std::vector<Riscv_input_section<size, big_endian>*>* new_sections)
+{
+  unsigned int shnum = this->shnum();
+  const unsigned int shdr_size = elfcpp::Elf_sizes<size>::shdr_size;
+  const unsigned int reloc_size = elfcpp::Elf_sizes<size>::rela_size;
+
+  // Read the section headers.
+  const unsigned char* pshdrs = this->get_view(this->elf_file()->shoff(),
+					       shnum * shdr_size,
+					       true, true);
+
+  this->code_sections_.assign(shnum, false);
+  const unsigned char* p = pshdrs + shdr_size;
+  for (unsigned int i = 1; i < shnum; ++i, p += shdr_size)
+    {
+      const elfcpp::Shdr<size, big_endian> shdr(p);
+      this->code_sections_[i] = (shdr.get_sh_flags()
+				 & elfcpp::SHF_EXECINSTR) != 0;
+    }
+
+  const Relobj::Output_sections& out_sections(this->output_sections());
+  p = pshdrs + shdr_size;
+  for (unsigned int i = 1; i < shnum; ++i, p += shdr_size)
+    {
+      const elfcpp::Shdr<size, big_endian> shdr(p);
+      if (shdr.get_sh_type() != elfcpp::SHT_RELA)
+	continue;
+
+      // Ignore malformed reloc sections.  The error will be reported
+      // in the final link.
+      off_t sh_size = shdr.get_sh_size();
+      if (sh_size == 0
+	  || shdr.get_sh_entsize() != reloc_size
+	  || sh_size % reloc_size != 0
+	  || this->adjust_shndx(shdr.get_sh_link()) != this->symtab_shndx())
+	continue;
+      unsigned int shndx = this->adjust_shndx(shdr.get_sh_info());
+      if (shndx >= shnum)
+	continue;
+
+      // Only code sections that are laid out normally can be relaxed.
+      const elfcpp::Shdr<size, big_endian> text_shdr(pshdrs
+						     + shndx * shdr_size);
+      if (text_shdr.get_sh_type() != elfcpp::SHT_PROGBITS
+	  || text_shdr.get_sh_size() == 0
+	  || ((text_shdr.get_sh_flags()
+	       & (elfcpp::SHF_ALLOC | elfcpp::SHF_EXECINSTR))
+	      != (elfcpp::SHF_ALLOC | elfcpp::SHF_EXECINSTR))
+	  || out_sections[shndx] == NULL
+	  || this->is_output_section_offset_invalid(shndx)
+	  || symtab->is_section_folded(this, shndx))
+	continue;
+
+      const unsigned char* prelocs = this->get_view(shdr.get_sh_offset(),
+						    sh_size, true, false);
+      size_t reloc_count = sh_size / reloc_size;
+
+      // The assembler marks the relocations that may be relaxed with an
+      // R_RISCV_RELAX, and emits R_RISCV_ALIGN for alignment padding
+      // that must shrink once code before it does.
+      bool needs_relaxation = false;
+      const unsigned char* preloc = prelocs;
+      for (size_t j = 0; j < reloc_count; ++j, preloc += reloc_size)
+	{
+	  const elfcpp::Rela<size, big_endian> rela(preloc);
+	  unsigned int r_type = elfcpp::elf_r_type<size>(rela.get_r_info());
+	  if (r_type == elfcpp::R_RISCV_RELAX || r_type == elfcpp::R_RISCV_ALIGN)
+	    {
+	      needs_relaxation = true;
+	      break;
+	    }
+	}
+      if (!needs_relaxation)
+	continue;
+
+      Riscv_input_section<size, big_endian>* input_section =
+	target->new_riscv_input_section(this, shndx);
+      input_section->init(this, prelocs, reloc_count);
+      new_sections->push_back(input_section);
+    }
+}
+
+// The RISC-V target.
+
+template<int size, bool big_endian>
+class Target_riscv : public Sized_target<size, big_endian>
+{
+ public:
+  typedef Target_riscv<size, big_endian> This;
+  typedef Output_data_reloc<elfcpp::SHT_RELA, true, size, big_endian>
+    Reloc_section;
+  typedef typename elfcpp::Elf_types<size>::Elf_Addr Address;
+  typedef typename elfcpp::Elf_types<size>::Elf_Swxword Addend;
+  typedef Riscv_input_section<size, big_endian> The_riscv_input_section;
+  typedef Riscv_relobj<size, big_endian> The_riscv_relobj;
+  typedef Unordered_map<Section_id, The_riscv_input_section*, Section_id_hash>
+    Riscv_input_section_map;
+
+  Target_riscv(const Target::Target_info* info = &riscv_info)
+    : Sized_target<size, big_endian>(info),
+      got_(NULL), plt_(NULL), got_plt_(NULL), global_offset_table_(NULL),
+      global_pointer_(NULL), rela_dyn_(NULL),
+      copy_relocs_(elfcpp::R_RISCV_COPY), riscv_input_section_map_(),
+      relaxed_sections_(), relax_state_(RELAX_INIT)
+  { }
+
+  // Scan the relocations to determine unreferenced sections for
+  // garbage collection.
+  void
+  gc_process_relocs(Symbol_table* symtab,
+		    Layout* layout,
+		    Sized_relobj_file<size, big_endian>* object,
+		    unsigned int data_shndx,
+		    unsigned int sh_type,
+		    const unsigned char* prelocs,
+		    size_t reloc_count,
+		    Output_section* output_section,
+		    bool needs_special_offset_handling,
+		    size_t local_symbol_count,
+		    const unsigned char* plocal_symbols);
+
+  // Scan the relocations to look for symbol adjustments.
+  void
+  scan_relocs(Symbol_table* symtab,
+	      Layout* layout,
+	      Sized_relobj_file<size, big_endian>* object,
+	      unsigned int data_shndx,
+	      unsigned int sh_type,
+	      const unsigned char* prelocs,
+	      size_t reloc_count,
+	      Output_section* output_section,
+	      bool needs_special_offset_handling,
+	      size_t local_symbol_count,
+	      const unsigned char* plocal_symbols);
+
+  // Finalize the sections.
+  void
+  do_finalize_sections(Layout*, const Input_objects*, Symbol_table*);
+
+  // Return the value to use for a dynamic which requires special
+  // treatment.
+  uint64_t
+  do_dynsym_value(const Symbol*) const;
+
+  // Discard .L local labels unless told otherwise, as GNU ld does for
+  // RISC-V; relaxation leaves many of them behind.
+  bool
+  do_discard_local_labels_by_default() const
+  { return true; }
+
+  // Relocate a section.
+  void
+  relocate_section(const Relocate_info<size, big_endian>*,
+		   unsigned int sh_type,
+		   const unsigned char* prelocs,
+		   size_t reloc_count,
+		   Output_section* output_section,
+		   bool needs_special_offset_handling,
+		   unsigned char* view,
+		   Address view_address,
+		   section_size_type view_size,
+		   const Reloc_symbol_changes*);
+
+  // Scan the relocs during a relocatable link.
+  void
+  scan_relocatable_relocs(Symbol_table* symtab,
+			  Layout* layout,
+			  Sized_relobj_file<size, big_endian>* object,
+			  unsigned int data_shndx,
+			  unsigned int sh_type,
+			  const unsigned char* prelocs,
+			  size_t reloc_count,
+			  Output_section* output_section,
+			  bool needs_special_offset_handling,
+			  size_t local_symbol_count,
+			  const unsigned char* plocal_symbols,
+			  Relocatable_relocs*);
+
+  // Scan the relocs for --emit-relocs.
+  void
+  emit_relocs_scan(Symbol_table* symtab,
+		   Layout* layout,
+		   Sized_relobj_file<size, big_endian>* object,
+		   unsigned int data_shndx,
+		   unsigned int sh_type,
+		   const unsigned char* prelocs,
+		   size_t reloc_count,
+		   Output_section* output_section,
+		   bool needs_special_offset_handling,
+		   size_t local_symbol_count,
+		   const unsigned char* plocal_syms,
+		   Relocatable_relocs* rr);
+
+  // Relocate a section during a relocatable link.
+  void
+  relocate_relocs(
+      const Relocate_info<size, big_endian>*,
+      unsigned int sh_type,
+      const unsigned char* prelocs,
+      size_t reloc_count,
+      Output_section* output_section,
+      typename elfcpp::Elf_types<size>::Elf_Off offset_in_output_section,
+      unsigned char* view,
+      Address view_address,
+      section_size_type view_size,
+      unsigned char* reloc_view,
+      section_size_type reloc_view_size);
+
+  // Return the PLT address to use for a global symbol.
+  uint64_t
+  do_plt_address_for_global(const Symbol* gsym) const
+  { return this->plt_section()->address_for_global(gsym); }
+
+  // Return the offset to use for the GOT_INDX'th got entry which is
+  // for a local tls symbol specified by OBJECT, SYMNDX.
+  int64_t
+  do_tls_offset_for_local(const Relobj*, unsigned int, unsigned int) const
+  { return -RISCV_DTP_OFFSET; }
+
+  // Return the offset to use for the GOT_INDX'th got entry which is
+  // for global tls symbol GSYM.
+  int64_t
+  do_tls_offset_for_global(Symbol*, unsigned int) const
+  { return -RISCV_DTP_OFFSET; }
+
+  // Return whether there is a GOT section.
+  bool
+  has_got_section() const
+  { return this->got_ != NULL; }
+
+  // Return the number of entries in the PLT.
+  unsigned int
+  plt_entry_count() const
+  {
+    if (this->plt_ == NULL)
+      return 0;
+    return this->plt_->entry_count();
+  }
+
+  // We relax code unless this is a relocatable link.
+  bool
+  do_may_relax() const
+  { return !parameters->options().relocatable(); }
+
+  // Relaxation hook.  This is where code shrinks.
+  bool
+  do_relax(int, const Input_objects*, Symbol_table*, Layout*, const Task*);
+
+  // Make an ELF object.
+  Object*
+  do_make_elf_object(const std::string&, Input_file*, off_t,
+		     const elfcpp::Ehdr<size, big_endian>& ehdr);
+
+  Object*
+  do_make_elf_object(const std::string&, Input_file*, off_t,
+		     const elfcpp::Ehdr<size, !big_endian>&)
+  { gold_unreachable(); }
+
+  // Make a new Riscv_input_section object for section SHNDX of RELOBJ.
+  The_riscv_input_section*
+  new_riscv_input_section(Relobj* relobj, unsigned int shndx);
+
+  // Find the Riscv_input_section object corresponding to the SHNDX-th
+  // input section of RELOBJ, or NULL if that section is not relaxed.
+  The_riscv_input_section*
+  find_riscv_input_section(Relobj* relobj, unsigned int shndx) const;
+
+ private:
+  // The class which scans relocations.
+  class Scan
+  {
+   public:
+    Scan()
+      : issued_non_pic_error_(false)
+    { }
+
+    static inline int
+    get_reference_flags(unsigned int r_type);
+
+    inline void
+    local(Symbol_table* symtab, Layout* layout, Target_riscv* target,
+	  Sized_relobj_file<size, big_endian>* object,
+	  unsigned int data_shndx,
+	  Output_section* output_section,
+	  const elfcpp::Rela<size, big_endian>& reloc, unsigned int r_type,
+	  const elfcpp::Sym<size, big_endian>& lsym,
+	  bool is_discarded);
+
+    inline void
+    global(Symbol_table* symtab, Layout* layout, Target_riscv* target,
+	   Sized_relobj_file<size, big_endian>* object,
+	   unsigned int data_shndx,
+	   Output_section* output_section,
+	   const elfcpp::Rela<size, big_endian>& reloc, unsigned int r_type,
+	   Symbol* gsym);
+
+    inline bool
+    local_reloc_may_be_function_pointer(Symbol_table*, Layout*,
+					Target_riscv*,
+					Sized_relobj_file<size, big_endian>*,
+					unsigned int,
+					Output_section*,
+					const elfcpp::Rela<size, big_endian>&,
+					unsigned int,
+					const elfcpp::Sym<size, big_endian>&)
+    { return false; }
+
+    inline bool
+    global_reloc_may_be_function_pointer(Symbol_table*, Layout*,
+					 Target_riscv*,
+					 Sized_relobj_file<size, big_endian>*,
+					 unsigned int,
+					 Output_section*,
+					 const elfcpp::Rela<size, big_endian>&,
+					 unsigned int, Symbol*)
+    { return false; }
+
+   private:
+    static void
+    unsupported_reloc_local(Sized_relobj_file<size, big_endian>*,
+			    unsigned int r_type);
+
+    static void
+    unsupported_reloc_global(Sized_relobj_file<size, big_endian>*,
+			     unsigned int r_type, Symbol*);
+
+    void
+    check_non_pic(Relobj*, unsigned int r_type);
+
+    // Whether we have issued an error about a non-PIC compilation.
+    bool issued_non_pic_error_;
+  };
+
+  // The class which implements relocation.
+  class Relocate
+  {
+   public:
+    Relocate()
+      : target_(NULL), relaxed_section_(NULL), pcrel_hi_(),
+	pcrel_hi_by_offset_(), pcrel_lo_()
+    { }
+
+    // A %pcrel_lo is resolved once the whole section has been
+    // relocated, since its %pcrel_hi may come after it.
+    ~Relocate()
+    { this->resolve_pcrel_lo_relocs(); }
+
+    // Do a relocation.  Return false if the caller should not issue
+    // any warnings about this relocation.
+    inline bool
+    relocate(const Relocate_info<size, big_endian>*, unsigned int,
+	     Target_riscv*, Output_section*, size_t, const unsigned char*,
+	     const Sized_symbol<size>*, const Symbol_value<size>*,
+	     unsigned char*, Address, section_size_type);
+
+   private:
+    // A %pcrel_lo relocation waiting for its %pcrel_hi.
+    struct Pcrel_lo
+    {
+      const Relocate_info<size, big_endian>* relinfo;
+      size_t relnum;
+      Address r_offset;
+      unsigned int r_type;
+      unsigned char* view;
+      // The address of the %pcrel_hi, or its input offset if
+      // KEY_IS_OFFSET.
+      Address key;
+      bool key_is_offset;
+      Addend addend;
+    };
+
+    void
+    resolve_pcrel_lo_relocs();
+
+    // The target.
+    Target_riscv* target_;
+    // The section being relocated, if relaxation rewrote it.
+    const The_riscv_input_section* relaxed_section_;
+    // The value of each %pcrel_hi, by address.
+    std::map<Address, Address> pcrel_hi_;
+    // The value of each %pcrel_hi of a relaxed section, by input offset.
+    std::map<Address, Address> pcrel_hi_by_offset_;
+    // The %pcrel_lo relocations.
+    std::vector<Pcrel_lo> pcrel_lo_;
+  };
+
+  // Where relaxation has got to.
+  enum Relax_state
+  {
+    // The relaxed sections have not been created yet.
+    RELAX_INIT,
+    // Shrinking code sequences.
+    RELAX_SHRINK,
+    // Deleting alignment padding that is no longer needed.
+    RELAX_ALIGN,
+    // Finished.
+    RELAX_DONE
+  };
+
+  // Get the GOT section, creating it if necessary.
+  Output_data_got_riscv<size, big_endian>*
+  got_section(Symbol_table*, Layout*);
+
+  // Get the GOT PLT section.
+  Output_data_space*
+  got_plt_section() const
+  {
+    gold_assert(this->got_plt_ != NULL);
+    return this->got_plt_;
+  }
+
+  // Create the PLT section.
+  void
+  make_plt_section(Symbol_table* symtab, Layout* layout);
+
+  // Create a PLT entry for a global symbol.
+  void
+  make_plt_entry(Symbol_table*, Layout*, Symbol*);
+
+  // Get the PLT section.
+  Output_data_plt_riscv<size, big_endian>*
+  plt_section() const
+  {
+    gold_assert(this->plt_ != NULL);
+    return this->plt_;
+  }
+
+  // Get the dynamic reloc section, creating it if necessary.
+  Reloc_section*
+  rela_dyn_section(Layout*);
+
+  // Add a potential copy relocation.
+  void
+  copy_reloc(Symbol_table* symtab, Layout* layout,
+	     Sized_relobj_file<size, big_endian>* object,
+	     unsigned int shndx, Output_section* output_section,
+	     Symbol* sym, const elfcpp::Rela<size, big_endian>& reloc)
+  {
+    unsigned int r_type = elfcpp::elf_r_type<size>(reloc.get_r_info());
+    this->copy_relocs_.copy_reloc(symtab, layout,
+				  symtab->get_sized_symbol<size>(sym),
+				  object, shndx, output_section,
+				  r_type, reloc.get_r_offset(),
+				  reloc.get_r_addend(),
+				  this->rela_dyn_section(layout));
+  }
+
+  // Return the distance from ADDRESS to VALUE.  The subtraction wraps
+  // at SIZE bits, so the result is sign extended from there.
+  static int64_t
+  pcrel_offset(Address value, Address address)
+  { return static_cast<Addend>(value - address); }
+
+  // Return the value of the global pointer, or 0 if there is none.
+  // FINAL says whether symbol values have been finalized.
+  Address
+  global_pointer_value(const Symbol_table* symtab, bool final) const;
+
+  // Compute the value that relocation R of RSEC refers to for
+  // relaxation, including the addend.  Set *IN_CODE if the symbol is
+  // defined in code, *POS to its output section, and *RESERVE to the
+  // part of a data object that lies beyond the referenced address.
+  // Return false if the value is not known.
+  bool
+  relax_symbol_value(const Symbol_table* symtab, The_riscv_relobj* object,
+		     const typename The_riscv_input_section::Reloc& r,
+		     Address* pvalue, bool* in_code, Output_section** pos,
+		     Address* reserve) const;
+
+  // Shrink the code sequences of RSEC that the relocations allow.
+  // Return true if anything changed.
+  bool
+  relax_section(const Symbol_table* symtab, The_riscv_input_section* rsec,
+		Address gp, Address max_alignment);
+
+  // Delete the alignment padding of RSEC that is no longer needed.
+  // Return true if anything changed.
+  bool
+  relax_section_alignment(The_riscv_input_section* rsec);
+
+  // Recompute the sizes of global symbols defined in relaxed sections.
+  void
+  adjust_symbol_sizes(Symbol_table* symtab);
+
+  // Information about this specific target which we pass to the
+  // general Target structure.
+  static const Target::Target_info riscv_info;
+
+  // The types of GOT entries needed for this platform.
+  // These values are exposed to the ABI in an incremental link.
+  // Do not renumber existing values without changing the version
+  // number of the .gnu_incremental_inputs section.
+  enum Got_type
+  {
+    GOT_TYPE_STANDARD = 0,	// GOT entry for a regular symbol
+    GOT_TYPE_TLS_OFFSET = 1,	// GOT entry for TLS offset
+    GOT_TYPE_TLS_PAIR = 2,	// GOT entry for TLS module/offset pair
+    GOT_TYPE_TLS_DTPREL = 3	// GOT entry for DTP-relative TLS offset
+  };
+
+  // The GOT section.
+  Output_data_got_riscv<size, big_endian>* got_;
+  // The PLT section.
+  Output_data_plt_riscv<size, big_endian>* plt_;
+  // The GOT PLT section.
+  Output_data_space* got_plt_;
+  // The _GLOBAL_OFFSET_TABLE_ symbol.
+  Symbol* global_offset_table_;
+  // The __global_pointer$ symbol.
+  Symbol* global_pointer_;
+  // The dynamic reloc section.
+  Reloc_section* rela_dyn_;
+  // Relocs saved to avoid a COPY reloc.
+  Copy_relocs<elfcpp::SHT_RELA, size, big_endian> copy_relocs_;
+  // Map of relaxed input sections.
+  Riscv_input_section_map riscv_input_section_map_;
+  // The relaxed input sections, in the order they were created.
+  std::vector<The_riscv_input_section*> relaxed_sections_;
+  // Where relaxation has got to.
+  Relax_state relax_state_;
+};
+
+template<>
+const Target::Target_info Target_riscv<64, false>::riscv_info =
+{
+  64,			// size
+  false,		// is_big_endian
+  elfcpp::EM_RISCV,	// machine_code
+  false,		// has_make_symbol
+  false,		// has_resolve
+  false,		// has_code_fill
+  true,			// is_default_stack_executable
+  true,			// can_icf_inline_merge_sections
+  '\0',			// wrap_char
+  "/lib/ld.so.1",	// program interpreter
+  0x10000,		// default_text_segment_address
+  0x1000,		// abi_pagesize (overridable by -z max-page-size)
+  0x1000,		// common_pagesize (overridable by -z common-page-size)
+  false,                // isolate_execinstr
+  0,                    // rosegment_gap
+  elfcpp::SHN_UNDEF,	// small_common_shndx
+  elfcpp::SHN_UNDEF,	// large_common_shndx
+  0,			// small_common_section_flags
+  0,			// large_common_section_flags
+  NULL,			// attributes_section
+  NULL,			// attributes_vendor
+  "_start",		// entry_symbol_name
+  32,			// hash_entry_size
+};
+
+template<>
+const Target::Target_info Target_riscv<32, false>::riscv_info =
+{
+  32,			// size
+  false,		// is_big_endian
+  elfcpp::EM_RISCV,	// machine_code
+  false,		// has_make_symbol
+  false,		// has_resolve
+  false,		// has_code_fill
+  true,			// is_default_stack_executable
+  true,			// can_icf_inline_merge_sections
+  '\0',			// wrap_char
+  "/lib32/ld.so.1",	// program interpreter
+  0x10000,		// default_text_segment_address
+  0x1000,		// abi_pagesize (overridable by -z max-page-size)
+  0x1000,		// common_pagesize (overridable by -z common-page-size)
+  false,                // isolate_execinstr
+  0,                    // rosegment_gap
+  elfcpp::SHN_UNDEF,	// small_common_shndx
+  elfcpp::SHN_UNDEF,	// large_common_shndx
+  0,			// small_common_section_flags
+  0,			// large_common_section_flags
+  NULL,			// attributes_section
+  NULL,			// attributes_vendor
+  "_start",		// entry_symbol_name
+  32,			// hash_entry_size
+};
+
+// Get the GOT section, creating it if necessary.
+
+template<int size, bool big_endian>
+Output_data_got_riscv<size, big_endian>*
+Target_riscv<size, big_endian>::got_section(Symbol_table* symtab,
+					    Layout* layout)
+{
+  if (this->got_ == NULL)
+    {
+      gold_assert(symtab != NULL && layout != NULL);
+
+      // When using -z now, we can treat .got.plt as a relro section.
+      // Without -z now, it is modified after program startup by lazy
+      // PLT relocations.
+      bool is_got_plt_relro = parameters->options().now();
+      Output_section_order got_order = (is_got_plt_relro
+					? ORDER_RELRO
+					: ORDER_RELRO_LAST);
+      Output_section_order got_plt_order = (is_got_plt_relro
+					    ? ORDER_RELRO
+					    : ORDER_NON_RELRO_FIRST);
+
+      this->got_ = new Output_data_got_riscv<size, big_endian>(layout);
+
+      layout->add_output_section_data(".got", elfcpp::SHT_PROGBITS,
+				      (elfcpp::SHF_ALLOC
+				       | elfcpp::SHF_WRITE),
+				      this->got_, got_order, true);
+
+      // The first word of the GOT is reserved for the address of
+      // .dynamic; the GOT class fills it in.
+      this->got_->add_constant(0);
+
+      // Define _GLOBAL_OFFSET_TABLE_ at the start of the GOT.
+      // _GLOBAL_OFFSET_TABLE_ value points to the start of the .got section,
+      // even if there is a .got.plt section.
+      this->global_offset_table_ =
+	symtab->define_in_output_data("_GLOBAL_OFFSET_TABLE_", NULL,
+				      Symbol_table::PREDEFINED,
+				      this->got_,
+				      0, 0, elfcpp::STT_OBJECT,
+				      elfcpp::STB_LOCAL,
+				      elfcpp::STV_HIDDEN, 0,
+				      false, false);
+
+      this->got_plt_ = new Output_data_space(size / 8, "** GOT PLT");
+      layout->add_output_section_data(".got.plt", elfcpp::SHT_PROGBITS,
+				      (elfcpp::SHF_ALLOC
+				       | elfcpp::SHF_WRITE),
+				      this->got_plt_, got_plt_order,
+				      is_got_plt_relro);
+
+      // The first two entries are reserved.
+      this->got_plt_->set_current_data_size(
+	  RISCV_GOTPLT_RESERVE_COUNT * (size / 8));
+
+      if (!is_got_plt_relro)
+	{
+	  // Those bytes can go into the relro segment.
+	  layout->increase_relro(
+	      RISCV_GOTPLT_RESERVE_COUNT * (size / 8));
+	}
+    }
+  return this->got_;
+}
+
+// Get the dynamic reloc section, creating it if necessary.
+
+template<int size, bool big_endian>
+typename Target_riscv<size, big_endian>::Reloc_section*
+Target_riscv<size, big_endian>::rela_dyn_section(Layout* layout)
+{
+  if (this->rela_dyn_ == NULL)
+    {
+      gold_assert(layout != NULL);
+      this->rela_dyn_ = new Reloc_section(parameters->options().combreloc());
+      layout->add_output_section_data(".rela.dyn", elfcpp::SHT_RELA,
+				      elfcpp::SHF_ALLOC, this->rela_dyn_,
+				      ORDER_DYNAMIC_RELOCS, false);
+    }
+  return this->rela_dyn_;
+}
+
+// Create the PLT section.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::make_plt_section(Symbol_table* symtab,
+						 Layout* layout)
+{
+  if (this->plt_ == NULL)
+    {
+      // Create the GOT section first.
+      this->got_section(symtab, layout);
+
+      this->plt_ = new Output_data_plt_riscv<size, big_endian>(layout,
+							       this->got_plt_);
+
+      layout->add_output_section_data(".plt", elfcpp::SHT_PROGBITS,
+				      (elfcpp::SHF_ALLOC
+				       | elfcpp::SHF_EXECINSTR),
+				      this->plt_, ORDER_PLT, false);
+
+      // Make the sh_info field of .rela.plt point to .plt.
+      Output_section* rela_plt_os = this->plt_->rela_plt()->output_section();
+      rela_plt_os->set_info_section(this->plt_->output_section());
+    }
+}
+
+// Create a PLT entry for a global symbol.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::make_plt_entry(Symbol_table* symtab,
+					       Layout* layout,
+					       Symbol* gsym)
+{
+  if (gsym->has_plt_offset())
+    return;
+
+  if (this->plt_ == NULL)
+    this->make_plt_section(symtab, layout);
+
+  this->plt_->add_entry(gsym);
+}
+
+// Make a new Riscv_input_section object.
+
+template<int size, bool big_endian>
+Riscv_input_section<size, big_endian>*
+Target_riscv<size, big_endian>::new_riscv_input_section(Relobj* relobj,
+							unsigned int shndx)
+{
+  Section_id sid(relobj, shndx);
+
+  The_riscv_input_section* input_section =
+    new The_riscv_input_section(relobj, shndx);
+
+  // Register new Riscv_input_section in map for look-up.
+  std::pair<typename Riscv_input_section_map::iterator, bool> ins =
+    this->riscv_input_section_map_.insert(std::make_pair(sid, input_section));
+
+  // Make sure that it we have not created another Riscv_input_section
+  // for this input section already.
+  gold_assert(ins.second);
+
+  this->relaxed_sections_.push_back(input_section);
+  return input_section;
+}
+
+// Find the Riscv_input_section object corresponding to the SHNDX-th
+// input section of RELOBJ.
+
+template<int size, bool big_endian>
+Riscv_input_section<size, big_endian>*
+Target_riscv<size, big_endian>::find_riscv_input_section(
+    Relobj* relobj, unsigned int shndx) const
+{
+  Section_id sid(relobj, shndx);
+  typename Riscv_input_section_map::const_iterator p =
+    this->riscv_input_section_map_.find(sid);
+  return (p != this->riscv_input_section_map_.end()) ? p->second : NULL;
+}
+
+// Make an ELF object.  We need to use a target-specific sub-class of
+// Sized_relobj_file to record the ELF header flags and which sections
+// hold code.
+
+template<int size, bool big_endian>
+Object*
+Target_riscv<size, big_endian>::do_make_elf_object(
+    const std::string& name,
+    Input_file* input_file,
+    off_t offset, const elfcpp::Ehdr<size, big_endian>& ehdr)
+{
+  int et = ehdr.get_e_type();
+  // ET_EXEC files are valid input for --just-symbols/-R,
+  // and we treat them as relocatable objects.
+  if (et == elfcpp::ET_REL
+      || (et == elfcpp::ET_EXEC && input_file->just_symbols()))
+    {
+      The_riscv_relobj* obj =
+	new The_riscv_relobj(name, input_file, offset, ehdr);
+      obj->setup();
+      return obj;
+    }
+  else if (et == elfcpp::ET_DYN)
+    {
+      Sized_dynobj<size, big_endian>* obj =
+	new Sized_dynobj<size, big_endian>(name, input_file, offset, ehdr);
+      obj->setup();
+      return obj;
+    }
+  else
+    {
+      gold_error(_("%s: unsupported ELF file type %d"),
+		 name.c_str(), et);
+      return NULL;
+    }
+}
+
+// Report an unsupported relocation against a local symbol.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::Scan::unsupported_reloc_local(
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int r_type)
+{
+  gold_error(_("%s: unsupported reloc %u against local symbol"),
+	     object->name().c_str(), r_type);
+}
+
+// Report an unsupported relocation against a global symbol.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::Scan::unsupported_reloc_global(
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int r_type,
+    Symbol* gsym)
+{
+  gold_error(_("%s: unsupported reloc %u against global symbol %s"),
+	     object->name().c_str(), r_type, gsym->demangled_name().c_str());
+}
+
+// We are about to emit a dynamic relocation of type R_TYPE.  If the
+// dynamic linker does not support it, issue an error.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::Scan::check_non_pic(Relobj* object,
+						    unsigned int r_type)
+{
+  switch (r_type)
+    {
+    // These are the relocation types supported by glibc for RISC-V.
+    case elfcpp::R_RISCV_NONE:
+    case elfcpp::R_RISCV_32:
+    case elfcpp::R_RISCV_64:
+    case elfcpp::R_RISCV_RELATIVE:
+    case elfcpp::R_RISCV_COPY:
+    case elfcpp::R_RISCV_JUMP_SLOT:
+    case elfcpp::R_RISCV_TLS_DTPMOD32:
+    case elfcpp::R_RISCV_TLS_DTPMOD64:
+    case elfcpp::R_RISCV_TLS_DTPREL32:
+    case elfcpp::R_RISCV_TLS_DTPREL64:
+    case elfcpp::R_RISCV_TLS_TPREL32:
+    case elfcpp::R_RISCV_TLS_TPREL64:
+      return;
+
+    default:
+      break;
+    }
+
+  // This prevents us from issuing more than one error per reloc
+  // section.  But we can still wind up issuing more than one
+  // error per object file.
+  if (this->issued_non_pic_error_)
+    return;
+  object->error(_("requires unsupported dynamic reloc %u; "
+		  "recompile with -fPIC"),
+		r_type);
+  this->issued_non_pic_error_ = true;
+}
+
+// Return the reference flags for relocation type R_TYPE.
+
+template<int size, bool big_endian>
+inline int
+Target_riscv<size, big_endian>::Scan::get_reference_flags(unsigned int r_type)
+{
+  switch (r_type)
+    {
+    case elfcpp::R_RISCV_NONE:
+    case elfcpp::R_RISCV_RELAX:
+    case elfcpp::R_RISCV_ALIGN:
+    case elfcpp::R_RISCV_TPREL_ADD:
+    case elfcpp::R_RISCV_GNU_VTINHERIT:
+    case elfcpp::R_RISCV_GNU_VTENTRY:
+      // No symbol reference.
+      return 0;
+
+    case elfcpp::R_RISCV_32:
+    case elfcpp::R_RISCV_64:
+    case elfcpp::R_RISCV_HI20:
+    case elfcpp::R_RISCV_LO12_I:
+    case elfcpp::R_RISCV_LO12_S:
+    case elfcpp::R_RISCV_RVC_LUI:
+    case elfcpp::R_RISCV_GPREL_I:
+    case elfcpp::R_RISCV_GPREL_S:
+    case elfcpp::R_RISCV_ADD8:
+    case elfcpp::R_RISCV_ADD16:
+    case elfcpp::R_RISCV_ADD32:
+    case elfcpp::R_RISCV_ADD64:
+    case elfcpp::R_RISCV_SUB6:
+    case elfcpp::R_RISCV_SUB8:
+    case elfcpp::R_RISCV_SUB16:
+    case elfcpp::R_RISCV_SUB32:
+    case elfcpp::R_RISCV_SUB64:
+    case elfcpp::R_RISCV_SET6:
+    case elfcpp::R_RISCV_SET8:
+    case elfcpp::R_RISCV_SET16:
+    case elfcpp::R_RISCV_SET32:
+      return Symbol::ABSOLUTE_REF;
+
+    case elfcpp::R_RISCV_PCREL_HI20:
+    case elfcpp::R_RISCV_PCREL_LO12_I:
+    case elfcpp::R_RISCV_PCREL_LO12_S:
+    case elfcpp::R_RISCV_BRANCH:
+    case elfcpp::R_RISCV_RVC_BRANCH:
+    case elfcpp::R_RISCV_32_PCREL:
+    case elfcpp::R_RISCV_GOT_HI20:
+      return Symbol::RELATIVE_REF;
+
+    case elfcpp::R_RISCV_CALL:
+    case elfcpp::R_RISCV_CALL_PLT:
+    case elfcpp::R_RISCV_JAL:
+    case elfcpp::R_RISCV_RVC_JUMP:
+      return Symbol::FUNCTION_CALL | Symbol::RELATIVE_REF;
+
+    case elfcpp::R_RISCV_TLS_GOT_HI20:
+    case elfcpp::R_RISCV_TLS_GD_HI20:
+    case elfcpp::R_RISCV_TPREL_HI20:
+    case elfcpp::R_RISCV_TPREL_LO12_I:
+    case elfcpp::R_RISCV_TPREL_LO12_S:
+    case elfcpp::R_RISCV_TPREL_I:
+    case elfcpp::R_RISCV_TPREL_S:
+    case elfcpp::R_RISCV_TLS_DTPREL32:
+    case elfcpp::R_RISCV_TLS_DTPREL64:
+      return Symbol::TLS_REF;
+
+    default:
+      // Not expected.  We will give an error later.
+      return 0;
+    }
+}
+
+// Scan a relocation for a local symbol.
+
+template<int size, bool big_endian>
+inline void
+Target_riscv<size, big_endian>::Scan::local(
+    Symbol_table* symtab,
+    Layout* layout,
+    Target_riscv<size, big_endian>* target,
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int data_shndx,
+    Output_section* output_section,
+    const elfcpp::Rela<size, big_endian>& rela,
+    unsigned int r_type,
+    const elfcpp::Sym<size, big_endian>&,
+    bool is_discarded)
+{
+  if (is_discarded)
+    return;
+
+  unsigned int r_sym = elfcpp::elf_r_sym<size>(rela.get_r_info());
+  const unsigned int native_reloc = (size == 64
+				     ? elfcpp::R_RISCV_64
+				     : elfcpp::R_RISCV_32);
+
+  switch (r_type)
+    {
+    case elfcpp::R_RISCV_NONE:
+    case elfcpp::R_RISCV_RELAX:
+    case elfcpp::R_RISCV_ALIGN:
+    case elfcpp::R_RISCV_GNU_VTINHERIT:
+    case elfcpp::R_RISCV_GNU_VTENTRY:
+      break;
+
+    case elfcpp::R_RISCV_32:
+    case elfcpp::R_RISCV_64:
+      // If building a shared library or pie, we need to mark this as a
+      // dynamic relocation, so that the dynamic loader can relocate it.
+      if (parameters->options().output_is_position_independent())
+	{
+	  if (r_type != native_reloc)
+	    {
+	      gold_error(_("%s: unsupported reloc %u in pos independent link."),
+			 object->name().c_str(), r_type);
+	      break;
+	    }
+	  Reloc_section* rela_dyn = target->rela_dyn_section(layout);
+	  rela_dyn->add_local_relative(object, r_sym,
+				       elfcpp::R_RISCV_RELATIVE,
+				       output_section, data_shndx,
+				       rela.get_r_offset(),
+				       rela.get_r_addend(), false);
+	}
+      break;
+
+    case elfcpp::R_RISCV_HI20:
+    case elfcpp::R_RISCV_LO12_I:
+    case elfcpp::R_RISCV_LO12_S:
+    case elfcpp::R_RISCV_RVC_LUI:
+    case elfcpp::R_RISCV_GPREL_I:
+    case elfcpp::R_RISCV_GPREL_S:
+      // Absolute addresses cannot be relocated at run time.
+      if (parameters->options().output_is_position_independent())
+	this->check_non_pic(object, r_type);
+      break;
+
+    case elfcpp::R_RISCV_PCREL_HI20:
+    case elfcpp::R_RISCV_PCREL_LO12_I:
+    case elfcpp::R_RISCV_PCREL_LO12_S:
+    case elfcpp::R_RISCV_BRANCH:
+    case elfcpp::R_RISCV_JAL:
+    case elfcpp::R_RISCV_CALL:
+    case elfcpp::R_RISCV_CALL_PLT:
+    case elfcpp::R_RISCV_RVC_BRANCH:
+    case elfcpp::R_RISCV_RVC_JUMP:
+    case elfcpp::R_RISCV_32_PCREL:
+    case elfcpp::R_RISCV_ADD8:
+    case elfcpp::R_RISCV_ADD16:
+    case elfcpp::R_RISCV_ADD32:
+    case elfcpp::R_RISCV_ADD64:
+    case elfcpp::R_RISCV_SUB6:
+    case elfcpp::R_RISCV_SUB8:
+    case elfcpp::R_RISCV_SUB16:
+    case elfcpp::R_RISCV_SUB32:
+    case elfcpp::R_RISCV_SUB64:
+    case elfcpp::R_RISCV_SET6:
+    case elfcpp::R_RISCV_SET8:
+    case elfcpp::R_RISCV_SET16:
+    case elfcpp::R_RISCV_SET32:
+    case elfcpp::R_RISCV_TLS_DTPREL32:
+    case elfcpp::R_RISCV_TLS_DTPREL64:
+      break;
+
+    case elfcpp::R_RISCV_GOT_HI20:
+      {
+	// This symbol requires a GOT entry.
+	Output_data_got_riscv<size, big_endian>* got =
+	  target->got_section(symtab, layout);
+	if (got->add_local(object, r_sym, GOT_TYPE_STANDARD)
+	    && parameters->options().output_is_position_independent())
+	  target->rela_dyn_section(layout)->
+	    add_local_relative(object, r_sym, elfcpp::R_RISCV_RELATIVE, got,
+			       object->local_got_offset(r_sym,
+							GOT_TYPE_STANDARD),
+			       0, false);
+      }
+      break;
+
+    case elfcpp::R_RISCV_TLS_GOT_HI20:
+      {
+	// Initial exec: the GOT entry holds the offset from the thread
+	// pointer, which is known unless this is a shared library.
+	layout->set_has_static_tls();
+	Output_data_got_riscv<size, big_endian>* got =
+	  target->got_section(symtab, layout);
+	if (!parameters->options().shared())
+	  got->add_local(object, r_sym, GOT_TYPE_TLS_OFFSET);
+	else if (!object->local_has_got_offset(r_sym, GOT_TYPE_TLS_OFFSET))
+	  got->add_local_with_rel(object, r_sym, GOT_TYPE_TLS_OFFSET,
+				  target->rela_dyn_section(layout),
+				  (size == 64
+				   ? elfcpp::R_RISCV_TLS_TPREL64
+				   : elfcpp::R_RISCV_TLS_TPREL32));
+      }
+      break;
+
+    case elfcpp::R_RISCV_TLS_GD_HI20:
+      {
+	// General dynamic: a module ID and offset pair.  The executable
+	// is always module 1.
+	Output_data_got_riscv<size, big_endian>* got =
+	  target->got_section(symtab, layout);
+	if (!parameters->options().shared())
+	  {
+	    if (!object->local_has_got_offset(r_sym, GOT_TYPE_TLS_PAIR))
+	      {
+		unsigned int got_offset = got->add_constant(1);
+		got->add_local_tls(object, r_sym, GOT_TYPE_TLS_DTPREL);
+		object->set_local_got_offset(r_sym, GOT_TYPE_TLS_PAIR,
+					     got_offset);
+	      }
+	  }
+	else
+	  got->add_local_tls_pair(object, r_sym, GOT_TYPE_TLS_PAIR,
+				  target->rela_dyn_section(layout),
+				  (size == 64
+				   ? elfcpp::R_RISCV_TLS_DTPMOD64
+				   : elfcpp::R_RISCV_TLS_DTPMOD32));
+      }
+      break;
+
+    case elfcpp::R_RISCV_TPREL_HI20:
+    case elfcpp::R_RISCV_TPREL_LO12_I:
+    case elfcpp::R_RISCV_TPREL_LO12_S:
+    case elfcpp::R_RISCV_TPREL_ADD:
+    case elfcpp::R_RISCV_TPREL_I:
+    case elfcpp::R_RISCV_TPREL_S:
+      // Local exec is only valid in an executable.
+      layout->set_has_static_tls();
+      if (parameters->options().shared())
+	unsupported_reloc_local(object, r_type);
+      break;
+
+    default:
+      unsupported_reloc_local(object, r_type);
+      break;
+    }
+}
+
+// Scan a relocation for a global symbol.
+
+template<int size, bool big_endian>
+inline void
+Target_riscv<size, big_endian>::Scan::global(
+    Symbol_table* symtab,
+    Layout* layout,
+    Target_riscv<size, big_endian>* target,
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int data_shndx,
+    Output_section* output_section,
+    const elfcpp::Rela<size, big_endian>& rela,
+    unsigned int r_type,
+    Symbol* gsym)
+{
+  const unsigned int native_reloc = (size == 64
+				     ? elfcpp::R_RISCV_64
+				     : elfcpp::R_RISCV_32);
+
+  switch (r_type)
+    {
+    case elfcpp::R_RISCV_NONE:
+    case elfcpp::R_RISCV_RELAX:
+    case elfcpp::R_RISCV_ALIGN:
+    case elfcpp::R_RISCV_GNU_VTINHERIT:
+    case elfcpp::R_RISCV_GNU_VTENTRY:
+      break;
+
+    case elfcpp::R_RISCV_32:
+    case elfcpp::R_RISCV_64:
+      {
+	// Make a PLT entry if necessary.
+	if (gsym->needs_plt_entry())
+	  {
+	    target->make_plt_entry(symtab, layout, gsym);
+	    // Since this is not a PC-relative relocation, we may be
+	    // taking the address of a function.  In that case we need to
+	    // set the entry in the dynamic symbol table to the address of
+	    // the PLT entry.
+	    if (gsym->is_from_dynobj() && !parameters->options().shared())
+	      gsym->set_needs_dynsym_value();
+	  }
+	// Make a dynamic relocation if necessary.
+	if (gsym->needs_dynamic_reloc(Scan::get_reference_flags(r_type)))
+	  {
+	    if (!parameters->options().output_is_position_independent()
+		&& gsym->may_need_copy_reloc())
+	      target->copy_reloc(symtab, layout, object,
+				 data_shndx, output_section, gsym, rela);
+	    else if (r_type == native_reloc
+		     && gsym->can_use_relative_reloc(false))
+	      {
+		Reloc_section* rela_dyn = target->rela_dyn_section(layout);
+		rela_dyn->add_global_relative(gsym, elfcpp::R_RISCV_RELATIVE,
+					      output_section, object,
+					      data_shndx, rela.get_r_offset(),
+					      rela.get_r_addend(), false);
+	      }
+	    else
+	      {
+		this->check_non_pic(object, r_type);
+		Reloc_section* rela_dyn = target->rela_dyn_section(layout);
+		rela_dyn->add_global(gsym, r_type, output_section, object,
+				     data_shndx, rela.get_r_offset(),
+				     rela.get_r_addend());
+	      }
+	  }
+      }
+      break;
+
+    case elfcpp::R_RISCV_HI20:
+    case elfcpp::R_RISCV_LO12_I:
+    case elfcpp::R_RISCV_LO12_S:
+    case elfcpp::R_RISCV_RVC_LUI:
+    case elfcpp::R_RISCV_GPREL_I:
+    case elfcpp::R_RISCV_GPREL_S:
+    case elfcpp::R_RISCV_PCREL_HI20:
+    case elfcpp::R_RISCV_PCREL_LO12_I:
+    case elfcpp::R_RISCV_PCREL_LO12_S:
+    case elfcpp::R_RISCV_BRANCH:
+    case elfcpp::R_RISCV_RVC_BRANCH:
+    case elfcpp::R_RISCV_32_PCREL:
+      {
+	// Make a PLT entry if necessary.
+	if (gsym->needs_plt_entry())
+	  {
+	    target->make_plt_entry(symtab, layout, gsym);
+	    if (gsym->is_from_dynobj() && !parameters->options().shared())
+	      gsym->set_needs_dynsym_value();
+	  }
+	// Make a dynamic relocation if necessary.  Only a copy reloc
+	// can stand in for these in an executable.
+	if (gsym->needs_dynamic_reloc(Scan::get_reference_flags(r_type)))
+	  {
+	    if (parameters->options().output_is_executable()
+		&& gsym->may_need_copy_reloc())
+	      target->copy_reloc(symtab, layout, object,
+				 data_shndx, output_section, gsym, rela);
+	    else
+	      this->check_non_pic(object, r_type);
+	  }
+      }
+      break;
+
+    case elfcpp::R_RISCV_CALL:
+    case elfcpp::R_RISCV_CALL_PLT:
+    case elfcpp::R_RISCV_JAL:
+    case elfcpp::R_RISCV_RVC_JUMP:
+      // If the symbol is fully resolved, this is just a PC-relative
+      // reference.  Otherwise we need a PLT entry.
+      if (gsym->final_value_is_known())
+	break;
+      // If building a shared library, we can also skip the PLT entry
+      // if the symbol is defined in the output file and is protected
+      // or hidden.
+      if (gsym->is_defined()
+	  && !gsym->is_from_dynobj()
+	  && !gsym->is_preemptible())
+	break;
+      target->make_plt_entry(symtab, layout, gsym);
+      break;
+
+    case elfcpp::R_RISCV_ADD8:
+    case elfcpp::R_RISCV_ADD16:
+    case elfcpp::R_RISCV_ADD32:
+    case elfcpp::R_RISCV_ADD64:
+    case elfcpp::R_RISCV_SUB6:
+    case elfcpp::R_RISCV_SUB8:
+    case elfcpp::R_RISCV_SUB16:
+    case elfcpp::R_RISCV_SUB32:
+    case elfcpp::R_RISCV_SUB64:
+    case elfcpp::R_RISCV_SET6:
+    case elfcpp::R_RISCV_SET8:
+    case elfcpp::R_RISCV_SET16:
+    case elfcpp::R_RISCV_SET32:
+    case elfcpp::R_RISCV_TLS_DTPREL32:
+    case elfcpp::R_RISCV_TLS_DTPREL64:
+      break;
+
+    case elfcpp::R_RISCV_GOT_HI20:
+      {
+	// This symbol requires a GOT entry.
+	Output_data_got_riscv<size, big_endian>* got =
+	  target->got_section(symtab, layout);
+	if (gsym->final_value_is_known())
+	  got->add_global(gsym, GOT_TYPE_STANDARD);
+	else
+	  {
+	    // If this symbol is not fully resolved, we need to add a
+	    // dynamic relocation for it.
+	    Reloc_section* rela_dyn = target->rela_dyn_section(layout);
+	    if (gsym->is_from_dynobj()
+		|| gsym->is_undefined()
+		|| gsym->is_preemptible()
+		|| (gsym->visibility() == elfcpp::STV_PROTECTED
+		    && parameters->options().shared()))
+	      got->add_global_with_rel(gsym, GOT_TYPE_STANDARD, rela_dyn,
+				       native_reloc);
+	    else if (got->add_global(gsym, GOT_TYPE_STANDARD))
+	      rela_dyn->add_global_relative(
+		  gsym, elfcpp::R_RISCV_RELATIVE, got,
+		  gsym->got_offset(GOT_TYPE_STANDARD), 0, false);
+	  }
+      }
+      break;
+
+    case elfcpp::R_RISCV_TLS_GOT_HI20:
+      {
+	// Initial exec.
+	layout->set_has_static_tls();
+	Output_data_got_riscv<size, big_endian>* got =
+	  target->got_section(symtab, layout);
+	if (gsym->final_value_is_known())
+	  got->add_global(gsym, GOT_TYPE_TLS_OFFSET);
+	else
+	  got->add_global_with_rel(gsym, GOT_TYPE_TLS_OFFSET,
+				   target->rela_dyn_section(layout),
+				   (size == 64
+				    ? elfcpp::R_RISCV_TLS_TPREL64
+				    : elfcpp::R_RISCV_TLS_TPREL32));
+      }
+      break;
+
+    case elfcpp::R_RISCV_TLS_GD_HI20:
+      {
+	// General dynamic.
+	Output_data_got_riscv<size, big_endian>* got =
+	  target->got_section(symtab, layout);
+	if (gsym->final_value_is_known())
+	  {
+	    // The symbol is in the executable, module 1.
+	    if (!gsym->has_got_offset(GOT_TYPE_TLS_PAIR))
+	      {
+		unsigned int got_offset = got->add_constant(1);
+		got->add_global_tls(gsym, GOT_TYPE_TLS_DTPREL);
+		gsym->set_got_offset(GOT_TYPE_TLS_PAIR, got_offset);
+	      }
+	  }
+	else
+	  got->add_global_pair_with_rel(gsym, GOT_TYPE_TLS_PAIR,
+					target->rela_dyn_section(layout),
+					(size == 64
+					 ? elfcpp::R_RISCV_TLS_DTPMOD64
+					 : elfcpp::R_RISCV_TLS_DTPMOD32),
+					(size == 64
+					 ? elfcpp::R_RISCV_TLS_DTPREL64
+					 : elfcpp::R_RISCV_TLS_DTPREL32));
+      }
+      break;
+
+    case elfcpp::R_RISCV_TPREL_HI20:
+    case elfcpp::R_RISCV_TPREL_LO12_I:
+    case elfcpp::R_RISCV_TPREL_LO12_S:
+    case elfcpp::R_RISCV_TPREL_ADD:
+    case elfcpp::R_RISCV_TPREL_I:
+    case elfcpp::R_RISCV_TPREL_S:
+      // Local exec.
+      layout->set_has_static_tls();
+      if (parameters->options().shared())
+	unsupported_reloc_global(object, r_type, gsym);
+      break;
+
+    default:
+      unsupported_reloc_global(object, r_type, gsym);
+      break;
+    }
+}
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::gc_process_relocs(
+    Symbol_table* symtab,
+    Layout* layout,
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int data_shndx,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    bool needs_special_offset_handling,
+    size_t local_symbol_count,
+    const unsigned char* plocal_symbols)
+{
+  typedef gold::Default_classify_reloc<elfcpp::SHT_RELA, size, big_endian>
+      Classify_reloc;
+
+  if (sh_type == elfcpp::SHT_REL)
+    return;
+
+  gold::gc_process_relocs<size, big_endian, This, Scan, Classify_reloc>(
+    symtab,
+    layout,
+    this,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_symbols);
+}
+
+// Scan relocations for a section.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::scan_relocs(
+    Symbol_table* symtab,
+    Layout* layout,
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int data_shndx,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    bool needs_special_offset_handling,
+    size_t local_symbol_count,
+    const unsigned char* plocal_symbols)
+{
+  typedef gold::Default_classify_reloc<elfcpp::SHT_RELA, size, big_endian>
+      Classify_reloc;
+
+  if (sh_type == elfcpp::SHT_REL)
+    {
+      gold_error(_("%s: unsupported REL reloc section"),
+		 object->name().c_str());
+      return;
+    }
+
+  gold::scan_relocs<size, big_endian, This, Scan, Classify_reloc>(
+    symtab,
+    layout,
+    this,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_symbols);
+}
+
+// Return the value to use for a dynamic symbol which requires special
+// treatment.  This is how we support equality comparisons of function
+// pointers across shared library boundaries, as described in the
+// processor specific ABI supplement.
+
+template<int size, bool big_endian>
+uint64_t
+Target_riscv<size, big_endian>::do_dynsym_value(const Symbol* gsym) const
+{
+  gold_assert(gsym->is_from_dynobj() && gsym->has_plt_offset());
+  return this->plt_address_for_global(gsym);
+}
+
+// Finalize the sections.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::do_finalize_sections(
+    Layout* layout,
+    const Input_objects* input_objects,
+    Symbol_table* symtab)
+{
+  const Reloc_section* rel_plt = (this->plt_ == NULL
+				  ? NULL
+				  : this->plt_->rela_plt());
+  layout->add_target_dynamic_tags(false, this->got_plt_, rel_plt,
+				  this->rela_dyn_, true, false);
+
+  // Emit any relocs we saved in an attempt to avoid generating COPY
+  // relocs.
+  if (this->copy_relocs_.any_saved_relocs())
+    this->copy_relocs_.emit(this->rela_dyn_section(layout));
+
+  // Set the size of the _GLOBAL_OFFSET_TABLE_ symbol to the size of
+  // the .got section.
+  Symbol* sym = this->global_offset_table_;
+  if (sym != NULL)
+    {
+      uint64_t data_size = this->got_->current_data_size();
+      symtab->get_sized_symbol<size>(sym)->set_symsize(data_size);
+    }
+
+  // Merge the ELF header flags of the input objects.  Code that may
+  // use compressed instructions taints the output, and the
+  // floating-point ABIs must agree.
+  for (Input_objects::Relobj_iterator p = input_objects->relobj_begin();
+       p != input_objects->relobj_end();
+       ++p)
+    {
+      if ((*p)->just_symbols())
+	continue;
+      The_riscv_relobj* riscv_relobj = static_cast<The_riscv_relobj*>(*p);
+      elfcpp::Elf_Word flags = riscv_relobj->e_flags();
+      if (!this->are_processor_specific_flags_set())
+	{
+	  this->set_processor_specific_flags(flags);
+	  continue;
+	}
+      elfcpp::Elf_Word out_flags = this->processor_specific_flags();
+      if ((flags & elfcpp::EF_RISCV_FLOAT_ABI)
+	  != (out_flags & elfcpp::EF_RISCV_FLOAT_ABI))
+	gold_error(_("%s: can't link %s modules with %s modules"),
+		   riscv_relobj->name().c_str(),
+		   ((flags & elfcpp::EF_RISCV_FLOAT_ABI)
+		    == elfcpp::EF_RISCV_FLOAT_ABI_SOFT
+		    ? "soft-float" : "hard-float"),
+		   ((out_flags & elfcpp::EF_RISCV_FLOAT_ABI)
+		    == elfcpp::EF_RISCV_FLOAT_ABI_SOFT
+		    ? "soft-float" : "hard-float"));
+      this->set_processor_specific_flags(out_flags | flags);
+    }
+
+  // Define __global_pointer$ in executables that do not define it
+  // themselves, 0x800 bytes into the small data so that a signed
+  // 12-bit offset reaches either side of it.
+  if (!parameters->options().shared()
+      && !parameters->options().relocatable())
+    {
+      Symbol* gp = symtab->lookup("__global_pointer$");
+      if (gp == NULL || !gp->is_defined())
+	{
+	  Output_section* os = layout->find_output_section(".sdata");
+	  if (os == NULL)
+	    os = layout->find_output_section(".data");
+	  if (os != NULL)
+	    symtab->define_in_output_data("__global_pointer$", NULL,
+					  Symbol_table::PREDEFINED, os,
+					  0x800, 0, elfcpp::STT_NOTYPE,
+					  elfcpp::STB_GLOBAL,
+					  elfcpp::STV_DEFAULT, 0,
+					  false, false);
+	}
+    }
+  this->global_pointer_ = symtab->lookup("__global_pointer$");
+}
+
+// Return the value of the global pointer.
+
+template<int size, bool big_endian>
+typename Target_riscv<size, big_endian>::Address
+Target_riscv<size, big_endian>::global_pointer_value(
+    const Symbol_table* symtab,
+    bool final) const
+{
+  Symbol* gp = this->global_pointer_;
+  if (gp == NULL || !gp->is_defined() || gp->is_from_dynobj())
+    return 0;
+  const Sized_symbol<size>* sym = symtab->get_sized_symbol<size>(gp);
+  if (final)
+    return sym->value();
+  Symbol_table::Compute_final_value_status status;
+  Address value = symtab->compute_final_value<size>(sym, &status);
+  return status == Symbol_table::CFVS_OK ? value : 0;
+}
+
+// Perform a relocation.
+
+template<int size, bool big_endian>
+inline bool
+Target_riscv<size, big_endian>::Relocate::relocate(
+    const Relocate_info<size, big_endian>* relinfo,
+    unsigned int,
+    Target_riscv* target,
+    Output_section*,
+    size_t relnum,
+    const unsigned char* preloc,
+    const Sized_symbol<size>* gsym,
+    const Symbol_value<size>* psymval,
+    unsigned char* view,
+    Address address,
+    section_size_type)
+{
+  typedef Riscv_relocate_functions<big_endian> Insn_writer;
+
+  const elfcpp::Rela<size, big_endian> rela(preloc);
+  Sized_relobj_file<size, big_endian>* object = relinfo->object;
+  unsigned int r_type = elfcpp::elf_r_type<size>(rela.get_r_info());
+  const Addend addend = rela.get_r_addend();
+
+  if (this->target_ == NULL)
+    {
+      this->target_ = target;
+      this->relaxed_section_ =
+	target->find_riscv_input_section(object, relinfo->data_shndx);
+    }
+
+  // Relaxation may have rewritten the relocation.
+  const The_riscv_input_section* rsec = this->relaxed_section_;
+  unsigned int orig_type = r_type;
+  unsigned int hi_index = -1U;
+  if (rsec != NULL)
+    {
+      const typename The_riscv_input_section::Reloc& r(rsec->relocs()[relnum]);
+      r_type = r.r_type;
+      hi_index = r.hi_index;
+    }
+
+  switch (r_type)
+    {
+    case elfcpp::R_RISCV_NONE:
+      // If relaxation deleted a %pcrel_hi, the %pcrel_lo relocations
+      // that went with it became R_RISCV_GPREL_*, which need the
+      // address the %pcrel_hi referred to.
+      if (orig_type == elfcpp::R_RISCV_PCREL_HI20 && rsec != NULL)
+	this->pcrel_hi_by_offset_[rela.get_r_offset()] =
+	  psymval->value(object, addend);
+      return false;
+
+    case elfcpp::R_RISCV_RELAX:
+    case elfcpp::R_RISCV_ALIGN:
+    case elfcpp::R_RISCV_TPREL_ADD:
+    case elfcpp::R_RISCV_GNU_VTINHERIT:
+    case elfcpp::R_RISCV_GNU_VTENTRY:
+      // Nothing to do; relaxation has already dealt with alignment.
+      return false;
+
+    default:
+      break;
+    }
+
+  if (view == NULL)
+    return true;
+
+  Symbol_value<size> symval;
+  if (gsym != NULL
+      && gsym->use_plt_offset(Scan::get_reference_flags(r_type)))
+    {
+      symval.set_output_value(target->plt_address_for_global(gsym));
+      psymval = &symval;
+    }
+
+  const Address value = psymval->value(object, addend);
+  bool overflow = false;
+  Address got_offset = 0;
+
+  switch (r_type)
+    {
+    case elfcpp::R_RISCV_32:
+    case elfcpp::R_RISCV_SET32:
+      Insn_writer::template put<32>(view, value);
+      break;
+
+    case elfcpp::R_RISCV_64:
+      Insn_writer::template put<64>(view, value);
+      break;
+
+    case elfcpp::R_RISCV_SET6:
+      Insn_writer::template put<8>(
+	  view, (Insn_writer::template get<8>(view) & ~0x3f) | (value & 0x3f));
+      break;
+
+    case elfcpp::R_RISCV_SET8:
+      Insn_writer::template put<8>(view, value);
+      break;
+
+    case elfcpp::R_RISCV_SET16:
+      Insn_writer::template put<16>(view, value);
+      break;
+
+    case elfcpp::R_RISCV_ADD8:
+      Insn_writer::template put<8>(
+	  view, Insn_writer::template get<8>(view) + value);
+      break;
+
+    case elfcpp::R_RISCV_ADD16:
+      Insn_writer::template put<16>(
+	  view, Insn_writer::template get<16>(view) + value);
+      break;
+
+    case elfcpp::R_RISCV_ADD32:
+      Insn_writer::template put<32>(
+	  view, Insn_writer::template get<32>(view) + value);
+      break;
+
+    case elfcpp::R_RISCV_ADD64:
+      Insn_writer::template put<64>(
+	  view, Insn_writer::template get<64>(view) + value);
+      break;
+
+    case elfcpp::R_RISCV_SUB6:
+      {
+	unsigned int old = Insn_writer::template get<8>(view);
+	Insn_writer::template put<8>(view,
+				     (old & ~0x3f) | ((old - value) & 0x3f));
+      }
+      break;
+
+    case elfcpp::R_RISCV_SUB8:
+      Insn_writer::template put<8>(
+	  view, Insn_writer::template get<8>(view) - value);
+      break;
+
+    case elfcpp::R_RISCV_SUB16:
+      Insn_writer::template put<16>(
+	  view, Insn_writer::template get<16>(view) - value);
+      break;
+
+    case elfcpp::R_RISCV_SUB32:
+      Insn_writer::template put<32>(
+	  view, Insn_writer::template get<32>(view) - value);
+      break;
+
+    case elfcpp::R_RISCV_SUB64:
+      Insn_writer::template put<64>(
+	  view, Insn_writer::template get<64>(view) - value);
+      break;
+
+    case elfcpp::R_RISCV_32_PCREL:
+      Insn_writer::template put<32>(view, value - address);
+      break;
+
+    case elfcpp::R_RISCV_TLS_DTPREL32:
+      Insn_writer::template put<32>(view, value - RISCV_DTP_OFFSET);
+      break;
+
+    case elfcpp::R_RISCV_TLS_DTPREL64:
+      Insn_writer::template put<64>(view, value - RISCV_DTP_OFFSET);
+      break;
+
+    case elfcpp::R_RISCV_HI20:
+    case elfcpp::R_RISCV_TPREL_HI20:
+      {
+	// TLS symbol values are offsets into the TLS segment, which
+	// starts at the thread pointer.
+	int64_t hi = Riscv_insn::const_high_part(value);
+	if (size == 64 && !Riscv_insn::valid_utype_imm(hi))
+	  overflow = true;
+	else
+	  Insn_writer::update_insn(view, Riscv_insn::UTYPE_MASK,
+				   Riscv_insn::encode_utype_imm(hi));
+      }
+      break;
+
+    case elfcpp::R_RISCV_LO12_I:
+    case elfcpp::R_RISCV_TPREL_LO12_I:
+      Insn_writer::update_insn(view, Riscv_insn::ITYPE_MASK,
+			       Riscv_insn::encode_itype_imm(value));
+      break;
+
+    case elfcpp::R_RISCV_LO12_S:
+    case elfcpp::R_RISCV_TPREL_LO12_S:
+      Insn_writer::update_insn(view, Riscv_insn::STYPE_MASK,
+			       Riscv_insn::encode_stype_imm(value));
+      break;
+
+    case elfcpp::R_RISCV_TPREL_I:
+    case elfcpp::R_RISCV_TPREL_S:
+      // The offset from the thread pointer fits in the instruction.
+      if (!Riscv_insn::valid_itype_imm(static_cast<int64_t>(
+	      static_cast<uint64_t>(value))))
+	overflow = true;
+      else if (r_type == elfcpp::R_RISCV_TPREL_I)
+	Insn_writer::update_insn(view,
+				 Riscv_insn::RS1_MASK | Riscv_insn::ITYPE_MASK,
+				 ((Riscv_insn::X_TP << Riscv_insn::RS1_SHIFT)
+				  | Riscv_insn::encode_itype_imm(value)));
+      else
+	Insn_writer::update_insn(view,
+				 Riscv_insn::RS1_MASK | Riscv_insn::STYPE_MASK,
+				 ((Riscv_insn::X_TP << Riscv_insn::RS1_SHIFT)
+				  | Riscv_insn::encode_stype_imm(value)));
+      break;
+
+    case elfcpp::R_RISCV_GPREL_I:
+    case elfcpp::R_RISCV_GPREL_S:
+      if (orig_type == elfcpp::R_RISCV_PCREL_LO12_I
+	  || orig_type == elfcpp::R_RISCV_PCREL_LO12_S)
+	{
+	  // This was a %pcrel_lo whose %pcrel_hi relaxation deleted;
+	  // it refers to the address the %pcrel_hi referred to.
+	  gold_assert(hi_index != -1U);
+	  Pcrel_lo lo = { relinfo, relnum, rela.get_r_offset(), r_type, view,
+			  rsec->relocs()[hi_index].offset, true, addend };
+	  this->pcrel_lo_.push_back(lo);
+	}
+      else if (!Insn_writer::gprel(view, r_type, value,
+				   target->global_pointer_value(
+				       relinfo->symtab, true)))
+	overflow = true;
+      break;
+
+    case elfcpp::R_RISCV_GOT_HI20:
+    case elfcpp::R_RISCV_TLS_GOT_HI20:
+    case elfcpp::R_RISCV_TLS_GD_HI20:
+    case elfcpp::R_RISCV_PCREL_HI20:
+      {
+	Address hi_value;
+	if (r_type == elfcpp::R_RISCV_PCREL_HI20)
+	  hi_value = value - address;
+	else
+	  {
+	    unsigned int got_type =
+	      (r_type == elfcpp::R_RISCV_GOT_HI20
+	       ? GOT_TYPE_STANDARD
+	       : (r_type == elfcpp::R_RISCV_TLS_GOT_HI20
+		  ? GOT_TYPE_TLS_OFFSET
+		  : GOT_TYPE_TLS_PAIR));
+	    if (gsym != NULL)
+	      {
+		gold_assert(gsym->has_got_offset(got_type));
+		got_offset = gsym->got_offset(got_type);
+	      }
+	    else
+	      {
+		unsigned int r_sym = elfcpp::elf_r_sym<size>(rela.get_r_info());
+		gold_assert(object->local_has_got_offset(r_sym, got_type));
+		got_offset = object->local_got_offset(r_sym, got_type);
+	      }
+	    hi_value = target->got_->address() + got_offset + addend - address;
+	  }
+
+	this->pcrel_hi_[address] = hi_value;
+	if (rsec != NULL)
+	  this->pcrel_hi_by_offset_[rela.get_r_offset()] = hi_value;
+
+	int64_t hi = Riscv_insn::const_high_part(hi_value);
+	if (size == 64 && !Riscv_insn::valid_utype_imm(hi))
+	  overflow = true;
+	else
+	  Insn_writer::update_insn(view, Riscv_insn::UTYPE_MASK,
+				   Riscv_insn::encode_utype_imm(hi));
+      }
+      break;
+
+    case elfcpp::R_RISCV_PCREL_LO12_I:
+    case elfcpp::R_RISCV_PCREL_LO12_S:
+      {
+	// The symbol is a label at the instruction the %pcrel_hi
+	// applies to.
+	Pcrel_lo lo = { relinfo, relnum, rela.get_r_offset(), r_type, view,
+			psymval->value(object, 0), false, addend };
+	if (hi_index != -1U)
+	  {
+	    lo.key = rsec->relocs()[hi_index].offset;
+	    lo.key_is_offset = true;
+	  }
+	this->pcrel_lo_.push_back(lo);
+      }
+      break;
+
+    case elfcpp::R_RISCV_BRANCH:
+      {
+	int64_t offset = This::pcrel_offset(value, address);
+	if (!Riscv_insn::valid_sbtype_imm(offset))
+	  overflow = true;
+	else
+	  Insn_writer::update_insn(view, Riscv_insn::SBTYPE_MASK,
+				   Riscv_insn::encode_sbtype_imm(offset));
+      }
+      break;
+
+    case elfcpp::R_RISCV_JAL:
+      {
+	int64_t offset = This::pcrel_offset(value, address);
+	if (!Riscv_insn::valid_ujtype_imm(offset))
+	  overflow = true;
+	else
+	  Insn_writer::update_insn(view, Riscv_insn::UJTYPE_MASK,
+				   Riscv_insn::encode_ujtype_imm(offset));
+      }
+      break;
+
+    case elfcpp::R_RISCV_RVC_BRANCH:
+      {
+	int64_t offset = This::pcrel_offset(value, address);
+	if (!Riscv_insn::valid_rvc_b_imm(offset))
+	  overflow = true;
+	else
+	  Insn_writer::update_rvc_insn(view, Riscv_insn::RVC_B_MASK,
+				       Riscv_insn::encode_rvc_b_imm(offset));
+      }
+      break;
+
+    case elfcpp::R_RISCV_RVC_JUMP:
+      {
+	int64_t offset = This::pcrel_offset(value, address);
+	if (!Riscv_insn::valid_rvc_j_imm(offset))
+	  overflow = true;
+	else
+	  Insn_writer::update_rvc_insn(view, Riscv_insn::RVC_J_MASK,
+				       Riscv_insn::encode_rvc_j_imm(offset));
+      }
+      break;
+
+    case elfcpp::R_RISCV_RVC_LUI:
+      {
+	int64_t hi = Riscv_insn::const_high_part(value);
+	if (hi == 0)
+	  {
+	    // Relaxation can bring an address that needed C.LUI below
+	    // 0x800, where C.LUI has no encoding; C.LI rd, 0 does the
+	    // same job.
+	    Insn_writer::update_rvc_insn(view,
+					 (Riscv_insn::RVC_OPCODE_MASK
+					  | Riscv_insn::RVC_IMM_MASK),
+					 Riscv_insn::MATCH_C_LI);
+	  }
+	else if (!Riscv_insn::valid_rvc_lui_imm(hi))
+	  overflow = true;
+	else
+	  Insn_writer::update_rvc_insn(view, Riscv_insn::RVC_IMM_MASK,
+				       Riscv_insn::encode_rvc_lui_imm(hi));
+      }
+      break;
+
+    case elfcpp::R_RISCV_CALL:
+    case elfcpp::R_RISCV_CALL_PLT:
+      {
+	int64_t offset = This::pcrel_offset(value, address);
+	int64_t hi = Riscv_insn::const_high_part(offset);
+	if (size == 64 && !Riscv_insn::valid_utype_imm(hi))
+	  overflow = true;
+	else
+	  {
+	    Insn_writer::update_insn(view, Riscv_insn::UTYPE_MASK,
+				     Riscv_insn::encode_utype_imm(hi));
+	    Insn_writer::update_insn(view + 4, Riscv_insn::ITYPE_MASK,
+				     Riscv_insn::encode_itype_imm(offset));
+	  }
+      }
+      break;
+
+    default:
+      gold_error_at_location(relinfo, relnum, rela.get_r_offset(),
+			     _("unexpected reloc %u in object file"),
+			     r_type);
+      break;
+    }
+
+  if (overflow)
+    gold_error_at_location(relinfo, relnum, rela.get_r_offset(),
+			   _("relocation overflow in reloc %u"),
+			   r_type);
+
+  return true;
+}
+
+// Apply the %pcrel_lo relocations of the section now that every
+// %pcrel_hi in it has been seen.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::Relocate::resolve_pcrel_lo_relocs()
+{
+  typedef Riscv_relocate_functions<big_endian> Insn_writer;
+
+  for (typename std::vector<Pcrel_lo>::const_iterator p =
+	 this->pcrel_lo_.begin();
+       p != this->pcrel_lo_.end();
+       ++p)
+    {
+      const std::map<Address, Address>& hi_relocs(p->key_is_offset
+						  ? this->pcrel_hi_by_offset_
+						  : this->pcrel_hi_);
+      typename std::map<Address, Address>::const_iterator hi =
+	hi_relocs.find(p->key);
+      if (hi == hi_relocs.end())
+	{
+	  gold_error_at_location(p->relinfo, p->relnum, p->r_offset,
+				 _("%%pcrel_lo missing matching %%pcrel_hi"));
+	  continue;
+	}
+
+      Address value = hi->second + p->addend;
+      switch (p->r_type)
+	{
+	case elfcpp::R_RISCV_PCREL_LO12_I:
+	  Insn_writer::update_insn(p->view, Riscv_insn::ITYPE_MASK,
+				   Riscv_insn::encode_itype_imm(value));
+	  break;
+
+	case elfcpp::R_RISCV_PCREL_LO12_S:
+	  Insn_writer::update_insn(p->view, Riscv_insn::STYPE_MASK,
+				   Riscv_insn::encode_stype_imm(value));
+	  break;
+
+	case elfcpp::R_RISCV_GPREL_I:
+	case elfcpp::R_RISCV_GPREL_S:
+	  if (!Insn_writer::gprel(p->view, p->r_type, value,
+				  this->target_->global_pointer_value(
+				      p->relinfo->symtab, true)))
+	    gold_error_at_location(p->relinfo, p->relnum, p->r_offset,
+				   _("relocation overflow in reloc %u"),
+				   p->r_type);
+	  break;
+
+	default:
+	  gold_unreachable();
+	}
+    }
+  this->pcrel_lo_.clear();
+}
+
+// Relocate section data.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::relocate_section(
+    const Relocate_info<size, big_endian>* relinfo,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    bool needs_special_offset_handling,
+    unsigned char* view,
+    Address address,
+    section_size_type view_size,
+    const Reloc_symbol_changes* reloc_symbol_changes)
+{
+  typedef typename Target_riscv<size, big_endian>::Relocate Riscv_relocate;
+  typedef gold::Default_classify_reloc<elfcpp::SHT_RELA, size, big_endian>
+      Classify_reloc;
+
+  gold_assert(sh_type == elfcpp::SHT_RELA);
+
+  // See if we are relocating a relaxed input section.  If so, the view
+  // covers the whole output section and we need to adjust accordingly.
+  if (needs_special_offset_handling)
+    {
+      const Output_relaxed_input_section* poris =
+	output_section->find_relaxed_input_section(relinfo->object,
+						   relinfo->data_shndx);
+      if (poris != NULL)
+	{
+	  Address section_address = poris->address();
+	  section_size_type section_size = poris->data_size();
+
+	  gold_assert((section_address >= address)
+		      && ((section_address + section_size)
+			  <= (address + view_size)));
+
+	  off_t offset = section_address - address;
+	  view += offset;
+	  address += offset;
+	  view_size = section_size;
+	}
+    }
+
+  gold::relocate_section<size, big_endian, This, Riscv_relocate,
+			 gold::Default_comdat_behavior, Classify_reloc>(
+    relinfo,
+    this,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    view,
+    address,
+    view_size,
+    reloc_symbol_changes);
+}
+
+// Scan the relocs during a relocatable link.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::scan_relocatable_relocs(
+    Symbol_table* symtab,
+    Layout* layout,
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int data_shndx,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    bool needs_special_offset_handling,
+    size_t local_symbol_count,
+    const unsigned char* plocal_symbols,
+    Relocatable_relocs* rr)
+{
+  typedef gold::Default_classify_reloc<elfcpp::SHT_RELA, size, big_endian>
+      Classify_reloc;
+  typedef gold::Default_scan_relocatable_relocs<Classify_reloc>
+      Scan_relocatable_relocs;
+
+  gold_assert(sh_type == elfcpp::SHT_RELA);
+
+  gold::scan_relocatable_relocs<size, big_endian, Scan_relocatable_relocs>(
+    symtab,
+    layout,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_symbols,
+    rr);
+}
+
+// Scan the relocs for --emit-relocs.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::emit_relocs_scan(
+    Symbol_table* symtab,
+    Layout* layout,
+    Sized_relobj_file<size, big_endian>* object,
+    unsigned int data_shndx,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    bool needs_special_offset_handling,
+    size_t local_symbol_count,
+    const unsigned char* plocal_syms,
+    Relocatable_relocs* rr)
+{
+  typedef gold::Default_classify_reloc<elfcpp::SHT_RELA, size, big_endian>
+      Classify_reloc;
+  typedef gold::Default_emit_relocs_strategy<Classify_reloc>
+      Emit_relocs_strategy;
+
+  gold_assert(sh_type == elfcpp::SHT_RELA);
+
+  gold::scan_relocatable_relocs<size, big_endian, Emit_relocs_strategy>(
+    symtab,
+    layout,
+    object,
+    data_shndx,
+    prelocs,
+    reloc_count,
+    output_section,
+    needs_special_offset_handling,
+    local_symbol_count,
+    plocal_syms,
+    rr);
+}
+
+// Relocate a section during a relocatable link.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::relocate_relocs(
+    const Relocate_info<size, big_endian>* relinfo,
+    unsigned int sh_type,
+    const unsigned char* prelocs,
+    size_t reloc_count,
+    Output_section* output_section,
+    typename elfcpp::Elf_types<size>::Elf_Off offset_in_output_section,
+    unsigned char* view,
+    Address view_address,
+    section_size_type view_size,
+    unsigned char* reloc_view,
+    section_size_type reloc_view_size)
+{
+  typedef gold::Default_classify_reloc<elfcpp::SHT_RELA, size, big_endian>
+      Classify_reloc;
+
+  gold_assert(sh_type == elfcpp::SHT_RELA);
+
+  gold::relocate_relocs<size, big_endian, Classify_reloc>(
+    relinfo,
+    prelocs,
+    reloc_count,
+    output_section,
+    offset_in_output_section,
+    view,
+    view_address,
+    view_size,
+    reloc_view,
+    reloc_view_size);
+}
+
+// Compute the value a relocation refers to for relaxation.
+
+template<int size, bool big_endian>
+bool
+Target_riscv<size, big_endian>::relax_symbol_value(
+    const Symbol_table* symtab,
+    The_riscv_relobj* object,
+    const typename The_riscv_input_section::Reloc& r,
+    Address* pvalue,
+    bool* in_code,
+    Output_section** pos,
+    Address* reserve) const
+{
+  *in_code = false;
+  *pos = NULL;
+  *reserve = 0;
+
+  if (r.r_sym < object->local_symbol_count())
+    {
+      const Symbol_value<size>* psymval = object->local_symbol(r.r_sym);
+      bool is_ordinary;
+      unsigned int shndx = psymval->input_shndx(&is_ordinary);
+      if (!is_ordinary)
+	{
+	  if (shndx != elfcpp::SHN_ABS)
+	    return false;
+	  *pvalue = psymval->input_value() + r.addend;
+	  return true;
+	}
+
+      Symbol_value<size> symval;
+      if (psymval->is_section_symbol())
+	symval.set_is_section_symbol();
+      typename The_riscv_relobj::Compute_final_local_value_status status =
+	object->compute_final_local_value(r.r_sym, psymval, &symval, symtab);
+      if (status != The_riscv_relobj::CFLV_OK)
+	return false;
+      *pvalue = symval.value(object, r.addend);
+      *in_code = object->is_code_section(shndx);
+      *pos = object->output_section(shndx);
+      return true;
+    }
+
+  Symbol* gsym = object->global_symbol(r.r_sym);
+  gold_assert(gsym != NULL);
+  if (gsym->is_forwarder())
+    gsym = symtab->resolve_forwards(gsym);
+
+  if (gsym->use_plt_offset(Scan::get_reference_flags(r.r_type)))
+    {
+      *pvalue = this->plt_address_for_global(gsym) + r.addend;
+      *in_code = true;
+      *pos = this->plt_->output_section();
+      return true;
+    }
+
+  // The values of undefined and dynamic symbols are not known yet.
+  if (!gsym->is_defined() || gsym->is_from_dynobj())
+    return false;
+
+  const Sized_symbol<size>* sym = symtab->get_sized_symbol<size>(gsym);
+  Symbol_table::Compute_final_value_status status;
+  Address value = symtab->compute_final_value<size>(sym, &status);
+  if (status != Symbol_table::CFVS_OK)
+    return false;
+  *pvalue = value + r.addend;
+
+  bool is_ordinary;
+  unsigned int shndx = gsym->shndx(&is_ordinary);
+  if (gsym->source() == Symbol::FROM_OBJECT && is_ordinary)
+    {
+      Relobj* relobj = static_cast<Relobj*>(gsym->object());
+      if (!relobj->just_symbols())
+	{
+	  *in_code = static_cast<The_riscv_relobj*>(relobj)->
+	    is_code_section(shndx);
+	  *pos = relobj->output_section(shndx);
+	}
+    }
+  else if (gsym->source() == Symbol::IN_OUTPUT_DATA)
+    {
+      *pos = gsym->output_data()->output_section();
+      *in_code = (*pos != NULL
+		  && ((*pos)->flags() & elfcpp::SHF_EXECINSTR) != 0);
+    }
+
+  // A data object may extend past the referenced address; keep all of
+  // it within reach of the global pointer.
+  if (gsym->type() != elfcpp::STT_FUNC
+      && r.addend >= 0
+      && static_cast<Address>(r.addend) <= sym->symsize())
+    *reserve = sym->symsize() - r.addend;
+  return true;
+}
+
+// Shrink the code sequences of a relaxed section.
+
+template<int size, bool big_endian>
+bool
+Target_riscv<size, big_endian>::relax_section(
+    const Symbol_table* symtab,
+    The_riscv_input_section* rsec,
+    Address gp,
+    Address max_alignment)
+{
+  typedef Riscv_relocate_functions<big_endian> Insn_writer;
+  typedef typename The_riscv_input_section::Reloc Reloc;
+
+  The_riscv_relobj* object = static_cast<The_riscv_relobj*>(rsec->relobj());
+  typename The_riscv_input_section::Relocs& relocs(rsec->relocs());
+  unsigned char* contents = rsec->contents();
+  const bool pic = parameters->options().output_is_position_independent();
+  const bool rvc = object->has_rvc();
+  Output_section* this_os = object->output_section(rsec->shndx());
+  bool changed = false;
+
+  for (size_t i = 0; i < relocs.size(); ++i)
+    {
+      Reloc& r(relocs[i]);
+
+      // Only relocations that the assembler paired with an
+      // R_RISCV_RELAX may be relaxed.
+      if (i + 1 >= relocs.size()
+	  || relocs[i + 1].r_type != elfcpp::R_RISCV_RELAX
+	  || relocs[i + 1].offset != r.offset)
+	continue;
+
+      switch (r.r_type)
+	{
+	case elfcpp::R_RISCV_CALL:
+	case elfcpp::R_RISCV_CALL_PLT:
+	case elfcpp::R_RISCV_HI20:
+	case elfcpp::R_RISCV_LO12_I:
+	case elfcpp::R_RISCV_LO12_S:
+	case elfcpp::R_RISCV_PCREL_HI20:
+	case elfcpp::R_RISCV_TPREL_HI20:
+	case elfcpp::R_RISCV_TPREL_LO12_I:
+	case elfcpp::R_RISCV_TPREL_LO12_S:
+	case elfcpp::R_RISCV_TPREL_ADD:
+	  break;
+	default:
+	  continue;
+	}
+
+      Address value;
+      bool in_code;
+      Output_section* sym_os;
+      Address reserve;
+      if (!this->relax_symbol_value(symtab, object, r, &value, &in_code,
+				    &sym_os, &reserve))
+	continue;
+
+      // Whether VALUE can be reached from x0 or, allowing for padding
+      // that alignment may still add, from the global pointer.
+      int64_t gp_offset = (static_cast<int64_t>(static_cast<uint64_t>(value))
+			   - static_cast<int64_t>(static_cast<uint64_t>(gp)));
+      bool gp_reachable =
+	(Riscv_insn::valid_itype_imm(static_cast<int64_t>(
+	     static_cast<uint64_t>(value)))
+	 || (gp_offset >= 0
+	     && Riscv_insn::valid_itype_imm(gp_offset + max_alignment
+					    + reserve))
+	 || (gp_offset < 0
+	     && Riscv_insn::valid_itype_imm(gp_offset - max_alignment
+					    - reserve)));
+
+      switch (r.r_type)
+	{
+	case elfcpp::R_RISCV_CALL:
+	case elfcpp::R_RISCV_CALL_PLT:
+	  {
+	    if (r.offset + 8 > rsec->original_size())
+	      break;
+	    Address pc = rsec->address() + rsec->output_offset_of(r.offset);
+	    int64_t foff = pcrel_offset(value, pc);
+
+	    // If the call crosses output sections, alignment padding
+	    // between them could still make the offset grow.
+	    if (Riscv_insn::valid_ujtype_imm(foff) && sym_os != this_os)
+	      foff += foff < 0 ? -max_alignment : max_alignment;
+
+	    bool near_zero = (value + 0x800) < 0x1000;
+	    if (!Riscv_insn::valid_ujtype_imm(foff) && (pic || !near_zero))
+	      break;
+
+	    unsigned char* pinsn = contents + r.offset;
+	    unsigned int rd = ((Insn_writer::template get<32>(pinsn + 4)
+				>> Riscv_insn::RD_SHIFT) & 0x1f);
+	    Address len = 4;
+	    // C.J is available everywhere; C.JAL only on RV32.
+	    if (rvc
+		&& Riscv_insn::valid_rvc_j_imm(foff)
+		&& (rd == Riscv_insn::X_ZERO
+		    || (size == 32 && rd == Riscv_insn::X_RA)))
+	      {
+		// Relax to C.J[AL] rd, addr.
+		Insn_writer::template put<16>(pinsn,
+					      (rd == Riscv_insn::X_ZERO
+					       ? Riscv_insn::MATCH_C_J
+					       : Riscv_insn::MATCH_C_JAL));
+		r.r_type = elfcpp::R_RISCV_RVC_JUMP;
+		len = 2;
+	      }
+	    else if (Riscv_insn::valid_ujtype_imm(foff))
+	      {
+		// Relax to JAL rd, addr.
+		Insn_writer::template put<32>(pinsn,
+					      (Riscv_insn::MATCH_JAL
+					       | (rd << Riscv_insn::RD_SHIFT)));
+		r.r_type = elfcpp::R_RISCV_JAL;
+	      }
+	    else
+	      {
+		// Relax to JALR rd, x0, addr.
+		Insn_writer::template put<32>(pinsn,
+					      (Riscv_insn::MATCH_JALR
+					       | (rd << Riscv_insn::RD_SHIFT)));
+		r.r_type = elfcpp::R_RISCV_LO12_I;
+	      }
+	    rsec->delete_bytes(r.offset + len, 8 - len);
+	    changed = true;
+	  }
+	  break;
+
+	case elfcpp::R_RISCV_HI20:
+	case elfcpp::R_RISCV_LO12_I:
+	case elfcpp::R_RISCV_LO12_S:
+	  {
+	    // Code might later move out of range.
+	    if (pic || in_code)
+	      break;
+	    if (gp_reachable)
+	      {
+		if (r.r_type == elfcpp::R_RISCV_LO12_I)
+		  r.r_type = elfcpp::R_RISCV_GPREL_I;
+		else if (r.r_type == elfcpp::R_RISCV_LO12_S)
+		  r.r_type = elfcpp::R_RISCV_GPREL_S;
+		else
+		  {
+		    // The LUI is no longer needed.
+		    if (r.offset + 4 > rsec->original_size())
+		      break;
+		    r.r_type = elfcpp::R_RISCV_NONE;
+		    rsec->delete_bytes(r.offset, 4);
+		    changed = true;
+		  }
+		break;
+	      }
+
+	    // Can the LUI be a C.LUI?  Alignment might move the section
+	    // forward; allow for a page at worst.
+	    if (r.r_type != elfcpp::R_RISCV_HI20
+		|| !rvc
+		|| r.offset + 4 > rsec->original_size()
+		|| !Riscv_insn::valid_rvc_lui_imm(
+		       Riscv_insn::const_high_part(value))
+		|| !Riscv_insn::valid_rvc_lui_imm(
+		       Riscv_insn::const_high_part(
+			   value + this->common_pagesize())))
+	      break;
+	    unsigned char* pinsn = contents + r.offset;
+	    Riscv_insn::Insntype lui = Insn_writer::template get<32>(pinsn);
+	    unsigned int rd = (lui >> Riscv_insn::RD_SHIFT) & 0x1f;
+	    if (rd == Riscv_insn::X_ZERO || rd == Riscv_insn::X_SP)
+	      break;
+	    Insn_writer::template put<16>(pinsn,
+					  ((lui & Riscv_insn::RD_MASK)
+					   | Riscv_insn::MATCH_C_LUI));
+	    r.r_type = elfcpp::R_RISCV_RVC_LUI;
+	    rsec->delete_bytes(r.offset + 2, 2);
+	    changed = true;
+	  }
+	  break;
+
+	case elfcpp::R_RISCV_PCREL_HI20:
+	  {
+	    // Turn the AUIPC and the instructions that use it into
+	    // accesses relative to x0 or gp.  Every %pcrel_lo that goes
+	    // with the AUIPC must be converted, or none.
+	    if (pic
+		|| in_code
+		|| !gp_reachable
+		|| r.offset + 4 > rsec->original_size())
+	      break;
+	    const typename The_riscv_input_section::Lo_indexes* lo =
+	      rsec->lo_relocs(i);
+	    if (lo == NULL)
+	      break;
+	    bool all_relaxable = true;
+	    for (size_t k = 0; k < lo->size() && all_relaxable; ++k)
+	      {
+		size_t j = (*lo)[k];
+		all_relaxable = ((relocs[j].r_type
+				  == elfcpp::R_RISCV_PCREL_LO12_I
+				  || relocs[j].r_type
+				  == elfcpp::R_RISCV_PCREL_LO12_S)
+				 && j + 1 < relocs.size()
+				 && (relocs[j + 1].r_type
+				     == elfcpp::R_RISCV_RELAX)
+				 && relocs[j + 1].offset == relocs[j].offset);
+	      }
+	    if (!all_relaxable)
+	      break;
+	    for (size_t k = 0; k < lo->size(); ++k)
+	      {
+		size_t j = (*lo)[k];
+		relocs[j].r_type = (relocs[j].r_type
+				    == elfcpp::R_RISCV_PCREL_LO12_I
+				    ? elfcpp::R_RISCV_GPREL_I
+				    : elfcpp::R_RISCV_GPREL_S);
+	      }
+	    r.r_type = elfcpp::R_RISCV_NONE;
+	    rsec->delete_bytes(r.offset, 4);
+	    changed = true;
+	  }
+	  break;
+
+	case elfcpp::R_RISCV_TPREL_HI20:
+	case elfcpp::R_RISCV_TPREL_LO12_I:
+	case elfcpp::R_RISCV_TPREL_LO12_S:
+	case elfcpp::R_RISCV_TPREL_ADD:
+	  // The thread pointer alone reaches the symbol; VALUE is its
+	  // offset from the thread pointer.
+	  if (Riscv_insn::const_high_part(value) != 0)
+	    break;
+	  if (r.r_type == elfcpp::R_RISCV_TPREL_LO12_I)
+	    r.r_type = elfcpp::R_RISCV_TPREL_I;
+	  else if (r.r_type == elfcpp::R_RISCV_TPREL_LO12_S)
+	    r.r_type = elfcpp::R_RISCV_TPREL_S;
+	  else if (r.offset + 4 <= rsec->original_size())
+	    {
+	      // The LUI or ADD is no longer needed.
+	      r.r_type = elfcpp::R_RISCV_NONE;
+	      rsec->delete_bytes(r.offset, 4);
+	      changed = true;
+	    }
+	  break;
+
+	default:
+	  gold_unreachable();
+	}
+    }
+
+  return changed;
+}
+
+// Delete the alignment padding that is no longer needed.  The
+// assembler emits enough NOPs for the worst case and marks them with
+// an R_RISCV_ALIGN whose addend is their size.
+
+template<int size, bool big_endian>
+bool
+Target_riscv<size, big_endian>::relax_section_alignment(
+    The_riscv_input_section* rsec)
+{
+  typedef Riscv_relocate_functions<big_endian> Insn_writer;
+  typedef typename The_riscv_input_section::Reloc Reloc;
+
+  typename The_riscv_input_section::Relocs& relocs(rsec->relocs());
+  unsigned char* contents = rsec->contents();
+  bool changed = false;
+
+  for (size_t i = 0; i < relocs.size(); ++i)
+    {
+      Reloc& r(relocs[i]);
+      if (r.r_type != elfcpp::R_RISCV_ALIGN || r.addend <= 0)
+	continue;
+      Address padding = r.addend;
+      if (r.offset + padding > rsec->original_size())
+	continue;
+
+      // The alignment is the smallest power of two greater than the
+      // padding.
+      Address alignment = 1;
+      while (alignment <= padding)
+	alignment *= 2;
+
+      Address pc = rsec->address() + rsec->output_offset_of(r.offset);
+      Address aligned_address = ((pc - 1) & ~(alignment - 1)) + alignment;
+      Address nop_bytes = aligned_address - pc;
+
+      // Make sure there are enough NOPs to actually achieve the alignment.
+      if (padding < nop_bytes)
+	{
+	  gold_error(_("%s: %d bytes required for alignment to %d-byte "
+		       "boundary, but only %d present"),
+		     rsec->relobj()->name().c_str(),
+		     static_cast<int>(nop_bytes),
+		     static_cast<int>(alignment),
+		     static_cast<int>(padding));
+	  continue;
+	}
+
+      // Keep as many NOPs as are needed, and delete the rest.
+      Address pos;
+      for (pos = 0; pos + 4 <= nop_bytes; pos += 4)
+	Insn_writer::template put<32>(contents + r.offset + pos,
+				      Riscv_insn::NOP);
+      if (pos < nop_bytes)
+	Insn_writer::template put<16>(contents + r.offset + pos,
+				      Riscv_insn::C_NOP);
+      if (nop_bytes < padding)
+	{
+	  rsec->delete_bytes(r.offset + nop_bytes, padding - nop_bytes);
+	  changed = true;
+	}
+    }
+
+  return changed;
+}
+
+// Relaxation changes where symbols end, so recompute the sizes of the
+// global symbols defined in relaxed sections.
+
+template<int size, bool big_endian>
+void
+Target_riscv<size, big_endian>::adjust_symbol_sizes(Symbol_table* symtab)
+{
+  typedef std::vector<Relobj*> Relobj_list;
+
+  Relobj_list relobjs;
+  for (typename std::vector<The_riscv_input_section*>::const_iterator p =
+	 this->relaxed_sections_.begin();
+       p != this->relaxed_sections_.end();
+       ++p)
+    relobjs.push_back((*p)->relobj());
+  std::sort(relobjs.begin(), relobjs.end());
+  relobjs.erase(std::unique(relobjs.begin(), relobjs.end()), relobjs.end());
+
+  for (Relobj_list::const_iterator p = relobjs.begin();
+       p != relobjs.end();
+       ++p)
+    {
+      const Object::Symbols* syms = (*p)->get_global_symbols();
+      if (syms == NULL)
+	continue;
+      for (Object::Symbols::const_iterator q = syms->begin();
+	   q != syms->end();
+	   ++q)
+	{
+	  Symbol* gsym = *q;
+	  if (gsym == NULL)
+	    continue;
+	  if (gsym->is_forwarder())
+	    gsym = symtab->resolve_forwards(gsym);
+	  bool is_ordinary;
+	  unsigned int shndx = gsym->shndx(&is_ordinary);
+	  if (gsym->source() != Symbol::FROM_OBJECT
+	      || gsym->object() != *p
+	      || !is_ordinary)
+	    continue;
+	  The_riscv_input_section* rsec =
+	    this->find_riscv_input_section(*p, shndx);
+	  if (rsec == NULL)
+	    continue;
+	  Sized_symbol<size>* sym = symtab->get_sized_symbol<size>(gsym);
+	  Address start = sym->value();
+	  Address end = start + sym->symsize();
+	  if (sym->symsize() == 0 || end > rsec->original_size())
+	    continue;
+	  sym->set_symsize(rsec->output_offset_of(end)
+			   - rsec->output_offset_of(start));
+	}
+    }
+}
+
+// Relaxation hook.  Code sequences shrink in passes until nothing
+// changes; then the alignment padding is trimmed to what the final
+// addresses need.
+
+template<int size, bool big_endian>
+bool
+Target_riscv<size, big_endian>::do_relax(
+    int,
+    const Input_objects* input_objects,
+    Symbol_table* symtab,
+    Layout* layout,
+    const Task* task)
+{
+  gold_assert(!parameters->options().relocatable());
+
+  if (this->relax_state_ == RELAX_DONE)
+    return false;
+
+  if (this->relax_state_ == RELAX_INIT)
+    {
+      // Find the sections to relax, grouped by output section.
+      typedef std::map<Output_section*,
+		       std::vector<Output_relaxed_input_section*> >
+	Section_groups;
+      Section_groups groups;
+      for (Input_objects::Relobj_iterator op = input_objects->relobj_begin();
+	   op != input_objects->relobj_end();
+	   ++op)
+	{
+	  if ((*op)->just_symbols())
+	    continue;
+	  The_riscv_relobj* riscv_relobj = static_cast<The_riscv_relobj*>(*op);
+	  // Lock the object so we can read from it.  This is only called
+	  // single-threaded from Layout::finalize, so it is OK to lock.
+	  Task_lock_obj<Object> tl(task, riscv_relobj);
+	  std::vector<The_riscv_input_section*> new_sections;
+	  riscv_relobj->scan_sections_for_relaxation(this, symtab,
+						     &new_sections);
+	  for (size_t i = 0; i < new_sections.size(); ++i)
+	    {
+	      unsigned int shndx = new_sections[i]->shndx();
+	      groups[riscv_relobj->output_section(shndx)].push_back(
+		  new_sections[i]);
+	    }
+	}
+
+      for (typename Section_groups::const_iterator p = groups.begin();
+	   p != groups.end();
+	   ++p)
+	p->first->convert_input_sections_to_relaxed_sections(p->second);
+      for (size_t i = 0; i < this->relaxed_sections_.size(); ++i)
+	{
+	  The_riscv_input_section* rsec = this->relaxed_sections_[i];
+	  static_cast<The_riscv_relobj*>(rsec->relobj())->
+	    convert_input_section_to_relaxed_section(rsec->shndx());
+	}
+
+      if (this->relaxed_sections_.empty())
+	{
+	  this->relax_state_ = RELAX_DONE;
+	  return false;
+	}
+
+      // Code is not shrunk for --no-relax, nor for --emit-relocs,
+      // whose output relocations must still describe the code; the
+      // alignment padding must be trimmed regardless.
+      if ((parameters->options().user_set_relax()
+	   && !parameters->options().relax())
+	  || parameters->options().emit_relocs())
+	this->relax_state_ = RELAX_ALIGN;
+      else
+	this->relax_state_ = RELAX_SHRINK;
+    }
+
+  std::vector<The_riscv_input_section*> changed_sections;
+  if (this->relax_state_ == RELAX_SHRINK)
+    {
+      Address gp = this->global_pointer_value(symtab, false);
+      Address max_alignment = 0;
+      const Layout::Section_list& sections(layout->section_list());
+      for (Layout::Section_list::const_iterator p = sections.begin();
+	   p != sections.end();
+	   ++p)
+	if (((*p)->flags() & elfcpp::SHF_ALLOC) != 0)
+	  max_alignment = std::max(max_alignment,
+				   static_cast<Address>((*p)->addralign()));
+
+      for (size_t i = 0; i < this->relaxed_sections_.size(); ++i)
+	if (this->relax_section(symtab, this->relaxed_sections_[i], gp,
+				max_alignment))
+	  changed_sections.push_back(this->relaxed_sections_[i]);
+
+      // Once nothing shrinks, the addresses are final but for the
+      // alignment padding.
+      if (changed_sections.empty())
+	this->relax_state_ = RELAX_ALIGN;
+    }
+
+  if (this->relax_state_ == RELAX_ALIGN)
+    {
+      for (size_t i = 0; i < this->relaxed_sections_.size(); ++i)
+	if (this->relax_section_alignment(this->relaxed_sections_[i]))
+	  changed_sections.push_back(this->relaxed_sections_[i]);
+      this->adjust_symbol_sizes(symtab);
+      this->relax_state_ = RELAX_DONE;
+    }
+
+  // Resize the sections that changed, and have the input sections
+  // after them moved up.
+  for (size_t i = 0; i < changed_sections.size(); ++i)
+    {
+      The_riscv_input_section* rsec = changed_sections[i];
+      uint64_t address = rsec->address();
+      off_t offset = rsec->offset();
+      rsec->reset_address_and_file_offset();
+      rsec->set_address_and_file_offset(address, offset);
+      rsec->relobj()->output_section(rsec->shndx())->
+	set_section_offsets_need_adjustment();
+    }
+
+  return !changed_sections.empty();
+}
+
+// The selector for riscv object files.
+
+template<int size, bool big_endian>
+class Target_selector_riscv : public Target_selector
+{
+ public:
+  Target_selector_riscv()
+    : Target_selector(elfcpp::EM_RISCV, size, big_endian,
+		      (size == 64 ? "elf64-littleriscv" : "elf32-littleriscv"),
+		      (size == 64 ? "elf64lriscv" : "elf32lriscv"))
+  { }
+
+  virtual Target*
+  do_instantiate_target()
+  { return new Target_riscv<size, big_endian>(); }
+};
+
+Target_selector_riscv<32, false> target_selector_riscv32;
+Target_selector_riscv<64, false> target_selector_riscv64;
+
+} // End anonymous namespace.
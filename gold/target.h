@@ -264,6 +264,13 @@ class Target
   is_local_label_name(const char* name) const
   { return this->do_is_local_label_name(name); }
 
+  // Return whether local labels should be discarded from the output
+  // symbol table when neither --discard-locals nor --discard-none is
+  // given.  This matches targets whose GNU ld emulation does the same.
+  bool
+  discard_local_labels_by_default() const
+  { return this->do_discard_local_labels_by_default(); }
+
   // Get the symbol index to use for a target specific reloc.
   unsigned int
   reloc_symbol_index(void* arg, unsigned int type) const
@@ -612,6 +619,11 @@ class Target
   virtual bool
   do_is_local_label_name(const char*) const;
 
+  // Virtual function which may be overridden by the child class.
+  virtual bool
+  do_discard_local_labels_by_default() const
+  { return false; }
+
   // Virtual function that must be overridden by a target which uses
   // target specific relocations.
   virtual unsigned int
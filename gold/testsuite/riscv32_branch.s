@@ -0,0 +1,25 @@
+	.text
+	.globl	back
+back:
+	ret
+
+	# Each loop ends with a backward branch and a backward jump,
+	# first without and then with compressed instructions.
+	.globl	_start
+_start:
+	.option	push
+	.option	norvc
+loop:
+	addi	a0, a0, -1
+	bnez	a0, loop
+	j	loop
+	.option	pop
+rvc_loop:
+	addi	a0, a0, -1
+	bnez	a0, rvc_loop
+	j	rvc_loop
+
+	# The backward call is relaxed to C.JAL.
+call_back:
+	call	back
+	ret
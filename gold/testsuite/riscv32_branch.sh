@@ -0,0 +1,60 @@
+#!/bin/sh
+
+# riscv32_branch.sh -- test backward branches and calls on RV32
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# Check that line LINE after label LBL in FILE matches PATTERN.
+
+check()
+{
+    file=$1
+    lbl=$2
+    line=$3
+    pattern=$4
+
+    found=`grep "<$lbl>:" $file`
+    if test -z "$found"; then
+	echo "Label $lbl not found."
+	exit 1
+    fi
+
+    match_pattern=`grep "<$lbl>:" -A$line $file | tail -n 1 | grep -e "$pattern"`
+    if test -z "$match_pattern"; then
+	echo "Expected pattern not found in line $line after label $lbl:"
+	echo "    $pattern"
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# The backward branches and jumps reach their targets, and the
+# backward call becomes a C.JAL.
+
+check riscv32_branch.stdout "_start" 2 "bnez[[:space:]]*a0,.*<_start>"
+check riscv32_branch.stdout "_start" 3 "j[[:space:]].*<_start>"
+check riscv32_branch.stdout "rvc_loop" 2 "bnez[[:space:]]*a0,.*<rvc_loop>"
+check riscv32_branch.stdout "rvc_loop" 3 "j[[:space:]].*<rvc_loop>"
+check riscv32_branch.stdout "call_back" 1 ":[[:space:]]*[0-9a-f]\{4\}[[:space:]]*jal[[:space:]].*<back>"
+check riscv32_branch.stdout "call_back" 2 "ret"
+
+exit 0
@@ -0,0 +1,28 @@
+	.text
+	.globl	f
+	.type	f, @function
+f:
+	call	g
+	call	ext
+	.globl	var_ref
+var_ref:
+	la	a0, var
+	.globl	local_ref
+local_ref:
+	lla	a1, local
+	lw	a1, 0(a1)
+	ret
+
+	.globl	g
+	.type	g, @function
+g:
+	ret
+
+	.data
+	.globl	var
+	.type	var, @object
+var:
+	.word	1
+local:
+	.word	2
+	.dc.a	var
@@ -0,0 +1,88 @@
+#!/bin/sh
+
+# riscv_pic.sh -- test a RISC-V shared library
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# Check that line LINE after label LBL in FILE matches PATTERN.
+
+check()
+{
+    file=$1
+    lbl=$2
+    line=$3
+    pattern=$4
+
+    found=`grep "<$lbl>:" $file`
+    if test -z "$found"; then
+	echo "Label $lbl not found."
+	exit 1
+    fi
+
+    match_pattern=`grep "<$lbl>:" -A$line $file | tail -n 1 | grep -e "$pattern"`
+    if test -z "$match_pattern"; then
+	echo "Expected pattern not found in line $line after label $lbl:"
+	echo "    $pattern"
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# Check that FILE has a line matching PATTERN.
+
+check_sym()
+{
+    file=$1
+    pattern=$2
+
+    found=`grep -e "$pattern" $file`
+    if test -z "$found"; then
+	echo "Pattern \"$pattern\" not found in file $file."
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# Calls to the global functions go through the PLT, relaxed to jal.
+# The address of var is loaded from the GOT and the address of local
+# is PC-relative.  The GOT entry and the data word that hold the address
+# of var get dynamic relocs, and the PLT entries get JUMP_SLOT relocs.
+
+check riscv_pic.stdout "f" 1 "jal.*<g@plt>"
+check riscv_pic.stdout "f" 2 "jal.*<ext@plt>"
+check riscv_pic.stdout "var_ref" 1 "auipc[[:space:]]*a0,"
+check riscv_pic.stdout "var_ref" 2 "l[wd][[:space:]]*a0,"
+check riscv_pic.stdout "local_ref" 1 "auipc[[:space:]]*a1,"
+check riscv_pic.stdout "local_ref" 2 "addi[[:space:]]*a1,a1,.*<local>"
+
+check_sym riscv_pic_relocs.stdout "R_RISCV_JUMP_SLOT .* g + 0$"
+check_sym riscv_pic_relocs.stdout "R_RISCV_JUMP_SLOT .* ext + 0$"
+check_sym riscv_pic_relocs.stdout "R_RISCV_\(32\|64\) .* var + 0$"
+if test `grep -c "R_RISCV_\(32\|64\) .* var + 0$" riscv_pic_relocs.stdout` != 2; then
+    echo "Expected two dynamic relocs against var."
+    cat riscv_pic_relocs.stdout
+    exit 1
+fi
+
+exit 0
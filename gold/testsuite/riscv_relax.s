@@ -0,0 +1,29 @@
+	.text
+	.globl	_start
+_start:
+	call	near
+	lui	a0, %hi(small)
+	addi	a0, a0, %lo(small)
+	# %pcrel_lo refers to a local label at its %pcrel_hi.
+pcrel_ref:
+	auipc	a1, %pcrel_hi(small)
+	lw	a1, %pcrel_lo(pcrel_ref)(a1)
+	tail	near
+	# The assembler names the auipc of lla with a .L0 label.
+	lla	a2, small
+
+	.balign	16
+	.globl	aligned
+aligned:
+	ret
+
+	.globl	near
+near:
+	ret
+
+	# Keep small out of the alignment slack at the edge of gp's reach.
+	.section .sdata, "aw", @progbits
+	.zero	64
+	.globl	small
+small:
+	.word	1
@@ -0,0 +1,110 @@
+#!/bin/sh
+
+# riscv_relax.sh -- test RISC-V linker relaxation
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# Check that line LINE after label LBL in FILE matches PATTERN.
+
+check()
+{
+    file=$1
+    lbl=$2
+    line=$3
+    pattern=$4
+
+    found=`grep "<$lbl>:" $file`
+    if test -z "$found"; then
+	echo "Label $lbl not found."
+	exit 1
+    fi
+
+    match_pattern=`grep "<$lbl>:" -A$line $file | tail -n 1 | grep -e "$pattern"`
+    if test -z "$match_pattern"; then
+	echo "Expected pattern not found in line $line after label $lbl:"
+	echo "    $pattern"
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# Check that FILE has a line matching PATTERN.
+
+check_sym()
+{
+    file=$1
+    pattern=$2
+
+    found=`grep -e "$pattern" $file`
+    if test -z "$found"; then
+	echo "Pattern \"$pattern\" not found in file $file."
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# Check that FILE has no line matching PATTERN.
+
+check_no_sym()
+{
+    file=$1
+    pattern=$2
+
+    found=`grep -e "$pattern" $file`
+    if test -n "$found"; then
+	echo "Pattern \"$pattern\" unexpectedly found in file $file."
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# The call and the tail call become jumps to near, and both
+# references to small become gp-relative.  The padding before aligned
+# is trimmed to what the relaxed code needs, so that aligned stays
+# aligned and near follows it directly.
+
+check riscv_relax.stdout "_start" 1 "jal.*<near>"
+check riscv_relax.stdout "_start" 2 "addi[[:space:]]*a0,gp,.*<small>"
+check riscv_relax.stdout "pcrel_ref" 1 "lw[[:space:]]*a1,.*(gp).*<small>"
+check riscv_relax.stdout "pcrel_ref" 2 "j[[:space:]].*<near>"
+check riscv_relax.stdout "near" 1 "ret"
+
+check_sym riscv_relax_syms.stdout "^[0-9a-f]*0 T aligned$"
+
+# As with GNU ld, .L local labels are discarded by default.
+
+check_sym riscv_relax_syms.stdout " t pcrel_ref$"
+check_no_sym riscv_relax_syms.stdout " \.L"
+
+# With --no-relax, the call and the tail call keep their auipc and
+# jalr pairs.
+
+check riscv_no_relax.stdout "_start" 1 "auipc[[:space:]]*ra,"
+check riscv_no_relax.stdout "_start" 2 "jalr.*<near>"
+check riscv_no_relax.stdout "pcrel_ref" 3 "auipc[[:space:]]*t1,"
+check riscv_no_relax.stdout "pcrel_ref" 4 "jr.*<near>"
+
+exit 0
@@ -0,0 +1,30 @@
+	.text
+	.globl	_start
+_start:
+	lui	a0, %tprel_hi(le)
+	add	a0, a0, tp, %tprel_add(le)
+	lw	a0, %tprel_lo(le)(a0)
+	.globl	le_far_ref
+le_far_ref:
+	lui	a1, %tprel_hi(le_far)
+	add	a1, a1, tp, %tprel_add(le_far)
+	lw	a1, %tprel_lo(le_far)(a1)
+	.globl	ie_ref
+ie_ref:
+	la.tls.ie a2, ie
+	add	a2, a2, tp
+	ret
+
+	.section .tdata, "awT", @progbits
+	.globl	le
+le:
+	.word	1
+	.globl	ie
+ie:
+	.word	2
+
+	.section .tbss, "awT", @nobits
+	.zero	0x1000
+	.globl	le_far
+le_far:
+	.zero	4
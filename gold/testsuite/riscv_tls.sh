@@ -0,0 +1,83 @@
+#!/bin/sh
+
+# riscv_tls.sh -- test RISC-V TLS relocations and relaxation
+
+# Copyright (C) 2026 Free Software Foundation, Inc.
+
+# This file is part of gold.
+
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+# MA 02110-1301, USA.
+
+# Check that line LINE after label LBL in FILE matches PATTERN.
+
+check()
+{
+    file=$1
+    lbl=$2
+    line=$3
+    pattern=$4
+
+    found=`grep "<$lbl>:" $file`
+    if test -z "$found"; then
+	echo "Label $lbl not found."
+	exit 1
+    fi
+
+    match_pattern=`grep "<$lbl>:" -A$line $file | tail -n 1 | grep -e "$pattern"`
+    if test -z "$match_pattern"; then
+	echo "Expected pattern not found in line $line after label $lbl:"
+	echo "    $pattern"
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# Check that FILE has a line matching PATTERN.
+
+check_sym()
+{
+    file=$1
+    pattern=$2
+
+    found=`grep -e "$pattern" $file`
+    if test -z "$found"; then
+	echo "Pattern \"$pattern\" not found in file $file."
+	echo ""
+	echo "Actual output below:"
+	cat "$file"
+	exit 1
+    fi
+}
+
+# The local-exec access to le is within reach of tp, so the lui and
+# add are deleted and the load is tp-relative.  le_far is not, so its
+# sequence is kept.  The initial-exec access loads the offset of ie
+# from the GOT.
+
+check riscv_tls.stdout "_start" 1 "lw[[:space:]]*a0,0(tp).*<le>"
+check riscv_tls.stdout "le_far_ref" 1 "lui[[:space:]]*a1,0x1$"
+check riscv_tls.stdout "le_far_ref" 2 "add[[:space:]]*a1,a1,tp"
+check riscv_tls.stdout "le_far_ref" 3 "lw[[:space:]]*a1,8(a1).*<le_far>"
+check riscv_tls.stdout "ie_ref" 1 "auipc[[:space:]]*a2,"
+check riscv_tls.stdout "ie_ref" 2 "l[wd][[:space:]]*a2,.*<_GLOBAL_OFFSET_TABLE_+0x[48]>"
+
+check_sym riscv_tls_syms.stdout "^0* D le$"
+check_sym riscv_tls_syms.stdout "^0*4 D ie$"
+check_sym riscv_tls_syms.stdout "^0*1008 B le_far$"
+
+exit 0
@@ -42,6 +42,14 @@ enum bfd_link_discard
   discard_all		/* Discard all locals.  */
 };
 
+/* Which identical code sections to fold into one during a link.  */
+enum bfd_link_icf
+{
+  icf_none,		/* Don't fold any sections.  */
+  icf_safe,		/* Fold sections whose address is not taken.  */
+  icf_all		/* Fold all identical code sections.  */
+};
+
 /* Whether to generate ELF common symbols with the STT_COMMON type
    during a relocatable link.  */
 enum bfd_link_elf_stt_common
@@ -357,6 +365,9 @@ struct bfd_link_info
   /* Whether to generate ELF common symbols with the STT_COMMON type.  */
   ENUM_BITFIELD (bfd_link_elf_stt_common) elf_stt_common : 2;
 
+  /* Which identical code sections to fold.  */
+  ENUM_BITFIELD (bfd_link_icf) icf : 2;
+
   /* Criteria for skipping symbols when determining
      whether to include an object from an archive. */
   ENUM_BITFIELD (bfd_link_common_skip_ar_symbols) common_skip_ar_symbols : 2;
@@ -458,6 +469,9 @@ struct bfd_link_info
   /* TRUE if user should be informed of removed unreferenced sections.  */
   unsigned int print_gc_sections: 1;
 
+  /* TRUE if user should be informed of identical sections folded.  */
+  unsigned int print_icf_sections: 1;
+
   /* TRUE if we should warn alternate ELF machine code.  */
   unsigned int warn_alternate_em: 1;
 
@@ -241,6 +241,7 @@ static const char * const riscv_pred_succ[16] =
 #define X_T0 5
 #define X_T1 6
 #define X_T2 7
+#define X_A0 10
 #define X_T3 28
 
 #define NGPR 32
@@ -343,4 +344,33 @@ extern const char * const riscv_vpr_names_numeric[NVPR];
 
 extern const struct riscv_opcode riscv_opcodes[];
 
+/* Mnemonics and register names are looked up through the perfect hash
+   tables that riscv-gen writes to opcodes/riscv-hash.h.  A name of LEN
+   characters selects bucket RISCV_NAME_HASH & (BUCKETS - 1); the bucket's
+   displacement then picks the one slot that can hold the name.  These
+   must stay in step with the generator.  */
+
+#define RISCV_HASH_EMPTY 0xffff
+
+static inline uint32_t
+riscv_name_hash (const char *s, size_t len)
+{
+  uint32_t h = 2166136261u;
+
+  while (len-- > 0)
+    h = (h ^ (unsigned char) *s++) * 16777619u;
+  return h;
+}
+
+static inline uint32_t
+riscv_name_slot (uint32_t hash, unsigned int disp, uint32_t slot_mask)
+{
+  uint32_t x = hash ^ (disp * 0x9e3779b1u);
+
+  x ^= x >> 15;
+  x *= 0x2c1b3c6du;
+  x ^= x >> 12;
+  return x & slot_mask;
+}
+
 #endif /* _RISCV_H_ */
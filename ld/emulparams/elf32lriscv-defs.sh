@@ -2,6 +2,8 @@
 SCRIPT_NAME=elf
 ARCH=riscv
 NO_REL_RELOCS=yes
+OTHER_PLT_RELOC_SECTIONS="
+  .relr.dyn     ${RELOCATING-0} : { *(.relr.dyn) }"
 
 TEMPLATE_NAME=elf32
 EXTRA_EM_FILE=riscvelf
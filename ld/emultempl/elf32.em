@@ -1697,6 +1697,10 @@ gld${EMULATION_NAME}_before_allocation (void)
     {
       _bfd_elf_tls_setup (link_info.output_bfd, &link_info);
 
+      if (link_info.icf != icf_none
+	  && !bfd_elf_icf_sections (link_info.output_bfd, &link_info))
+	einfo (_("%P%F: identical code folding failed: %E\n"));
+
       /* Make __ehdr_start hidden if it has been referenced, to
 	 prevent the symbol from being dynamic.  */
       if (!bfd_link_relocatable (&link_info))
@@ -25,21 +25,566 @@ fragment <<EOF
 #include "elf/riscv.h"
 #include "elfxx-riscv.h"
 
+/* If TRUE, place the most referenced small data objects first.  */
+static bfd_boolean riscv_sort_sdata = FALSE;
+
+/* The number of relaxable references to each input section, indexed by
+   section id.  Only computed when RISCV_SORT_SDATA is set.  */
+static unsigned int *riscv_sdata_refs;
+static unsigned int riscv_sdata_refs_size;
+
+/* The output sections whose input sections are sorted by reference count.
+   __global_pointer$ is placed 0x800 bytes past the start of .sdata, so gp
+   reaches from the start of .sdata to 4 KiB past it, and .sbss follows
+   .sdata.  In both, the objects placed first are the most likely to be
+   within reach of gp.  Each output section is sorted on its own, so the
+   objects of .sbss are only reached if .sdata is small enough.  */
+static const char *const riscv_sdata_sections[] = { ".sdata", ".sbss" };
+
+/* If TRUE, report what relaxation did on each trip of each pass.  */
+static bfd_boolean riscv_print_relax_stats = FALSE;
+
+/* If TRUE, pack the relative relocs of shared objects and PIEs into
+   .relr.dyn.  */
+static bfd_boolean riscv_pack_relative_relocs = FALSE;
+
+/* Return the largest id of any input section.  */
+
+static unsigned int
+riscv_elf_top_section_id (void)
+{
+  unsigned int top_id = 0;
+
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      asection *sec;
+
+      for (sec = f->the_bfd->sections; sec != NULL; sec = sec->next)
+	if (sec->id > top_id)
+	  top_id = sec->id;
+    }
+
+  return top_id;
+}
+
+/* Count the references to each input section from instructions that
+   relaxation could delete if the target were within reach of gp, ie. the
+   LUI and AUIPC halves of absolute and PC-relative address sequences.  */
+
 static void
-riscv_elf_before_allocation (void)
+riscv_elf_count_sdata_refs (void)
 {
-  gld${EMULATION_NAME}_before_allocation ();
+  riscv_sdata_refs_size = riscv_elf_top_section_id () + 1;
+  riscv_sdata_refs = xcalloc (riscv_sdata_refs_size,
+			      sizeof (*riscv_sdata_refs));
 
-  if (link_info.discard == discard_sec_merge)
-    link_info.discard = discard_l;
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      bfd *abfd = f->the_bfd;
+      Elf_Internal_Shdr *symtab_hdr;
+      asection *sec;
+
+      if (bfd_get_flavour (abfd) != bfd_target_elf_flavour
+	  || bfd_get_arch (abfd) != bfd_arch_riscv
+	  || (abfd->flags & DYNAMIC) != 0)
+	continue;
+
+      symtab_hdr = &elf_symtab_hdr (abfd);
+      for (sec = abfd->sections; sec != NULL; sec = sec->next)
+	{
+	  Elf_Internal_Rela *relocs, *rel, *relend;
+
+	  /* Sections folded by --icf are not written, so their
+	     references do not count.  */
+	  if ((sec->flags & (SEC_CODE | SEC_RELOC)) != (SEC_CODE | SEC_RELOC)
+	      || sec->reloc_count == 0
+	      || sec->output_section == NULL
+	      || discarded_section (sec)
+	      || sec->kept_section != NULL)
+	    continue;
+
+	  relocs = _bfd_elf_link_read_relocs (abfd, sec, NULL, NULL,
+					      link_info.keep_memory);
+	  if (relocs == NULL)
+	    continue;
+
+	  relend = relocs + sec->reloc_count;
+	  for (rel = relocs; rel + 1 < relend; rel++)
+	    {
+	      unsigned int r_type = ELF${ELFSIZE}_R_TYPE (rel->r_info);
+	      unsigned long r_symndx = ELF${ELFSIZE}_R_SYM (rel->r_info);
+	      asection *sym_sec = NULL;
+
+	      /* Only relaxable sequences count.  */
+	      if ((r_type != R_RISCV_HI20
+		   && (r_type != R_RISCV_PCREL_HI20
+		       || bfd_link_pic (&link_info)))
+		  || ELF${ELFSIZE}_R_TYPE (rel[1].r_info) != R_RISCV_RELAX
+		  || rel[1].r_offset != rel->r_offset)
+		continue;
+
+	      if (r_symndx < symtab_hdr->sh_info)
+		{
+		  /* Read the local symbols the same way relaxation does, so
+		     that it can reuse them.  */
+		  if (symtab_hdr->contents == NULL)
+		    symtab_hdr->contents = (unsigned char *)
+		      bfd_elf_get_elf_syms (abfd, symtab_hdr,
+					    symtab_hdr->sh_info,
+					    0, NULL, NULL, NULL);
+		  if (symtab_hdr->contents == NULL)
+		    break;
+		  sym_sec = bfd_section_from_elf_index
+		    (abfd, ((Elf_Internal_Sym *) symtab_hdr->contents
+			    + r_symndx)->st_shndx);
+		}
+	      else
+		{
+		  struct elf_link_hash_entry *h;
+
+		  h = elf_sym_hashes (abfd)[r_symndx - symtab_hdr->sh_info];
+		  while (h->root.type == bfd_link_hash_indirect
+			 || h->root.type == bfd_link_hash_warning)
+		    h = (struct elf_link_hash_entry *) h->root.u.i.link;
+		  if (h->root.type == bfd_link_hash_defined
+		      || h->root.type == bfd_link_hash_defweak)
+		    sym_sec = h->root.u.def.section;
+		}
+
+	      if (sym_sec != NULL && sym_sec->id < riscv_sdata_refs_size)
+		riscv_sdata_refs[sym_sec->id]++;
+	    }
+
+	  if (elf_section_data (sec)->relocs != relocs)
+	    free (relocs);
+	}
+    }
+}
+
+/* An input section statement and its position in a run of wild
+   statements.  */
+
+struct riscv_sdata_entry
+{
+  lang_statement_union_type *stmt;
+  unsigned int refs;
+  unsigned int index;
+};
+
+/* Order input sections by decreasing reference count, and otherwise keep
+   their linker script order.  */
+
+static int
+riscv_sdata_entry_compare (const void *a, const void *b)
+{
+  const struct riscv_sdata_entry *ea = a, *eb = b;
+
+  if (ea->refs != eb->refs)
+    return ea->refs > eb->refs ? -1 : 1;
+  return ea->index < eb->index ? -1 : ea->index > eb->index;
+}
+
+/* Return the reference count of input section statement S.  */
+
+static unsigned int
+riscv_sdata_refs_of (lang_statement_union_type *s)
+{
+  asection *sec = s->input_section.section;
+
+  return sec->id < riscv_sdata_refs_size ? riscv_sdata_refs[sec->id] : 0;
+}
+
+/* Return the number of input sections matched by S if it is a wild
+   statement whose input sections may be reordered, else zero.  Wild
+   statements that the linker script already asks to be sorted are left
+   alone.  */
+
+static unsigned int
+riscv_sdata_sortable (lang_statement_union_type *s)
+{
+  lang_wild_statement_type *w = &s->wild_statement;
+  lang_statement_union_type *c;
+  unsigned int count = 0;
+
+  if (s->header.type != lang_wild_statement_enum
+      || w->filenames_sorted
+      || (w->section_list != NULL
+	  && w->section_list->spec.sorted != none))
+    return 0;
+
+  for (c = w->children.head; c != NULL; c = c->header.next)
+    if (c->header.type != lang_input_section_enum)
+      return 0;
+    else
+      count++;
+
+  return count;
+}
+
+/* Sort the input sections of the output section called NAME by decreasing
+   reference count.  The input sections of each run of wild statements
+   that follow one another, such as the .srodata and .sdata statements of
+   the default scripts, are sorted together and all placed in the first
+   statement of the run, so that a much referenced object matched by a
+   later statement can move ahead of the objects matched by an earlier
+   one.  Assignments and other statements end a run.  The map file lists
+   the sorted input sections under that first statement.  */
+
+static void
+riscv_elf_sort_sdata (const char *name)
+{
+  lang_output_section_statement_type *os = lang_output_section_find (name);
+  lang_statement_union_type *s, *first, *next;
+  lang_wild_statement_type *w;
+  struct riscv_sdata_entry *entries;
+  unsigned int i, count;
+
+  if (os == NULL)
+    return;
+
+  for (s = os->children.head; s != NULL; s = next)
+    {
+      /* Find the run of wild statements starting at S.  Those that match
+	 nothing do not end it.  */
+      first = s;
+      count = 0;
+      for (next = s; next != NULL; next = next->header.next)
+	{
+	  unsigned int n = riscv_sdata_sortable (next);
+
+	  if (n == 0
+	      && (next->header.type != lang_wild_statement_enum
+		  || next->wild_statement.children.head != NULL))
+	    break;
+	  count += n;
+	}
+
+      if (next == first)
+	{
+	  next = first->header.next;
+	  continue;
+	}
+
+      if (count < 2)
+	continue;
+
+      entries = xmalloc (count * sizeof (*entries));
+      i = 0;
+      for (s = first; s != next; s = s->header.next)
+	{
+	  lang_statement_union_type *c;
+
+	  w = &s->wild_statement;
+	  for (c = w->children.head; c != NULL; c = c->header.next, i++)
+	    {
+	      entries[i].stmt = c;
+	      entries[i].refs = riscv_sdata_refs_of (c);
+	      entries[i].index = i;
+	    }
+	  w->children.head = NULL;
+	  w->children.tail = &w->children.head;
+	}
+
+      qsort (entries, count, sizeof (*entries), riscv_sdata_entry_compare);
+
+      w = &first->wild_statement;
+      w->children.head = entries[0].stmt;
+      for (i = 0; i + 1 < count; i++)
+	entries[i].stmt->header.next = entries[i + 1].stmt;
+      entries[count - 1].stmt->header.next = NULL;
+      w->children.tail = &entries[count - 1].stmt->header.next;
+      free (entries);
+    }
+}
+
+/* Report where the sorted small data objects ended up relative to gp, and
+   how many of their relaxable references gp can cover.  */
+
+static void
+riscv_elf_map_sdata (bfd *abfd ATTRIBUTE_UNUSED,
+		     struct bfd_link_info *info,
+		     FILE *mapf)
+{
+  struct bfd_link_hash_entry *h;
+  bfd_vma gp;
+  unsigned long total = 0, covered = 0;
+  unsigned int i;
+
+  if (riscv_sdata_refs == NULL || mapf == NULL)
+    return;
+
+  h = bfd_link_hash_lookup (info->hash, RISCV_GP_SYMBOL, FALSE, FALSE, TRUE);
+  if (h == NULL || h->type != bfd_link_hash_defined)
+    return;
+  gp = (h->u.def.value + h->u.def.section->output_section->vma
+	+ h->u.def.section->output_offset);
+
+  fprintf (mapf, _("\nSmall data placement\n\n"));
+  minfo (_("%s = 0x%V\n\n"), RISCV_GP_SYMBOL, gp);
+  fprintf (mapf, _("    Refs  In range  Section\n"));
+
+  for (i = 0; i < ARRAY_SIZE (riscv_sdata_sections); i++)
+    {
+      lang_output_section_statement_type *os
+	= lang_output_section_find (riscv_sdata_sections[i]);
+      lang_statement_union_type *s, *c;
+
+      if (os == NULL)
+	continue;
+
+      for (s = os->children.head; s != NULL; s = s->header.next)
+	if (s->header.type == lang_wild_statement_enum)
+	  for (c = s->wild_statement.children.head; c != NULL;
+	       c = c->header.next)
+	    {
+	      asection *sec;
+	      unsigned int refs;
+	      bfd_vma start, end;
+	      bfd_boolean in_range;
+
+	      if (c->header.type != lang_input_section_enum)
+		continue;
 
-  /* We always need at least some relaxation to handle code alignment.  */
+	      sec = c->input_section.section;
+	      refs = riscv_sdata_refs_of (c);
+	      if (refs == 0 || sec->output_section == NULL)
+		continue;
+
+	      start = sec->output_section->vma + sec->output_offset;
+	      end = start + sec->size;
+	      /* gp-relative accesses have a signed 12-bit offset.  */
+	      in_range = start + 0x800 >= gp && end <= gp + 0x800;
+
+	      total += refs;
+	      if (in_range)
+		covered += refs;
+	      fprintf (mapf, "%8u  %-8s  ", refs, in_range ? _("yes") : _("no"));
+	      minfo ("%A %B\n", sec, sec->owner);
+	    }
+    }
+
+  fprintf (mapf, _("\n%lu of %lu relaxable references are within reach of gp\n"),
+	   covered, total);
+}
+
+/* Print the relaxation statistics collected by the backend to stderr.  */
+
+static void
+riscv_elf_print_relax_stats (void)
+{
+  const struct riscv_relax_stats *stats;
+  unsigned long total[riscv_relax_kind_max];
+  bfd_vma bytes_saved = 0;
+  long time = 0;
+  unsigned int i, count;
+  int kind;
+
+  stats = bfd_elf${ELFSIZE}_riscv_get_relax_stats (&link_info, &count);
+  if (stats == NULL)
+    return;
+
+  memset (total, 0, sizeof (total));
+  fprintf (stderr, _("%s: relaxation statistics:\n"), program_name);
+  fprintf (stderr, _("pass trip  call:jal  rvc  abs island  lui:gp  rvc"
+		     "  pcrel:gp  tprel  align     bytes  sections  changed"
+		     "    time\n"));
+  for (i = 0; i < count; i++)
+    {
+      const struct riscv_relax_stats *s = &stats[i];
+
+      fprintf (stderr, "%4d %4d  %8lu %4lu %4lu %6lu  %6lu %4lu  %8lu %6lu"
+	       " %6lu %9lu %9lu %8lu %4ld.%03ld\n",
+	       s->pass, s->trip,
+	       s->count[riscv_relax_call_jal],
+	       s->count[riscv_relax_call_rvc],
+	       s->count[riscv_relax_call_abs],
+	       s->count[riscv_relax_call_island],
+	       s->count[riscv_relax_lui_gp],
+	       s->count[riscv_relax_lui_rvc],
+	       s->count[riscv_relax_pcrel_gp],
+	       s->count[riscv_relax_tprel],
+	       s->count[riscv_relax_align],
+	       (unsigned long) s->bytes_saved,
+	       s->sections_examined, s->sections_changed,
+	       s->time / 1000000, (s->time % 1000000) / 1000);
+
+      for (kind = 0; kind < riscv_relax_kind_max; kind++)
+	total[kind] += s->count[kind];
+      bytes_saved += s->bytes_saved;
+      time += s->time;
+
+      /* The last trip of a pass is the one that changed nothing.  */
+      if (i + 1 == count || stats[i + 1].pass != s->pass)
+	fprintf (stderr, _("pass %d converged after %d trip(s)\n"),
+		 s->pass, s->trip + 1);
+    }
+
+  fprintf (stderr, _("total      %8lu %4lu %4lu %6lu  %6lu %4lu  %8lu %6lu"
+		     " %6lu %9lu %23ld.%03ld\n"),
+	   total[riscv_relax_call_jal],
+	   total[riscv_relax_call_rvc],
+	   total[riscv_relax_call_abs],
+	   total[riscv_relax_call_island],
+	   total[riscv_relax_lui_gp],
+	   total[riscv_relax_lui_rvc],
+	   total[riscv_relax_pcrel_gp],
+	   total[riscv_relax_tprel],
+	   total[riscv_relax_align],
+	   (unsigned long) bytes_saved,
+	   time / 1000000, (time % 1000000) / 1000);
+}
+
+/* Where riscv_elf_hook_in_island is to insert a call island.  */
+
+struct riscv_hook_island_info
+{
+  lang_statement_list_type add;
+  asection *input_section;
+};
+
+/* Traverse the linker tree to find the spot where the island goes.  */
+
+static bfd_boolean
+riscv_elf_hook_in_island (struct riscv_hook_island_info *info,
+			  lang_statement_union_type **lp)
+{
+  lang_statement_union_type *l;
+  bfd_boolean ret;
+
+  for (; (l = *lp) != NULL; lp = &l->header.next)
+    {
+      switch (l->header.type)
+	{
+	case lang_constructors_statement_enum:
+	  ret = riscv_elf_hook_in_island (info, &constructor_list.head);
+	  if (ret)
+	    return ret;
+	  break;
+
+	case lang_output_section_statement_enum:
+	  ret = riscv_elf_hook_in_island
+	    (info, &l->output_section_statement.children.head);
+	  if (ret)
+	    return ret;
+	  break;
+
+	case lang_wild_statement_enum:
+	  ret = riscv_elf_hook_in_island (info,
+					  &l->wild_statement.children.head);
+	  if (ret)
+	    return ret;
+	  break;
+
+	case lang_group_statement_enum:
+	  ret = riscv_elf_hook_in_island (info,
+					  &l->group_statement.children.head);
+	  if (ret)
+	    return ret;
+	  break;
+
+	case lang_input_section_enum:
+	  if (l->input_section.section == info->input_section)
+	    {
+	      /* We've found our section.  Insert the island immediately
+		 after it.  */
+	      *(info->add.tail) = l->header.next;
+	      l->header.next = info->add.head;
+	      return TRUE;
+	    }
+	  break;
+
+	case lang_data_statement_enum:
+	case lang_reloc_statement_enum:
+	case lang_object_symbols_statement_enum:
+	case lang_output_statement_enum:
+	case lang_target_statement_enum:
+	case lang_input_statement_enum:
+	case lang_assignment_statement_enum:
+	case lang_padding_statement_enum:
+	case lang_address_statement_enum:
+	case lang_fill_statement_enum:
+	  break;
+
+	default:
+	  FAIL ();
+	  break;
+	}
+    }
+  return FALSE;
+}
+
+/* Call-back for bfd_elf${ELFSIZE}_riscv_size_call_islands.  Arrange for
+   ISLAND to be linked immediately after INPUT_SECTION.  */
+
+static bfd_boolean
+riscv_elf_add_call_island (asection *island, asection *input_section)
+{
+  lang_output_section_statement_type *os;
+  struct riscv_hook_island_info info;
+
+  os = lang_output_section_get (input_section->output_section);
+
+  info.input_section = input_section;
+  lang_list_init (&info.add);
+  lang_add_section (&info.add, island, NULL, os);
+
+  if (info.add.head != NULL
+      && riscv_elf_hook_in_island (&info, &os->children.head))
+    return TRUE;
+
+  einfo ("%X%P: can not make call island section: %E\n");
+  return FALSE;
+}
+
+/* Another call-back for bfd_elf${ELFSIZE}_riscv_size_call_islands.  */
+
+static void
+riscv_elf_layout_sections_again (void)
+{
+  lang_do_assignments (lang_assigning_phase_enum);
+  lang_reset_memory_regions ();
+  lang_size_sections (NULL, FALSE);
+}
+
+static void
+riscv_elf_after_open (void)
+{
+  gld${EMULATION_NAME}_after_open ();
+
+  if (riscv_pack_relative_relocs
+      && !bfd_elf${ELFSIZE}_riscv_pack_relative_relocs (&link_info))
+    einfo (_("%F%P: failed to create .relr.dyn: %E\n"));
+}
+
+static void
+riscv_elf_before_allocation (void)
+{
+  /* We always need at least some relaxation to handle code alignment.
+     Decide how much before sizing the dynamic sections, which converts
+     TLS GOT accesses when relaxation is enabled.  */
   if (RELAXATION_DISABLED_BY_USER)
     TARGET_ENABLE_RELAXATION;
   else
     ENABLE_RELAXATION;
 
+  gld${EMULATION_NAME}_before_allocation ();
+
+  if (riscv_sort_sdata && !bfd_link_relocatable (&link_info))
+    {
+      unsigned int i;
+
+      riscv_elf_count_sdata_refs ();
+      for (i = 0; i < ARRAY_SIZE (riscv_sdata_sections); i++)
+	riscv_elf_sort_sdata (riscv_sdata_sections[i]);
+    }
+
+  if (link_info.discard == discard_sec_merge)
+    link_info.discard = discard_l;
+
   link_info.relax_pass = 3;
+
+  if (riscv_print_relax_stats)
+    bfd_elf${ELFSIZE}_riscv_set_relax_stats (&link_info, TRUE);
 }
 
 static void
@@ -59,10 +604,87 @@ gld${EMULATION_NAME}_after_allocation (void)
 	}
     }
 
+  /* Size the call islands before relaxation starts, so that relaxation
+     only ever brings calls closer to their stubs.  */
+  if (!bfd_link_relocatable (&link_info))
+    {
+      if (need_layout)
+	riscv_elf_layout_sections_again ();
+      if (!bfd_elf${ELFSIZE}_riscv_size_call_islands
+	     (&link_info, riscv_elf_add_call_island,
+	      riscv_elf_layout_sections_again))
+	einfo (_("%F%P: failed to size call islands: %E\n"));
+    }
+
   gld${EMULATION_NAME}_map_segments (need_layout);
+
+  if (riscv_pack_relative_relocs && !bfd_link_relocatable (&link_info))
+    {
+      bfd_boolean again;
+
+      do
+	{
+	  if (!bfd_elf${ELFSIZE}_riscv_size_relative_relocs (&link_info,
+							     &again))
+	    einfo (_("%F%P: failed to size .relr.dyn: %E\n"));
+	  if (again)
+	    gld${EMULATION_NAME}_map_segments (TRUE);
+	}
+      while (again);
+    }
+
+  if (riscv_print_relax_stats)
+    riscv_elf_print_relax_stats ();
 }
 
 EOF
 
+# Define some shell vars to insert bits of code into the standard elf
+# parse_args and list_options functions.
+#
+PARSE_AND_LIST_PROLOGUE='
+#define OPTION_SORT_SDATA		301
+#define OPTION_NO_SORT_SDATA		302
+#define OPTION_PRINT_RELAX_STATS	303
+'
+
+PARSE_AND_LIST_LONGOPTS='
+  { "sort-sdata", no_argument, NULL, OPTION_SORT_SDATA},
+  { "no-sort-sdata", no_argument, NULL, OPTION_NO_SORT_SDATA},
+  { "print-relax-stats", no_argument, NULL, OPTION_PRINT_RELAX_STATS},
+'
+
+PARSE_AND_LIST_OPTIONS='
+  fprintf (file, _("  --sort-sdata                Place the small data objects with the most\n"
+		   "                                relaxable references first\n"));
+  fprintf (file, _("  --no-sort-sdata             Keep small data in linker script order [default]\n"));
+  fprintf (file, _("  --print-relax-stats         Print what each relaxation pass did\n"));
+  fprintf (file, _("  -z pack-relative-relocs     Pack relative relocs into .relr.dyn\n"));
+  fprintf (file, _("  -z nopack-relative-relocs   Keep relative relocs in .rela.dyn [default]\n"));
+'
+
+PARSE_AND_LIST_ARGS_CASES='
+    case OPTION_SORT_SDATA:
+      riscv_sort_sdata = TRUE;
+      break;
+
+    case OPTION_NO_SORT_SDATA:
+      riscv_sort_sdata = FALSE;
+      break;
+
+    case OPTION_PRINT_RELAX_STATS:
+      riscv_print_relax_stats = TRUE;
+      break;
+'
+
+PARSE_AND_LIST_ARGS_CASE_Z='
+      else if (strcmp (optarg, "pack-relative-relocs") == 0)
+	riscv_pack_relative_relocs = TRUE;
+      else if (strcmp (optarg, "nopack-relative-relocs") == 0)
+	riscv_pack_relative_relocs = FALSE;
+'
+
+LDEMUL_AFTER_OPEN=riscv_elf_after_open
 LDEMUL_BEFORE_ALLOCATION=riscv_elf_before_allocation
 LDEMUL_AFTER_ALLOCATION=gld${EMULATION_NAME}_after_allocation
+LDEMUL_EXTRA_MAP_FILE_TEXT=riscv_elf_map_sdata
@@ -214,6 +214,11 @@ typedef struct
 
   /* Default linker script.  */
   char *default_script;
+
+  /* Files giving the order of input sections, from the
+     --symbol-ordering-file and --call-graph-ordering-file options.  */
+  char *symbol_ordering_file;
+  char *call_graph_ordering_file;
 } args_type;
 
 extern args_type command_line;
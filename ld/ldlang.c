@@ -4181,6 +4181,18 @@ print_all_symbols (asection *sec)
 
 /* Print information about an input section to the map file.  */
 
+/* Return TRUE if identical code folding has folded section S into
+   another.  */
+
+static bfd_boolean
+folded_section_p (asection *s)
+{
+  return (link_info.icf != icf_none
+	  && s->kept_section != NULL
+	  && s->output_section != NULL
+	  && !discarded_section (s));
+}
+
 static void
 print_input_section (asection *i, bfd_boolean is_discarded)
 {
@@ -4234,6 +4246,24 @@ print_input_section (asection *i, bfd_boolean is_discarded)
       minfo (_("%W (size before relaxing)\n"), i->rawsize);
     }
 
+  if (!is_discarded && folded_section_p (i))
+    {
+      len = SECTION_NAME_MAP_LENGTH + 3;
+#ifdef BFD64
+      len += 16;
+#else
+      len += 8;
+#endif
+      while (len > 0)
+	{
+	  print_space ();
+	  --len;
+	}
+
+      minfo (_("(folded into %A in %B)\n"), i->kept_section,
+	     i->kept_section->owner);
+    }
+
   if (i->output_section != NULL
       && i->output_section->owner == link_info.output_bfd)
     {
@@ -4644,7 +4674,8 @@ size_input_section
   if (i->sec_info_type == SEC_INFO_TYPE_JUST_SYMS)
     i->output_offset = i->vma - o->vma;
   else if (((i->flags & SEC_EXCLUDE) != 0)
-	   || output_section_statement->ignored)
+	   || output_section_statement->ignored
+	   || folded_section_p (i))
     i->output_offset = dot - o->vma;
   else
     {
@@ -5337,7 +5368,7 @@ lang_size_sections_1
 	    asection *i;
 
 	    i = s->input_section.section;
-	    if (relax)
+	    if (relax && !folded_section_p (i))
 	      {
 		bfd_boolean again;
 
@@ -5521,12 +5552,32 @@ ldlang_override_segment_assignment (struct bfd_link_info *info ATTRIBUTE_UNUSED,
   return cur->region != prev->region;
 }
 
+/* Give each section folded by --icf the place of the section it was
+   folded into, so that its symbols resolve there.  */
+
+static void
+lang_place_folded_sections (void)
+{
+  if (link_info.icf == icf_none)
+    return;
+
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      asection *s;
+
+      for (s = f->the_bfd->sections; s != NULL; s = s->next)
+	if (folded_section_p (s))
+	  s->output_offset = s->kept_section->output_offset;
+    }
+}
+
 void
 one_lang_size_sections_pass (bfd_boolean *relax, bfd_boolean check_regions)
 {
   lang_statement_iteration++;
   lang_size_sections_1 (&statement_list.head, abs_output_section,
 			0, 0, relax, check_regions);
+  lang_place_folded_sections ();
 }
 
 void
@@ -5735,7 +5786,7 @@ lang_do_assignments_1 (lang_statement_union_type *s,
 	  {
 	    asection *in = s->input_section.section;
 
-	    if ((in->flags & SEC_EXCLUDE) == 0)
+	    if ((in->flags & SEC_EXCLUDE) == 0 && !folded_section_p (in))
 	      dot += TO_ADDR (in->size);
 	  }
 	  break;
@@ -6963,6 +7014,608 @@ lang_check_relocs (void)
     }
 }
 
+/* Input section ordering, from --symbol-ordering-file and
+   --call-graph-ordering-file.  Each symbol named by those files is given
+   a priority, lowest first.  Every input section takes the smallest
+   priority of the symbols it defines, and each run of input sections in
+   an output section or unsorted wild statement is then stably sorted by
+   it, so that sections defining no named symbol follow the ordered ones
+   in their original order.
+
+   A plain symbol name only matches global and weak definitions, since
+   local symbols of the same name may be defined by many input files.  A
+   name of the form FILE:SYMBOL matches SYMBOL, local or not, in the input
+   file or archive member whose base name is FILE.  */
+
+#define ORDER_NONE ((unsigned int) -1)
+
+struct order_sym_entry
+{
+  struct bfd_hash_entry root;
+  /* Position of the symbol in the requested order.  */
+  unsigned int priority;
+  /* Call graph node number of the symbol.  */
+  unsigned int node;
+  /* TRUE if the symbol is listed in the symbol ordering file.  */
+  bfd_boolean listed;
+  /* TRUE once a definition of the symbol has been seen.  */
+  bfd_boolean found;
+};
+
+/* An edge of the call graph read from the call graph ordering file.  */
+
+struct order_cg_edge
+{
+  unsigned int from;
+  unsigned int to;
+  bfd_vma weight;
+  unsigned int index;
+};
+
+/* A cluster of the call graph, named by its root node.  */
+
+struct order_cg_root
+{
+  unsigned int node;
+  bfd_vma weight;
+};
+
+/* An input section statement being sorted.  */
+
+struct order_stmt
+{
+  lang_statement_union_type *stmt;
+  unsigned int priority;
+  unsigned int index;
+};
+
+static struct bfd_hash_table order_sym_table;
+static unsigned int order_sym_count;
+/* TRUE if some name in ORDER_SYM_TABLE is qualified by a file name.  */
+static bfd_boolean order_sym_qualified;
+static unsigned int *order_section_priority;
+static unsigned int order_section_top_id;
+
+static struct bfd_hash_entry *
+order_sym_newfunc (struct bfd_hash_entry *entry,
+		   struct bfd_hash_table *table,
+		   const char *string)
+{
+  struct order_sym_entry *ret;
+
+  if (entry == NULL)
+    {
+      entry = (struct bfd_hash_entry *) bfd_hash_allocate (table,
+							   sizeof (*ret));
+      if (entry == NULL)
+	return entry;
+    }
+
+  entry = bfd_hash_newfunc (entry, table, string);
+  if (entry == NULL)
+    return entry;
+
+  ret = (struct order_sym_entry *) entry;
+  ret->priority = ORDER_NONE;
+  ret->node = ORDER_NONE;
+  ret->listed = FALSE;
+  ret->found = FALSE;
+  return entry;
+}
+
+static struct order_sym_entry *
+order_sym_lookup (const char *name)
+{
+  struct order_sym_entry *ret;
+
+  ret = (struct order_sym_entry *) bfd_hash_lookup (&order_sym_table, name,
+						    TRUE, TRUE);
+  if (ret == NULL)
+    einfo (_("%P%F: bfd_hash_lookup for insertion failed: %E\n"));
+  if (strchr (name, ':') != NULL)
+    order_sym_qualified = TRUE;
+  return ret;
+}
+
+/* Return the priority of the definition SYM in ABFD: the smaller of the
+   priorities of its FILE:SYMBOL name and, unless it is local, its plain
+   name.  Mark the names found.  BUF, of size *BUFSIZE, is scratch space
+   for the qualified name.  */
+
+static unsigned int
+order_sym_priority (bfd *abfd, asymbol *sym, char **buf, size_t *bufsize)
+{
+  struct order_sym_entry *ent;
+  unsigned int priority = ORDER_NONE;
+
+  if ((sym->flags & (BSF_GLOBAL | BSF_WEAK)) != 0)
+    {
+      ent = (struct order_sym_entry *)
+	bfd_hash_lookup (&order_sym_table, sym->name, FALSE, FALSE);
+      if (ent != NULL && ent->priority != ORDER_NONE)
+	{
+	  ent->found = TRUE;
+	  priority = ent->priority;
+	}
+    }
+
+  if (order_sym_qualified)
+    {
+      const char *file = lbasename (bfd_get_filename (abfd));
+      size_t len = strlen (file) + strlen (sym->name) + 2;
+
+      if (len > *bufsize)
+	{
+	  *bufsize = len;
+	  *buf = (char *) xrealloc (*buf, len);
+	}
+      sprintf (*buf, "%s:%s", file, sym->name);
+      ent = (struct order_sym_entry *)
+	bfd_hash_lookup (&order_sym_table, *buf, FALSE, FALSE);
+      if (ent != NULL && ent->priority != ORDER_NONE)
+	{
+	  ent->found = TRUE;
+	  if (ent->priority < priority)
+	    priority = ent->priority;
+	}
+    }
+
+  return priority;
+}
+
+/* Read the next whitespace separated word of FILE into *BUF, of size
+   *BUFSIZE, growing it as needed.  Return FALSE at the end of FILE.  */
+
+static bfd_boolean
+order_read_word (FILE *file, char **buf, size_t *bufsize)
+{
+  size_t len = 0;
+  int c;
+
+  do
+    c = getc (file);
+  while (ISSPACE (c));
+
+  if (c == EOF)
+    return FALSE;
+
+  while (!ISSPACE (c) && c != EOF)
+    {
+      (*buf)[len++] = c;
+      if (len >= *bufsize)
+	{
+	  *bufsize *= 2;
+	  *buf = (char *) xrealloc (*buf, *bufsize);
+	}
+      c = getc (file);
+    }
+  (*buf)[len] = '\0';
+  return TRUE;
+}
+
+static FILE *
+order_open_file (const char *filename)
+{
+  FILE *file = fopen (filename, "r");
+
+  if (file == NULL)
+    {
+      bfd_set_error (bfd_error_system_call);
+      einfo ("%X%P: %s: %E\n", filename);
+    }
+  return file;
+}
+
+/* Read FILENAME, a list of symbol names, and give each one the next
+   priority.  */
+
+static void
+order_read_symbol_file (const char *filename)
+{
+  FILE *file;
+  char *buf;
+  size_t bufsize = 100;
+
+  file = order_open_file (filename);
+  if (file == NULL)
+    return;
+
+  buf = (char *) xmalloc (bufsize);
+  while (order_read_word (file, &buf, &bufsize))
+    {
+      struct order_sym_entry *ent = order_sym_lookup (buf);
+
+      if (ent->priority == ORDER_NONE)
+	ent->priority = order_sym_count++;
+      ent->listed = TRUE;
+    }
+
+  free (buf);
+  fclose (file);
+}
+
+static int
+order_cg_edge_compare (const void *a, const void *b)
+{
+  const struct order_cg_edge *ea = (const struct order_cg_edge *) a;
+  const struct order_cg_edge *eb = (const struct order_cg_edge *) b;
+
+  if (ea->weight != eb->weight)
+    return ea->weight > eb->weight ? -1 : 1;
+  return ea->index < eb->index ? -1 : ea->index > eb->index;
+}
+
+static int
+order_cg_root_compare (const void *a, const void *b)
+{
+  const struct order_cg_root *ra = (const struct order_cg_root *) a;
+  const struct order_cg_root *rb = (const struct order_cg_root *) b;
+
+  if (ra->weight != rb->weight)
+    return ra->weight > rb->weight ? -1 : 1;
+  return ra->node < rb->node ? -1 : ra->node > rb->node;
+}
+
+static unsigned int
+order_cluster_find (unsigned int *parent, unsigned int node)
+{
+  unsigned int root = node;
+
+  while (parent[root] != root)
+    root = parent[root];
+  while (parent[node] != root)
+    {
+      unsigned int next = parent[node];
+      parent[node] = root;
+      node = next;
+    }
+  return root;
+}
+
+/* Read FILENAME, a call graph given as lines of "CALLER CALLEE COUNT",
+   and give the functions in it the next priorities, laid out with
+   Pettis-Hansen style clustering: the edges are visited heaviest first,
+   and the cluster of each callee is placed after that of its caller,
+   unless they are already one.  The clusters are then placed heaviest
+   first.  */
+
+static void
+order_read_call_graph_file (const char *filename)
+{
+  FILE *file;
+  char *buf;
+  const char *end;
+  size_t bufsize = 100;
+  struct order_sym_entry **nodes = NULL;
+  struct order_cg_edge *edges = NULL;
+  unsigned int nnodes = 0, nodes_size = 0, nedges = 0, edges_size = 0;
+  unsigned int *parent, *next, *first, *last, nroots, i;
+  struct order_cg_root *roots;
+  bfd_vma *weight;
+
+  file = order_open_file (filename);
+  if (file == NULL)
+    return;
+
+  buf = (char *) xmalloc (bufsize);
+  while (order_read_word (file, &buf, &bufsize))
+    {
+      unsigned int ends[2];
+
+      for (i = 0; i < 2; i++)
+	{
+	  struct order_sym_entry *ent;
+
+	  if (i != 0 && !order_read_word (file, &buf, &bufsize))
+	    einfo (_("%P%F: %s: truncated call graph edge\n"), filename);
+
+	  ent = order_sym_lookup (buf);
+	  if (ent->node == ORDER_NONE)
+	    {
+	      if (nnodes == nodes_size)
+		{
+		  nodes_size = nodes_size ? nodes_size * 2 : 64;
+		  nodes = (struct order_sym_entry **)
+		    xrealloc (nodes, nodes_size * sizeof (*nodes));
+		}
+	      ent->node = nnodes;
+	      nodes[nnodes++] = ent;
+	    }
+	  ends[i] = ent->node;
+	}
+
+      if (!order_read_word (file, &buf, &bufsize))
+	einfo (_("%P%F: %s: truncated call graph edge\n"), filename);
+
+      if (nedges == edges_size)
+	{
+	  edges_size = edges_size ? edges_size * 2 : 64;
+	  edges = (struct order_cg_edge *)
+	    xrealloc (edges, edges_size * sizeof (*edges));
+	}
+      edges[nedges].from = ends[0];
+      edges[nedges].to = ends[1];
+      edges[nedges].weight = bfd_scan_vma (buf, &end, 0);
+      edges[nedges].index = nedges;
+      if (*end != '\0')
+	einfo (_("%P%F: %s: invalid call count `%s'\n"), filename, buf);
+      nedges++;
+    }
+  free (buf);
+  fclose (file);
+
+  if (nnodes == 0)
+    return;
+
+  qsort (edges, nedges, sizeof (*edges), order_cg_edge_compare);
+
+  parent = (unsigned int *) xmalloc (4 * nnodes * sizeof (*parent));
+  next = parent + nnodes;
+  first = next + nnodes;
+  last = first + nnodes;
+  roots = (struct order_cg_root *) xmalloc (nnodes * sizeof (*roots));
+  weight = (bfd_vma *) xcalloc (nnodes, sizeof (*weight));
+  for (i = 0; i < nnodes; i++)
+    {
+      parent[i] = i;
+      next[i] = ORDER_NONE;
+      first[i] = i;
+      last[i] = i;
+    }
+
+  for (i = 0; i < nedges; i++)
+    {
+      unsigned int a = order_cluster_find (parent, edges[i].from);
+      unsigned int b = order_cluster_find (parent, edges[i].to);
+
+      weight[a] += edges[i].weight;
+      if (a == b)
+	continue;
+
+      next[last[a]] = first[b];
+      last[a] = last[b];
+      parent[b] = a;
+      weight[a] += weight[b];
+    }
+
+  /* Place the clusters heaviest first, keeping the order in which their
+     first functions appeared in the file between clusters of equal
+     weight.  */
+  nroots = 0;
+  for (i = 0; i < nnodes; i++)
+    if (parent[i] == i)
+      {
+	roots[nroots].node = i;
+	roots[nroots].weight = weight[i];
+	nroots++;
+      }
+  qsort (roots, nroots, sizeof (*roots), order_cg_root_compare);
+
+  for (i = 0; i < nroots; i++)
+    {
+      unsigned int n;
+
+      for (n = first[roots[i].node]; n != ORDER_NONE; n = next[n])
+	if (nodes[n]->priority == ORDER_NONE)
+	  nodes[n]->priority = order_sym_count++;
+    }
+
+  free (roots);
+  free (weight);
+  free (parent);
+  free (edges);
+  free (nodes);
+}
+
+/* Give every input section the smallest priority of the symbols it
+   defines.  */
+
+static void
+order_assign_section_priorities (void)
+{
+  unsigned int i;
+  char *buf;
+  size_t bufsize = 100;
+
+  order_section_top_id = 0;
+  LANG_FOR_EACH_INPUT_STATEMENT (is)
+    {
+      asection *sec;
+
+      if (is->the_bfd == NULL)
+	continue;
+      for (sec = is->the_bfd->sections; sec != NULL; sec = sec->next)
+	if (sec->id >= order_section_top_id)
+	  order_section_top_id = sec->id + 1;
+    }
+
+  order_section_priority = (unsigned int *)
+    xmalloc ((order_section_top_id + 1) * sizeof (*order_section_priority));
+  for (i = 0; i < order_section_top_id; i++)
+    order_section_priority[i] = ORDER_NONE;
+
+  buf = (char *) xmalloc (bufsize);
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      bfd *abfd = f->the_bfd;
+      asymbol **syms;
+
+      if (abfd == NULL
+	  || (abfd->flags & DYNAMIC) != 0
+	  || f->flags.just_syms)
+	continue;
+
+      if (!bfd_generic_link_read_symbols (abfd))
+	einfo (_("%B%F: could not read symbols: %E\n"), abfd);
+
+      for (syms = bfd_get_outsymbols (abfd); *syms; ++syms)
+	{
+	  asymbol *sym = *syms;
+	  asection *sec = sym->section;
+	  unsigned int priority;
+
+	  if ((sym->flags & (BSF_LOCAL | BSF_GLOBAL | BSF_WEAK)) == 0
+	      || (sym->flags & BSF_SECTION_SYM) != 0
+	      || bfd_is_abs_section (sec)
+	      || bfd_is_und_section (sec)
+	      || bfd_is_com_section (sec)
+	      || sec->id >= order_section_top_id)
+	    continue;
+
+	  priority = order_sym_priority (abfd, sym, &buf, &bufsize);
+	  if (priority < order_section_priority[sec->id])
+	    order_section_priority[sec->id] = priority;
+	}
+    }
+  free (buf);
+}
+
+static int
+order_stmt_compare (const void *a, const void *b)
+{
+  const struct order_stmt *sa = (const struct order_stmt *) a;
+  const struct order_stmt *sb = (const struct order_stmt *) b;
+
+  if (sa->priority != sb->priority)
+    return sa->priority < sb->priority ? -1 : 1;
+  return sa->index < sb->index ? -1 : sa->index > sb->index;
+}
+
+/* Stably sort each run of input section statements in LIST by the
+   priority of their sections.  */
+
+static void
+order_statement_list (lang_statement_list_type *list)
+{
+  lang_statement_union_type **link = &list->head;
+  struct order_stmt *run = NULL;
+  unsigned int run_size = 0;
+
+  while (*link != NULL)
+    {
+      lang_statement_union_type *s;
+      unsigned int count = 0, i;
+      bfd_boolean ordered = FALSE;
+
+      for (s = *link;
+	   s != NULL && s->header.type == lang_input_section_enum;
+	   s = s->header.next)
+	{
+	  asection *sec = s->input_section.section;
+
+	  if (count == run_size)
+	    {
+	      run_size = run_size ? run_size * 2 : 16;
+	      run = (struct order_stmt *)
+		xrealloc (run, run_size * sizeof (*run));
+	    }
+	  run[count].stmt = s;
+	  run[count].priority = (sec->id < order_section_top_id
+				 ? order_section_priority[sec->id]
+				 : ORDER_NONE);
+	  run[count].index = count;
+	  if (run[count].priority != ORDER_NONE)
+	    ordered = TRUE;
+	  count++;
+	}
+
+      if (count == 0)
+	{
+	  link = &(*link)->header.next;
+	  continue;
+	}
+
+      if (ordered && count > 1)
+	qsort (run, count, sizeof (*run), order_stmt_compare);
+
+      for (i = 0; i < count; i++)
+	{
+	  *link = run[i].stmt;
+	  link = &run[i].stmt->header.next;
+	}
+      *link = s;
+      if (s == NULL)
+	list->tail = link;
+    }
+
+  free (run);
+}
+
+static void
+order_statement (lang_statement_union_type *s)
+{
+  struct wildcard_list *sec;
+
+  switch (s->header.type)
+    {
+    case lang_output_section_statement_enum:
+      order_statement_list (&s->output_section_statement.children);
+      break;
+
+    case lang_wild_statement_enum:
+      /* Leave the order asked for by the script alone.  */
+      if (s->wild_statement.filenames_sorted)
+	break;
+      for (sec = s->wild_statement.section_list; sec != NULL; sec = sec->next)
+	if (sec->spec.sorted != none && sec->spec.sorted != by_none)
+	  break;
+      if (sec == NULL)
+	order_statement_list (&s->wild_statement.children);
+      break;
+
+    default:
+      break;
+    }
+}
+
+static bfd_boolean
+order_sym_check_found (struct bfd_hash_entry *entry, void *filename)
+{
+  struct order_sym_entry *ent = (struct order_sym_entry *) entry;
+
+  if (ent->listed && !ent->found)
+    einfo (_("%P: warning: %s: no definition of `%s' to order\n"),
+	   (const char *) filename, ent->root.string);
+  return TRUE;
+}
+
+/* Reorder the input sections as asked by --symbol-ordering-file and
+   --call-graph-ordering-file.  Symbols listed in the symbol ordering file
+   come first, then the rest of the call graph.  */
+
+static void
+lang_order_input_sections (void)
+{
+  if (command_line.symbol_ordering_file == NULL
+      && command_line.call_graph_ordering_file == NULL)
+    return;
+
+  if (!bfd_hash_table_init (&order_sym_table, order_sym_newfunc,
+			    sizeof (struct order_sym_entry)))
+    einfo (_("%P%F: bfd_hash_table_init failed: %E\n"));
+  order_sym_count = 0;
+  order_sym_qualified = FALSE;
+
+  if (command_line.symbol_ordering_file != NULL)
+    order_read_symbol_file (command_line.symbol_ordering_file);
+  if (command_line.call_graph_ordering_file != NULL)
+    order_read_call_graph_file (command_line.call_graph_ordering_file);
+
+  if (order_sym_count != 0)
+    {
+      order_assign_section_priorities ();
+      lang_for_each_statement (order_statement);
+      free (order_section_priority);
+      order_section_priority = NULL;
+      order_section_top_id = 0;
+    }
+
+  if (command_line.symbol_ordering_file != NULL)
+    bfd_hash_traverse (&order_sym_table, order_sym_check_found,
+		       command_line.symbol_ordering_file);
+  bfd_hash_table_free (&order_sym_table);
+}
+
 /* Look through all output sections looking for places where we can
    propagate forward the lma region.  */
 
@@ -7146,6 +7799,9 @@ lang_process (void)
   /* Find any sections not attached explicitly and handle them.  */
   lang_place_orphans ();
 
+  /* Apply --symbol-ordering-file and --call-graph-ordering-file.  */
+  lang_order_input_sections ();
+
   if (!bfd_link_relocatable (&link_info))
     {
       asection *found;
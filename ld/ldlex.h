@@ -147,6 +147,10 @@ enum option_values
   OPTION_REQUIRE_DEFINED_SYMBOL,
   OPTION_ORPHAN_HANDLING,
   OPTION_FORCE_GROUP_ALLOCATION,
+  OPTION_SYMBOL_ORDERING_FILE,
+  OPTION_CALL_GRAPH_ORDERING_FILE,
+  OPTION_ICF,
+  OPTION_PRINT_ICF_SECTIONS,
 };
 
 /* The initial parser states.  */
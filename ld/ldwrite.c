@@ -239,8 +239,10 @@ build_link_order (lang_statement_union_type *statement)
 	   attached */
 	asection *i = statement->input_section.section;
 
+	/* Sections folded by --icf are not written.  */
 	if (i->sec_info_type != SEC_INFO_TYPE_JUST_SYMS
-	    && (i->flags & SEC_EXCLUDE) == 0)
+	    && (i->flags & SEC_EXCLUDE) == 0
+	    && (link_info.icf == icf_none || i->kept_section == NULL))
 	  {
 	    asection *output_section = i->output_section;
 	    struct bfd_link_order *link_order;
@@ -341,6 +341,12 @@ static const struct ld_option ld_options[] =
   { {"gc-keep-exported", no_argument, NULL, OPTION_GC_KEEP_EXPORTED},
     '\0', NULL, N_("Keep exported symbols when removing unused sections"),
     TWO_DASHES },
+  { {"icf", required_argument, NULL, OPTION_ICF},
+    '\0', N_("[none|safe|all]"),
+    N_("Fold identical code sections (on some targets)"), TWO_DASHES },
+  { {"print-icf-sections", no_argument, NULL, OPTION_PRINT_ICF_SECTIONS},
+    '\0', NULL, N_("List sections folded by --icf on stderr"),
+    TWO_DASHES },
   { {"hash-size=<NUMBER>", required_argument, NULL, OPTION_HASH_SIZE},
     '\0', NULL, N_("Set default hash table size close to <NUMBER>"),
     TWO_DASHES },
@@ -436,6 +442,14 @@ static const struct ld_option ld_options[] =
   { {"sort-section", required_argument, NULL, OPTION_SORT_SECTION},
     '\0', N_("name|alignment"),
     N_("Sort sections by name or maximum alignment"), TWO_DASHES },
+  { {"symbol-ordering-file", required_argument, NULL,
+     OPTION_SYMBOL_ORDERING_FILE},
+    '\0', N_("FILE"), N_("Order input sections by the symbols listed in FILE"),
+    TWO_DASHES },
+  { {"call-graph-ordering-file", required_argument, NULL,
+     OPTION_CALL_GRAPH_ORDERING_FILE},
+    '\0', N_("FILE"), N_("Order input sections by the call graph in FILE"),
+    TWO_DASHES },
   { {"spare-dynamic-tags", required_argument, NULL, OPTION_SPARE_DYNAMIC_TAGS},
     '\0', N_("COUNT"), N_("How many tags to reserve in .dynamic section"),
     TWO_DASHES },
@@ -873,6 +887,19 @@ parse_args (unsigned argc, char **argv)
 	case OPTION_GC_KEEP_EXPORTED:
 	  link_info.gc_keep_exported = TRUE;
 	  break;
+	case OPTION_ICF:
+	  if (strcmp (optarg, "none") == 0)
+	    link_info.icf = icf_none;
+	  else if (strcmp (optarg, "safe") == 0)
+	    link_info.icf = icf_safe;
+	  else if (strcmp (optarg, "all") == 0)
+	    link_info.icf = icf_all;
+	  else
+	    einfo (_("%P%F: bad --icf option: %s\n"), optarg);
+	  break;
+	case OPTION_PRINT_ICF_SECTIONS:
+	  link_info.print_icf_sections = TRUE;
+	  break;
 	case OPTION_HELP:
 	  help ();
 	  xexit (0);
@@ -1214,6 +1241,12 @@ parse_args (unsigned argc, char **argv)
 	    einfo (_("%P%F: invalid section sorting option: %s\n"),
 		   optarg);
 	  break;
+	case OPTION_SYMBOL_ORDERING_FILE:
+	  command_line.symbol_ordering_file = optarg;
+	  break;
+	case OPTION_CALL_GRAPH_ORDERING_FILE:
+	  command_line.call_graph_ordering_file = optarg;
+	  break;
 	case OPTION_STATS:
 	  config.stats = TRUE;
 	  break;
@@ -0,0 +1,6 @@
+	.section .text.bbb,"ax",%progbits
+bbb:
+	.dc.a 0
+	.globl bbb_2
+bbb_2:
+	.dc.a 0
@@ -0,0 +1,18 @@
+	.text
+	.globl _start
+_start:
+	.dc.a 0
+
+	.section .text.aaa,"ax",%progbits
+	.globl aaa
+aaa:
+	.dc.a 0
+
+	.section .text.bbb,"ax",%progbits
+bbb:
+	.dc.a 0
+
+	.section .text.ccc,"ax",%progbits
+	.globl ccc
+ccc:
+	.dc.a 0
@@ -0,0 +1,16 @@
+	.text
+	.globl	_start
+_start:
+	call	far
+	jal	far
+	call	local
+	call	local
+	call	local
+	ret
+
+	.section .far, "ax", @progbits
+	.globl	far
+far:
+	ret
+local:
+	ret
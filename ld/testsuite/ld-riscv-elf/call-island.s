@@ -0,0 +1,22 @@
+	.text
+	.globl	_start
+_start:
+	call	far
+	jal	far
+	call	far2
+	call	far2
+	call	far2
+	call	far3
+	ret
+	tail	far
+
+	.section .far, "ax", @progbits
+	.globl	far
+far:
+	ret
+	.globl	far2
+far2:
+	ret
+	.globl	far3
+far3:
+	ret
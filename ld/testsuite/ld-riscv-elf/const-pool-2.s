@@ -0,0 +1,5 @@
+	.text
+	.globl	f
+f:
+	li	a0, 0x123456789abcdef0
+	ret
@@ -0,0 +1,6 @@
+	.text
+	.globl	_start
+_start:
+	li	a0, 0x123456789abcdef0
+	li	a1, 0x0fedcba987654321
+	ret
@@ -0,0 +1,12 @@
+	.text
+	.globl	_start
+_start:
+	la	a0, far_abs
+	la	a1, near_abs
+	la	a2, far_data
+	ret
+
+	.section .far, "aw"
+	.globl	far_data
+far_data:
+	.word	0
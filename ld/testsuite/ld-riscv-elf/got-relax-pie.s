@@ -0,0 +1,22 @@
+# The loads of foo and bar become address computations, so their GOT
+# entries and R_RISCV_RELATIVE relocs go away.  baz keeps both.
+	.text
+	.globl	_start
+_start:
+	la	a0, foo
+	la	a1, bar
+	.option	push
+	.option	norelax
+	la	a2, baz
+	.option	pop
+	ret
+
+	.data
+foo:
+	.dword	0
+	.globl	bar
+	.hidden	bar
+bar:
+	.dword	0
+baz:
+	.dword	0
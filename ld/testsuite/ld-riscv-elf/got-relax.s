@@ -0,0 +1,9 @@
+	.text
+	.globl	_start
+_start:
+	la	a0, foo
+	ret
+
+	.globl	foo
+foo:
+	.word	0
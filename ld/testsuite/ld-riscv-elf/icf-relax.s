@@ -0,0 +1,30 @@
+	.section .text._start, "ax", @progbits
+	.globl	_start
+_start:
+	call	f1
+	call	f2
+	call	f1_tail
+	call	f2_tail
+	call	g
+	ret
+
+	.section .text.f1, "ax", @progbits
+	.globl	f1, f1_tail
+f1:
+	call	g
+f1_tail:
+	li	a0, 42
+	ret
+
+	.section .text.f2, "ax", @progbits
+	.globl	f2, f2_tail
+f2:
+	call	g
+f2_tail:
+	li	a0, 42
+	ret
+
+	.section .text.g, "ax", @progbits
+	.globl	g
+g:
+	ret
@@ -0,0 +1,29 @@
+	.section .text._start, "ax", @progbits
+	.globl	_start
+_start:
+	jal	f1
+	jal	f2
+	jal	f3
+	ret
+
+	.section .text.f1, "ax", @progbits
+	.globl	f1
+f1:
+	li	a0, 42
+	ret
+
+	.section .text.f2, "ax", @progbits
+	.globl	f2
+f2:
+	li	a0, 42
+	ret
+
+	.section .text.f3, "ax", @progbits
+	.globl	f3
+f3:
+	li	a0, 43
+	ret
+
+	.data
+	.balign	8
+	.dword	f2
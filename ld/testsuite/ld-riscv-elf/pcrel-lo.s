@@ -0,0 +1,28 @@
+# The first %pcrel_lo comes before its %pcrel_hi, and .text.other
+# reuses the tables that .text filled in.
+	.text
+	.globl	_start
+_start:
+	j	1f
+2:
+	addi	a1, a1, %pcrel_lo(3f)
+	ret
+1:
+	auipc	a0, %pcrel_hi(x)
+	addi	a0, a0, %pcrel_lo(1b)
+3:
+	auipc	a1, %pcrel_hi(y)
+	j	2b
+
+	.section .text.other, "ax", @progbits
+	.globl	f
+f:
+	auipc	a2, %pcrel_hi(y)
+	sw	a3, %pcrel_lo(f)(a2)
+	ret
+
+	.data
+x:
+	.word	1
+y:
+	.word	2
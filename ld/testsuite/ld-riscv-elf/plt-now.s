@@ -0,0 +1,8 @@
+	.option pic
+	.text
+	.globl	func
+func:
+	call	bar@plt
+	call	foo@plt
+	la	a0, foo
+	ret
@@ -0,0 +1,14 @@
+	.text
+	.globl	_start
+_start:
+	call	foo
+	lui	a0, %hi(x)
+	addi	a0, a0, %lo(x)
+	ret
+
+foo:
+	ret
+
+	.section .sdata,"aw"
+x:
+	.word	1
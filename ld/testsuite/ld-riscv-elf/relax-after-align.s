@@ -0,0 +1,23 @@
+# The call is out of reach of g until relaxation has removed the padding
+# that gas reserved for the .balign.  .relr.dyn grows once it is sized,
+# so ld relaxes again, and only that second run can relax the call.
+	.text
+	.zero	4088
+g:
+	ret
+	.balign	4096
+	.zero	1046000
+	call	g
+
+	.data
+	.balign	8
+	.zero	320
+	.dword	a
+	.dword	a
+
+	.section .mydata, "aw", @progbits
+	.balign	512
+	.dword	a
+	.dword	a
+a:
+	.dword	0
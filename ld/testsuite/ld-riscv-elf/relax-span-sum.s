@@ -0,0 +1,27 @@
+# y is 1032 bytes above gp, past .sbss and .bss, which are both 512-byte
+# aligned.  Either one alone leaves y in reach of gp; the padding of both
+# does not.
+	.text
+	.globl	_start
+_start:
+	lui	a0, %hi(x)
+	addi	a0, a0, %lo(x)
+	lui	a1, %hi(y)
+	lw	a1, %lo(y)(a1)
+	ret
+
+	.section .sdata, "aw", @progbits
+	.balign	8
+x:
+	.dword	1
+	.zero	2200
+
+	.section .sbss, "aw", @nobits
+	.balign	512
+	.zero	8
+
+	.bss
+	.balign	512
+	.zero	200
+y:
+	.zero	4
@@ -0,0 +1,20 @@
+	.text
+	.globl	_start
+_start:
+	lui	a0, %hi(x)
+	addi	a0, a0, %lo(x)
+	lui	a1, %hi(y)
+	lw	a1, %lo(y)(a1)
+	ret
+
+	.data
+	.balign	4096
+	.dword	0
+
+	.section .sdata, "aw", @progbits
+	.balign	8
+x:
+	.dword	1
+	.zero	3000
+y:
+	.word	2
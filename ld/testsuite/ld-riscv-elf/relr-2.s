@@ -0,0 +1,16 @@
+# The padding puts the words of .mydata out of reach of a bitmap
+# following the words of .data when .relr.dyn is first sized, and in
+# reach once it has grown, so the final encoding is shorter than the
+# section.
+	.data
+	.balign	8
+	.zero	320
+	.dword	a
+	.dword	a
+
+	.section .mydata, "aw", @progbits
+	.balign	512
+	.dword	a
+	.dword	a
+a:
+	.dword	0
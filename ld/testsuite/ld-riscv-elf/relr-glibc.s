@@ -0,0 +1,13 @@
+	.text
+	.globl	_start
+_start:
+	call	puts@plt
+	ret
+
+	.data
+	.balign	8
+	.dword	_start
+	.dword	_start
+	.dword	x
+x:
+	.dword	0
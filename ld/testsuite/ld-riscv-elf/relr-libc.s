@@ -0,0 +1,7 @@
+# Stands in for a glibc libc.so.6, which packed relative relocs need a
+# GLIBC_ABI_DT_RELR version of.
+	.text
+	.globl	puts
+	.type	puts, @function
+puts:
+	ret
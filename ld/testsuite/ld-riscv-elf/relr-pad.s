@@ -0,0 +1,9 @@
+# A packed relative reloc section ending in the empty bitmaps that the
+# linker pads .relr.dyn with.
+	.section .relr.dyn, "a", @19
+	.balign	8
+	.dword	0x1000
+	.dword	0x7
+	.dword	0x1
+	.dword	0x1
+	.dword	0x1
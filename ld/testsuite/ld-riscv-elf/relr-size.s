@@ -0,0 +1,14 @@
+# A table of 64 pointers needs 64 R_RISCV_RELATIVE relocs in .rela.dyn,
+# or one address and one bitmap in .relr.dyn.  Only the size of the
+# dynamic relocs is checked; the work the dynamic loader saves at
+# start-up is not measured, since the testsuite does not run RISC-V
+# programs.
+	.data
+	.balign	8
+	.globl	table
+table:
+	.rept	64
+	.dword	a
+	.endr
+a:
+	.dword	0
@@ -0,0 +1,18 @@
+	.data
+	.balign	8
+	.globl	table
+table:
+	.dword	a
+	.dword	b
+	.dword	c
+	.dword	0
+	.dword	a
+	.dword	ext
+	.zero	512
+	.dword	c
+a:
+	.dword	0
+b:
+	.dword	0
+c:
+	.dword	0
@@ -0,0 +1,20 @@
+	.text
+	.globl	_start
+_start:
+	lui	a0, %hi(cold)
+	addi	a0, a0, %lo(cold)
+	lui	a1, %hi(hot)
+	lw	a1, %lo(hot)(a1)
+	lui	a2, %hi(hot)
+	lw	a2, %lo(hot)(a2)
+	ret
+
+	.section .srodata.cold,"a"
+	.globl	cold
+cold:
+	.zero	4096
+
+	.section .sdata.hot,"aw"
+	.globl	hot
+hot:
+	.word	1
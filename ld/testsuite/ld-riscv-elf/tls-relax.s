@@ -0,0 +1,17 @@
+	.section .tbss,"awT",@nobits
+	.globl	x
+x:
+	.zero	4
+
+	.text
+	.globl	_start
+_start:
+	la.tls.gd a0, x
+	call	__tls_get_addr@plt
+	la.tls.ie a5, x
+	add	a5, a5, tp
+	ret
+
+	.globl	__tls_get_addr
+__tls_get_addr:
+	ret
@@ -0,0 +1,413 @@
+/* riscv-gen.c -- Generate the perfect hash tables for the RISC-V assembler.
+   Copyright (C) 2018 Free Software Foundation, Inc.
+
+   This file is part of the GNU opcodes library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   It is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+   or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+   License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; see the file COPYING3. If not,
+   see <http://www.gnu.org/licenses/>.  */
+
+/* The assembler looks up every mnemonic and every register operand by
+   name.  Both sets of names are fixed when the opcode table is built, so
+   rather than have gas fill hash tables at startup this program computes a
+   minimal-probe perfect hash for each of them and writes the result as C
+   tables.  A lookup then costs one hash of the name, two table loads and
+   a single string comparison.
+
+   The hash is "hash and displace": every name is first hashed into a
+   small number of buckets; each bucket is then given a displacement that
+   scatters its names into otherwise unused slots of a larger table.
+   riscv_name_hash and riscv_name_slot in opcode/riscv.h are shared with
+   the assembler so that both sides agree on the slot of each name.  */
+
+/* riscv-opc.c brings in sysdep.h, which must come first.  */
+#include "riscv-opc.c"
+
+#include <stdarg.h>
+#include <errno.h>
+
+#include "libiberty.h"
+#include "getopt.h"
+
+#include <libintl.h>
+#define _(String) gettext (String)
+
+static const char *program_name = NULL;
+static int debug = 0;
+
+/* One name to be placed in a perfect hash table.  */
+
+struct key
+{
+  const char *name;
+  uint32_t hash;
+  /* For a mnemonic, the index of its first riscv_opcodes entry; for a
+     register, its number.  */
+  unsigned int value;
+  /* For a register, the RCLASS_* enumerator naming its class.  */
+  const char *rclass;
+};
+
+/* A perfect hash table built over an array of keys.  */
+
+struct table
+{
+  unsigned int nkeys;
+  unsigned int nbuckets;
+  unsigned int nslots;
+  unsigned short *disp;
+  /* Index into the key array of the name held in each slot, or -1.  */
+  int *slot;
+};
+
+static void
+fail (const char *message, ...)
+{
+  va_list args;
+
+  va_start (args, message);
+  fprintf (stderr, _("%s: Error: "), program_name);
+  vfprintf (stderr, message, args);
+  va_end (args);
+  xexit (1);
+}
+
+static void
+add_key (struct key **keys, unsigned int *nkeys, unsigned int *nalloc,
+	 const char *name, unsigned int value, const char *rclass)
+{
+  unsigned int i;
+
+  for (i = 0; i < *nkeys; i++)
+    if (strcmp ((*keys)[i].name, name) == 0)
+      fail (_("duplicate name `%s'\n"), name);
+
+  if (*nkeys == *nalloc)
+    {
+      *nalloc = *nalloc ? *nalloc * 2 : 256;
+      *keys = (struct key *) xrealloc (*keys, *nalloc * sizeof (**keys));
+    }
+
+  (*keys)[*nkeys].name = name;
+  (*keys)[*nkeys].hash = riscv_name_hash (name, strlen (name));
+  (*keys)[*nkeys].value = value;
+  (*keys)[*nkeys].rclass = rclass;
+  (*nkeys)++;
+}
+
+static unsigned int
+round_up_pow2 (unsigned int n)
+{
+  unsigned int p = 1;
+
+  while (p < n)
+    p <<= 1;
+  return p;
+}
+
+/* Bucket order for placement: the fullest buckets are the hardest to
+   place, so they go first while most slots are still free.  */
+
+static unsigned int *bucket_size;
+
+static int
+compare_buckets (const void *x, const void *y)
+{
+  unsigned int a = *(const unsigned int *) x;
+  unsigned int b = *(const unsigned int *) y;
+
+  if (bucket_size[a] != bucket_size[b])
+    return bucket_size[a] > bucket_size[b] ? -1 : 1;
+  return a < b ? -1 : a > b;
+}
+
+static void
+build_table (struct table *t, const struct key *keys, unsigned int nkeys,
+	     const char *what)
+{
+  unsigned int *order, *members, *first;
+  unsigned int i, b, placed = 0;
+  uint32_t *want;
+
+  t->nkeys = nkeys;
+  t->nslots = round_up_pow2 (nkeys + nkeys / 4);
+  t->nbuckets = round_up_pow2 (nkeys / 4 ? nkeys / 4 : 1);
+  t->disp = XCNEWVEC (unsigned short, t->nbuckets);
+  t->slot = XNEWVEC (int, t->nslots);
+  for (i = 0; i < t->nslots; i++)
+    t->slot[i] = -1;
+
+  /* Group the keys by bucket.  */
+  bucket_size = XCNEWVEC (unsigned int, t->nbuckets);
+  first = XNEWVEC (unsigned int, t->nbuckets + 1);
+  members = XNEWVEC (unsigned int, nkeys);
+  for (i = 0; i < nkeys; i++)
+    bucket_size[keys[i].hash & (t->nbuckets - 1)]++;
+  first[0] = 0;
+  for (b = 0; b < t->nbuckets; b++)
+    first[b + 1] = first[b] + bucket_size[b];
+  for (b = 0; b < t->nbuckets; b++)
+    bucket_size[b] = 0;
+  for (i = 0; i < nkeys; i++)
+    {
+      b = keys[i].hash & (t->nbuckets - 1);
+      members[first[b] + bucket_size[b]++] = i;
+    }
+
+  order = XNEWVEC (unsigned int, t->nbuckets);
+  for (b = 0; b < t->nbuckets; b++)
+    order[b] = b;
+  qsort (order, t->nbuckets, sizeof (*order), compare_buckets);
+
+  want = XNEWVEC (uint32_t, nkeys);
+  for (i = 0; i < t->nbuckets && bucket_size[order[i]] != 0; i++)
+    {
+      unsigned int n = bucket_size[order[i]];
+      unsigned int *m = members + first[order[i]];
+      unsigned int d, j, k;
+
+      for (d = 0; d < 0x10000; d++)
+	{
+	  for (j = 0; j < n; j++)
+	    {
+	      want[j] = riscv_name_slot (keys[m[j]].hash, d, t->nslots - 1);
+	      if (t->slot[want[j]] != -1)
+		break;
+	      for (k = 0; k < j; k++)
+		if (want[k] == want[j])
+		  break;
+	      if (k < j)
+		break;
+	    }
+	  if (j == n)
+	    break;
+	}
+      if (d == 0x10000)
+	fail (_("can't find a perfect hash for the %s table\n"), what);
+
+      t->disp[order[i]] = d;
+      for (j = 0; j < n; j++)
+	t->slot[want[j]] = m[j];
+      placed += n;
+    }
+
+  if (placed != nkeys)
+    abort ();
+
+  if (debug)
+    fprintf (stderr, "%s: %u names, %u buckets, %u slots\n",
+	     what, nkeys, t->nbuckets, t->nslots);
+
+  free (want);
+  free (order);
+  free (members);
+  free (first);
+  free (bucket_size);
+}
+
+static void
+print_disp (FILE *fp, const struct table *t, const char *name,
+	    const char *size)
+{
+  unsigned int i;
+
+  fprintf (fp, "\nstatic const unsigned short %s[%s] =\n{", name, size);
+  for (i = 0; i < t->nbuckets; i++)
+    fprintf (fp, "%s%5u%s", i % 8 == 0 ? "\n  " : " ", t->disp[i],
+	     i + 1 < t->nbuckets ? "," : "");
+  fprintf (fp, "\n};\n");
+}
+
+static void
+process_copyright (FILE *fp)
+{
+  fprintf (fp, "/* This file is automatically generated by riscv-gen.  Do not edit!  */\n\
+/* Copyright (C) 2018 Free Software Foundation, Inc.\n\
+\n\
+   This file is part of the GNU opcodes library.\n\
+\n\
+   This library is free software; you can redistribute it and/or modify\n\
+   it under the terms of the GNU General Public License as published by\n\
+   the Free Software Foundation; either version 3, or (at your option)\n\
+   any later version.\n\
+\n\
+   It is distributed in the hope that it will be useful, but WITHOUT\n\
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY\n\
+   or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public\n\
+   License for more details.\n\
+\n\
+   You should have received a copy of the GNU General Public License\n\
+   along with this program; see the file COPYING3. If not,\n\
+   see <http://www.gnu.org/licenses/>.  */\n");
+}
+
+static void
+process_opcodes (FILE *fp)
+{
+  struct key *keys = NULL;
+  unsigned int nkeys = 0, nalloc = 0;
+  struct table t;
+  unsigned int i;
+
+  for (i = 0; riscv_opcodes[i].name; i++)
+    if (i == 0 || strcmp (riscv_opcodes[i].name, riscv_opcodes[i - 1].name))
+      add_key (&keys, &nkeys, &nalloc, riscv_opcodes[i].name, i, NULL);
+  if (i >= RISCV_HASH_EMPTY)
+    fail (_("riscv_opcodes has too many entries\n"));
+
+  build_table (&t, keys, nkeys, "opcode");
+
+  fprintf (fp, "\n/* Mnemonics.  Each slot holds the index in riscv_opcodes of the first\n\
+   entry with a given name, or RISCV_HASH_EMPTY.  */\n\n");
+  fprintf (fp, "#define RISCV_OPCODE_HASH_BUCKETS %u\n", t.nbuckets);
+  fprintf (fp, "#define RISCV_OPCODE_HASH_SLOTS %u\n", t.nslots);
+  print_disp (fp, &t, "riscv_opcode_hash_disp", "RISCV_OPCODE_HASH_BUCKETS");
+
+  fprintf (fp, "\nstatic const unsigned short riscv_opcode_hash_index[RISCV_OPCODE_HASH_SLOTS] =\n{");
+  for (i = 0; i < t.nslots; i++)
+    {
+      unsigned int v = t.slot[i] < 0 ? RISCV_HASH_EMPTY : keys[t.slot[i]].value;
+
+      fprintf (fp, "%s%5u%s", i % 8 == 0 ? "\n  " : " ", v,
+	       i + 1 < t.nslots ? "," : "");
+    }
+  fprintf (fp, "\n};\n");
+
+  free (t.disp);
+  free (t.slot);
+  free (keys);
+}
+
+static void
+process_registers (FILE *fp)
+{
+  struct key *keys = NULL;
+  unsigned int nkeys = 0, nalloc = 0;
+  struct table t;
+  unsigned int i;
+
+  for (i = 0; i < NGPR; i++)
+    add_key (&keys, &nkeys, &nalloc, riscv_gpr_names_numeric[i], i,
+	     "RCLASS_GPR");
+  for (i = 0; i < NGPR; i++)
+    add_key (&keys, &nkeys, &nalloc, riscv_gpr_names_abi[i], i,
+	     "RCLASS_GPR");
+  for (i = 0; i < NFPR; i++)
+    add_key (&keys, &nkeys, &nalloc, riscv_fpr_names_numeric[i], i,
+	     "RCLASS_FPR");
+  for (i = 0; i < NFPR; i++)
+    add_key (&keys, &nkeys, &nalloc, riscv_fpr_names_abi[i], i,
+	     "RCLASS_FPR");
+  for (i = 0; i < NVPR; i++)
+    add_key (&keys, &nkeys, &nalloc, riscv_vpr_names_numeric[i], i,
+	     "RCLASS_VPR");
+
+#define DECLARE_CSR(name, num) \
+  add_key (&keys, &nkeys, &nalloc, #name, num, "RCLASS_CSR");
+#define DECLARE_CSR_ALIAS(name, num) DECLARE_CSR(name, num)
+#include "opcode/riscv-opc.h"
+#undef DECLARE_CSR
+#undef DECLARE_CSR_ALIAS
+
+  build_table (&t, keys, nkeys, "register");
+
+  fprintf (fp, "\n/* Register names, including the CSRs.  The includer defines the\n\
+   RCLASS_* enumerators.  */\n\n");
+  fprintf (fp, "#define RISCV_REG_HASH_BUCKETS %u\n", t.nbuckets);
+  fprintf (fp, "#define RISCV_REG_HASH_SLOTS %u\n", t.nslots);
+  print_disp (fp, &t, "riscv_reg_hash_disp", "RISCV_REG_HASH_BUCKETS");
+
+  fprintf (fp, "\nstruct riscv_reg_hash_entry\n{\n\
+  const char *name;\n\
+  unsigned char rclass;\n\
+  unsigned short num;\n\
+};\n");
+  fprintf (fp, "\nstatic const struct riscv_reg_hash_entry riscv_reg_hash_table[RISCV_REG_HASH_SLOTS] =\n{\n");
+  for (i = 0; i < t.nslots; i++)
+    {
+      const char *sep = i + 1 < t.nslots ? "," : "";
+
+      if (t.slot[i] < 0)
+	fprintf (fp, "  { NULL, 0, 0 }%s\n", sep);
+      else
+	fprintf (fp, "  { \"%s\", %s, %#x }%s\n", keys[t.slot[i]].name,
+		 keys[t.slot[i]].rclass, keys[t.slot[i]].value, sep);
+    }
+  fprintf (fp, "};\n");
+
+  free (t.disp);
+  free (t.slot);
+  free (keys);
+}
+
+/* Program options.  */
+
+struct option long_options[] =
+{
+  {"debug",   no_argument,       NULL, 'd'},
+  {"version", no_argument,       NULL, 'V'},
+  {"help",    no_argument,       NULL, 'h'},
+  {0,         no_argument,       NULL, 0}
+};
+
+static void
+print_version (void)
+{
+  printf ("%s: version 1.0\n", program_name);
+  xexit (0);
+}
+
+static void
+usage (FILE * stream, int status)
+{
+  fprintf (stream, "Usage: %s [-V | --version] [-d | --debug] [--help]\n",
+	   program_name);
+  xexit (status);
+}
+
+int
+main (int argc, char **argv)
+{
+  int c;
+
+  program_name = *argv;
+  xmalloc_set_program_name (program_name);
+
+  while ((c = getopt_long (argc, argv, "vVdh", long_options, 0)) != EOF)
+    switch (c)
+      {
+      case 'V':
+      case 'v':
+	print_version ();
+	break;
+      case 'd':
+	debug = 1;
+	break;
+      case 'h':
+      case '?':
+	usage (stderr, 0);
+      default:
+      case 0:
+	break;
+      }
+
+  if (optind != argc)
+    usage (stdout, 1);
+
+  process_copyright (stdout);
+  process_opcodes (stdout);
+  process_registers (stdout);
+
+  xexit (0);
+  return 0;
+}
@@ -0,0 +1,725 @@
+/* This file is automatically generated by riscv-gen.  Do not edit!  */
+/* Copyright (C) 2018 Free Software Foundation, Inc.
+
+   This file is part of the GNU opcodes library.
+
+   This library is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3, or (at your option)
+   any later version.
+
+   It is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+   or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public
+   License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; see the file COPYING3. If not,
+   see <http://www.gnu.org/licenses/>.  */
+
+/* Mnemonics.  Each slot holds the index in riscv_opcodes of the first
+   entry with a given name, or RISCV_HASH_EMPTY.  */
+
+#define RISCV_OPCODE_HASH_BUCKETS 128
+#define RISCV_OPCODE_HASH_SLOTS 1024
+
+static const unsigned short riscv_opcode_hash_disp[RISCV_OPCODE_HASH_BUCKETS] =
+{
+      0,     3,     0,     1,     1,     0,     2,     0,
+      0,     0,     0,     0,     0,     1,     4,     1,
+      0,     0,     0,     1,     0,     0,     1,     0,
+      0,     0,     0,     0,     1,    13,     2,     1,
+      0,     0,     3,     0,     2,     0,     0,     0,
+      1,     1,     2,     2,     4,     1,     1,     0,
+      0,     2,     1,     0,     5,     0,     2,     0,
+      0,     0,     6,     1,     1,     0,     0,     1,
+      2,     1,     0,     0,     0,     0,     0,     3,
+      2,     0,     1,     1,     0,     0,     0,     0,
+      1,     1,     2,     0,     1,     3,     1,     2,
+      2,     1,     1,     2,     0,     0,     0,     0,
+      3,     0,     1,     0,     0,     2,     0,     0,
+      3,     1,     0,     1,     6,     1,     0,     2,
+      0,     2,     1,     1,     0,     0,     1,     1,
+      1,     0,     6,     2,    10,     0,     1,     1
+};
+
+static const unsigned short riscv_opcode_hash_index[RISCV_OPCODE_HASH_SLOTS] =
+{
+  65535, 65535,   560, 65535,   297,   370, 65535, 65535,
+    290,   566, 65535, 65535,   492, 65535, 65535,     4,
+    190, 65535, 65535, 65535,   118, 65535, 65535, 65535,
+  65535,   481, 65535,   256,    24, 65535, 65535, 65535,
+    237, 65535,   198,   441, 65535, 65535, 65535, 65535,
+  65535,   534, 65535, 65535, 65535, 65535, 65535, 65535,
+    477,   238, 65535,   523,   189,   173, 65535, 65535,
+  65535,   517, 65535,   195,   473,   183,   571, 65535,
+     49,   242, 65535, 65535,   410,   469, 65535,   456,
+    513,   310, 65535, 65535, 65535,   201, 65535, 65535,
+  65535,   581,   281, 65535,   128, 65535,   461, 65535,
+  65535,   386,   485,   520, 65535, 65535, 65535, 65535,
+  65535, 65535, 65535, 65535, 65535, 65535,   218, 65535,
+     51, 65535, 65535, 65535,   293, 65535,   160,   187,
+    511, 65535, 65535,   331, 65535, 65535, 65535,   279,
+  65535,   479,   232,   384,   148, 65535, 65535,    62,
+    222, 65535,   576,   257, 65535,   371,   354, 65535,
+  65535, 65535, 65535,    92, 65535,   483,   259,   421,
+    196, 65535, 65535, 65535,   103,   435,   525,   178,
+    394,   278, 65535, 65535, 65535, 65535,   451, 65535,
+  65535, 65535,   141,   240,    81, 65535, 65535, 65535,
+  65535,    12,   332, 65535, 65535,   208,   569, 65535,
+  65535, 65535, 65535, 65535,   315,   243, 65535, 65535,
+  65535,   552, 65535,   553,   583, 65535, 65535, 65535,
+  65535, 65535,    58,   455, 65535, 65535, 65535, 65535,
+  65535, 65535, 65535, 65535,   482, 65535, 65535,   555,
+  65535, 65535, 65535, 65535,   484, 65535,   541, 65535,
+  65535, 65535, 65535,   147,   214, 65535, 65535, 65535,
+  65535, 65535, 65535, 65535, 65535, 65535,    60, 65535,
+  65535, 65535, 65535, 65535, 65535, 65535,   402,   211,
+  65535, 65535, 65535, 65535,   543, 65535, 65535, 65535,
+  65535,   526, 65535, 65535, 65535,   430,   246,   254,
+  65535,    79, 65535, 65535, 65535,   199, 65535, 65535,
+  65535, 65535, 65535, 65535,   400, 65535, 65535, 65535,
+     84, 65535, 65535, 65535,   499, 65535, 65535, 65535,
+  65535,   542,   268, 65535,   565, 65535,   429,   407,
+  65535, 65535, 65535,   374,   392, 65535, 65535,   112,
+  65535, 65535, 65535,   558, 65535, 65535, 65535, 65535,
+    522,   263, 65535,   537,   528,   203, 65535, 65535,
+  65535, 65535,   539,   330, 65535,   266, 65535, 65535,
+    334,   101, 65535,   272, 65535,   249, 65535, 65535,
+  65535, 65535, 65535,   572, 65535,   188, 65535, 65535,
+  65535,   213, 65535, 65535, 65535, 65535,   559, 65535,
+    557,   535, 65535, 65535, 65535, 65535, 65535,   413,
+    313,   390,   500,   387, 65535, 65535, 65535, 65535,
+  65535,   264, 65535, 65535,   515, 65535, 65535,   340,
+  65535,   466, 65535,   467,   241, 65535,     2,    59,
+  65535,   239, 65535,   426, 65535, 65535,   502, 65535,
+    428, 65535,   344,   132, 65535,   280, 65535, 65535,
+  65535, 65535,    50, 65535,   134, 65535, 65535,   209,
+    149,    53,   282, 65535, 65535,   419, 65535, 65535,
+  65535, 65535, 65535,   225, 65535, 65535, 65535, 65535,
+    322,   245,   223,   437, 65535, 65535, 65535,   458,
+    378,   122,   306, 65535, 65535, 65535,   358, 65535,
+  65535, 65535, 65535,   311, 65535, 65535,   453,   554,
+  65535, 65535, 65535, 65535, 65535,   506, 65535, 65535,
+  65535,    97, 65535,   142,   126,   206,   427,   286,
+  65535, 65535,   570,   425, 65535, 65535,   166, 65535,
+    493, 65535,   285, 65535, 65535,   518, 65535, 65535,
+    376, 65535, 65535, 65535,   274,   514,   191, 65535,
+    471, 65535, 65535, 65535, 65535,   130, 65535, 65535,
+  65535,   439, 65535, 65535, 65535,     6,   505,   275,
+  65535,   202, 65535, 65535, 65535,   372,   561,   253,
+    338, 65535, 65535, 65535,   229,   373, 65535, 65535,
+  65535,   320,   324, 65535,   433,   227, 65535,   111,
+    283, 65535, 65535,   415, 65535,   216, 65535, 65535,
+  65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+    488,   585, 65535, 65535,   409, 65535, 65535,   423,
+  65535,   230, 65535, 65535, 65535, 65535,    94, 65535,
+  65535, 65535,   388,   267,   277, 65535, 65535, 65535,
+    174,   233, 65535,   375,    26, 65535,   366, 65535,
+    312,   545,   544, 65535,   530,   154, 65535, 65535,
+  65535,   579,   138, 65535, 65535, 65535, 65535, 65535,
+    497,   185, 65535, 65535, 65535, 65535,   551, 65535,
+    567, 65535,   406,    36,   204,   507,   270,   480,
+  65535,    28, 65535, 65535, 65535,   346,   503, 65535,
+  65535,   317, 65535, 65535, 65535, 65535,    52, 65535,
+  65535, 65535,   231, 65535, 65535, 65535, 65535, 65535,
+    318, 65535, 65535, 65535, 65535,   470,   255,   205,
+    150,   575, 65535,   356, 65535, 65535,   380, 65535,
+     47, 65535, 65535, 65535, 65535,   261, 65535, 65535,
+  65535,   302, 65535, 65535,    61, 65535,   219,    19,
+    498, 65535, 65535, 65535,   273,   234, 65535, 65535,
+  65535,   248, 65535, 65535, 65535, 65535,   459, 65535,
+    252,    69, 65535, 65535, 65535, 65535,   495,   442,
+    574, 65535, 65535,   447,   582, 65535, 65535,   490,
+    360, 65535, 65535,    30, 65535, 65535,   501, 65535,
+  65535, 65535,   504, 65535,   168, 65535,   405,   468,
+  65535,   352, 65535,   129, 65535, 65535, 65535,     8,
+    362,   207, 65535,   512, 65535,   251,    78, 65535,
+  65535,    77, 65535,   573, 65535,   382, 65535,    54,
+    509, 65535,   349,    38,   276, 65535,    21, 65535,
+     56,   194, 65535, 65535, 65535,   533,    64,   401,
+  65535, 65535,   521,   144, 65535,   314, 65535,   562,
+  65535,   200, 65535,   244,   578,   300, 65535, 65535,
+    319,   564, 65535,   408, 65535,   228,    57,   292,
+  65535, 65535, 65535, 65535, 65535, 65535, 65535,   269,
+  65535, 65535,   235,   265, 65535, 65535, 65535, 65535,
+    403,    65,   546,   224, 65535,   113, 65535, 65535,
+    510,   494, 65535,    40, 65535,   120,   250, 65535,
+  65535, 65535,   584,   398, 65535,   145,   175,   463,
+    186,   193,   123, 65535,    89, 65535, 65535,   146,
+    577, 65535, 65535,   326, 65535, 65535,   247,   125,
+  65535, 65535,   350, 65535, 65535,   464,   353, 65535,
+    212, 65535, 65535,    55, 65535,   197, 65535, 65535,
+  65535, 65535, 65535,    87, 65535, 65535, 65535,   431,
+  65535, 65535,    99, 65535, 65535, 65535, 65535, 65535,
+    516,   336, 65535, 65535, 65535, 65535, 65535, 65535,
+  65535, 65535, 65535,   258, 65535, 65535, 65535,   289,
+  65535,    42, 65535, 65535,   568, 65535, 65535, 65535,
+  65535, 65535, 65535,   156, 65535, 65535, 65535,   443,
+    119,   287,   457, 65535,   342,   295, 65535, 65535,
+  65535,   177,   412, 65535, 65535, 65535, 65535,   496,
+  65535,   328,   556, 65535, 65535,   580, 65535,     0,
+  65535, 65535, 65535,   487,    82, 65535, 65535, 65535,
+    117, 65535,   465,   508, 65535, 65535, 65535,   220,
+    262,   260, 65535,   489,   271,    80, 65535, 65535,
+  65535,   181, 65535, 65535,   215, 65535, 65535, 65535,
+    445, 65535, 65535,   192,   140,   236, 65535, 65535,
+    411, 65535,   486, 65535, 65535, 65535, 65535,   217,
+  65535,   519, 65535,   548,   396, 65535, 65535,   180,
+  65535, 65535, 65535, 65535, 65535,   221, 65535, 65535,
+    348, 65535, 65535, 65535,   532, 65535, 65535, 65535,
+    143, 65535, 65535, 65535,   475, 65535,   298, 65535,
+    449, 65535,   226, 65535,   316,   164,    27,   284,
+  65535,   524,    32, 65535, 65535, 65535,   563, 65535,
+    121,   210,   105, 65535,   107, 65535, 65535, 65535,
+  65535,   417, 65535, 65535,   351, 65535, 65535, 65535
+};
+
+/* Register names, including the CSRs.  The includer defines the
+   RCLASS_* enumerators.  */
+
+#define RISCV_REG_HASH_BUCKETS 128
+#define RISCV_REG_HASH_SLOTS 512
+
+static const unsigned short riscv_reg_hash_disp[RISCV_REG_HASH_BUCKETS] =
+{
+      2,     1,    20,     0,     6,    12,     1,     0,
+      1,     0,    18,     0,     0,     8,    30,     0,
+      0,    10,    31,     1,     1,     1,     3,     1,
+      5,    16,    18,     1,     1,    12,    21,     0,
+      0,     2,     1,    22,    25,     4,     3,    35,
+      0,    25,     5,     0,     9,     4,     0,     1,
+      0,     3,     0,     9,    10,     6,     1,     7,
+      4,     1,     6,     6,     3,     2,     5,     1,
+      8,     6,    11,     1,     1,     0,     0,     0,
+     18,     0,     5,    20,     0,     0,     2,    11,
+      1,     0,     0,     8,     1,     0,     1,    51,
+      3,     3,    18,     6,    12,     6,     4,     2,
+      0,     4,     6,     2,     8,     1,     0,     2,
+     21,     3,     0,    35,     0,     8,    10,     7,
+     20,     0,    56,    21,     0,     3,     1,    17,
+     41,    31,     7,     7,     0,     0,     3,    11
+};
+
+struct riscv_reg_hash_entry
+{
+  const char *name;
+  unsigned char rclass;
+  unsigned short num;
+};
+
+static const struct riscv_reg_hash_entry riscv_reg_hash_table[RISCV_REG_HASH_SLOTS] =
+{
+  { "mhpmcounter13h", RCLASS_CSR, 0xb8d },
+  { "f22", RCLASS_FPR, 0x16 },
+  { "mhpmcounter16h", RCLASS_CSR, 0xb90 },
+  { "hscratch", RCLASS_CSR, 0x240 },
+  { "fs3", RCLASS_FPR, 0x13 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "hie", RCLASS_CSR, 0x204 },
+  { "x9", RCLASS_GPR, 0x9 },
+  { "mcounteren", RCLASS_CSR, 0x306 },
+  { "x27", RCLASS_GPR, 0x1b },
+  { "mhpmcounter16", RCLASS_CSR, 0xb10 },
+  { NULL, 0, 0 },
+  { "mimpid", RCLASS_CSR, 0xf13 },
+  { "v8", RCLASS_VPR, 0x8 },
+  { NULL, 0, 0 },
+  { "x13", RCLASS_GPR, 0xd },
+  { "mcause", RCLASS_CSR, 0x342 },
+  { NULL, 0, 0 },
+  { "f0", RCLASS_FPR, 0 },
+  { "mhpmevent12", RCLASS_CSR, 0x32c },
+  { "v20", RCLASS_VPR, 0x14 },
+  { "v31", RCLASS_VPR, 0x1f },
+  { "hpmcounter12", RCLASS_CSR, 0xc0c },
+  { "s8", RCLASS_GPR, 0x18 },
+  { "dscratch", RCLASS_CSR, 0x7b2 },
+  { "v10", RCLASS_VPR, 0xa },
+  { "hpmcounter19h", RCLASS_CSR, 0xc93 },
+  { "hpmcounter18", RCLASS_CSR, 0xc12 },
+  { "mhpmcounter12h", RCLASS_CSR, 0xb8c },
+  { NULL, 0, 0 },
+  { "ft0", RCLASS_FPR, 0 },
+  { "mip", RCLASS_CSR, 0x344 },
+  { "pmpaddr12", RCLASS_CSR, 0x3bc },
+  { "fflags", RCLASS_CSR, 0x1 },
+  { NULL, 0, 0 },
+  { "f27", RCLASS_FPR, 0x1b },
+  { "s2", RCLASS_GPR, 0x12 },
+  { "f8", RCLASS_FPR, 0x8 },
+  { "pmpaddr8", RCLASS_CSR, 0x3b8 },
+  { "f9", RCLASS_FPR, 0x9 },
+  { "scause", RCLASS_CSR, 0x142 },
+  { "hpmcounter6", RCLASS_CSR, 0xc06 },
+  { "x8", RCLASS_GPR, 0x8 },
+  { "x24", RCLASS_GPR, 0x18 },
+  { "hpmcounter13h", RCLASS_CSR, 0xc8d },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "f23", RCLASS_FPR, 0x17 },
+  { "mhpmevent18", RCLASS_CSR, 0x332 },
+  { "hpmcounter27h", RCLASS_CSR, 0xc9b },
+  { NULL, 0, 0 },
+  { "mhpmevent31", RCLASS_CSR, 0x33f },
+  { "a7", RCLASS_GPR, 0x11 },
+  { "hpmcounter24", RCLASS_CSR, 0xc18 },
+  { "mhpmcounter12", RCLASS_CSR, 0xb0c },
+  { "v1", RCLASS_VPR, 0x1 },
+  { "v6", RCLASS_VPR, 0x6 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "pmpaddr6", RCLASS_CSR, 0x3b6 },
+  { "pmpcfg3", RCLASS_CSR, 0x3a3 },
+  { "pmpaddr11", RCLASS_CSR, 0x3bb },
+  { "mhpmcounter6h", RCLASS_CSR, 0xb86 },
+  { "pmpaddr15", RCLASS_CSR, 0x3bf },
+  { "hpmcounter21h", RCLASS_CSR, 0xc95 },
+  { "f21", RCLASS_FPR, 0x15 },
+  { "mhpmcounter9", RCLASS_CSR, 0xb09 },
+  { "mhpmcounter14h", RCLASS_CSR, 0xb8e },
+  { "mhpmevent9", RCLASS_CSR, 0x329 },
+  { "x11", RCLASS_GPR, 0xb },
+  { "tselect", RCLASS_CSR, 0x7a0 },
+  { NULL, 0, 0 },
+  { "mhpmcounter7h", RCLASS_CSR, 0xb87 },
+  { "mhpmcounter31", RCLASS_CSR, 0xb1f },
+  { "v11", RCLASS_VPR, 0xb },
+  { NULL, 0, 0 },
+  { "mhpmevent30", RCLASS_CSR, 0x33e },
+  { "ft10", RCLASS_FPR, 0x1e },
+  { "mbase", RCLASS_CSR, 0x380 },
+  { "t2", RCLASS_GPR, 0x7 },
+  { "sip", RCLASS_CSR, 0x144 },
+  { "t6", RCLASS_GPR, 0x1f },
+  { "t5", RCLASS_GPR, 0x1e },
+  { "hpmcounter30", RCLASS_CSR, 0xc1e },
+  { "hpmcounter3", RCLASS_CSR, 0xc03 },
+  { NULL, 0, 0 },
+  { "ft3", RCLASS_FPR, 0x3 },
+  { "fs5", RCLASS_FPR, 0x15 },
+  { "tdata3", RCLASS_CSR, 0x7a3 },
+  { "t3", RCLASS_GPR, 0x1c },
+  { "mhpmcounter31h", RCLASS_CSR, 0xb9f },
+  { NULL, 0, 0 },
+  { "mhpmcounter5h", RCLASS_CSR, 0xb85 },
+  { "hip", RCLASS_CSR, 0x244 },
+  { "mhpmevent16", RCLASS_CSR, 0x330 },
+  { "sscratch", RCLASS_CSR, 0x140 },
+  { "f29", RCLASS_FPR, 0x1d },
+  { "x15", RCLASS_GPR, 0xf },
+  { "fs1", RCLASS_FPR, 0x9 },
+  { "mhpmevent17", RCLASS_CSR, 0x331 },
+  { "fs9", RCLASS_FPR, 0x19 },
+  { NULL, 0, 0 },
+  { "hpmcounter20", RCLASS_CSR, 0xc14 },
+  { NULL, 0, 0 },
+  { "v30", RCLASS_VPR, 0x1e },
+  { "v0", RCLASS_VPR, 0 },
+  { "sideleg", RCLASS_CSR, 0x103 },
+  { "x22", RCLASS_GPR, 0x16 },
+  { "pmpaddr1", RCLASS_CSR, 0x3b1 },
+  { "x17", RCLASS_GPR, 0x11 },
+  { NULL, 0, 0 },
+  { "medeleg", RCLASS_CSR, 0x302 },
+  { "ft6", RCLASS_FPR, 0x6 },
+  { "hedeleg", RCLASS_CSR, 0x202 },
+  { "ustatus", RCLASS_CSR, 0 },
+  { NULL, 0, 0 },
+  { "mhpmcounter17h", RCLASS_CSR, 0xb91 },
+  { "fa4", RCLASS_FPR, 0xe },
+  { NULL, 0, 0 },
+  { "f12", RCLASS_FPR, 0xc },
+  { "mhpmcounter10h", RCLASS_CSR, 0xb8a },
+  { NULL, 0, 0 },
+  { "mhpmevent23", RCLASS_CSR, 0x337 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "hpmcounter18h", RCLASS_CSR, 0xc92 },
+  { "hcause", RCLASS_CSR, 0x242 },
+  { "hpmcounter25", RCLASS_CSR, 0xc19 },
+  { "hpmcounter7", RCLASS_CSR, 0xc07 },
+  { NULL, 0, 0 },
+  { "mhpmcounter15h", RCLASS_CSR, 0xb8f },
+  { "f28", RCLASS_FPR, 0x1c },
+  { NULL, 0, 0 },
+  { "f11", RCLASS_FPR, 0xb },
+  { "v22", RCLASS_VPR, 0x16 },
+  { "t4", RCLASS_GPR, 0x1d },
+  { "v24", RCLASS_VPR, 0x18 },
+  { "hpmcounter24h", RCLASS_CSR, 0xc98 },
+  { "mhpmcounter19h", RCLASS_CSR, 0xb93 },
+  { NULL, 0, 0 },
+  { "x10", RCLASS_GPR, 0xa },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "ft11", RCLASS_FPR, 0x1f },
+  { NULL, 0, 0 },
+  { "mvendorid", RCLASS_CSR, 0xf11 },
+  { "hpmcounter17h", RCLASS_CSR, 0xc91 },
+  { "fs6", RCLASS_FPR, 0x16 },
+  { "ft9", RCLASS_FPR, 0x1d },
+  { "v16", RCLASS_VPR, 0x10 },
+  { "hpmcounter17", RCLASS_CSR, 0xc11 },
+  { "x18", RCLASS_GPR, 0x12 },
+  { "mhpmevent29", RCLASS_CSR, 0x33d },
+  { "x19", RCLASS_GPR, 0x13 },
+  { "f10", RCLASS_FPR, 0xa },
+  { "zero", RCLASS_GPR, 0 },
+  { "hpmcounter5", RCLASS_CSR, 0xc05 },
+  { "mepc", RCLASS_CSR, 0x341 },
+  { "fs2", RCLASS_FPR, 0x12 },
+  { "gp", RCLASS_GPR, 0x3 },
+  { NULL, 0, 0 },
+  { "s4", RCLASS_GPR, 0x14 },
+  { "mhpmevent10", RCLASS_CSR, 0x32a },
+  { "v15", RCLASS_VPR, 0xf },
+  { "mhpmevent26", RCLASS_CSR, 0x33a },
+  { "hbadaddr", RCLASS_CSR, 0x243 },
+  { "mhpmcounter21h", RCLASS_CSR, 0xb95 },
+  { "fs4", RCLASS_FPR, 0x14 },
+  { "mdbase", RCLASS_CSR, 0x384 },
+  { "pmpaddr5", RCLASS_CSR, 0x3b5 },
+  { "fa7", RCLASS_FPR, 0x11 },
+  { "f15", RCLASS_FPR, 0xf },
+  { "misa", RCLASS_CSR, 0x301 },
+  { "t1", RCLASS_GPR, 0x6 },
+  { "hpmcounter4h", RCLASS_CSR, 0xc84 },
+  { "ft7", RCLASS_FPR, 0x7 },
+  { NULL, 0, 0 },
+  { "hpmcounter16h", RCLASS_CSR, 0xc90 },
+  { "mhpmcounter8h", RCLASS_CSR, 0xb88 },
+  { "s11", RCLASS_GPR, 0x1b },
+  { "hpmcounter14", RCLASS_CSR, 0xc0e },
+  { NULL, 0, 0 },
+  { "tp", RCLASS_GPR, 0x4 },
+  { "mhartid", RCLASS_CSR, 0xf14 },
+  { "hpmcounter25h", RCLASS_CSR, 0xc99 },
+  { "pmpaddr13", RCLASS_CSR, 0x3bd },
+  { "mhpmevent5", RCLASS_CSR, 0x325 },
+  { "fs0", RCLASS_FPR, 0x8 },
+  { NULL, 0, 0 },
+  { "mibase", RCLASS_CSR, 0x382 },
+  { NULL, 0, 0 },
+  { "x14", RCLASS_GPR, 0xe },
+  { NULL, 0, 0 },
+  { "mhpmcounter30h", RCLASS_CSR, 0xb9e },
+  { "sp", RCLASS_GPR, 0x2 },
+  { "hpmcounter10h", RCLASS_CSR, 0xc8a },
+  { "mhpmevent8", RCLASS_CSR, 0x328 },
+  { NULL, 0, 0 },
+  { "f3", RCLASS_FPR, 0x3 },
+  { "f31", RCLASS_FPR, 0x1f },
+  { "v19", RCLASS_VPR, 0x13 },
+  { "mhpmevent6", RCLASS_CSR, 0x326 },
+  { NULL, 0, 0 },
+  { "mdbound", RCLASS_CSR, 0x385 },
+  { NULL, 0, 0 },
+  { "s3", RCLASS_GPR, 0x13 },
+  { NULL, 0, 0 },
+  { "x25", RCLASS_GPR, 0x19 },
+  { NULL, 0, 0 },
+  { "mtvec", RCLASS_CSR, 0x305 },
+  { "mhpmevent19", RCLASS_CSR, 0x333 },
+  { "t0", RCLASS_GPR, 0x5 },
+  { NULL, 0, 0 },
+  { "hpmcounter26h", RCLASS_CSR, 0xc9a },
+  { "mhpmcounter3", RCLASS_CSR, 0xb03 },
+  { "x4", RCLASS_GPR, 0x4 },
+  { NULL, 0, 0 },
+  { "f14", RCLASS_FPR, 0xe },
+  { NULL, 0, 0 },
+  { "v5", RCLASS_VPR, 0x5 },
+  { "s0", RCLASS_GPR, 0x8 },
+  { "hpmcounter26", RCLASS_CSR, 0xc1a },
+  { "pmpaddr10", RCLASS_CSR, 0x3ba },
+  { "ft1", RCLASS_FPR, 0x1 },
+  { "time", RCLASS_CSR, 0xc01 },
+  { "ubadaddr", RCLASS_CSR, 0x43 },
+  { "pmpaddr0", RCLASS_CSR, 0x3b0 },
+  { "hpmcounter22h", RCLASS_CSR, 0xc96 },
+  { "uip", RCLASS_CSR, 0x44 },
+  { "minstreth", RCLASS_CSR, 0xb82 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "uie", RCLASS_CSR, 0x4 },
+  { "f5", RCLASS_FPR, 0x5 },
+  { "v9", RCLASS_VPR, 0x9 },
+  { "mhpmcounter26", RCLASS_CSR, 0xb1a },
+  { NULL, 0, 0 },
+  { "fcsr", RCLASS_CSR, 0x3 },
+  { "a1", RCLASS_GPR, 0xb },
+  { "x7", RCLASS_GPR, 0x7 },
+  { NULL, 0, 0 },
+  { "x0", RCLASS_GPR, 0 },
+  { "fs11", RCLASS_FPR, 0x1b },
+  { "v21", RCLASS_VPR, 0x15 },
+  { "ft4", RCLASS_FPR, 0x4 },
+  { "a6", RCLASS_GPR, 0x10 },
+  { "pmpaddr7", RCLASS_CSR, 0x3b7 },
+  { NULL, 0, 0 },
+  { "mhpmevent3", RCLASS_CSR, 0x323 },
+  { "s6", RCLASS_GPR, 0x16 },
+  { "satp", RCLASS_CSR, 0x180 },
+  { "a3", RCLASS_GPR, 0xd },
+  { "mhpmevent22", RCLASS_CSR, 0x336 },
+  { "x20", RCLASS_GPR, 0x14 },
+  { "hpmcounter11", RCLASS_CSR, 0xc0b },
+  { NULL, 0, 0 },
+  { "hpmcounter16", RCLASS_CSR, 0xc10 },
+  { "f7", RCLASS_FPR, 0x7 },
+  { "a2", RCLASS_GPR, 0xc },
+  { "fa0", RCLASS_FPR, 0xa },
+  { NULL, 0, 0 },
+  { "a5", RCLASS_GPR, 0xf },
+  { "mhpmcounter5", RCLASS_CSR, 0xb05 },
+  { "s10", RCLASS_GPR, 0x1a },
+  { "pmpaddr14", RCLASS_CSR, 0x3be },
+  { "fa3", RCLASS_FPR, 0xd },
+  { "f30", RCLASS_FPR, 0x1e },
+  { NULL, 0, 0 },
+  { "mhpmcounter28h", RCLASS_CSR, 0xb9c },
+  { "fs7", RCLASS_FPR, 0x17 },
+  { NULL, 0, 0 },
+  { "f20", RCLASS_FPR, 0x14 },
+  { "s9", RCLASS_GPR, 0x19 },
+  { "v12", RCLASS_VPR, 0xc },
+  { "x3", RCLASS_GPR, 0x3 },
+  { NULL, 0, 0 },
+  { "x5", RCLASS_GPR, 0x5 },
+  { NULL, 0, 0 },
+  { "hpmcounter23", RCLASS_CSR, 0xc17 },
+  { NULL, 0, 0 },
+  { "mhpmcounter23", RCLASS_CSR, 0xb17 },
+  { "mhpmcounter24", RCLASS_CSR, 0xb18 },
+  { NULL, 0, 0 },
+  { "mhpmcounter25h", RCLASS_CSR, 0xb99 },
+  { NULL, 0, 0 },
+  { "mhpmcounter20", RCLASS_CSR, 0xb14 },
+  { "mhpmevent11", RCLASS_CSR, 0x32b },
+  { "mucounteren", RCLASS_CSR, 0x320 },
+  { "mhpmcounter25", RCLASS_CSR, 0xb19 },
+  { "f4", RCLASS_FPR, 0x4 },
+  { "cycle", RCLASS_CSR, 0xc00 },
+  { "fa6", RCLASS_FPR, 0x10 },
+  { NULL, 0, 0 },
+  { "f16", RCLASS_FPR, 0x10 },
+  { "mhpmevent24", RCLASS_CSR, 0x338 },
+  { "mideleg", RCLASS_CSR, 0x303 },
+  { "mhpmcounter9h", RCLASS_CSR, 0xb89 },
+  { "fa2", RCLASS_FPR, 0xc },
+  { "hpmcounter22", RCLASS_CSR, 0xc16 },
+  { NULL, 0, 0 },
+  { "hpmcounter7h", RCLASS_CSR, 0xc87 },
+  { "hideleg", RCLASS_CSR, 0x203 },
+  { "v27", RCLASS_VPR, 0x1b },
+  { "minstret", RCLASS_CSR, 0xb02 },
+  { "v7", RCLASS_VPR, 0x7 },
+  { "x1", RCLASS_GPR, 0x1 },
+  { "mibound", RCLASS_CSR, 0x383 },
+  { "mhpmcounter30", RCLASS_CSR, 0xb1e },
+  { "instret", RCLASS_CSR, 0xc02 },
+  { "fa5", RCLASS_FPR, 0xf },
+  { "hepc", RCLASS_CSR, 0x241 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "mhpmcounter13", RCLASS_CSR, 0xb0d },
+  { "mhpmcounter22h", RCLASS_CSR, 0xb96 },
+  { "hpmcounter12h", RCLASS_CSR, 0xc8c },
+  { "hpmcounter14h", RCLASS_CSR, 0xc8e },
+  { "f13", RCLASS_FPR, 0xd },
+  { "mhpmcounter18", RCLASS_CSR, 0xb12 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "s5", RCLASS_GPR, 0x15 },
+  { "hpmcounter9h", RCLASS_CSR, 0xc89 },
+  { NULL, 0, 0 },
+  { "mie", RCLASS_CSR, 0x304 },
+  { NULL, 0, 0 },
+  { "f1", RCLASS_FPR, 0x1 },
+  { NULL, 0, 0 },
+  { "hpmcounter28h", RCLASS_CSR, 0xc9c },
+  { NULL, 0, 0 },
+  { "hpmcounter30h", RCLASS_CSR, 0xc9e },
+  { "pmpcfg1", RCLASS_CSR, 0x3a1 },
+  { NULL, 0, 0 },
+  { "mhpmcounter27h", RCLASS_CSR, 0xb9b },
+  { "fa1", RCLASS_FPR, 0xb },
+  { NULL, 0, 0 },
+  { "tdata2", RCLASS_CSR, 0x7a2 },
+  { "mhpmcounter7", RCLASS_CSR, 0xb07 },
+  { "mhpmcounter29", RCLASS_CSR, 0xb1d },
+  { "pmpaddr2", RCLASS_CSR, 0x3b2 },
+  { "mhpmcounter8", RCLASS_CSR, 0xb08 },
+  { "mhpmcounter28", RCLASS_CSR, 0xb1c },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "f17", RCLASS_FPR, 0x11 },
+  { NULL, 0, 0 },
+  { "hpmcounter3h", RCLASS_CSR, 0xc83 },
+  { "v18", RCLASS_VPR, 0x12 },
+  { "s7", RCLASS_GPR, 0x17 },
+  { "hpmcounter31", RCLASS_CSR, 0xc1f },
+  { "sbadaddr", RCLASS_CSR, 0x143 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "x30", RCLASS_GPR, 0x1e },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "v25", RCLASS_VPR, 0x19 },
+  { NULL, 0, 0 },
+  { "sstatus", RCLASS_CSR, 0x100 },
+  { NULL, 0, 0 },
+  { "ft2", RCLASS_FPR, 0x2 },
+  { "uepc", RCLASS_CSR, 0x41 },
+  { "pmpcfg0", RCLASS_CSR, 0x3a0 },
+  { "hpmcounter5h", RCLASS_CSR, 0xc85 },
+  { "marchid", RCLASS_CSR, 0xf12 },
+  { "hpmcounter8h", RCLASS_CSR, 0xc88 },
+  { "mbound", RCLASS_CSR, 0x381 },
+  { "pmpaddr3", RCLASS_CSR, 0x3b3 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "mhpmevent7", RCLASS_CSR, 0x327 },
+  { "a0", RCLASS_GPR, 0xa },
+  { "cycleh", RCLASS_CSR, 0xc80 },
+  { NULL, 0, 0 },
+  { "ft8", RCLASS_FPR, 0x1c },
+  { "mhpmcounter11h", RCLASS_CSR, 0xb8b },
+  { "x16", RCLASS_GPR, 0x10 },
+  { "mhpmcounter6", RCLASS_CSR, 0xb06 },
+  { "f6", RCLASS_FPR, 0x6 },
+  { "mhpmcounter29h", RCLASS_CSR, 0xb9d },
+  { "hpmcounter27", RCLASS_CSR, 0xc1b },
+  { "mhpmcounter3h", RCLASS_CSR, 0xb83 },
+  { "uscratch", RCLASS_CSR, 0x40 },
+  { NULL, 0, 0 },
+  { "f19", RCLASS_FPR, 0x13 },
+  { "x12", RCLASS_GPR, 0xc },
+  { "v26", RCLASS_VPR, 0x1a },
+  { "hpmcounter9", RCLASS_CSR, 0xc09 },
+  { "mcycleh", RCLASS_CSR, 0xb80 },
+  { NULL, 0, 0 },
+  { "tdata1", RCLASS_CSR, 0x7a1 },
+  { "sptbr", RCLASS_CSR, 0x180 },
+  { "mtval", RCLASS_CSR, 0x343 },
+  { "hpmcounter6h", RCLASS_CSR, 0xc86 },
+  { "pmpaddr9", RCLASS_CSR, 0x3b9 },
+  { NULL, 0, 0 },
+  { "mhpmcounter18h", RCLASS_CSR, 0xb92 },
+  { "ucause", RCLASS_CSR, 0x42 },
+  { NULL, 0, 0 },
+  { "hpmcounter10", RCLASS_CSR, 0xc0a },
+  { NULL, 0, 0 },
+  { "mhpmevent28", RCLASS_CSR, 0x33c },
+  { NULL, 0, 0 },
+  { "x21", RCLASS_GPR, 0x15 },
+  { "v13", RCLASS_VPR, 0xd },
+  { "s1", RCLASS_GPR, 0x9 },
+  { "ft5", RCLASS_FPR, 0x5 },
+  { "v23", RCLASS_VPR, 0x17 },
+  { NULL, 0, 0 },
+  { "mhpmevent21", RCLASS_CSR, 0x335 },
+  { "mhpmevent14", RCLASS_CSR, 0x32e },
+  { "hpmcounter23h", RCLASS_CSR, 0xc97 },
+  { "mhpmcounter4h", RCLASS_CSR, 0xb84 },
+  { "mhpmevent27", RCLASS_CSR, 0x33b },
+  { "utval", RCLASS_CSR, 0x43 },
+  { NULL, 0, 0 },
+  { "mscounteren", RCLASS_CSR, 0x321 },
+  { "v17", RCLASS_VPR, 0x11 },
+  { "sepc", RCLASS_CSR, 0x141 },
+  { "mhpmcounter21", RCLASS_CSR, 0xb15 },
+  { "v2", RCLASS_VPR, 0x2 },
+  { "timeh", RCLASS_CSR, 0xc81 },
+  { "dpc", RCLASS_CSR, 0x7b1 },
+  { "htvec", RCLASS_CSR, 0x205 },
+  { "mcycle", RCLASS_CSR, 0xb00 },
+  { "mhpmevent20", RCLASS_CSR, 0x334 },
+  { "hpmcounter28", RCLASS_CSR, 0xc1c },
+  { "mhpmcounter22", RCLASS_CSR, 0xb16 },
+  { "x2", RCLASS_GPR, 0x2 },
+  { "mhpmcounter23h", RCLASS_CSR, 0xb97 },
+  { "scounteren", RCLASS_CSR, 0x106 },
+  { NULL, 0, 0 },
+  { "instreth", RCLASS_CSR, 0xc82 },
+  { "frm", RCLASS_CSR, 0x2 },
+  { "ra", RCLASS_GPR, 0x1 },
+  { "f26", RCLASS_FPR, 0x1a },
+  { "mhpmcounter15", RCLASS_CSR, 0xb0f },
+  { "pmpaddr4", RCLASS_CSR, 0x3b4 },
+  { "mhpmevent13", RCLASS_CSR, 0x32d },
+  { NULL, 0, 0 },
+  { "hpmcounter8", RCLASS_CSR, 0xc08 },
+  { "v4", RCLASS_VPR, 0x4 },
+  { NULL, 0, 0 },
+  { NULL, 0, 0 },
+  { "hpmcounter13", RCLASS_CSR, 0xc0d },
+  { "hpmcounter15", RCLASS_CSR, 0xc0f },
+  { "f24", RCLASS_FPR, 0x18 },
+  { NULL, 0, 0 },
+  { "fs8", RCLASS_FPR, 0x18 },
+  { "mhpmcounter27", RCLASS_CSR, 0xb1b },
+  { "utvec", RCLASS_CSR, 0x5 },
+  { "mhpmcounter11", RCLASS_CSR, 0xb0b },
+  { "v28", RCLASS_VPR, 0x1c },
+  { "stvec", RCLASS_CSR, 0x105 },
+  { "v3", RCLASS_VPR, 0x3 },
+  { "a4", RCLASS_GPR, 0xe },
+  { "mhpmcounter19", RCLASS_CSR, 0xb13 },
+  { "mhpmcounter4", RCLASS_CSR, 0xb04 },
+  { "f25", RCLASS_FPR, 0x19 },
+  { "v29", RCLASS_VPR, 0x1d },
+  { NULL, 0, 0 },
+  { "mhpmevent4", RCLASS_CSR, 0x324 },
+  { "mhpmcounter14", RCLASS_CSR, 0xb0e },
+  { "mhpmcounter20h", RCLASS_CSR, 0xb94 },
+  { "hstatus", RCLASS_CSR, 0x200 },
+  { "hpmcounter15h", RCLASS_CSR, 0xc8f },
+  { NULL, 0, 0 },
+  { "x6", RCLASS_GPR, 0x6 },
+  { "mhpmcounter26h", RCLASS_CSR, 0xb9a },
+  { NULL, 0, 0 },
+  { "x29", RCLASS_GPR, 0x1d },
+  { "hpmcounter4", RCLASS_CSR, 0xc04 },
+  { "pmpcfg2", RCLASS_CSR, 0x3a2 },
+  { "hpmcounter11h", RCLASS_CSR, 0xc8b },
+  { "v14", RCLASS_VPR, 0xe },
+  { "hpmcounter31h", RCLASS_CSR, 0xc9f },
+  { "mhpmcounter17", RCLASS_CSR, 0xb11 },
+  { "mscratch", RCLASS_CSR, 0x340 },
+  { NULL, 0, 0 },
+  { "x28", RCLASS_GPR, 0x1c },
+  { "f18", RCLASS_FPR, 0x12 },
+  { "hpmcounter29h", RCLASS_CSR, 0xc9d },
+  { "mhcounteren", RCLASS_CSR, 0x322 },
+  { "mhpmevent25", RCLASS_CSR, 0x339 },
+  { NULL, 0, 0 },
+  { "hpmcounter29", RCLASS_CSR, 0xc1d },
+  { NULL, 0, 0 },
+  { "mhpmcounter10", RCLASS_CSR, 0xb0a },
+  { "x26", RCLASS_GPR, 0x1a },
+  { "mhpmcounter24h", RCLASS_CSR, 0xb98 },
+  { "mstatus", RCLASS_CSR, 0x300 },
+  { "hpmcounter19", RCLASS_CSR, 0xc13 },
+  { NULL, 0, 0 },
+  { "stval", RCLASS_CSR, 0x143 },
+  { "f2", RCLASS_FPR, 0x2 },
+  { "hpmcounter20h", RCLASS_CSR, 0xc94 },
+  { "sie", RCLASS_CSR, 0x104 },
+  { "mhpmevent15", RCLASS_CSR, 0x32f },
+  { "hpmcounter21", RCLASS_CSR, 0xc15 },
+  { "fs10", RCLASS_FPR, 0x1a },
+  { "sedeleg", RCLASS_CSR, 0x102 },
+  { NULL, 0, 0 },
+  { "dcsr", RCLASS_CSR, 0x7b0 },
+  { NULL, 0, 0 },
+  { "x23", RCLASS_GPR, 0x17 },
+  { "x31", RCLASS_GPR, 0x1f },
+  { "mbadaddr", RCLASS_CSR, 0x343 }
+};